@@ -0,0 +1,352 @@
+/******************************************************************************
+ * VantageCV - Actor Index Subsystem Implementation
+ ******************************************************************************
+ * File: ActorIndexSubsystem.cpp
+ * Description: Name/label/tag actor index maintained from world delegates
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "ActorIndexSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "EngineUtils.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogActorIndex, Log, All);
+
+UActorIndexSubsystem* UActorIndexSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UActorIndexSubsystem>() : nullptr;
+}
+
+bool UActorIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::Editor;
+}
+
+void UActorIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &UActorIndexSubsystem::HandleActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateUObject(this, &UActorIndexSubsystem::HandleActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UActorIndexSubsystem::HandleLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UActorIndexSubsystem::HandleLevelRemoved);
+}
+
+void UActorIndexSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);	// Engine spelling
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	ActorsByName.Reset();
+	ActorsByLabel.Reset();
+	ActorsByTag.Reset();
+	IndexedActors.Reset();
+	PendingActors.Reset();
+	bBuilt = false;
+
+	Super::Deinitialize();
+}
+
+AActor* UActorIndexSubsystem::FindActorByName(const FString& ActorName)
+{
+	if (ActorName.IsEmpty())
+	{
+		return nullptr;
+	}
+	Refresh();
+
+	// FNAME_Find: a name nobody uses cannot match and must not grow the name table
+	const FName Name(*ActorName, FNAME_Find);
+	if (!Name.IsNone())
+	{
+		if (const TWeakObjectPtr<AActor>* Found = ActorsByName.Find(Name))
+		{
+			if (IsValid(Found->Get()))
+			{
+				return Found->Get();
+			}
+		}
+	}
+
+	if (const TWeakObjectPtr<AActor>* Found = ActorsByLabel.Find(ActorName))
+	{
+		if (IsValid(Found->Get()))
+		{
+			return Found->Get();
+		}
+	}
+	return nullptr;
+}
+
+void UActorIndexSubsystem::GetActorsWithTag(FName Tag, TArray<AActor*>& OutActors)
+{
+	Refresh();
+
+	// Tags can be added without ReindexActor (Remote Control property writes, Blueprint):
+	// re-read them once per frame, and again whenever the bucket comes up empty
+	TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByTag.Find(Tag);
+	if (TagsCheckedFrame != GFrameCounter || !Actors || Actors->Num() == 0)
+	{
+		RefreshTags();
+		Actors = ActorsByTag.Find(Tag);
+	}
+	if (!Actors)
+	{
+		return;
+	}
+
+	// Compact dead entries while reading; the tag check catches tags removed without ReindexActor
+	Actors->RemoveAll([](const TWeakObjectPtr<AActor>& Actor) { return !IsValid(Actor.Get()); });
+	for (const TWeakObjectPtr<AActor>& Actor : *Actors)
+	{
+		if (Actor->ActorHasTag(Tag))
+		{
+			OutActors.Add(Actor.Get());
+		}
+	}
+}
+
+TArray<AActor*> UActorIndexSubsystem::GetActorsWithAnyTag(const TArray<FString>& Tags)
+{
+	TArray<AActor*> FoundActors;
+	for (const FString& Tag : Tags)
+	{
+		const FName TagName(*Tag, FNAME_Find);
+		if (!TagName.IsNone())
+		{
+			GetActorsWithTag(TagName, FoundActors);
+		}
+	}
+
+	if (Tags.Num() > 1)
+	{
+		// Actors with several of the tags: keep the first occurrence, preserve order
+		TSet<AActor*> Seen;
+		Seen.Reserve(FoundActors.Num());
+		FoundActors.RemoveAll([&Seen](AActor* Actor)
+		{
+			bool bAlreadySeen = false;
+			Seen.Add(Actor, &bAlreadySeen);
+			return bAlreadySeen;
+		});
+	}
+	return FoundActors;
+}
+
+void UActorIndexSubsystem::ReindexActor(AActor* Actor)
+{
+	// Deferred like spawns, so tag edits made right after this call are still seen
+	if (bBuilt && IsValid(Actor))
+	{
+		PendingActors.Add(Actor);
+	}
+}
+
+void UActorIndexSubsystem::Rebuild()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	ActorsByName.Reset();
+	ActorsByLabel.Reset();
+	ActorsByTag.Reset();
+	IndexedActors.Reset();
+	PendingActors.Reset();
+	TagsCheckedFrame = GFrameCounter;
+
+	if (UWorld* World = GetWorld())
+	{
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			AddActor(*It);
+		}
+	}
+	bBuilt = true;
+
+	UE_LOG(LogActorIndex, Log, TEXT("Actor index built: %d actors, %d tags in %.2f ms"),
+		IndexedActors.Num(), ActorsByTag.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+int32 UActorIndexSubsystem::GetNumIndexedActors()
+{
+	Refresh();
+	return IndexedActors.Num();
+}
+
+void UActorIndexSubsystem::Refresh()
+{
+	if (!bBuilt)
+	{
+		Rebuild();
+		return;
+	}
+
+	for (const TWeakObjectPtr<AActor>& Actor : PendingActors)
+	{
+		if (IsValid(Actor.Get()))
+		{
+			AddActor(Actor.Get());
+		}
+	}
+	PendingActors.Reset();
+}
+
+void UActorIndexSubsystem::RefreshTags()
+{
+	TagsCheckedFrame = GFrameCounter;
+
+	TArray<AActor*> Changed;
+	for (const TPair<TWeakObjectPtr<AActor>, FIndexedKeys>& Entry : IndexedActors)
+	{
+		AActor* Actor = Entry.Key.Get();
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		const TArray<FName>& IndexedTags = Entry.Value.Tags;
+		bool bChanged = IndexedTags.ContainsByPredicate([Actor](const FName& Tag) { return !Actor->Tags.Contains(Tag); });
+		for (int32 Index = 0; !bChanged && Index < Actor->Tags.Num(); ++Index)
+		{
+			const FName& Tag = Actor->Tags[Index];
+			bChanged = !Tag.IsNone() && !IndexedTags.Contains(Tag);
+		}
+		if (bChanged)
+		{
+			Changed.Add(Actor);
+		}
+	}
+
+	// Re-added outside the loop: AddActor rewrites IndexedActors
+	for (AActor* Actor : Changed)
+	{
+		AddActor(Actor);
+	}
+	if (Changed.Num() > 0)
+	{
+		UE_LOG(LogActorIndex, Verbose, TEXT("Actor index: re-read tags of %d actors"), Changed.Num());
+	}
+}
+
+void UActorIndexSubsystem::AddActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (IndexedActors.Contains(Actor))
+	{
+		RemoveActor(Actor);
+	}
+
+	FIndexedKeys& Keys = IndexedActors.Add(Actor);
+	Keys.Name = Actor->GetFName();
+	ActorsByName.Add(Keys.Name, Actor);
+
+#if WITH_EDITOR
+	Keys.Label = Actor->GetActorLabel();
+	if (!Keys.Label.IsEmpty() && Keys.Label != Actor->GetName())
+	{
+		ActorsByLabel.Add(Keys.Label, Actor);
+	}
+#endif
+
+	for (const FName& Tag : Actor->Tags)
+	{
+		if (!Tag.IsNone() && !Keys.Tags.Contains(Tag))
+		{
+			Keys.Tags.Add(Tag);
+			ActorsByTag.FindOrAdd(Tag).Add(Actor);
+		}
+	}
+}
+
+void UActorIndexSubsystem::RemoveActor(AActor* Actor)
+{
+	FIndexedKeys Keys;
+	if (!IndexedActors.RemoveAndCopyValue(Actor, Keys))
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<AActor> WeakActor(Actor);
+	if (const TWeakObjectPtr<AActor>* Existing = ActorsByName.Find(Keys.Name); Existing && *Existing == WeakActor)
+	{
+		ActorsByName.Remove(Keys.Name);
+	}
+	if (const TWeakObjectPtr<AActor>* Existing = ActorsByLabel.Find(Keys.Label); Existing && *Existing == WeakActor)
+	{
+		ActorsByLabel.Remove(Keys.Label);
+	}
+
+	// Stable removal keeps annotation order deterministic across runs
+	for (const FName& Tag : Keys.Tags)
+	{
+		if (TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByTag.Find(Tag))
+		{
+			Actors->Remove(WeakActor);
+		}
+	}
+}
+
+void UActorIndexSubsystem::HandleActorSpawned(AActor* Actor)
+{
+	// Deferred: spawners usually add tags right after SpawnActor returns
+	if (bBuilt)
+	{
+		PendingActors.Add(Actor);
+	}
+}
+
+void UActorIndexSubsystem::HandleActorDestroyed(AActor* Actor)
+{
+	if (bBuilt)
+	{
+		RemoveActor(Actor);
+	}
+}
+
+void UActorIndexSubsystem::HandleLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+	if (!bBuilt || !Level || InWorld != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor)
+		{
+			PendingActors.Add(Actor);
+		}
+	}
+}
+
+void UActorIndexSubsystem::HandleLevelRemoved(ULevel* Level, UWorld* InWorld)
+{
+	if (!bBuilt || !Level || InWorld != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor)
+		{
+			RemoveActor(Actor);
+		}
+	}
+}
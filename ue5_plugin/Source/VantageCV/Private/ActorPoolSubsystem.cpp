@@ -0,0 +1,298 @@
+/******************************************************************************
+ * VantageCV - Actor Pool Subsystem Implementation
+ ******************************************************************************
+ * File: ActorPoolSubsystem.cpp
+ * Description: Park/reuse of spawned actors keyed by asset path
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "ActorPoolSubsystem.h"
+#include "ActorIndexSubsystem.h"
+#include "SegmentationStencil.h"
+#include "SpawnAssetCache.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectGlobals.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogActorPool, Log, All);
+
+const FName UActorPoolSubsystem::PooledTag(TEXT("VantageCVPooled"));
+
+namespace
+{
+	/** Far below any level; parked actors are hidden as well, this keeps them out of every frustum */
+	const FVector ParkLocation(0.0, 0.0, -200000.0);
+
+	constexpr ERenameFlags PoolRenameFlags = REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty;
+}
+
+UActorPoolSubsystem* UActorPoolSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UActorPoolSubsystem>() : nullptr;
+}
+
+bool UActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::Editor;
+}
+
+void UActorPoolSubsystem::Deinitialize()
+{
+	// Actors belong to the level and go away with the world
+	Buckets.Reset();
+	PooledActors.Reset();
+	Super::Deinitialize();
+}
+
+AActor* UActorPoolSubsystem::AcquireOrSpawn(UWorld* World, const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+	FName RequestedName, ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+	if (UActorPoolSubsystem* ActorPool = Get(World))
+	{
+		return ActorPool->Acquire(AssetPath, Location, Rotation, RequestedName, CollisionHandling);
+	}
+	return SpawnFromAsset(World, AssetPath, Location, Rotation, RequestedName, CollisionHandling);
+}
+
+AActor* UActorPoolSubsystem::Acquire(const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+	FName RequestedName, ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+	FActorPoolBucket& Bucket = Buckets.FindOrAdd(AssetPath);
+
+	while (Bucket.Idle.Num() > 0)
+	{
+		AActor* Actor = Bucket.Idle.Pop(EAllowShrinking::No);
+		FPooledActorInfo* Info = IsValid(Actor) ? PooledActors.Find(Actor) : nullptr;
+		if (!Info)
+		{
+			continue;  // Destroyed behind the pool's back
+		}
+
+		Activate(Actor, *Info, Location, Rotation, RequestedName);
+		Bucket.NumInUse++;
+		Bucket.NumReused++;
+		return Actor;
+	}
+
+	AActor* Actor = SpawnPooled(AssetPath, Location, Rotation, RequestedName, CollisionHandling);
+	if (Actor)
+	{
+		Bucket.NumInUse++;
+		Bucket.NumSpawned++;
+	}
+	return Actor;
+}
+
+void UActorPoolSubsystem::Release(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	FPooledActorInfo* Info = PooledActors.Find(Actor);
+	if (!Info)
+	{
+		FSegmentationStencil::ReleaseInstanceId(Actor);
+		Actor->Destroy();
+		return;
+	}
+	if (!Info->bActive)
+	{
+		return;  // Already parked
+	}
+
+	Park(Actor, *Info);
+
+	FActorPoolBucket& Bucket = Buckets.FindOrAdd(Info->AssetPath);
+	Bucket.NumInUse = FMath::Max(0, Bucket.NumInUse - 1);
+	Bucket.Idle.Add(Actor);
+}
+
+bool UActorPoolSubsystem::IsPooled(const AActor* Actor) const
+{
+	// Weak pointer keys cannot be built from a const pointer; the lookup does not modify the actor
+	return Actor && PooledActors.Contains(TWeakObjectPtr<AActor>(const_cast<AActor*>(Actor)));
+}
+
+int32 UActorPoolSubsystem::Prewarm(const FString& AssetPath, int32 Count)
+{
+	FActorPoolBucket& Bucket = Buckets.FindOrAdd(AssetPath);
+	Bucket.Idle.RemoveAll([](const TObjectPtr<AActor>& Actor) { return !IsValid(Actor); });
+
+	int32 NumSpawned = 0;
+	while (Bucket.Idle.Num() < Count)
+	{
+		AActor* Actor = SpawnPooled(AssetPath, ParkLocation, FRotator::ZeroRotator, NAME_None,
+			ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Actor)
+		{
+			break;
+		}
+		Park(Actor, PooledActors.FindChecked(Actor));
+		Bucket.Idle.Add(Actor);
+		Bucket.NumSpawned++;
+		NumSpawned++;
+	}
+
+	UE_LOG(LogActorPool, Log, TEXT("Prewarmed %s: %d spawned, %d idle"), *AssetPath, NumSpawned, Bucket.Idle.Num());
+	return NumSpawned;
+}
+
+int32 UActorPoolSubsystem::Trim(int32 MaxIdlePerAsset)
+{
+	int32 NumDestroyed = 0;
+	for (TPair<FString, FActorPoolBucket>& Pair : Buckets)
+	{
+		TArray<TObjectPtr<AActor>>& Idle = Pair.Value.Idle;
+		while (Idle.Num() > FMath::Max(0, MaxIdlePerAsset))
+		{
+			AActor* Actor = Idle.Pop(EAllowShrinking::No);
+			PooledActors.Remove(Actor);
+			if (IsValid(Actor))
+			{
+				Actor->Destroy();
+				NumDestroyed++;
+			}
+		}
+	}
+
+	UE_LOG(LogActorPool, Log, TEXT("Actor pool trimmed: %d destroyed"), NumDestroyed);
+	return NumDestroyed;
+}
+
+FString UActorPoolSubsystem::GetStatsJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> AssetsArray;
+	int32 TotalIdle = 0;
+	int32 TotalInUse = 0;
+	for (const TPair<FString, FActorPoolBucket>& Pair : Buckets)
+	{
+		TSharedPtr<FJsonObject> AssetObj = MakeShareable(new FJsonObject);
+		AssetObj->SetStringField("asset", Pair.Key);
+		AssetObj->SetNumberField("idle", Pair.Value.Idle.Num());
+		AssetObj->SetNumberField("in_use", Pair.Value.NumInUse);
+		AssetObj->SetNumberField("spawned", (double)Pair.Value.NumSpawned);
+		AssetObj->SetNumberField("reused", (double)Pair.Value.NumReused);
+		AssetsArray.Add(MakeShareable(new FJsonValueObject(AssetObj)));
+
+		TotalIdle += Pair.Value.Idle.Num();
+		TotalInUse += Pair.Value.NumInUse;
+	}
+
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetNumberField("total_idle", TotalIdle);
+	RootObj->SetNumberField("total_in_use", TotalInUse);
+	RootObj->SetArrayField("assets", AssetsArray);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	return OutputString;
+}
+
+AActor* UActorPoolSubsystem::SpawnPooled(const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+	FName RequestedName, ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+	AActor* Actor = SpawnFromAsset(GetWorld(), AssetPath, Location, Rotation, RequestedName, CollisionHandling);
+	if (Actor)
+	{
+		FPooledActorInfo& Info = PooledActors.Add(Actor);
+		Info.AssetPath = AssetPath;
+		Info.BaselineTags = Actor->Tags;
+		Info.BaselineScale = Actor->GetActorScale3D();
+		Info.bBaselineTickEnabled = Actor->IsActorTickEnabled();
+		Info.bActive = true;
+	}
+	return Actor;
+}
+
+AActor* UActorPoolSubsystem::SpawnFromAsset(UWorld* World, const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+	FName RequestedName, ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = RequestedName;
+	SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnParams.SpawnCollisionHandlingOverride = CollisionHandling;
+
+	// Blueprint class or static mesh, preloaded or resolved once by the asset cache
+	const FSpawnAsset Asset = FSpawnAssetCache::Get().Resolve(AssetPath);
+	if (Asset.Class)
+	{
+		return World->SpawnActor<AActor>(Asset.Class, Location, Rotation, SpawnParams);
+	}
+
+	UStaticMesh* Mesh = Asset.Mesh;
+	if (!Mesh)
+	{
+		UE_LOG(LogActorPool, Error, TEXT("Failed to load asset: %s"), *AssetPath);
+		return nullptr;
+	}
+
+	AActor* NewActor = World->SpawnActor<AActor>(AActor::StaticClass(), Location, Rotation, SpawnParams);
+	if (NewActor)
+	{
+		UStaticMeshComponent* MeshComp = NewObject<UStaticMeshComponent>(NewActor);
+		MeshComp->SetMobility(EComponentMobility::Movable);
+		MeshComp->SetStaticMesh(Mesh);
+		MeshComp->RegisterComponent();
+		NewActor->SetRootComponent(MeshComp);
+		NewActor->SetActorLocationAndRotation(Location, Rotation);
+	}
+	return NewActor;
+}
+
+void UActorPoolSubsystem::Park(AActor* Actor, FPooledActorInfo& Info)
+{
+	FSegmentationStencil::ReleaseInstanceId(Actor);
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->SetActorLocation(ParkLocation, false, nullptr, ETeleportType::ResetPhysics);
+
+	// Parked actors must not show up in tag queries (annotation, HideAllVehicles) or free-name checks
+	Actor->Tags.Reset();
+	Actor->Tags.Add(PooledTag);
+	const FName ParkedName = MakeUniqueObjectName(Actor->GetOuter(), Actor->GetClass(), FName(TEXT("PooledActor")));
+	Actor->Rename(*ParkedName.ToString(), nullptr, PoolRenameFlags);
+
+	Info.bActive = false;
+
+	if (UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(GetWorld()))
+	{
+		ActorIndex->ReindexActor(Actor);
+	}
+}
+
+void UActorPoolSubsystem::Activate(AActor* Actor, FPooledActorInfo& Info, const FVector& Location, const FRotator& Rotation, FName RequestedName)
+{
+	if (!RequestedName.IsNone() && !StaticFindObjectFast(nullptr, Actor->GetOuter(), RequestedName))
+	{
+		Actor->Rename(*RequestedName.ToString(), nullptr, PoolRenameFlags);
+	}
+
+	Actor->Tags = Info.BaselineTags;
+	Actor->SetActorScale3D(Info.BaselineScale);
+	Actor->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	Actor->SetActorTickEnabled(Info.bBaselineTickEnabled);
+	Actor->SetActorEnableCollision(true);
+	Actor->SetActorHiddenInGame(false);
+
+	Info.bActive = true;
+
+	// Deferred: callers usually add their own tags right after Acquire
+	if (UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(GetWorld()))
+	{
+		ActorIndex->ReindexActor(Actor);
+	}
+}
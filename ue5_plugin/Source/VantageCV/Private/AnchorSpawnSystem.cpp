@@ -1,14 +1,123 @@
 // Copyright VantageCV Research. All Rights Reserved.
 
 #include "AnchorSpawnSystem.h"
-#include "Engine/World.h"
+#include "SegmentationStencil.h"
+#include "ActorIndexSubsystem.h"
+#include "ActorPoolSubsystem.h"
+#include "SpawnAssetCache.h"
+#include "GroundHeightSubsystem.h"
+#include "VantageCVWorker.h"
 #include "Engine/StaticMesh.h"
-#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 #include "EngineUtils.h"  // For TActorIterator
 #include "DrawDebugHelpers.h"
 
-DEFINE_LOG_CATEGORY_STATIC(LogAnchorSpawn, Log, All);
+
+// ============================================================================
+// Layout Sampling (shared by the serial Spawn* path and frame plans)
+// ============================================================================
+// Templated on the random source (FDeterministicRandom or FCounterRandom) so
+// both paths draw in exactly the same order.
+
+namespace
+{
+    template <typename RandomType>
+    TArray<int32> ShuffleSlots(int32 SlotCount, RandomType& Random)
+    {
+        TArray<int32> SlotIndices;
+        for (int32 i = 0; i < SlotCount; i++)
+        {
+            SlotIndices.Add(i);
+        }
+
+        // Fisher-Yates shuffle
+        for (int32 i = SlotCount - 1; i > 0; i--)
+        {
+            int32 j = Random.RandRange(0, i);
+            SlotIndices.Swap(i, j);
+        }
+        return SlotIndices;
+    }
+
+    template <typename RandomType>
+    FTransform MakeParkingTransform(const FAnchorDefinition& Anchor, EParkingMode Mode, const FAnchorSpawnConfig& Config,
+        RandomType& Random, float& OutJitterX, float& OutJitterY, float& OutYawJitter)
+    {
+        FVector Location = Anchor.CachedTransform.GetLocation();
+        FRotator Rotation = Anchor.CachedTransform.Rotator();
+
+        // Apply position jitter
+        OutJitterX = Random.FRandRange(-Config.ParkingPositionJitter, Config.ParkingPositionJitter);
+        OutJitterY = Random.FRandRange(-Config.ParkingPositionJitter, Config.ParkingPositionJitter);
+        Location.X += OutJitterX;
+        Location.Y += OutJitterY;
+
+        // Apply parking mode rotation
+        if (Mode == EParkingMode::ReverseIn)
+        {
+            Rotation.Yaw += 180.0f;
+        }
+
+        // Apply yaw jitter
+        OutYawJitter = Random.FRandRange(-Config.ParkingYawJitter, Config.ParkingYawJitter);
+        Rotation.Yaw += OutYawJitter;
+
+        // Normalize yaw to [-180, 180]
+        Rotation.Yaw = FMath::Fmod(Rotation.Yaw + 180.0f, 360.0f) - 180.0f;
+
+        return FTransform(Rotation, Location, FVector::OneVector);
+    }
+
+    /** Position along the lane: evenly distributed, jittered, ends avoided */
+    template <typename RandomType>
+    float MakeLaneT(int32 Index, int32 VehiclesPerLane, RandomType& Random)
+    {
+        float T = (Index + 1.0f) / (VehiclesPerLane + 1.0f);
+        T += Random.FRandRange(-0.1f, 0.1f);
+        return FMath::Clamp(T, 0.05f, 0.95f);
+    }
+
+    template <typename RandomType>
+    FTransform MakeLaneTransform(const FLaneDefinition& Lane, float T, const FAnchorSpawnConfig& Config,
+        RandomType& Random, float& OutLateralOffset, float& OutYawJitter)
+    {
+        // Interpolate position along lane
+        FVector StartLoc = Lane.StartTransform.GetLocation();
+        FVector EndLoc = Lane.EndTransform.GetLocation();
+        FVector Location = FMath::Lerp(StartLoc, EndLoc, T);
+
+        // Compute yaw from lane direction
+        FRotator Rotation = Lane.Direction.Rotation();
+
+        // Apply lateral offset (perpendicular to lane direction)
+        FVector Right = FVector::CrossProduct(Lane.Direction, FVector::UpVector).GetSafeNormal();
+        OutLateralOffset = Random.FRandRange(-Config.LaneLateralJitter, Config.LaneLateralJitter);
+        Location += Right * OutLateralOffset;
+
+        // Apply yaw jitter
+        OutYawJitter = Random.FRandRange(-Config.LaneYawJitter, Config.LaneYawJitter);
+        Rotation.Yaw += OutYawJitter;
+
+        return FTransform(Rotation, Location, FVector::OneVector);
+    }
+
+    template <typename RandomType>
+    FVector MakeSidewalkPosition(const FBox& Bounds, RandomType& Random)
+    {
+        float X = Random.FRandRange(Bounds.Min.X, Bounds.Max.X);
+        float Y = Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y);
+        float Z = (Bounds.Min.Z + Bounds.Max.Z) * 0.5f; // Mid-point, will be adjusted by raycast
+
+        return FVector(X, Y, Z);
+    }
+
+    // Base seed offset by the frame this worker is on, so resumed and parallel runs never replay a stream
+    int32 GetWorkerSeed(int32 Seed)
+    {
+        return FVantageCVWorker::GetFrameSeed(Seed, FVantageCVWorker::Get().GetSeedFrame());
+    }
+}
 
 // ============================================================================
 // FDeterministicRandom Implementation
@@ -62,15 +171,18 @@ bool UAnchorSpawnSystem::Initialize(UWorld* InWorld, const FAnchorSpawnConfig& I
 
     World = InWorld;
     Config = InConfig;
-    Random.Initialize(Seed);
+    const int32 StreamSeed = GetWorkerSeed(Seed);
+    Random.Initialize(StreamSeed);
     InstanceCounter = 0;
+    FootprintGrid.SetCellSize(Config.FootprintGridCellSize);
 
     LogInfo(TEXT("AnchorSpawnSystem"), TEXT("Initializing"),
         {
-            {TEXT("seed"), FString::FromInt(Seed)},
-            {TEXT("parking_anchors"), FString::FromInt(Config.ParkingAnchors.Num())},
-            {TEXT("lanes"), FString::FromInt(Config.Lanes.Num())},
-            {TEXT("locked_actors"), FString::FromInt(Config.LockedActors.Num())}
+            {TEXT("seed"), Seed},
+            {TEXT("stream_seed"), StreamSeed},
+            {TEXT("parking_anchors"), Config.ParkingAnchors.Num()},
+            {TEXT("lanes"), Config.Lanes.Num()},
+            {TEXT("locked_actors"), Config.LockedActors.Num()}
         });
 
     // Resolve all anchors
@@ -78,8 +190,8 @@ bool UAnchorSpawnSystem::Initialize(UWorld* InWorld, const FAnchorSpawnConfig& I
 
     LogInfo(TEXT("AnchorSpawnSystem"), TEXT("Initialization complete"),
         {
-            {TEXT("resolved_anchors"), FString::FromInt(ResolvedCount)},
-            {TEXT("seed"), FString::FromInt(Seed)}
+            {TEXT("resolved_anchors"), ResolvedCount},
+            {TEXT("seed"), Seed}
         });
 
     return ResolvedCount > 0;
@@ -87,13 +199,15 @@ bool UAnchorSpawnSystem::Initialize(UWorld* InWorld, const FAnchorSpawnConfig& I
 
 void UAnchorSpawnSystem::ReinitializeWithSeed(int32 NewSeed)
 {
-    Random.Initialize(NewSeed);
+    const int32 StreamSeed = GetWorkerSeed(NewSeed);
+    Random.Initialize(StreamSeed);
     InstanceCounter = 0;
     ClearAllSpawned();
 
     LogInfo(TEXT("AnchorSpawnSystem"), TEXT("Reinitialized with new seed"),
         {
-            {TEXT("new_seed"), FString::FromInt(NewSeed)}
+            {TEXT("new_seed"), NewSeed},
+            {TEXT("stream_seed"), StreamSeed}
         });
 }
 
@@ -120,15 +234,10 @@ int32 UAnchorSpawnSystem::ResolveAnchors()
             ResolvedAnchors.Add(AnchorName, Anchor);
             ResolvedCount++;
 
-            LogInfo(TEXT("AnchorResolver"), TEXT("Parking anchor resolved"),
-                {
-                    {TEXT("name"), AnchorName},
-                    {TEXT("location"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"),
-                        Anchor.CachedTransform.GetLocation().X,
-                        Anchor.CachedTransform.GetLocation().Y,
-                        Anchor.CachedTransform.GetLocation().Z)},
-                    {TEXT("yaw"), FString::Printf(TEXT("%.1f"), Anchor.CachedTransform.Rotator().Yaw)}
-                });
+            VANTAGECV_EVENT(Verbose, TEXT("AnchorResolver"), TEXT("Parking anchor resolved"),
+                {TEXT("name"), AnchorName},
+                {TEXT("location"), Anchor.CachedTransform.GetLocation()},
+                {TEXT("yaw"), Anchor.CachedTransform.Rotator().Yaw});
         }
         else
         {
@@ -173,15 +282,12 @@ int32 UAnchorSpawnSystem::ResolveAnchors()
             EndAnchor.bIsValid = true;
             ResolvedAnchors.Add(Lane.EndAnchorName, EndAnchor);
 
-            LogInfo(TEXT("AnchorResolver"), TEXT("Lane resolved"),
-                {
-                    {TEXT("lane_id"), Lane.LaneId},
-                    {TEXT("start"), Lane.StartAnchorName},
-                    {TEXT("end"), Lane.EndAnchorName},
-                    {TEXT("length"), FString::Printf(TEXT("%.1f"), Lane.Length)},
-                    {TEXT("direction"), FString::Printf(TEXT("(%.2f, %.2f, %.2f)"),
-                        Lane.Direction.X, Lane.Direction.Y, Lane.Direction.Z)}
-                });
+            VANTAGECV_EVENT(Verbose, TEXT("AnchorResolver"), TEXT("Lane resolved"),
+                {TEXT("lane_id"), Lane.LaneId},
+                {TEXT("start"), Lane.StartAnchorName},
+                {TEXT("end"), Lane.EndAnchorName},
+                {TEXT("length"), Lane.Length},
+                {TEXT("direction"), Lane.Direction});
         }
         else
         {
@@ -212,10 +318,16 @@ int32 UAnchorSpawnSystem::ResolveAnchors()
         Config.SidewalkBounds.bIsValid = true;
         ResolvedCount += 2;
 
+        // Static ground: sampled once per level, reused by every scene's prop scatter
+        if (UGroundHeightSubsystem* GroundHeights = UGroundHeightSubsystem::Get(World))
+        {
+            GroundHeights->BuildHeightfield(Config.SidewalkBounds.Bounds, Config.GroundHeightfieldCellSize);
+        }
+
         LogInfo(TEXT("AnchorResolver"), TEXT("Sidewalk bounds resolved"),
             {
-                {TEXT("min"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"), Min.X, Min.Y, Min.Z)},
-                {TEXT("max"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"), Max.X, Max.Y, Max.Z)}
+                {TEXT("min"), Min},
+                {TEXT("max"), Max}
             });
     }
     else if (!Config.SidewalkBounds.Anchor1Name.IsEmpty() || !Config.SidewalkBounds.Anchor2Name.IsEmpty())
@@ -237,28 +349,9 @@ AActor* UAnchorSpawnSystem::FindActorByName(const FString& ActorName) const
         return nullptr;
     }
 
-    // Iterate through all actors and find by name
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        AActor* Actor = *It;
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            return Actor;
-        }
-    }
-
-    // Also try GetFName comparison
-    FName TargetName(*ActorName);
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        AActor* Actor = *It;
-        if (Actor && Actor->GetFName() == TargetName)
-        {
-            return Actor;
-        }
-    }
-
-    return nullptr;
+    // O(1) index lookup by name or label instead of a world sweep per anchor
+    UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(World);
+    return ActorIndex ? ActorIndex->FindActorByName(ActorName) : nullptr;
 }
 
 // ============================================================================
@@ -282,24 +375,13 @@ TArray<FSpawnResult> UAnchorSpawnSystem::SpawnParkingVehicles(
 
     LogInfo(TEXT("ParkingSpawner"), TEXT("Spawning parking vehicles"),
         {
-            {TEXT("slots_available"), FString::FromInt(SlotCount)},
-            {TEXT("vehicles_to_spawn"), FString::FromInt(VehiclesToSpawn)},
-            {TEXT("seed"), FString::FromInt(Random.GetSeed())}
+            {TEXT("slots_available"), SlotCount},
+            {TEXT("vehicles_to_spawn"), VehiclesToSpawn},
+            {TEXT("seed"), Random.GetSeed()}
         });
 
     // Shuffle slot order for variety
-    TArray<int32> SlotIndices;
-    for (int32 i = 0; i < SlotCount; i++)
-    {
-        SlotIndices.Add(i);
-    }
-
-    // Fisher-Yates shuffle
-    for (int32 i = SlotCount - 1; i > 0; i--)
-    {
-        int32 j = Random.RandRange(0, i);
-        SlotIndices.Swap(i, j);
-    }
+    TArray<int32> SlotIndices = ShuffleSlots(SlotCount, Random);
 
     // Spawn vehicles
     int32 SpawnedCount = 0;
@@ -327,9 +409,9 @@ TArray<FSpawnResult> UAnchorSpawnSystem::SpawnParkingVehicles(
 
     LogInfo(TEXT("ParkingSpawner"), TEXT("Parking spawn complete"),
         {
-            {TEXT("requested"), FString::FromInt(VehiclesToSpawn)},
-            {TEXT("spawned"), FString::FromInt(SpawnedCount)},
-            {TEXT("failed"), FString::FromInt(VehiclesToSpawn - SpawnedCount)}
+            {TEXT("requested"), VehiclesToSpawn},
+            {TEXT("spawned"), SpawnedCount},
+            {TEXT("failed"), VehiclesToSpawn - SpawnedCount}
         });
 
     return Results;
@@ -355,28 +437,43 @@ FSpawnResult UAnchorSpawnSystem::SpawnAtParkingSlot(
     // Compute transform
     FTransform SpawnTransform = ComputeParkingTransform(*Anchor, Mode);
 
-    // Check for overlap with existing vehicles
-    FVector VehicleExtent(250.0f, 100.0f, 75.0f); // Approximate car half-extents
-    if (CheckOverlap(SpawnTransform, VehicleExtent))
+    return SpawnVehicleAt(TEXT("ParkingSpawner"), AnchorName, TEXT("parking"), SpawnTransform, Config);
+}
+
+FSpawnResult UAnchorSpawnSystem::SpawnVehicleAt(
+    const TCHAR* Module,
+    const FString& AnchorName,
+    const FString& InstancePrefix,
+    const FTransform& SpawnTransform,
+    const FVehicleSpawnConfig& VehicleConfig)
+{
+    FSpawnResult Result;
+    Result.AnchorName = AnchorName;
+
+    // Check for overlap with existing vehicles (oriented footprint at final scale)
+    const FTransform FootprintTransform(SpawnTransform.GetRotation(), SpawnTransform.GetLocation(), FVector(VehicleConfig.Scale));
+    if (CheckOverlap(FootprintTransform, GetAssetLocalBounds(VehicleConfig)))
     {
         Result.FailureReason = TEXT("Overlap with existing vehicle");
-        LogError(TEXT("ParkingSpawner"), TEXT("Spawn failed"), Result.FailureReason);
+        LogError(Module, TEXT("Spawn failed"), Result.FailureReason);
         return Result;
     }
 
     // Generate instance ID
-    Result.InstanceId = GenerateInstanceId(TEXT("parking"));
+    Result.InstanceId = GenerateInstanceId(InstancePrefix);
 
     // Spawn actor
-    Result.SpawnedActor = SpawnActorFromAsset(Config.AssetPath, SpawnTransform, Result.InstanceId);
+    Result.SpawnedActor = SpawnActorFromAsset(VehicleConfig.AssetPath, SpawnTransform, Result.InstanceId);
 
     if (Result.SpawnedActor)
     {
-        Result.SpawnedActor->SetActorScale3D(FVector(Config.Scale));
+        Result.SpawnedActor->SetActorScale3D(FVector(VehicleConfig.Scale));
         Result.FinalTransform = SpawnTransform;
         Result.bSuccess = true;
 
         SpawnedActors.Add(Result.SpawnedActor);
+        RegisterFootprint(Result.SpawnedActor);
+        FSegmentationStencil::AssignInstanceId(Result.SpawnedActor);
         LogSpawnResult(Result);
     }
     else
@@ -389,38 +486,18 @@ FSpawnResult UAnchorSpawnSystem::SpawnAtParkingSlot(
 
 FTransform UAnchorSpawnSystem::ComputeParkingTransform(const FAnchorDefinition& Anchor, EParkingMode Mode)
 {
-    FVector Location = Anchor.CachedTransform.GetLocation();
-    FRotator Rotation = Anchor.CachedTransform.Rotator();
-
-    // Apply position jitter
-    float JitterX = Random.FRandRange(-Config.ParkingPositionJitter, Config.ParkingPositionJitter);
-    float JitterY = Random.FRandRange(-Config.ParkingPositionJitter, Config.ParkingPositionJitter);
-    Location.X += JitterX;
-    Location.Y += JitterY;
-
-    // Apply parking mode rotation
-    if (Mode == EParkingMode::ReverseIn)
-    {
-        Rotation.Yaw += 180.0f;
-    }
-
-    // Apply yaw jitter
-    float YawJitter = Random.FRandRange(-Config.ParkingYawJitter, Config.ParkingYawJitter);
-    Rotation.Yaw += YawJitter;
-
-    // Normalize yaw to [-180, 180]
-    Rotation.Yaw = FMath::Fmod(Rotation.Yaw + 180.0f, 360.0f) - 180.0f;
-
-    LogInfo(TEXT("ParkingSpawner"), TEXT("Transform computed"),
-        {
-            {TEXT("anchor"), Anchor.ActorName},
-            {TEXT("mode"), Mode == EParkingMode::ReverseIn ? TEXT("reverse") : TEXT("pull_in")},
-            {TEXT("jitter_xy"), FString::Printf(TEXT("(%.1f, %.1f)"), JitterX, JitterY)},
-            {TEXT("yaw_jitter"), FString::Printf(TEXT("%.1f"), YawJitter)},
-            {TEXT("final_yaw"), FString::Printf(TEXT("%.1f"), Rotation.Yaw)}
-        });
-
-    return FTransform(Rotation, Location, FVector::OneVector);
+    float JitterX, JitterY, YawJitter;
+    const FTransform Transform = MakeParkingTransform(Anchor, Mode, Config, Random, JitterX, JitterY, YawJitter);
+
+    VANTAGECV_EVENT(Verbose, TEXT("ParkingSpawner"), TEXT("Transform computed"),
+        {TEXT("anchor"), Anchor.ActorName},
+        {TEXT("mode"), Mode == EParkingMode::ReverseIn ? TEXT("reverse") : TEXT("pull_in")},
+        {TEXT("jitter_x"), JitterX},
+        {TEXT("jitter_y"), JitterY},
+        {TEXT("yaw_jitter"), YawJitter},
+        {TEXT("final_yaw"), Transform.Rotator().Yaw});
+
+    return Transform;
 }
 
 // ============================================================================
@@ -447,9 +524,9 @@ TArray<FSpawnResult> UAnchorSpawnSystem::SpawnLaneVehicles(
 
     LogInfo(TEXT("LaneSpawner"), TEXT("Spawning lane vehicles"),
         {
-            {TEXT("valid_lanes"), FString::FromInt(ValidLanes)},
-            {TEXT("vehicles_per_lane"), FString::FromInt(VehiclesPerLane)},
-            {TEXT("seed"), FString::FromInt(Random.GetSeed())}
+            {TEXT("valid_lanes"), ValidLanes},
+            {TEXT("vehicles_per_lane"), VehiclesPerLane},
+            {TEXT("seed"), Random.GetSeed()}
         });
 
     int32 VehicleIndex = 0;
@@ -464,12 +541,8 @@ TArray<FSpawnResult> UAnchorSpawnSystem::SpawnLaneVehicles(
         // Distribute vehicles along lane
         for (int32 i = 0; i < VehiclesPerLane; i++)
         {
-            // Compute T position along lane (avoid ends)
-            float T = (i + 1.0f) / (VehiclesPerLane + 1.0f);
-
-            // Add some randomization to T
-            T += Random.FRandRange(-0.1f, 0.1f);
-            T = FMath::Clamp(T, 0.05f, 0.95f);
+            // Compute T position along lane (avoid ends, with some randomization)
+            float T = MakeLaneT(i, VehiclesPerLane, Random);
 
             const FVehicleSpawnConfig& VehicleConfig = VehicleConfigs[VehicleIndex % VehicleConfigs.Num()];
 
@@ -488,9 +561,9 @@ TArray<FSpawnResult> UAnchorSpawnSystem::SpawnLaneVehicles(
 
     LogInfo(TEXT("LaneSpawner"), TEXT("Lane spawn complete"),
         {
-            {TEXT("total_attempted"), FString::FromInt(Results.Num())},
-            {TEXT("spawned"), FString::FromInt(SuccessCount)},
-            {TEXT("failed"), FString::FromInt(Results.Num() - SuccessCount)}
+            {TEXT("total_attempted"), Results.Num()},
+            {TEXT("spawned"), SuccessCount},
+            {TEXT("failed"), Results.Num() - SuccessCount}
         });
 
     return Results;
@@ -525,67 +598,22 @@ FSpawnResult UAnchorSpawnSystem::SpawnAlongLane(
     // Compute transform
     FTransform SpawnTransform = ComputeLaneTransform(*Lane, T);
 
-    // Check overlap
-    FVector VehicleExtent(250.0f, 100.0f, 75.0f);
-    if (CheckOverlap(SpawnTransform, VehicleExtent))
-    {
-        Result.FailureReason = TEXT("Overlap with existing vehicle");
-        LogError(TEXT("LaneSpawner"), TEXT("Spawn failed"), Result.FailureReason);
-        return Result;
-    }
-
-    // Generate instance ID
-    Result.InstanceId = GenerateInstanceId(TEXT("lane"));
-
-    // Spawn actor
-    Result.SpawnedActor = SpawnActorFromAsset(VehicleConfig.AssetPath, SpawnTransform, Result.InstanceId);
-
-    if (Result.SpawnedActor)
-    {
-        Result.SpawnedActor->SetActorScale3D(FVector(VehicleConfig.Scale));
-        Result.FinalTransform = SpawnTransform;
-        Result.bSuccess = true;
-
-        SpawnedActors.Add(Result.SpawnedActor);
-        LogSpawnResult(Result);
-    }
-    else
-    {
-        Result.FailureReason = TEXT("Actor spawn failed");
-    }
-
-    return Result;
+    return SpawnVehicleAt(TEXT("LaneSpawner"), LaneId, TEXT("lane"), SpawnTransform, VehicleConfig);
 }
 
 FTransform UAnchorSpawnSystem::ComputeLaneTransform(const FLaneDefinition& Lane, float T)
 {
-    // Interpolate position along lane
-    FVector StartLoc = Lane.StartTransform.GetLocation();
-    FVector EndLoc = Lane.EndTransform.GetLocation();
-    FVector Location = FMath::Lerp(StartLoc, EndLoc, T);
-
-    // Compute yaw from lane direction
-    FRotator Rotation = Lane.Direction.Rotation();
+    float LateralOffset, YawJitter;
+    const FTransform Transform = MakeLaneTransform(Lane, T, Config, Random, LateralOffset, YawJitter);
 
-    // Apply lateral offset (perpendicular to lane direction)
-    FVector Right = FVector::CrossProduct(Lane.Direction, FVector::UpVector).GetSafeNormal();
-    float LateralOffset = Random.FRandRange(-Config.LaneLateralJitter, Config.LaneLateralJitter);
-    Location += Right * LateralOffset;
+    VANTAGECV_EVENT(Verbose, TEXT("LaneSpawner"), TEXT("Transform computed"),
+        {TEXT("lane"), Lane.LaneId},
+        {TEXT("t"), T},
+        {TEXT("lateral_offset"), LateralOffset},
+        {TEXT("yaw_jitter"), YawJitter},
+        {TEXT("final_yaw"), Transform.Rotator().Yaw});
 
-    // Apply yaw jitter
-    float YawJitter = Random.FRandRange(-Config.LaneYawJitter, Config.LaneYawJitter);
-    Rotation.Yaw += YawJitter;
-
-    LogInfo(TEXT("LaneSpawner"), TEXT("Transform computed"),
-        {
-            {TEXT("lane"), Lane.LaneId},
-            {TEXT("t"), FString::Printf(TEXT("%.2f"), T)},
-            {TEXT("lateral_offset"), FString::Printf(TEXT("%.1f"), LateralOffset)},
-            {TEXT("yaw_jitter"), FString::Printf(TEXT("%.1f"), YawJitter)},
-            {TEXT("final_yaw"), FString::Printf(TEXT("%.1f"), Rotation.Yaw)}
-        });
-
-    return FTransform(Rotation, Location, FVector::OneVector);
+    return Transform;
 }
 
 // ============================================================================
@@ -612,37 +640,67 @@ TArray<FSpawnResult> UAnchorSpawnSystem::SpawnSidewalkProps(
 
     LogInfo(TEXT("SidewalkSpawner"), TEXT("Spawning sidewalk props"),
         {
-            {TEXT("count"), FString::FromInt(Count)},
-            {TEXT("asset_types"), FString::FromInt(PropAssetPaths.Num())}
+            {TEXT("count"), Count},
+            {TEXT("asset_types"), PropAssetPaths.Num()}
         });
 
+    // Draw every prop's randoms first (same order as before), then ground-align them in one batch
+    TArray<FVector> Locations;
+    TArray<FRotator> Rotations;
+    TArray<FString> AssetPaths;
+    Locations.Reserve(Count);
+    Rotations.Reserve(Count);
+    AssetPaths.Reserve(Count);
     for (int32 i = 0; i < Count; i++)
     {
-        FSpawnResult Result;
-        Result.AnchorName = TEXT("SidewalkBounds");
+        Locations.Add(ComputeSidewalkPosition());
+        Rotations.Add(FRotator(0, Random.FRandRange(0, 360), 0));
+        AssetPaths.Add(PropAssetPaths[Random.RandRange(0, PropAssetPaths.Num() - 1)]);
+    }
 
-        // Random position within bounds
-        FVector Location = ComputeSidewalkPosition();
+    return SpawnPropsAt(MoveTemp(Locations), Rotations, AssetPaths);
+}
 
-        // Ground alignment
-        Location.Z = GetGroundZ(Location);
+TArray<FSpawnResult> UAnchorSpawnSystem::SpawnPropsAt(
+    TArray<FVector> Locations,
+    const TArray<FRotator>& Rotations,
+    const TArray<FString>& AssetPaths)
+{
+    TArray<FSpawnResult> Results;
 
-        // Random yaw rotation
-        FRotator Rotation(0, Random.FRandRange(0, 360), 0);
+    TArray<float> GroundHeights;
+    if (UGroundHeightSubsystem* GroundHeightSubsystem = UGroundHeightSubsystem::Get(World))
+    {
+        GroundHeightSubsystem->GetGroundHeights(Locations, GroundHeights);
+    }
+    else
+    {
+        for (const FVector& Location : Locations)
+        {
+            GroundHeights.Add(GetGroundZ(Location));
+        }
+    }
+
+    for (int32 i = 0; i < Locations.Num(); i++)
+    {
+        FSpawnResult Result;
+        Result.AnchorName = TEXT("SidewalkBounds");
 
-        FTransform SpawnTransform(Rotation, Location, FVector::OneVector);
+        FVector Location = Locations[i];
+        Location.Z = GroundHeights[i];
 
-        // Random asset selection
-        const FString& AssetPath = PropAssetPaths[Random.RandRange(0, PropAssetPaths.Num() - 1)];
+        FTransform SpawnTransform(Rotations[i], Location, FVector::OneVector);
 
         Result.InstanceId = GenerateInstanceId(TEXT("prop"));
-        Result.SpawnedActor = SpawnActorFromAsset(AssetPath, SpawnTransform, Result.InstanceId);
+        Result.SpawnedActor = SpawnActorFromAsset(AssetPaths[i], SpawnTransform, Result.InstanceId);
 
         if (Result.SpawnedActor)
         {
             Result.FinalTransform = SpawnTransform;
             Result.bSuccess = true;
             SpawnedActors.Add(Result.SpawnedActor);
+            RegisterFootprint(Result.SpawnedActor);
+            FSegmentationStencil::AssignInstanceId(Result.SpawnedActor);
         }
 
         Results.Add(Result);
@@ -653,13 +711,7 @@ TArray<FSpawnResult> UAnchorSpawnSystem::SpawnSidewalkProps(
 
 FVector UAnchorSpawnSystem::ComputeSidewalkPosition()
 {
-    const FBox& Bounds = Config.SidewalkBounds.Bounds;
-
-    float X = Random.FRandRange(Bounds.Min.X, Bounds.Max.X);
-    float Y = Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y);
-    float Z = (Bounds.Min.Z + Bounds.Max.Z) * 0.5f; // Mid-point, will be adjusted by raycast
-
-    return FVector(X, Y, Z);
+    return MakeSidewalkPosition(Config.SidewalkBounds.Bounds, Random);
 }
 
 float UAnchorSpawnSystem::GetGroundZ(const FVector& Location) const
@@ -669,6 +721,11 @@ float UAnchorSpawnSystem::GetGroundZ(const FVector& Location) const
         return Location.Z;
     }
 
+    if (UGroundHeightSubsystem* GroundHeights = UGroundHeightSubsystem::Get(World))
+    {
+        return GroundHeights->GetGroundHeight(Location);
+    }
+
     FHitResult HitResult;
     FVector Start = Location + FVector(0, 0, 500); // Start above
     FVector End = Location - FVector(0, 0, 1000);  // End below
@@ -685,112 +742,262 @@ float UAnchorSpawnSystem::GetGroundZ(const FVector& Location) const
 }
 
 // ============================================================================
-// Cleanup
+// Precomputed Frame Plans
 // ============================================================================
 
-void UAnchorSpawnSystem::ClearAllSpawned()
+FAnchorSpawnPlan UAnchorSpawnSystem::PlanFrame(int32 Seed, int64 FrameIndex, const FAnchorSpawnPlanParams& Params) const
 {
-    int32 Count = SpawnedActors.Num();
+    return PlanFrameFrom(Config, ResolvedAnchors, Seed, FrameIndex, Params);
+}
 
-    for (AActor* Actor : SpawnedActors)
+FAnchorSpawnPlan UAnchorSpawnSystem::PlanFrameFrom(
+    const FAnchorSpawnConfig& PlanConfig,
+    const TMap<FString, FAnchorDefinition>& Anchors,
+    int32 Seed,
+    int64 FrameIndex,
+    const FAnchorSpawnPlanParams& Params)
+{
+    FAnchorSpawnPlan Plan;
+    Plan.FrameIndex = FrameIndex;
+
+    if (Params.NumVehicleConfigs > 0)
     {
-        if (Actor && IsValid(Actor))
+        // Parking: same sequence as SpawnParkingVehicles, on the frame's own stream
+        FCounterRandom ParkingRandom(Seed, FrameIndex, EScenePlanStream::Parking);
+        const int32 SlotCount = PlanConfig.ParkingAnchors.Num();
+        const int32 VehiclesToSpawn = (Params.MaxParkingVehicles < 0) ? SlotCount : FMath::Min(Params.MaxParkingVehicles, SlotCount);
+        const TArray<int32> SlotIndices = ShuffleSlots(SlotCount, ParkingRandom);
+
+        for (int32 i = 0; i < VehiclesToSpawn; i++)
         {
-            Actor->Destroy();
+            const FString& AnchorName = PlanConfig.ParkingAnchors[SlotIndices[i]];
+            EParkingMode Mode = ParkingRandom.RandBool(PlanConfig.ReverseParkingProbability)
+                ? EParkingMode::ReverseIn
+                : EParkingMode::PullIn;
+
+            const FAnchorDefinition* Anchor = Anchors.Find(AnchorName);
+            if (!Anchor || !Anchor->bIsValid)
+            {
+                continue;
+            }
+
+            float JitterX, JitterY, YawJitter;
+            FPlannedAnchorSpawn& Spawn = Plan.Parking.AddDefaulted_GetRef();
+            Spawn.AnchorName = AnchorName;
+            Spawn.AssetIndex = i % Params.NumVehicleConfigs;
+            Spawn.Transform = MakeParkingTransform(*Anchor, Mode, PlanConfig, ParkingRandom, JitterX, JitterY, YawJitter);
+        }
+
+        // Lanes
+        FCounterRandom LaneRandom(Seed, FrameIndex, EScenePlanStream::Lanes);
+        int32 VehicleIndex = 0;
+        for (const FLaneDefinition& Lane : PlanConfig.Lanes)
+        {
+            if (!Lane.bIsValid)
+            {
+                continue;
+            }
+
+            for (int32 i = 0; i < Params.VehiclesPerLane; i++)
+            {
+                const float T = MakeLaneT(i, Params.VehiclesPerLane, LaneRandom);
+
+                float LateralOffset, YawJitter;
+                FPlannedAnchorSpawn& Spawn = Plan.Lanes.AddDefaulted_GetRef();
+                Spawn.AnchorName = Lane.LaneId;
+                Spawn.AssetIndex = VehicleIndex++ % Params.NumVehicleConfigs;
+                Spawn.Transform = MakeLaneTransform(Lane, T, PlanConfig, LaneRandom, LateralOffset, YawJitter);
+            }
         }
     }
 
-    SpawnedActors.Empty();
-    InstanceCounter = 0;
+    // Props (ground alignment happens on apply)
+    if (Params.NumPropAssets > 0 && PlanConfig.SidewalkBounds.bIsValid)
+    {
+        FCounterRandom PropRandom(Seed, FrameIndex, EScenePlanStream::Props);
+        for (int32 i = 0; i < Params.PropCount; i++)
+        {
+            const FVector Location = MakeSidewalkPosition(PlanConfig.SidewalkBounds.Bounds, PropRandom);
+            const FRotator Rotation(0, PropRandom.FRandRange(0, 360), 0);
+
+            FPlannedAnchorSpawn& Spawn = Plan.Props.AddDefaulted_GetRef();
+            Spawn.AnchorName = TEXT("SidewalkBounds");
+            Spawn.AssetIndex = PropRandom.RandRange(0, Params.NumPropAssets - 1);
+            Spawn.Transform = FTransform(Rotation, Location, FVector::OneVector);
+        }
+    }
+
+    return Plan;
+}
+
+void UAnchorSpawnSystem::PlanFrames(int32 Seed, int64 FirstFrame, int32 NumFrames, const FAnchorSpawnPlanParams& Params)
+{
+    if (Seed != PlanSeed || !(Params == PlanParams))
+    {
+        // Plans for another seed or layout must never be applied
+        PlanQueue.Reset();
+        PlanSeed = Seed;
+        PlanParams = Params;
+    }
+
+    // Snapshot config and anchors: the task must not read this object
+    PlanQueue.Launch(FirstFrame, NumFrames, [PlanConfig = Config, Anchors = ResolvedAnchors, Seed, Params](int64 FrameIndex)
+    {
+        return PlanFrameFrom(PlanConfig, Anchors, Seed, FrameIndex, Params);
+    });
 
-    LogInfo(TEXT("AnchorSpawnSystem"), TEXT("Cleared all spawned actors"),
+    LogInfo(TEXT("ScenePlanner"), TEXT("Planning frames on worker threads"),
         {
-            {TEXT("count"), FString::FromInt(Count)}
+            {TEXT("seed"), Seed},
+            {TEXT("first_frame"), FirstFrame},
+            {TEXT("num_frames"), NumFrames}
         });
 }
 
-// ============================================================================
-// Collision Detection
-// ============================================================================
+FAnchorSpawnPlan UAnchorSpawnSystem::TakePlannedFrame(int64 FrameIndex)
+{
+    FAnchorSpawnPlan Plan;
+    if (!PlanQueue.Take(FrameIndex, Plan))
+    {
+        Plan = PlanFrame(PlanSeed, FrameIndex, PlanParams);
+    }
+    return Plan;
+}
 
-bool UAnchorSpawnSystem::CheckOverlap(const FTransform& Transform, const FVector& VehicleExtent) const
+TArray<FSpawnResult> UAnchorSpawnSystem::ApplyPlan(
+    const FAnchorSpawnPlan& Plan,
+    const TArray<FVehicleSpawnConfig>& VehicleConfigs,
+    const TArray<FString>& PropAssetPaths)
 {
-    FVector NewLocation = Transform.GetLocation();
+    TArray<FSpawnResult> Results;
 
-    for (AActor* ExistingActor : SpawnedActors)
+    for (const FPlannedAnchorSpawn& Spawn : Plan.Parking)
     {
-        if (!ExistingActor || !IsValid(ExistingActor))
+        if (VehicleConfigs.IsValidIndex(Spawn.AssetIndex))
         {
-            continue;
+            Results.Add(SpawnVehicleAt(TEXT("ParkingSpawner"), Spawn.AnchorName, TEXT("parking"), Spawn.Transform, VehicleConfigs[Spawn.AssetIndex]));
         }
+    }
 
-        FVector ExistingLocation = ExistingActor->GetActorLocation();
-        float Distance = FVector::Dist2D(NewLocation, ExistingLocation);
-
-        // Simple distance check (sum of extents)
-        float MinDistance = VehicleExtent.X * 2.0f; // Approximate vehicle length
+    for (const FPlannedAnchorSpawn& Spawn : Plan.Lanes)
+    {
+        if (VehicleConfigs.IsValidIndex(Spawn.AssetIndex))
+        {
+            Results.Add(SpawnVehicleAt(TEXT("LaneSpawner"), Spawn.AnchorName, TEXT("lane"), Spawn.Transform, VehicleConfigs[Spawn.AssetIndex]));
+        }
+    }
 
-        if (Distance < MinDistance)
+    TArray<FVector> Locations;
+    TArray<FRotator> Rotations;
+    TArray<FString> AssetPaths;
+    for (const FPlannedAnchorSpawn& Spawn : Plan.Props)
+    {
+        if (PropAssetPaths.IsValidIndex(Spawn.AssetIndex))
         {
-            return true; // Overlap detected
+            Locations.Add(Spawn.Transform.GetLocation());
+            Rotations.Add(Spawn.Transform.Rotator());
+            AssetPaths.Add(PropAssetPaths[Spawn.AssetIndex]);
         }
     }
+    Results.Append(SpawnPropsAt(MoveTemp(Locations), Rotations, AssetPaths));
+
+    int32 SuccessCount = 0;
+    for (const FSpawnResult& R : Results)
+    {
+        if (R.bSuccess) SuccessCount++;
+    }
 
-    return false;
+    VANTAGECV_EVENT(Verbose, TEXT("ScenePlanner"), TEXT("Plan applied"),
+        {TEXT("frame"), Plan.FrameIndex},
+        {TEXT("planned"), Plan.Parking.Num() + Plan.Lanes.Num() + Plan.Props.Num()},
+        {TEXT("spawned"), SuccessCount});
+
+    return Results;
 }
 
 // ============================================================================
-// Actor Spawning
+// Cleanup
 // ============================================================================
 
-AActor* UAnchorSpawnSystem::SpawnActorFromAsset(const FString& AssetPath, const FTransform& Transform, const FString& InstanceId)
+void UAnchorSpawnSystem::ClearAllSpawned()
 {
-    if (!World)
+    int32 Count = SpawnedActors.Num();
+
+    // Parked for the next scene; the pool releases stencil IDs
+    UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(World);
+    for (AActor* Actor : SpawnedActors)
     {
-        return nullptr;
+        if (Actor && IsValid(Actor))
+        {
+            if (ActorPool)
+            {
+                ActorPool->Release(Actor);
+            }
+            else
+            {
+                FSegmentationStencil::ReleaseInstanceId(Actor);
+                Actor->Destroy();
+            }
+        }
     }
 
-    // Try loading as blueprint class
-    UClass* ActorClass = LoadClass<AActor>(nullptr, *AssetPath);
+    SpawnedActors.Empty();
+    FootprintGrid.Reset();
+    InstanceCounter = 0;
 
-    if (ActorClass)
-    {
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.Name = FName(*InstanceId);
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    VANTAGECV_EVENT(Verbose, TEXT("AnchorSpawnSystem"), TEXT("Cleared all spawned actors"),
+        {TEXT("count"), Count});
+}
+
+// ============================================================================
+// Collision Detection
+// ============================================================================
+
+bool UAnchorSpawnSystem::CheckOverlap(const FTransform& Transform, const FBox& LocalBounds) const
+{
+    // Grid broadphase + oriented-box SAT; O(1) on average instead of a sweep over SpawnedActors
+    return FootprintGrid.Overlaps(FSpawnFootprint::FromTransform(Transform, LocalBounds), Config.FootprintClearance);
+}
 
-        return World->SpawnActor<AActor>(
-            ActorClass,
-            Transform.GetLocation(),
-            Transform.Rotator(),
-            SpawnParams
-        );
+FBox UAnchorSpawnSystem::GetAssetLocalBounds(const FVehicleSpawnConfig& VehicleConfig) const
+{
+    const FSpawnAsset Asset = FSpawnAssetCache::Get().Resolve(VehicleConfig.AssetPath);
+    if (Asset.Mesh)
+    {
+        return Asset.Mesh->GetBoundingBox();
     }
+    return FBox(-VehicleConfig.FootprintHalfExtent, VehicleConfig.FootprintHalfExtent);
+}
 
-    // Try loading as static mesh
-    UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, *AssetPath);
+void UAnchorSpawnSystem::RegisterFootprint(AActor* Actor)
+{
+    if (!Actor)
+    {
+        return;
+    }
 
-    if (Mesh)
+    const FBox LocalBounds = Actor->CalculateComponentsBoundingBoxInLocalSpace(true);
+    if (LocalBounds.IsValid)
     {
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.Name = FName(*InstanceId);
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        FootprintGrid.Add(FSpawnFootprint::FromTransform(Actor->GetActorTransform(), LocalBounds));
+    }
+}
 
-        AActor* NewActor = World->SpawnActor<AActor>(
-            AActor::StaticClass(),
-            Transform.GetLocation(),
-            Transform.Rotator(),
-            SpawnParams
-        );
+// ============================================================================
+// Actor Spawning
+// ============================================================================
 
-        if (NewActor)
-        {
-            UStaticMeshComponent* MeshComp = NewObject<UStaticMeshComponent>(NewActor);
-            MeshComp->SetStaticMesh(Mesh);
-            MeshComp->RegisterComponent();
-            NewActor->SetRootComponent(MeshComp);
-        }
+AActor* UAnchorSpawnSystem::SpawnActorFromAsset(const FString& AssetPath, const FTransform& Transform, const FString& InstanceId)
+{
+    if (!World)
+    {
+        return nullptr;
+    }
 
+    // Reuses a parked actor for this asset when one is idle; plain spawn in worlds without a pool
+    AActor* NewActor = UActorPoolSubsystem::AcquireOrSpawn(World, AssetPath, Transform.GetLocation(), Transform.Rotator(), FName(*InstanceId));
+    if (NewActor)
+    {
         return NewActor;
     }
 
@@ -810,38 +1017,23 @@ FString UAnchorSpawnSystem::GenerateInstanceId(const FString& Prefix)
 // Logging
 // ============================================================================
 
-void UAnchorSpawnSystem::LogInfo(const FString& Module, const FString& Message, const TMap<FString, FString>& Data)
+void UAnchorSpawnSystem::LogInfo(const TCHAR* Module, const TCHAR* Message, std::initializer_list<FVantageCVEventField> Fields)
 {
-    FString DataStr;
-    for (const auto& Pair : Data)
+    if (FVantageCVEventLog::IsEnabled(EVantageCVEventLevel::Info))
     {
-        if (!DataStr.IsEmpty())
-        {
-            DataStr += TEXT(", ");
-        }
-        DataStr += FString::Printf(TEXT("\"%s\": \"%s\""), *Pair.Key, *Pair.Value);
-    }
-
-    if (DataStr.IsEmpty())
-    {
-        UE_LOG(LogAnchorSpawn, Log, TEXT("[%s] %s"), *Module, *Message);
-    }
-    else
-    {
-        UE_LOG(LogAnchorSpawn, Log, TEXT("[%s] %s | {%s}"), *Module, *Message, *DataStr);
+        FVantageCVEventLog::Get().Write(EVantageCVEventLevel::Info, Module, Message, Fields);
     }
 }
 
-void UAnchorSpawnSystem::LogError(const FString& Module, const FString& Message, const FString& Reason, const FString& SuggestedFix)
+void UAnchorSpawnSystem::LogError(const TCHAR* Module, const TCHAR* Message, const FString& Reason, const FString& SuggestedFix)
 {
-    if (SuggestedFix.IsEmpty())
+    if (!SuggestedFix.IsEmpty())
     {
-        UE_LOG(LogAnchorSpawn, Error, TEXT("[%s] %s | Reason: %s"), *Module, *Message, *Reason);
+        FVantageCVEventLog::Get().Write(EVantageCVEventLevel::Error, Module, Message, {{TEXT("reason"), Reason}, {TEXT("fix"), SuggestedFix}});
     }
     else
     {
-        UE_LOG(LogAnchorSpawn, Error, TEXT("[%s] %s | Reason: %s | Fix: %s"),
-            *Module, *Message, *Reason, *SuggestedFix);
+        FVantageCVEventLog::Get().Write(EVantageCVEventLevel::Error, Module, Message, {{TEXT("reason"), Reason}});
     }
 }
 
@@ -849,18 +1041,13 @@ void UAnchorSpawnSystem::LogSpawnResult(const FSpawnResult& Result)
 {
     if (Result.bSuccess)
     {
-        FVector Loc = Result.FinalTransform.GetLocation();
-        FRotator Rot = Result.FinalTransform.Rotator();
-
-        LogInfo(TEXT("SpawnResult"), TEXT("Vehicle spawned"),
-            {
-                {TEXT("instance_id"), Result.InstanceId},
-                {TEXT("anchor"), Result.AnchorName},
-                {TEXT("location"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"), Loc.X, Loc.Y, Loc.Z)},
-                {TEXT("rotation"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"), Rot.Pitch, Rot.Yaw, Rot.Roll)},
-                {TEXT("seed"), FString::FromInt(Random.GetSeed())},
-                {TEXT("rand_calls"), FString::FromInt(Random.GetCallCount())}
-            });
+        VANTAGECV_EVENT(Verbose, TEXT("SpawnResult"), TEXT("Vehicle spawned"),
+            {TEXT("instance_id"), Result.InstanceId},
+            {TEXT("anchor"), Result.AnchorName},
+            {TEXT("location"), Result.FinalTransform.GetLocation()},
+            {TEXT("rotation"), Result.FinalTransform.Rotator()},
+            {TEXT("seed"), Random.GetSeed()},
+            {TEXT("rand_calls"), Random.GetCallCount()});
     }
     else
     {
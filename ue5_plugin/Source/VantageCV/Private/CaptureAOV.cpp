@@ -0,0 +1,250 @@
+/******************************************************************************
+ * VantageCV - Capture AOV Implementation
+ ******************************************************************************
+ * File: CaptureAOV.cpp
+ * Description: Parallel decode of the packed AOV target and per-AOV EXR/PNG
+ *              encoding for files and shard samples
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureAOV.h"
+#include "CaptureEncoder.h"
+#include "CaptureShardWriter.h"
+#include "CaptureTelemetry.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Async/ParallelFor.h"
+#include "Math/Float16Color.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCaptureAOV, Log, All);
+
+namespace
+{
+	enum class EAOV : uint8
+	{
+		Depth,
+		Normal,
+		Instance,
+		Velocity,
+		Num
+	};
+
+	/** Name suffix and extension per AOV */
+	const TCHAR* const AOVNames[] = { TEXT("depth"), TEXT("normal"), TEXT("instance"), TEXT("velocity") };
+	const TCHAR* const AOVExtensions[] = { TEXT("exr"), TEXT("exr"), TEXT("png"), TEXT("exr") };
+
+	bool IsSelected(const FCaptureAOVSelection& Selection, EAOV AOV)
+	{
+		switch (AOV)
+		{
+		case EAOV::Depth: return Selection.bDepth;
+		case EAOV::Normal: return Selection.bNormals;
+		case EAOV::Instance: return Selection.bInstanceId;
+		case EAOV::Velocity: return Selection.bVelocity;
+		default: return false;
+		}
+	}
+
+	/**
+	 * shard:// base -> sample key; any extension is dropped and "_aov" appended, so the AOV sample
+	 * never shares a key with the RGB sample written from the same base
+	 */
+	FString GetShardKey(const FString& BasePath)
+	{
+		FString Name = BasePath.RightChop(FCString::Strlen(FCaptureShardWriter::PathPrefix));
+		Name.ReplaceInline(TEXT("\\"), TEXT("/"));
+		return FPaths::GetBaseFilename(Name, false) + TEXT("_aov");
+	}
+
+	FString GetOutputPath(const FString& BasePath, EAOV AOV)
+	{
+		const int32 Index = (int32)AOV;
+		if (FCaptureShardWriter::IsShardPath(BasePath))
+		{
+			return FString::Printf(TEXT("%s.%s.%s"), *GetShardKey(BasePath), AOVNames[Index], AOVExtensions[Index]);
+		}
+		return FString::Printf(TEXT("%s_%s.%s"), *FPaths::GetBaseFilename(BasePath, false), AOVNames[Index], AOVExtensions[Index]);
+	}
+
+	bool Compress(IImageWrapperModule& ImageWrapperModule, EImageFormat Format, const void* Data, int64 NumBytes,
+		int32 Width, int32 Height, ERGBFormat RGBFormat, int32 BitDepth, TArray64<uint8>& OutData)
+	{
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(Format);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Data, NumBytes, Width, Height, RGBFormat, BitDepth))
+		{
+			return false;
+		}
+		OutData = ImageWrapper->GetCompressed((int32)EImageCompressionQuality::Default);
+		return OutData.Num() > 0;
+	}
+}
+
+FVector2f FCaptureAOV::UnpackUnorm15x2(float Packed)
+{
+	// Bit 31 and bits 28..15 hold X, bits 14..0 hold Y; bits 30..29 are the fixed exponent guard
+	uint32 Bits = 0;
+	FMemory::Memcpy(&Bits, &Packed, sizeof(Bits));
+	const uint32 X = ((Bits >> 17) & 0x4000u) | ((Bits >> 15) & 0x3FFFu);
+	const uint32 Y = Bits & 0x7FFFu;
+	return FVector2f(X / 32767.0f, Y / 32767.0f);
+}
+
+FVector3f FCaptureAOV::OctahedronDecode(const FVector2f& Oct)
+{
+	FVector3f N(Oct.X, Oct.Y, 1.0f - FMath::Abs(Oct.X) - FMath::Abs(Oct.Y));
+	if (N.Z < 0.0f)
+	{
+		const float X = (1.0f - FMath::Abs(N.Y)) * (N.X >= 0.0f ? 1.0f : -1.0f);
+		const float Y = (1.0f - FMath::Abs(N.X)) * (N.Y >= 0.0f ? 1.0f : -1.0f);
+		N.X = X;
+		N.Y = Y;
+	}
+	return N.GetSafeNormal();
+}
+
+TArray<FString> FCaptureAOV::GetOutputPaths(const FString& BasePath, const FCaptureAOVSelection& Selection)
+{
+	TArray<FString> Paths;
+	for (int32 Index = 0; Index < (int32)EAOV::Num; ++Index)
+	{
+		if (IsSelected(Selection, (EAOV)Index))
+		{
+			Paths.Add(GetOutputPath(BasePath, (EAOV)Index));
+		}
+	}
+	return Paths;
+}
+
+bool FCaptureAOV::WriteAll(const FCapturedImage& Packed, const FString& BasePath, const FCaptureAOVSelection& Selection,
+	IImageWrapperModule& ImageWrapperModule, int32 MaxStrips)
+{
+	if (!Packed.IsValid() || Packed.Layout != ECapturePixelLayout::RGBA32F)
+	{
+		UE_LOG(LogCaptureAOV, Error, TEXT("WriteAll: %s is not a packed RGBA32F AOV image"), *BasePath);
+		return false;
+	}
+
+	const int32 Width = Packed.Width;
+	const int32 Height = Packed.Height;
+	const int64 NumPixels = (int64)Width * Height;
+	const FVector4f* Source = reinterpret_cast<const FVector4f*>(Packed.Data.GetData());
+
+	TArray64<float> Depth;
+	TArray64<FFloat16Color> Normals;
+	TArray64<uint8> Instances;
+	TArray64<FFloat16Color> Velocity;
+	TArray64<uint8> Encoded[(int32)EAOV::Num];
+
+	{
+		VANTAGECV_CAPTURE_STAGE(Encode);
+
+		if (Selection.bDepth) { Depth.SetNumUninitialized(NumPixels); }
+		if (Selection.bNormals) { Normals.SetNumUninitialized(NumPixels); }
+		if (Selection.bInstanceId) { Instances.SetNumUninitialized(NumPixels); }
+		if (Selection.bVelocity) { Velocity.SetNumUninitialized(NumPixels); }
+
+		// NDC (full screen = 2, Y up) to pixels (Y down)
+		const FVector2f VelocityScale(Width * 0.5f, Height * -0.5f);
+
+		const int32 NumStrips = FCaptureEncoder::GetNumStrips(Packed, MaxStrips);
+		const int64 PixelsPerChunk = FMath::DivideAndRoundUp<int64>(NumPixels, NumStrips);
+		ParallelFor(NumStrips, [&](int32 StripIndex)
+		{
+			const int64 Begin = StripIndex * PixelsPerChunk;
+			const int64 End = FMath::Min(NumPixels, Begin + PixelsPerChunk);
+			for (int64 PixelIndex = Begin; PixelIndex < End; ++PixelIndex)
+			{
+				const FVector4f& Pixel = Source[PixelIndex];
+				if (Selection.bInstanceId)
+				{
+					Instances[PixelIndex] = (uint8)FMath::Clamp(FMath::RoundToInt(Pixel.X), 0, 255);
+				}
+				if (Selection.bDepth)
+				{
+					Depth[PixelIndex] = Pixel.Y;
+				}
+				if (Selection.bNormals)
+				{
+					const FVector3f N = OctahedronDecode(UnpackUnorm15x2(Pixel.Z) * 2.0f - 1.0f);
+					Normals[PixelIndex] = FFloat16Color(FLinearColor(N.X, N.Y, N.Z, 1.0f));
+				}
+				if (Selection.bVelocity)
+				{
+					const FVector2f V = (UnpackUnorm15x2(Pixel.W) * 2.0f - 1.0f) * VantageCVAOV::VelocityRange * VelocityScale;
+					Velocity[PixelIndex] = FFloat16Color(FLinearColor(V.X, V.Y, 0.0f, 1.0f));
+				}
+			}
+		}, NumStrips == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		bool bEncoded = true;
+		if (Selection.bDepth)
+		{
+			bEncoded &= Compress(ImageWrapperModule, EImageFormat::EXR, Depth.GetData(), Depth.Num() * sizeof(float),
+				Width, Height, ERGBFormat::GrayF, 32, Encoded[(int32)EAOV::Depth]);
+		}
+		if (Selection.bNormals)
+		{
+			bEncoded &= Compress(ImageWrapperModule, EImageFormat::EXR, Normals.GetData(), Normals.Num() * sizeof(FFloat16Color),
+				Width, Height, ERGBFormat::RGBAF, 16, Encoded[(int32)EAOV::Normal]);
+		}
+		if (Selection.bInstanceId)
+		{
+			bEncoded &= Compress(ImageWrapperModule, EImageFormat::PNG, Instances.GetData(), Instances.Num(),
+				Width, Height, ERGBFormat::Gray, 8, Encoded[(int32)EAOV::Instance]);
+		}
+		if (Selection.bVelocity)
+		{
+			bEncoded &= Compress(ImageWrapperModule, EImageFormat::EXR, Velocity.GetData(), Velocity.Num() * sizeof(FFloat16Color),
+				Width, Height, ERGBFormat::RGBAF, 16, Encoded[(int32)EAOV::Velocity]);
+		}
+		if (!bEncoded)
+		{
+			UE_LOG(LogCaptureAOV, Error, TEXT("AOV encoding failed for: %s (%dx%d)"), *BasePath, Width, Height);
+			return false;
+		}
+	}
+
+	VANTAGECV_CAPTURE_STAGE(Write);
+
+	// All AOVs of a frame form one shard sample (<key>_aov) so they stay together in the tar
+	if (FCaptureShardWriter::IsShardPath(BasePath))
+	{
+		TArray<FCaptureShardMember> Members;
+		for (int32 Index = 0; Index < (int32)EAOV::Num; ++Index)
+		{
+			if (IsSelected(Selection, (EAOV)Index))
+			{
+				Members.Add({ FString::Printf(TEXT("%s.%s"), AOVNames[Index], AOVExtensions[Index]), Encoded[Index].GetData(), Encoded[Index].Num() });
+			}
+		}
+		return FCaptureShardWriter::Get().AppendSample(GetShardKey(BasePath), Members);
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Directory = FPaths::GetPath(BasePath);
+	if (!Directory.IsEmpty() && !PlatformFile.DirectoryExists(*Directory))
+	{
+		PlatformFile.CreateDirectoryTree(*Directory);
+	}
+
+	bool bSuccess = true;
+	for (int32 Index = 0; Index < (int32)EAOV::Num; ++Index)
+	{
+		if (!IsSelected(Selection, (EAOV)Index))
+		{
+			continue;
+		}
+
+		const FString FilePath = GetOutputPath(BasePath, (EAOV)Index);
+		if (!FFileHelper::SaveArrayToFile(Encoded[Index], *FilePath))
+		{
+			UE_LOG(LogCaptureAOV, Error, TEXT("FFileHelper::SaveArrayToFile failed for: %s"), *FilePath);
+			bSuccess = false;
+		}
+	}
+	return bSuccess;
+}
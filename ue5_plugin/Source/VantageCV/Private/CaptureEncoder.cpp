@@ -0,0 +1,330 @@
+/******************************************************************************
+ * VantageCV - Capture Encoder Implementation
+ ******************************************************************************
+ * File: CaptureEncoder.cpp
+ * Description: ImageWrapper-backed PNG/JPEG/EXR encoding and a strip-parallel
+ *              QOI encoder (https://qoiformat.org/qoi-specification.pdf)
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureEncoder.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Math/Float16Color.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCaptureEncoder, Log, All);
+
+namespace
+{
+	constexpr uint8 QOI_OP_INDEX = 0x00;
+	constexpr uint8 QOI_OP_DIFF = 0x40;
+	constexpr uint8 QOI_OP_LUMA = 0x80;
+	constexpr uint8 QOI_OP_RUN = 0xc0;
+	constexpr uint8 QOI_OP_RGB = 0xfe;
+	constexpr uint8 QOI_OP_RGBA = 0xff;
+	constexpr int32 QOI_HEADER_SIZE = 14;
+	constexpr int32 QOI_MAX_RUN = 62;
+	constexpr uint8 QOI_END_MARKER[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+	/** Worst-case bytes per pixel (QOI_OP_RGBA) */
+	constexpr int32 QOI_MAX_PIXEL_BYTES = 5;
+
+	/** Target strip size; below this the per-strip restart overhead is not worth it */
+	constexpr int64 PixelsPerStrip = 256 * 1024;
+
+	struct FQoiPixel
+	{
+		uint8 R = 0;
+		uint8 G = 0;
+		uint8 B = 0;
+		uint8 A = 0;
+
+		bool operator==(const FQoiPixel& Other) const
+		{
+			return R == Other.R && G == Other.G && B == Other.B && A == Other.A;
+		}
+	};
+
+	FORCEINLINE FQoiPixel LoadBGRA(const uint8* Pixel)
+	{
+		return FQoiPixel{ Pixel[2], Pixel[1], Pixel[0], Pixel[3] };
+	}
+
+	FORCEINLINE int32 QoiHash(const FQoiPixel& Pixel)
+	{
+		return (Pixel.R * 3 + Pixel.G * 5 + Pixel.B * 7 + Pixel.A * 11) % 64;
+	}
+
+	void WriteBigEndian32(uint8* Dest, uint32 Value)
+	{
+		Dest[0] = (uint8)(Value >> 24);
+		Dest[1] = (uint8)(Value >> 16);
+		Dest[2] = (uint8)(Value >> 8);
+		Dest[3] = (uint8)Value;
+	}
+
+	/**
+	 * Encode pixels [Begin, End) of a BGRA8 buffer.
+	 *
+	 * The decoder's previous pixel at Begin is the source pixel Begin - 1, which
+	 * is known here. Its color index, however, still holds entries from earlier
+	 * strips, so QOI_OP_INDEX is only emitted for slots this strip wrote itself:
+	 * those hold the same value in the decoder, since both sides overwrite a slot
+	 * with every later pixel of the same hash.
+	 */
+	void EncodeQoiStrip(const uint8* Pixels, int64 Begin, int64 End, TArray64<uint8>& Out)
+	{
+		Out.SetNumUninitialized(FMath::Max<int64>((End - Begin) * 2, 64));
+		int64 Pos = 0;
+
+		FQoiPixel Index[64];
+		uint64 IndexValid = 0;
+		FQoiPixel Prev = Begin == 0 ? FQoiPixel{ 0, 0, 0, 255 } : LoadBGRA(Pixels + (Begin - 1) * 4);
+		int32 Run = 0;
+
+		for (int64 PixelIndex = Begin; PixelIndex < End; ++PixelIndex)
+		{
+			if (Pos + QOI_MAX_PIXEL_BYTES + 1 > Out.Num())
+			{
+				Out.SetNumUninitialized(Out.Num() * 2);
+			}
+			uint8* Dest = Out.GetData();
+
+			const FQoiPixel Pixel = LoadBGRA(Pixels + PixelIndex * 4);
+			if (Pixel == Prev)
+			{
+				if (++Run == QOI_MAX_RUN)
+				{
+					Dest[Pos++] = QOI_OP_RUN | (uint8)(Run - 1);
+					Run = 0;
+				}
+				continue;
+			}
+
+			if (Run > 0)
+			{
+				Dest[Pos++] = QOI_OP_RUN | (uint8)(Run - 1);
+				Run = 0;
+			}
+
+			const int32 Hash = QoiHash(Pixel);
+			if ((IndexValid & (1ull << Hash)) && Index[Hash] == Pixel)
+			{
+				Dest[Pos++] = QOI_OP_INDEX | (uint8)Hash;
+			}
+			else
+			{
+				Index[Hash] = Pixel;
+				IndexValid |= 1ull << Hash;
+
+				if (Pixel.A == Prev.A)
+				{
+					const int32 DeltaR = (int8)(Pixel.R - Prev.R);
+					const int32 DeltaG = (int8)(Pixel.G - Prev.G);
+					const int32 DeltaB = (int8)(Pixel.B - Prev.B);
+					const int32 DeltaGR = DeltaR - DeltaG;
+					const int32 DeltaGB = DeltaB - DeltaG;
+
+					if (DeltaR > -3 && DeltaR < 2 && DeltaG > -3 && DeltaG < 2 && DeltaB > -3 && DeltaB < 2)
+					{
+						Dest[Pos++] = QOI_OP_DIFF | (uint8)((DeltaR + 2) << 4 | (DeltaG + 2) << 2 | (DeltaB + 2));
+					}
+					else if (DeltaGR > -9 && DeltaGR < 8 && DeltaG > -33 && DeltaG < 32 && DeltaGB > -9 && DeltaGB < 8)
+					{
+						Dest[Pos++] = QOI_OP_LUMA | (uint8)(DeltaG + 32);
+						Dest[Pos++] = (uint8)((DeltaGR + 8) << 4 | (DeltaGB + 8));
+					}
+					else
+					{
+						Dest[Pos++] = QOI_OP_RGB;
+						Dest[Pos++] = Pixel.R;
+						Dest[Pos++] = Pixel.G;
+						Dest[Pos++] = Pixel.B;
+					}
+				}
+				else
+				{
+					Dest[Pos++] = QOI_OP_RGBA;
+					Dest[Pos++] = Pixel.R;
+					Dest[Pos++] = Pixel.G;
+					Dest[Pos++] = Pixel.B;
+					Dest[Pos++] = Pixel.A;
+				}
+			}
+			Prev = Pixel;
+		}
+
+		// Runs never cross a strip boundary; the next strip restarts from this pixel
+		if (Run > 0)
+		{
+			Out[Pos++] = QOI_OP_RUN | (uint8)(Run - 1);
+		}
+		Out.SetNum(Pos, EAllowShrinking::No);
+	}
+}
+
+const TCHAR* FCaptureEncoder::GetExtension(ECaptureImageFormat Format)
+{
+	switch (Format)
+	{
+	case ECaptureImageFormat::QOI:	return TEXT("qoi");
+	case ECaptureImageFormat::JPEG:	return TEXT("jpg");
+	case ECaptureImageFormat::EXR:	return TEXT("exr");
+	case ECaptureImageFormat::Raw:	return TEXT("bgra");
+	default:						return TEXT("png");
+	}
+}
+
+FString FCaptureEncoder::ResolveOutputPath(const FString& FilePath, ECaptureImageFormat Format)
+{
+	return FPaths::ChangeExtension(FilePath, GetExtension(Format));
+}
+
+int32 FCaptureEncoder::GetNumStrips(const FCapturedImage& Image, int32 MaxStrips)
+{
+	const int64 NumPixels = (int64)Image.Width * Image.Height;
+	const int32 WantedStrips = (int32)FMath::Clamp<int64>(NumPixels / PixelsPerStrip, 1, FMath::Max(1, Image.Height));
+	const int32 StripCap = MaxStrips > 0 ? MaxStrips : FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	return FMath::Min(WantedStrips, StripCap);
+}
+
+bool FCaptureEncoder::Encode(const FCapturedImage& Image, const FCaptureEncodeSettings& Settings,
+	IImageWrapperModule& ImageWrapperModule, TArray64<uint8>& OutData)
+{
+	// Packed AOV images are split by FCaptureAOV, never encoded as color
+	if (Image.Layout != ECapturePixelLayout::BGRA8)
+	{
+		return false;
+	}
+
+	switch (Settings.Format)
+	{
+	case ECaptureImageFormat::QOI:
+		return EncodeQOI(Image, Settings.MaxStrips, OutData);
+	case ECaptureImageFormat::EXR:
+		return EncodeEXR(Image, Settings.MaxStrips, ImageWrapperModule, OutData);
+	case ECaptureImageFormat::Raw:
+		return false;
+	default:
+		return EncodeWithImageWrapper(Image, Settings, ImageWrapperModule, OutData);
+	}
+}
+
+bool FCaptureEncoder::EncodeWithImageWrapper(const FCapturedImage& Image, const FCaptureEncodeSettings& Settings,
+	IImageWrapperModule& ImageWrapperModule, TArray64<uint8>& OutData)
+{
+	int32 Quality = Settings.PngCompressionLevel;
+	if (Settings.Format == ECaptureImageFormat::PNGFast)
+	{
+		Quality = (int32)EImageCompressionQuality::Default;
+	}
+	else if (Settings.Format == ECaptureImageFormat::JPEG)
+	{
+		Quality = FMath::Clamp(Settings.JpegQuality, 1, 100);
+	}
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(
+		Settings.Format == ECaptureImageFormat::JPEG ? EImageFormat::JPEG : EImageFormat::PNG);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Image.Data.GetData(), Image.Data.Num(),
+		Image.Width, Image.Height, ERGBFormat::BGRA, 8))
+	{
+		UE_LOG(LogCaptureEncoder, Error, TEXT("Image wrapper SetRaw failed (%dx%d)"), Image.Width, Image.Height);
+		return false;
+	}
+
+	OutData = ImageWrapper->GetCompressed(Quality);
+	return OutData.Num() > 0;
+}
+
+bool FCaptureEncoder::EncodeQOI(const FCapturedImage& Image, int32 MaxStrips, TArray64<uint8>& OutData)
+{
+	if (!Image.IsValid() || Image.Layout != ECapturePixelLayout::BGRA8)
+	{
+		return false;
+	}
+
+	const int32 NumStrips = GetNumStrips(Image, MaxStrips);
+	const int32 RowsPerStrip = FMath::DivideAndRoundUp(Image.Height, NumStrips);
+	const uint8* Pixels = Image.Data.GetData();
+
+	TArray<TArray64<uint8>> Strips;
+	Strips.SetNum(NumStrips);
+	ParallelFor(NumStrips, [&](int32 StripIndex)
+	{
+		const int32 FirstRow = StripIndex * RowsPerStrip;
+		const int32 EndRow = FMath::Min(Image.Height, FirstRow + RowsPerStrip);
+		if (FirstRow < EndRow)
+		{
+			EncodeQoiStrip(Pixels, (int64)FirstRow * Image.Width, (int64)EndRow * Image.Width, Strips[StripIndex]);
+		}
+	}, NumStrips == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	int64 TotalSize = QOI_HEADER_SIZE + sizeof(QOI_END_MARKER);
+	for (const TArray64<uint8>& Strip : Strips)
+	{
+		TotalSize += Strip.Num();
+	}
+
+	OutData.SetNumUninitialized(TotalSize);
+	uint8* Dest = OutData.GetData();
+
+	// Header: magic, big-endian size, 4 channels, sRGB color space
+	FMemory::Memcpy(Dest, "qoif", 4);
+	WriteBigEndian32(Dest + 4, (uint32)Image.Width);
+	WriteBigEndian32(Dest + 8, (uint32)Image.Height);
+	Dest[12] = 4;
+	Dest[13] = 0;
+
+	int64 Offset = QOI_HEADER_SIZE;
+	for (const TArray64<uint8>& Strip : Strips)
+	{
+		FMemory::Memcpy(Dest + Offset, Strip.GetData(), Strip.Num());
+		Offset += Strip.Num();
+	}
+	FMemory::Memcpy(Dest + Offset, QOI_END_MARKER, sizeof(QOI_END_MARKER));
+
+	UE_LOG(LogCaptureEncoder, VeryVerbose, TEXT("QOI %dx%d: %d strips, %lld bytes"), Image.Width, Image.Height, NumStrips, TotalSize);
+	return true;
+}
+
+bool FCaptureEncoder::EncodeEXR(const FCapturedImage& Image, int32 MaxStrips,
+	IImageWrapperModule& ImageWrapperModule, TArray64<uint8>& OutData)
+{
+	if (!Image.IsValid() || Image.Layout != ECapturePixelLayout::BGRA8)
+	{
+		return false;
+	}
+
+	// FColor is BGRA in memory, matching the capture layout
+	const int64 NumPixels = (int64)Image.Width * Image.Height;
+	const FColor* Source = reinterpret_cast<const FColor*>(Image.Data.GetData());
+	TArray64<FFloat16Color> Linear;
+	Linear.SetNumUninitialized(NumPixels);
+
+	const int32 NumStrips = GetNumStrips(Image, MaxStrips);
+	const int64 PixelsPerChunk = FMath::DivideAndRoundUp<int64>(NumPixels, NumStrips);
+	ParallelFor(NumStrips, [&](int32 StripIndex)
+	{
+		const int64 Begin = StripIndex * PixelsPerChunk;
+		const int64 End = FMath::Min(NumPixels, Begin + PixelsPerChunk);
+		for (int64 PixelIndex = Begin; PixelIndex < End; ++PixelIndex)
+		{
+			Linear[PixelIndex] = FFloat16Color(FLinearColor::FromSRGBColor(Source[PixelIndex]));
+		}
+	}, NumStrips == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::EXR);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Linear.GetData(), Linear.Num() * sizeof(FFloat16Color),
+		Image.Width, Image.Height, ERGBFormat::RGBAF, 16))
+	{
+		UE_LOG(LogCaptureEncoder, Error, TEXT("EXR SetRaw failed (%dx%d)"), Image.Width, Image.Height);
+		return false;
+	}
+
+	OutData = ImageWrapper->GetCompressed((int32)EImageCompressionQuality::Default);
+	return OutData.Num() > 0;
+}
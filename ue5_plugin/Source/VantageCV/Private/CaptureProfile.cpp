@@ -0,0 +1,102 @@
+/******************************************************************************
+ * VantageCV - Capture Profile Implementation
+ ******************************************************************************
+ * File: CaptureProfile.cpp
+ * Description: Built-in capture profiles and their show flag / post-process
+ *              application
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureProfile.h"
+#include "Components/SceneCaptureComponent2D.h"
+
+namespace
+{
+	TArray<FCaptureProfile> MakeBuiltInProfiles()
+	{
+		TArray<FCaptureProfile> Profiles;
+
+		FCaptureProfile& Final = Profiles.AddDefaulted_GetRef();
+		Final.Name = TEXT("final");
+
+		FCaptureProfile& FastPreview = Profiles.AddDefaulted_GetRef();
+		FastPreview.Name = TEXT("fast-preview");
+		FastPreview.bGlobalIllumination = false;
+		FastPreview.bAmbientOcclusion = false;
+		FastPreview.bScreenSpaceReflections = false;
+		FastPreview.bReflections = false;
+		FastPreview.bVolumetricFog = false;
+
+		FCaptureProfile& AnnotationOnly = Profiles.AddDefaulted_GetRef();
+		AnnotationOnly.Name = TEXT("annotation-only");
+		AnnotationOnly.bLighting = false;
+		AnnotationOnly.bDynamicShadows = false;
+		AnnotationOnly.bGlobalIllumination = false;
+		AnnotationOnly.bAmbientOcclusion = false;
+		AnnotationOnly.bScreenSpaceReflections = false;
+		AnnotationOnly.bReflections = false;
+		AnnotationOnly.bAtmosphere = false;
+		AnnotationOnly.bVolumetricFog = false;
+		AnnotationOnly.bTranslucency = false;
+		AnnotationOnly.bAntiAliasing = false;
+
+		return Profiles;
+	}
+}
+
+const TArray<FCaptureProfile>& FCaptureProfile::GetBuiltIns()
+{
+	static const TArray<FCaptureProfile> BuiltIns = MakeBuiltInProfiles();
+	return BuiltIns;
+}
+
+const FCaptureProfile* FCaptureProfile::FindBuiltIn(FName ProfileName)
+{
+	return GetBuiltIns().FindByPredicate([ProfileName](const FCaptureProfile& Profile) { return Profile.Name == ProfileName; });
+}
+
+void FCaptureProfile::ApplyTo(USceneCaptureComponent2D* Component) const
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	FEngineShowFlags& ShowFlags = Component->ShowFlags;
+	ShowFlags.SetLighting(bLighting);
+	ShowFlags.SetDynamicShadows(bDynamicShadows);
+	ShowFlags.SetGlobalIllumination(bGlobalIllumination);
+	ShowFlags.SetLumenGlobalIllumination(bGlobalIllumination);
+	ShowFlags.SetAmbientOcclusion(bAmbientOcclusion);
+	ShowFlags.SetScreenSpaceReflections(bScreenSpaceReflections);
+	ShowFlags.SetReflectionEnvironment(bReflections);
+	ShowFlags.SetLumenReflections(bReflections);
+	ShowFlags.SetAtmosphere(bAtmosphere);
+	ShowFlags.SetFog(bAtmosphere);
+	ShowFlags.SetVolumetricFog(bVolumetricFog);
+	ShowFlags.SetTranslucency(bTranslucency);
+	ShowFlags.SetAntiAliasing(bAntiAliasing);
+
+	// Show flags hide the result; the method override keeps Lumen from being set up at all
+	FPostProcessSettings& Settings = Component->PostProcessSettings;
+	Settings.bOverride_DynamicGlobalIlluminationMethod = !bGlobalIllumination;
+	Settings.DynamicGlobalIlluminationMethod = EDynamicGlobalIlluminationMethod::None;
+	Settings.bOverride_ReflectionMethod = !bReflections;
+	Settings.ReflectionMethod = EReflectionMethod::None;
+}
+
+bool FCaptureProfile::operator==(const FCaptureProfile& Other) const
+{
+	return Name == Other.Name
+		&& bLighting == Other.bLighting
+		&& bDynamicShadows == Other.bDynamicShadows
+		&& bGlobalIllumination == Other.bGlobalIllumination
+		&& bAmbientOcclusion == Other.bAmbientOcclusion
+		&& bScreenSpaceReflections == Other.bScreenSpaceReflections
+		&& bReflections == Other.bReflections
+		&& bAtmosphere == Other.bAtmosphere
+		&& bVolumetricFog == Other.bVolumetricFog
+		&& bTranslucency == Other.bTranslucency
+		&& bAntiAliasing == Other.bAntiAliasing;
+}
@@ -0,0 +1,236 @@
+/******************************************************************************
+ * VantageCV - Capture Projection Implementation
+ ******************************************************************************
+ * File: CaptureProjection.cpp
+ * Description: Capture view matrix setup and batched box projection
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureProjection.h"
+#include "Components/SceneCaptureComponent2D.h"
+
+namespace
+{
+	/** Corner index bits: 1 = +X half-axis, 2 = +Y, 4 = +Z */
+	constexpr int32 NumCorners = 8;
+
+	/** Box edges as corner index pairs (corners differing in exactly one bit) */
+	constexpr int32 BoxEdges[12][2] =
+	{
+		{0, 1}, {2, 3}, {4, 5}, {6, 7},
+		{0, 2}, {1, 3}, {4, 6}, {5, 7},
+		{0, 4}, {1, 5}, {2, 6}, {3, 7}
+	};
+}
+
+FCaptureProjection::FCaptureProjection(const FVector& ViewLocation, const FRotator& ViewRotation, float FOVDegrees,
+	int32 InWidth, int32 InHeight, float InNearPlane)
+	: ViewOrigin(ViewLocation)
+	, NearPlane(FMath::Max(InNearPlane, KINDA_SMALL_NUMBER))
+	, Width(FMath::Max(InWidth, 0))
+	, Height(FMath::Max(InHeight, 0))
+{
+	if (Width == 0 || Height == 0)
+	{
+		return;
+	}
+
+	// Scene capture convention: horizontal FOV, vertical scaled by aspect ratio
+	const float HalfFOVRadians = FMath::DegreesToRadians(FMath::Clamp(FOVDegrees, 1.0f, 179.0f) * 0.5f);
+	const float ScaleX = 1.0f / FMath::Tan(HalfFOVRadians);
+	const float ScaleY = ScaleX * (float)Width / (float)Height;
+
+	// UE camera looks down +X with +Y right and +Z up
+	const FRotationMatrix Rotation(ViewRotation);
+	const FVector3f Forward(Rotation.GetScaledAxis(EAxis::X));
+	const FVector3f Right(Rotation.GetScaledAxis(EAxis::Y));
+	const FVector3f Up(Rotation.GetScaledAxis(EAxis::Z));
+
+	RowX = Right * ScaleX;
+	RowY = Up * ScaleY;
+	RowW = Forward;
+}
+
+FCaptureProjection FCaptureProjection::FromCaptureComponent(const USceneCaptureComponent2D* Component, int32 InWidth, int32 InHeight)
+{
+	if (!Component)
+	{
+		return FCaptureProjection();
+	}
+
+	const float Near = Component->bOverride_CustomNearClippingPlane ? Component->CustomNearClippingPlane : GNearClippingPlane;
+	return FCaptureProjection(Component->GetComponentLocation(), Component->GetComponentRotation(),
+		Component->FOVAngle, InWidth, InHeight, Near);
+}
+
+bool FCaptureProjection::ProjectPoint(const FVector& WorldLocation, FVector2D& OutPixel) const
+{
+	const FVector3f Relative(WorldLocation - ViewOrigin);
+	const float W = RowW | Relative;
+	if (!IsValid() || W < NearPlane)
+	{
+		return false;
+	}
+
+	const float NdcX = (RowX | Relative) / W;
+	const float NdcY = (RowY | Relative) / W;
+	OutPixel.X = (NdcX * 0.5f + 0.5f) * Width;
+	OutPixel.Y = (0.5f - NdcY * 0.5f) * Height;
+	return true;
+}
+
+void FCaptureProjection::ProjectBoxes(TConstArrayView<FCaptureWorldBox> Boxes, TArray<FCaptureProjectedBox>& OutBoxes) const
+{
+	const int32 NumBoxes = Boxes.Num();
+	OutBoxes.Reset(NumBoxes);
+	OutBoxes.SetNum(NumBoxes);
+	if (!IsValid() || NumBoxes == 0)
+	{
+		return;
+	}
+
+	// Pass 1 (SoA): center and half-axes of every box in camera-relative float space.
+	// Projection is linear, so corner clip coords are sums of these four transformed vectors.
+	const int32 NumVectors = NumBoxes * 4;
+	TArray<float> InX, InY, InZ;
+	InX.SetNumUninitialized(NumVectors);
+	InY.SetNumUninitialized(NumVectors);
+	InZ.SetNumUninitialized(NumVectors);
+
+	for (int32 BoxIndex = 0; BoxIndex < NumBoxes; ++BoxIndex)
+	{
+		const FCaptureWorldBox& Box = Boxes[BoxIndex];
+		const FVector RelativeCenter = Box.Center - ViewOrigin;
+		const FVector* Vectors[4] = { &RelativeCenter, &Box.HalfAxisX, &Box.HalfAxisY, &Box.HalfAxisZ };
+		for (int32 V = 0; V < 4; ++V)
+		{
+			InX[BoxIndex * 4 + V] = (float)Vectors[V]->X;
+			InY[BoxIndex * 4 + V] = (float)Vectors[V]->Y;
+			InZ[BoxIndex * 4 + V] = (float)Vectors[V]->Z;
+		}
+	}
+
+	// Pass 2 (SoA): 3x3 view-projection over all vectors, branch-free so it auto-vectorizes
+	TArray<float> OutX, OutY, OutW;
+	OutX.SetNumUninitialized(NumVectors);
+	OutY.SetNumUninitialized(NumVectors);
+	OutW.SetNumUninitialized(NumVectors);
+
+	const float* RESTRICT SrcX = InX.GetData();
+	const float* RESTRICT SrcY = InY.GetData();
+	const float* RESTRICT SrcZ = InZ.GetData();
+	float* RESTRICT DstX = OutX.GetData();
+	float* RESTRICT DstY = OutY.GetData();
+	float* RESTRICT DstW = OutW.GetData();
+
+	for (int32 Index = 0; Index < NumVectors; ++Index)
+	{
+		DstX[Index] = RowX.X * SrcX[Index] + RowX.Y * SrcY[Index] + RowX.Z * SrcZ[Index];
+		DstY[Index] = RowY.X * SrcX[Index] + RowY.Y * SrcY[Index] + RowY.Z * SrcZ[Index];
+		DstW[Index] = RowW.X * SrcX[Index] + RowW.Y * SrcY[Index] + RowW.Z * SrcZ[Index];
+	}
+
+	// Pass 3: expand corners and clip per box
+	float CornerX[NumCorners], CornerY[NumCorners], CornerW[NumCorners];
+	for (int32 BoxIndex = 0; BoxIndex < NumBoxes; ++BoxIndex)
+	{
+		const int32 Base = BoxIndex * 4;
+		for (int32 Corner = 0; Corner < NumCorners; ++Corner)
+		{
+			const float SignX = (Corner & 1) ? 1.0f : -1.0f;
+			const float SignY = (Corner & 2) ? 1.0f : -1.0f;
+			const float SignZ = (Corner & 4) ? 1.0f : -1.0f;
+			CornerX[Corner] = DstX[Base] + SignX * DstX[Base + 1] + SignY * DstX[Base + 2] + SignZ * DstX[Base + 3];
+			CornerY[Corner] = DstY[Base] + SignX * DstY[Base + 1] + SignY * DstY[Base + 2] + SignZ * DstY[Base + 3];
+			CornerW[Corner] = DstW[Base] + SignX * DstW[Base + 1] + SignY * DstW[Base + 2] + SignZ * DstW[Base + 3];
+		}
+		OutBoxes[BoxIndex] = ResolveBox(CornerX, CornerY, CornerW);
+	}
+}
+
+FCaptureProjectedBox FCaptureProjection::ResolveBox(const float* ClipX, const float* ClipY, const float* ClipW) const
+{
+	FCaptureProjectedBox Result;
+
+	// Trivial reject: every corner outside the same frustum plane
+	uint32 OutsideAll = 0x1F;
+	int32 NumInFront = 0;
+	for (int32 Corner = 0; Corner < NumCorners; ++Corner)
+	{
+		const float X = ClipX[Corner], Y = ClipY[Corner], W = ClipW[Corner];
+		const uint32 Outside =
+			(X < -W ? 0x01u : 0u) | (X > W ? 0x02u : 0u) |
+			(Y < -W ? 0x04u : 0u) | (Y > W ? 0x08u : 0u) |
+			(W < NearPlane ? 0x10u : 0u);
+		OutsideAll &= Outside;
+		NumInFront += (W >= NearPlane) ? 1 : 0;
+	}
+	if (OutsideAll != 0 || NumInFront == 0)
+	{
+		return Result;
+	}
+
+	float MinX = FLT_MAX, MinY = FLT_MAX, MaxX = -FLT_MAX, MaxY = -FLT_MAX;
+	float NearestDepth = FLT_MAX;
+	auto AddPoint = [&](float X, float Y, float W)
+	{
+		const float NdcX = X / W;
+		const float NdcY = Y / W;
+		MinX = FMath::Min(MinX, NdcX);
+		MaxX = FMath::Max(MaxX, NdcX);
+		MinY = FMath::Min(MinY, NdcY);
+		MaxY = FMath::Max(MaxY, NdcY);
+		NearestDepth = FMath::Min(NearestDepth, W);
+	};
+
+	for (int32 Corner = 0; Corner < NumCorners; ++Corner)
+	{
+		if (ClipW[Corner] >= NearPlane)
+		{
+			AddPoint(ClipX[Corner], ClipY[Corner], ClipW[Corner]);
+		}
+	}
+
+	// Straddling the near plane: add the edge intersections instead of the corners behind it
+	const bool bNearClipped = NumInFront < NumCorners;
+	if (bNearClipped)
+	{
+		for (const int32 (&Edge)[2] : BoxEdges)
+		{
+			const int32 A = Edge[0], B = Edge[1];
+			if ((ClipW[A] >= NearPlane) != (ClipW[B] >= NearPlane))
+			{
+				const float T = (NearPlane - ClipW[A]) / (ClipW[B] - ClipW[A]);
+				AddPoint(FMath::Lerp(ClipX[A], ClipX[B], T), FMath::Lerp(ClipY[A], ClipY[B], T), NearPlane);
+			}
+		}
+	}
+
+	// Entirely off-screen after clipping
+	if (MaxX < -1.0f || MinX > 1.0f || MaxY < -1.0f || MinY > 1.0f)
+	{
+		return Result;
+	}
+
+	Result.bVisible = true;
+	Result.bTruncated = bNearClipped || MinX < -1.0f || MaxX > 1.0f || MinY < -1.0f || MaxY > 1.0f;
+	Result.NearestDepth = NearestDepth;
+
+	const float UnclampedArea = (MaxX - MinX) * (MaxY - MinY);
+
+	MinX = FMath::Max(MinX, -1.0f);
+	MaxX = FMath::Min(MaxX, 1.0f);
+	MinY = FMath::Max(MinY, -1.0f);
+	MaxY = FMath::Min(MaxY, 1.0f);
+
+	// For near-clipped boxes only the part in front of the near plane is measured
+	Result.InFrameFraction = UnclampedArea > KINDA_SMALL_NUMBER
+		? FMath::Clamp((MaxX - MinX) * (MaxY - MinY) / UnclampedArea, 0.0f, 1.0f)
+		: 1.0f;
+
+	// NDC +Y is up, pixel +Y is down
+	Result.Min = FVector2D((MinX * 0.5f + 0.5f) * Width, (0.5f - MaxY * 0.5f) * Height);
+	Result.Max = FVector2D((MaxX * 0.5f + 0.5f) * Width, (0.5f - MinY * 0.5f) * Height);
+	return Result;
+}
@@ -0,0 +1,388 @@
+/******************************************************************************
+ * VantageCV - Asynchronous Capture Readback Implementation
+ ******************************************************************************
+ * File: CaptureReadback.cpp
+ * Description: Implementation of the in-flight render target ring. GPU copies
+ *              are queued with FRHIGPUTextureReadback and resolved on the
+ *              render thread once the GPU fence has passed.
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureReadback.h"
+#include "CaptureResourcePool.h"
+#include "CaptureTelemetry.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCaptureReadback, Log, All);
+
+int32 FCapturedImage::GetBytesPerPixel() const
+{
+	switch (Layout)
+	{
+		case ECapturePixelLayout::BGRA8: return 4;
+		case ECapturePixelLayout::RGBA32F: return 16;
+	}
+	return 4;
+}
+
+FCaptureReadbackRing::FCaptureReadbackRing()
+{
+}
+
+FCaptureReadbackRing::~FCaptureReadbackRing()
+{
+	// Render commands hold raw slot pointers - let them drain before the slots go away
+	if (Slots.Num() > 0)
+	{
+		FlushRenderingCommands();
+		ReleaseSlotResources();
+	}
+}
+
+void FCaptureReadbackRing::Initialize(UObject* InOuter, int32 InRingSize)
+{
+	const int32 RingSize = FMath::Clamp(InRingSize, 1, 16);
+	if (Outer.Get() == InOuter && Slots.Num() >= RingSize)
+	{
+		return;
+	}
+
+	if (GetNumInFlight() > 0)
+	{
+		Flush();
+	}
+	FlushRenderingCommands();
+	ReleaseSlotResources();
+
+	Outer = InOuter;
+	Slots.Reset();
+	for (int32 i = 0; i < RingSize; ++i)
+	{
+		TUniquePtr<FSlot> Slot = MakeUnique<FSlot>();
+		Slot->Readback = MakeUnique<FRHIGPUTextureReadback>(*FString::Printf(TEXT("VantageCVCaptureReadback_%d"), i));
+		Slots.Add(MoveTemp(Slot));
+	}
+
+	UE_LOG(LogCaptureReadback, Log, TEXT("Readback ring initialized with %d slots"), RingSize);
+}
+
+void FCaptureReadbackRing::EnsureCapacity(int32 InRingSize)
+{
+	const int32 RingSize = FMath::Clamp(InRingSize, 1, 16);
+	if (Slots.Num() >= RingSize)
+	{
+		return;
+	}
+
+	// Slots are heap-allocated, so pointers held by queued render commands stay valid
+	for (int32 i = Slots.Num(); i < RingSize; ++i)
+	{
+		TUniquePtr<FSlot> Slot = MakeUnique<FSlot>();
+		Slot->Readback = MakeUnique<FRHIGPUTextureReadback>(*FString::Printf(TEXT("VantageCVCaptureReadback_%d"), i));
+		Slots.Add(MoveTemp(Slot));
+	}
+
+	UE_LOG(LogCaptureReadback, Log, TEXT("Readback ring grown to %d slots"), RingSize);
+}
+
+int32 FCaptureReadbackRing::AcquireSlot(int32 Width, int32 Height, ECapturePixelLayout Layout)
+{
+	if (Slots.Num() == 0 || Width <= 0 || Height <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Hand out anything that already finished before looking for a free slot
+	DeliverResolved();
+
+	int32 SlotIndex = Slots.IndexOfByPredicate([](const TUniquePtr<FSlot>& Slot) { return Slot->State == ESlotState::Free; });
+	if (SlotIndex == INDEX_NONE)
+	{
+		// Ring full: back-pressure on the oldest frame so in-flight memory stays bounded
+		const int32 OldestIndex = FindOldestPendingSlot();
+		if (OldestIndex == INDEX_NONE)
+		{
+			UE_LOG(LogCaptureReadback, Error, TEXT("AcquireSlot: all %d slots acquired but none submitted"), Slots.Num());
+			return INDEX_NONE;
+		}
+
+		UE_LOG(LogCaptureReadback, Verbose, TEXT("Ring full - waiting on ticket %d"), Slots[OldestIndex]->Ticket);
+		WaitForTicket(Slots[OldestIndex]->Ticket);
+		SlotIndex = OldestIndex;
+	}
+
+	FSlot& Slot = *Slots[SlotIndex];
+	PrepareSlotTarget(Slot, Width, Height, Layout);
+	if (!Slot.Target)
+	{
+		return INDEX_NONE;
+	}
+
+	Slot.Layout = Layout;
+	Slot.State = ESlotState::Acquired;
+	return SlotIndex;
+}
+
+UTextureRenderTarget2D* FCaptureReadbackRing::GetSlotTarget(int32 SlotIndex) const
+{
+	return Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex]->Target.Get() : nullptr;
+}
+
+int32 FCaptureReadbackRing::Submit(int32 SlotIndex, const FString& OutputPath)
+{
+	if (!Slots.IsValidIndex(SlotIndex) || Slots[SlotIndex]->State != ESlotState::Acquired)
+	{
+		UE_LOG(LogCaptureReadback, Error, TEXT("Submit: slot %d was not acquired"), SlotIndex);
+		return INDEX_NONE;
+	}
+
+	FSlot& Slot = *Slots[SlotIndex];
+	FTextureRenderTargetResource* Resource = Slot.Target ? Slot.Target->GameThread_GetRenderTargetResource() : nullptr;
+	if (!Resource)
+	{
+		UE_LOG(LogCaptureReadback, Error, TEXT("Submit: slot %d has no render target resource"), SlotIndex);
+		ReleaseSlot(SlotIndex);
+		return INDEX_NONE;
+	}
+
+	Slot.Ticket = NextTicket++;
+	Slot.OutputPath = OutputPath;
+	Slot.Image.Width = Slot.Target->SizeX;
+	Slot.Image.Height = Slot.Target->SizeY;
+	Slot.Image.Layout = Slot.Layout;
+	Slot.Image.Data = FCaptureResourcePool::Get().AcquireBuffer((int64)Slot.Image.Width * Slot.Image.Height * Slot.Image.GetBytesPerPixel());
+	Slot.bCopied.store(false);
+	Slot.State = ESlotState::InFlight;
+	Slot.SubmitCycles = FPlatformTime::Cycles64();
+
+	// Queued behind the CaptureScene render commands, so the copy sees the finished frame
+	FRHIGPUTextureReadback* Readback = Slot.Readback.Get();
+	ENQUEUE_RENDER_COMMAND(VantageCV_EnqueueCaptureReadback)(
+		[Resource, Readback](FRHICommandListImmediate& RHICmdList)
+		{
+			Readback->EnqueueCopy(RHICmdList, Resource->GetRenderTargetTexture());
+		});
+
+	return Slot.Ticket;
+}
+
+void FCaptureReadbackRing::ReleaseSlot(int32 SlotIndex)
+{
+	if (Slots.IsValidIndex(SlotIndex) && Slots[SlotIndex]->State == ESlotState::Acquired)
+	{
+		Slots[SlotIndex]->State = ESlotState::Free;
+	}
+}
+
+void FCaptureReadbackRing::Tick()
+{
+	DeliverResolved();
+	EnqueueResolve(false);
+}
+
+bool FCaptureReadbackRing::WaitForTicket(int32 Ticket)
+{
+	if (!IsTicketPending(Ticket))
+	{
+		return IsTicketComplete(Ticket);
+	}
+
+	EnqueueResolve(true);
+	FlushRenderingCommands();
+	DeliverResolved();
+
+	return !IsTicketPending(Ticket);
+}
+
+int32 FCaptureReadbackRing::Flush()
+{
+	if (GetNumInFlight() == 0)
+	{
+		return DeliverResolved();
+	}
+
+	EnqueueResolve(true);
+	FlushRenderingCommands();
+	return DeliverResolved();
+}
+
+bool FCaptureReadbackRing::IsTicketPending(int32 Ticket) const
+{
+	return Slots.ContainsByPredicate([Ticket](const TUniquePtr<FSlot>& Slot)
+	{
+		return Slot->State == ESlotState::InFlight && Slot->Ticket == Ticket;
+	});
+}
+
+int32 FCaptureReadbackRing::GetNumInFlight() const
+{
+	int32 Count = 0;
+	for (const TUniquePtr<FSlot>& Slot : Slots)
+	{
+		Count += Slot->State == ESlotState::InFlight ? 1 : 0;
+	}
+	return Count;
+}
+
+void FCaptureReadbackRing::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TUniquePtr<FSlot>& Slot : Slots)
+	{
+		Collector.AddReferencedObject(Slot->Target);
+	}
+}
+
+void FCaptureReadbackRing::PrepareSlotTarget(FSlot& Slot, int32 Width, int32 Height, ECapturePixelLayout Layout)
+{
+	// BGRA8: same format as ADataCapture::SetResolution - linear RGBA8, SCS_FinalColorLDR bakes gamma in.
+	// RGBA32F: full float so the bit-packed AOV channels survive the copy untouched.
+	const ETextureRenderTargetFormat Format = Layout == ECapturePixelLayout::RGBA32F ? RTF_RGBA32f : RTF_RGBA8;
+	Slot.Target = FCaptureResourcePool::Get().ResizeRenderTarget(Slot.Target, Width, Height, Format);
+}
+
+void FCaptureReadbackRing::ReleaseSlotResources()
+{
+	if (!FCaptureResourcePool::IsAvailable())
+	{
+		return;
+	}
+
+	FCaptureResourcePool& Pool = FCaptureResourcePool::Get();
+	for (TUniquePtr<FSlot>& Slot : Slots)
+	{
+		Pool.ReleaseRenderTarget(Slot->Target);
+		Slot->Target = nullptr;
+		Pool.ReleaseBuffer(MoveTemp(Slot->Image.Data));
+	}
+}
+
+void FCaptureReadbackRing::EnqueueResolve(bool bBlock)
+{
+	TArray<FSlot*> Pending;
+	for (const TUniquePtr<FSlot>& Slot : Slots)
+	{
+		if (Slot->State == ESlotState::InFlight && !Slot->bCopied.load())
+		{
+			Pending.Add(Slot.Get());
+		}
+	}
+
+	if (Pending.Num() == 0)
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(VantageCV_ResolveCaptureReadbacks)(
+		[Pending = MoveTemp(Pending), bBlock](FRHICommandListImmediate& RHICmdList)
+		{
+			bool bGPUIdle = false;
+			for (FSlot* Slot : Pending)
+			{
+				// A previous non-blocking resolve may already have handled this slot
+				if (Slot->bCopied.load())
+				{
+					continue;
+				}
+
+				if (!Slot->Readback->IsReady())
+				{
+					if (!bBlock)
+					{
+						continue;
+					}
+					if (!bGPUIdle)
+					{
+						RHICmdList.BlockUntilGPUIdle();
+						bGPUIdle = true;
+					}
+				}
+
+				// Submit to copy-ready, observed at the first resolve after the fence (includes queueing)
+				const double GPULatencyMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Slot->SubmitCycles);
+				FCaptureTelemetry::Get().Record(ECaptureStage::GPU, GPULatencyMs);
+				SET_FLOAT_STAT(STAT_VantageCV_GPULatency, GPULatencyMs);
+
+				VANTAGECV_CAPTURE_STAGE(Readback);
+				FCapturedImage& Image = Slot->Image;
+				const int64 RowBytes = (int64)Image.Width * Image.GetBytesPerPixel();
+
+				int32 RowPitchInPixels = 0;
+				const uint8* Source = static_cast<const uint8*>(Slot->Readback->Lock(RowPitchInPixels));
+				if (Source)
+				{
+					if (RowPitchInPixels == Image.Width)
+					{
+						FMemory::Memcpy(Image.Data.GetData(), Source, Image.Data.Num());
+					}
+					else
+					{
+						const int64 SourcePitch = (int64)RowPitchInPixels * Image.GetBytesPerPixel();
+						for (int32 Row = 0; Row < Image.Height; ++Row)
+						{
+							FMemory::Memcpy(Image.Data.GetData() + Row * RowBytes, Source + Row * SourcePitch, RowBytes);
+						}
+					}
+				}
+				else
+				{
+					Image.Data.Reset();
+				}
+				Slot->Readback->Unlock();
+
+				Slot->bCopied.store(true);
+			}
+		});
+}
+
+int32 FCaptureReadbackRing::DeliverResolved()
+{
+	TArray<int32, TInlineAllocator<16>> Ready;
+	for (int32 i = 0; i < Slots.Num(); ++i)
+	{
+		if (Slots[i]->State == ESlotState::InFlight && Slots[i]->bCopied.load())
+		{
+			Ready.Add(i);
+		}
+	}
+
+	// Deliver in submission order so consumers see frames sequentially
+	Ready.Sort([this](int32 A, int32 B) { return Slots[A]->Ticket < Slots[B]->Ticket; });
+
+	for (int32 SlotIndex : Ready)
+	{
+		FSlot& Slot = *Slots[SlotIndex];
+		const int32 Ticket = Slot.Ticket;
+		FString OutputPath = MoveTemp(Slot.OutputPath);
+		FCapturedImage Image = MoveTemp(Slot.Image);
+
+		// Free before the callback so it may immediately acquire this slot again
+		Slot.State = ESlotState::Free;
+		Slot.Ticket = INDEX_NONE;
+		Slot.bCopied.store(false);
+
+		if (!Image.IsValid())
+		{
+			UE_LOG(LogCaptureReadback, Error, TEXT("Readback for ticket %d returned no data"), Ticket);
+		}
+		OnComplete.ExecuteIfBound(Ticket, OutputPath, MoveTemp(Image));
+	}
+
+	return Ready.Num();
+}
+
+int32 FCaptureReadbackRing::FindOldestPendingSlot() const
+{
+	int32 OldestIndex = INDEX_NONE;
+	for (int32 i = 0; i < Slots.Num(); ++i)
+	{
+		if (Slots[i]->State == ESlotState::InFlight &&
+			(OldestIndex == INDEX_NONE || Slots[i]->Ticket < Slots[OldestIndex]->Ticket))
+		{
+			OldestIndex = i;
+		}
+	}
+	return OldestIndex;
+}
@@ -0,0 +1,274 @@
+/******************************************************************************
+ * VantageCV - Capture Resource Pool Implementation
+ ******************************************************************************
+ * File: CaptureResourcePool.cpp
+ * Description: Render target and pixel buffer reuse with memory accounting
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureResourcePool.h"
+#include "Misc/ScopeLock.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCaptureResourcePool, Log, All);
+
+FCaptureResourcePool* FCaptureResourcePool::Instance = nullptr;
+
+FCaptureResourcePool& FCaptureResourcePool::Get()
+{
+	if (!Instance)
+	{
+		check(IsInGameThread());
+		Instance = new FCaptureResourcePool();
+	}
+	return *Instance;
+}
+
+void FCaptureResourcePool::Shutdown()
+{
+	if (Instance)
+	{
+		const FCaptureResourcePoolStats FinalStats = Instance->GetStats();
+		UE_LOG(LogCaptureResourcePool, Log, TEXT("Resource pool shut down (high water: %.1f MB GPU, %.1f MB CPU)"),
+			FinalStats.HighWaterRenderTargetBytes / (1024.0 * 1024.0), FinalStats.HighWaterBufferBytes / (1024.0 * 1024.0));
+
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+UTextureRenderTarget2D* FCaptureResourcePool::AcquireRenderTarget(int32 Width, int32 Height, ETextureRenderTargetFormat Format)
+{
+	check(IsInGameThread());
+
+	if (Width <= 0 || Height <= 0)
+	{
+		UE_LOG(LogCaptureResourcePool, Error, TEXT("AcquireRenderTarget: invalid size %dx%d"), Width, Height);
+		return nullptr;
+	}
+
+	const FRenderTargetKey Key{Width, Height, Format};
+
+	TArray<TObjectPtr<UTextureRenderTarget2D>>* Idle = IdleTargets.Find(Key);
+	while (Idle && Idle->Num() > 0)
+	{
+		UTextureRenderTarget2D* Target = Idle->Pop(EAllowShrinking::No);
+		FScopeLock Lock(&BufferLock);
+		Stats.RenderTargetsIdle--;
+		if (IsValid(Target))
+		{
+			InUseTargets.Add(Target);
+			Stats.RenderTargetsInUse++;
+			Stats.RenderTargetReuses++;
+			return Target;
+		}
+		Stats.RenderTargetBytes -= GetRenderTargetBytes(Key);
+	}
+
+	// Same configuration the capture actors used before pooling - SCS_FinalColorLDR bakes gamma in
+	UTextureRenderTarget2D* Target = NewObject<UTextureRenderTarget2D>(GetTransientPackage());
+	Target->RenderTargetFormat = Format;
+	Target->ClearColor = FLinearColor::Black;
+	Target->bAutoGenerateMips = false;
+	Target->InitAutoFormat(Width, Height);
+	Target->UpdateResourceImmediate(true);
+
+	InUseTargets.Add(Target);
+	int64 PooledBytes = 0;
+	{
+		FScopeLock Lock(&BufferLock);
+		Stats.RenderTargetsInUse++;
+		Stats.RenderTargetAllocations++;
+		Stats.RenderTargetBytes += GetRenderTargetBytes(Key);
+		Stats.HighWaterRenderTargetBytes = FMath::Max(Stats.HighWaterRenderTargetBytes, Stats.RenderTargetBytes);
+		PooledBytes = Stats.RenderTargetBytes;
+	}
+
+	UE_LOG(LogCaptureResourcePool, Log, TEXT("Allocated render target %dx%d (format %d), %.1f MB pooled"),
+		Width, Height, (int32)Format, PooledBytes / (1024.0 * 1024.0));
+	return Target;
+}
+
+void FCaptureResourcePool::ReleaseRenderTarget(UTextureRenderTarget2D* Target)
+{
+	check(IsInGameThread());
+
+	if (!Target)
+	{
+		return;
+	}
+
+	if (InUseTargets.RemoveSingleSwap(Target, EAllowShrinking::No) == 0)
+	{
+		UE_LOG(LogCaptureResourcePool, Warning, TEXT("ReleaseRenderTarget: %s is not owned by the pool"), *Target->GetName());
+		return;
+	}
+
+	FScopeLock Lock(&BufferLock);
+	Stats.RenderTargetsInUse--;
+
+	const FRenderTargetKey Key = MakeKey(Target);
+	TArray<TObjectPtr<UTextureRenderTarget2D>>& Idle = IdleTargets.FindOrAdd(Key);
+	if (Idle.Num() >= MaxIdlePerKey)
+	{
+		// Over the idle cap - let GC reclaim it
+		Stats.RenderTargetBytes -= GetRenderTargetBytes(Key);
+		return;
+	}
+
+	Idle.Add(Target);
+	Stats.RenderTargetsIdle++;
+}
+
+UTextureRenderTarget2D* FCaptureResourcePool::ResizeRenderTarget(UTextureRenderTarget2D* Current, int32 Width, int32 Height, ETextureRenderTargetFormat Format)
+{
+	if (Current && Current->SizeX == Width && Current->SizeY == Height && Current->RenderTargetFormat == Format)
+	{
+		return Current;
+	}
+
+	ReleaseRenderTarget(Current);
+	return AcquireRenderTarget(Width, Height, Format);
+}
+
+TArray64<uint8> FCaptureResourcePool::AcquireBuffer(int64 NumBytes)
+{
+	TArray64<uint8> Buffer;
+	if (NumBytes <= 0)
+	{
+		return Buffer;
+	}
+
+	{
+		FScopeLock Lock(&BufferLock);
+		Stats.BuffersInUse++;
+
+		TArray<TArray64<uint8>>* Idle = IdleBuffers.Find(NumBytes);
+		if (Idle && Idle->Num() > 0)
+		{
+			Buffer = Idle->Pop(EAllowShrinking::No);
+			Stats.BuffersIdle--;
+			Stats.BufferReuses++;
+			return Buffer;
+		}
+
+		Stats.BufferAllocations++;
+		Stats.BufferBytes += NumBytes;
+		Stats.HighWaterBufferBytes = FMath::Max(Stats.HighWaterBufferBytes, Stats.BufferBytes);
+	}
+
+	// Allocate outside the lock; tens of MB can take a while to commit
+	Buffer.SetNumUninitialized(NumBytes);
+	return Buffer;
+}
+
+void FCaptureResourcePool::ReleaseBuffer(TArray64<uint8>&& Buffer)
+{
+	const int64 NumBytes = Buffer.Num();
+	if (NumBytes <= 0)
+	{
+		return;
+	}
+
+	TArray64<uint8> Released = MoveTemp(Buffer);
+
+	FScopeLock Lock(&BufferLock);
+	Stats.BuffersInUse = FMath::Max(0, Stats.BuffersInUse - 1);
+
+	TArray<TArray64<uint8>>& Idle = IdleBuffers.FindOrAdd(NumBytes);
+	if (Idle.Num() >= MaxIdlePerKey)
+	{
+		// Over the idle cap - Released frees when it goes out of scope
+		Stats.BufferBytes -= NumBytes;
+		return;
+	}
+
+	Idle.Add(MoveTemp(Released));
+	Stats.BuffersIdle++;
+}
+
+void FCaptureResourcePool::Trim()
+{
+	check(IsInGameThread());
+
+	TMap<int64, TArray<TArray64<uint8>>> FreedBuffers;
+	FCaptureResourcePoolStats Remaining;
+	{
+		FScopeLock Lock(&BufferLock);
+		for (const TPair<FRenderTargetKey, TArray<TObjectPtr<UTextureRenderTarget2D>>>& Pair : IdleTargets)
+		{
+			Stats.RenderTargetBytes -= GetRenderTargetBytes(Pair.Key) * Pair.Value.Num();
+		}
+		IdleTargets.Reset();
+		Stats.RenderTargetsIdle = 0;
+
+		for (const TPair<int64, TArray<TArray64<uint8>>>& Pair : IdleBuffers)
+		{
+			Stats.BufferBytes -= Pair.Key * Pair.Value.Num();
+		}
+		FreedBuffers = MoveTemp(IdleBuffers);
+		IdleBuffers.Reset();
+		Stats.BuffersIdle = 0;
+		Remaining = Stats;
+	}
+
+	UE_LOG(LogCaptureResourcePool, Log, TEXT("Trimmed idle resources (%.1f MB GPU, %.1f MB CPU still pooled)"),
+		Remaining.RenderTargetBytes / (1024.0 * 1024.0), Remaining.BufferBytes / (1024.0 * 1024.0));
+}
+
+void FCaptureResourcePool::SetMaxIdlePerKey(int32 InMaxIdlePerKey)
+{
+	FScopeLock Lock(&BufferLock);
+	MaxIdlePerKey = FMath::Max(0, InMaxIdlePerKey);
+}
+
+FCaptureResourcePoolStats FCaptureResourcePool::GetStats() const
+{
+	FScopeLock Lock(&BufferLock);
+	return Stats;
+}
+
+FString FCaptureResourcePool::GetStatsJson() const
+{
+	const FCaptureResourcePoolStats Snapshot = GetStats();
+
+	TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+	RootObject->SetNumberField("render_targets_in_use", Snapshot.RenderTargetsInUse);
+	RootObject->SetNumberField("render_targets_idle", Snapshot.RenderTargetsIdle);
+	RootObject->SetNumberField("buffers_in_use", Snapshot.BuffersInUse);
+	RootObject->SetNumberField("buffers_idle", Snapshot.BuffersIdle);
+	RootObject->SetNumberField("render_target_bytes", (double)Snapshot.RenderTargetBytes);
+	RootObject->SetNumberField("buffer_bytes", (double)Snapshot.BufferBytes);
+	RootObject->SetNumberField("high_water_render_target_bytes", (double)Snapshot.HighWaterRenderTargetBytes);
+	RootObject->SetNumberField("high_water_buffer_bytes", (double)Snapshot.HighWaterBufferBytes);
+	RootObject->SetNumberField("render_target_allocations", (double)Snapshot.RenderTargetAllocations);
+	RootObject->SetNumberField("render_target_reuses", (double)Snapshot.RenderTargetReuses);
+	RootObject->SetNumberField("buffer_allocations", (double)Snapshot.BufferAllocations);
+	RootObject->SetNumberField("buffer_reuses", (double)Snapshot.BufferReuses);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+	return OutputString;
+}
+
+void FCaptureResourcePool::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(InUseTargets);
+	for (TPair<FRenderTargetKey, TArray<TObjectPtr<UTextureRenderTarget2D>>>& Pair : IdleTargets)
+	{
+		Collector.AddReferencedObjects(Pair.Value);
+	}
+}
+
+FCaptureResourcePool::FRenderTargetKey FCaptureResourcePool::MakeKey(const UTextureRenderTarget2D* Target)
+{
+	return FRenderTargetKey{Target->SizeX, Target->SizeY, Target->RenderTargetFormat};
+}
+
+int64 FCaptureResourcePool::GetRenderTargetBytes(const FRenderTargetKey& Key)
+{
+	const EPixelFormat PixelFormat = GetPixelFormatFromRenderTargetFormat(Key.Format);
+	return (int64)Key.Width * Key.Height * GPixelFormats[PixelFormat].BlockBytes;
+}
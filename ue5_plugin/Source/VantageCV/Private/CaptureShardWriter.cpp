@@ -0,0 +1,350 @@
+/******************************************************************************
+ * VantageCV - Capture Shard Writer Implementation
+ ******************************************************************************
+ * File: CaptureShardWriter.cpp
+ * Description: ustar member writer, shard rollover and sidecar index
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureShardWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/DateTime.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCaptureShard, Log, All);
+
+const TCHAR* FCaptureShardWriter::PathPrefix = TEXT("shard://");
+FCaptureShardWriter* FCaptureShardWriter::Instance = nullptr;
+
+namespace
+{
+	constexpr int64 TarBlockBytes = 512;
+
+	/** Zero padding source for member data and the end-of-archive blocks */
+	const uint8 ZeroBlock[TarBlockBytes] = {};
+
+	int64 TarMemberBytes(int64 NumBytes)
+	{
+		return TarBlockBytes + Align(NumBytes, TarBlockBytes);
+	}
+
+	/** Width - 1 zero-padded octal digits followed by NUL */
+	void WriteOctal(uint8* Field, int32 Width, uint64 Value)
+	{
+		Field[Width - 1] = 0;
+		for (int32 Index = Width - 2; Index >= 0; --Index)
+		{
+			Field[Index] = (uint8)('0' + (Value & 7));
+			Value >>= 3;
+		}
+	}
+
+	void BuildTarHeader(const ANSICHAR* Name, int32 NameBytes, int64 Size, int64 ModifiedTime, uint8 (&Header)[TarBlockBytes])
+	{
+		FMemory::Memzero(Header);
+		FMemory::Memcpy(Header, Name, NameBytes);
+		WriteOctal(Header + 100, 8, 0644);				// mode
+		WriteOctal(Header + 108, 8, 0);					// uid
+		WriteOctal(Header + 116, 8, 0);					// gid
+		WriteOctal(Header + 124, 12, (uint64)Size);
+		WriteOctal(Header + 136, 12, (uint64)ModifiedTime);
+		Header[156] = '0';								// regular file
+		FMemory::Memcpy(Header + 257, "ustar", 6);		// magic + NUL
+		Header[263] = '0';								// version "00"
+		Header[264] = '0';
+		FMemory::Memcpy(Header + 265, "vantagecv", 9);	// uname
+		FMemory::Memcpy(Header + 297, "vantagecv", 9);	// gname
+
+		// Checksum is computed with its own field set to spaces, stored as 6 digits, NUL, space
+		FMemory::Memset(Header + 148, ' ', 8);
+		uint32 Checksum = 0;
+		for (uint8 Byte : Header)
+		{
+			Checksum += Byte;
+		}
+		WriteOctal(Header + 148, 7, Checksum);
+	}
+}
+
+FCaptureShardWriter& FCaptureShardWriter::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FCaptureShardWriter();
+	}
+	return *Instance;
+}
+
+void FCaptureShardWriter::Shutdown()
+{
+	if (Instance)
+	{
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+FCaptureShardWriter::~FCaptureShardWriter()
+{
+	Close();
+}
+
+bool FCaptureShardWriter::Open(const FString& InDirectory, const FString& InPrefix, int64 InMaxShardBytes)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (bOpen)
+	{
+		CloseShard_Locked();
+		bOpen = false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.DirectoryExists(*InDirectory) && !PlatformFile.CreateDirectoryTree(*InDirectory))
+	{
+		UE_LOG(LogCaptureShard, Error, TEXT("Cannot create shard directory: %s"), *InDirectory);
+		return false;
+	}
+
+	Directory = InDirectory;
+	Prefix = InPrefix.IsEmpty() ? FString(TEXT("shard")) : InPrefix;
+	MaxShardBytes = FMath::Max<int64>(InMaxShardBytes, 16 * TarBlockBytes);
+	NumShards = 0;
+	NumSamples = 0;
+	NumMembers = 0;
+	TotalBytes = 0;
+	NumFailed = 0;
+
+	if (!OpenShard_Locked())
+	{
+		return false;
+	}
+
+	bOpen = true;
+	UE_LOG(LogCaptureShard, Log, TEXT("Shard set opened: %s/%s-*.tar (max %lld MB per shard)"),
+		*Directory, *Prefix, MaxShardBytes / (1024 * 1024));
+	return true;
+}
+
+int32 FCaptureShardWriter::Close()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bOpen)
+	{
+		return 0;
+	}
+
+	CloseShard_Locked();
+	bOpen = false;
+
+	UE_LOG(LogCaptureShard, Log, TEXT("Shard set closed: %d shards, %lld samples, %lld bytes, %lld failed"),
+		NumShards, NumSamples, TotalBytes, NumFailed);
+	return NumShards;
+}
+
+bool FCaptureShardWriter::IsOpen() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return bOpen;
+}
+
+bool FCaptureShardWriter::OpenShard_Locked()
+{
+	CurrentShardPath = Directory / FString::Printf(TEXT("%s-%06d.tar"), *Prefix, NumShards);
+	ShardArchive.Reset(IFileManager::Get().CreateFileWriter(*CurrentShardPath));
+	IndexArchive.Reset(IFileManager::Get().CreateFileWriter(*FPaths::ChangeExtension(CurrentShardPath, TEXT("idx"))));
+	if (!ShardArchive || !IndexArchive)
+	{
+		UE_LOG(LogCaptureShard, Error, TEXT("Cannot open shard for writing: %s"), *CurrentShardPath);
+		ShardArchive.Reset();
+		IndexArchive.Reset();
+		return false;
+	}
+
+	FCaptureShardIndexHeader Header;
+	Header.EntryBytes = sizeof(FCaptureShardIndexEntry);
+	IndexArchive->Serialize(&Header, sizeof(Header));
+
+	CurrentShardBytes = 0;
+	CurrentShardSamples = 0;
+	++NumShards;
+	return true;
+}
+
+void FCaptureShardWriter::CloseShard_Locked()
+{
+	if (ShardArchive)
+	{
+		// End of archive: two zero blocks
+		ShardArchive->Serialize(const_cast<uint8*>(ZeroBlock), TarBlockBytes);
+		ShardArchive->Serialize(const_cast<uint8*>(ZeroBlock), TarBlockBytes);
+		ShardArchive->Close();
+		ShardArchive.Reset();
+
+		UE_LOG(LogCaptureShard, Log, TEXT("Shard finished: %s (%u samples, %lld bytes)"),
+			*CurrentShardPath, CurrentShardSamples, CurrentShardBytes + 2 * TarBlockBytes);
+	}
+	if (IndexArchive)
+	{
+		IndexArchive->Close();
+		IndexArchive.Reset();
+	}
+}
+
+bool FCaptureShardWriter::WriteMember_Locked(const FString& Name, const uint8* Data, int64 NumBytes)
+{
+	const FTCHARToUTF8 Utf8Name(*Name);
+	if (Utf8Name.Length() > FCaptureShardIndexEntry::MaxNameBytes)
+	{
+		UE_LOG(LogCaptureShard, Error, TEXT("Shard member name longer than %d bytes: %s"), FCaptureShardIndexEntry::MaxNameBytes, *Name);
+		return false;
+	}
+
+	uint8 Header[TarBlockBytes];
+	BuildTarHeader(Utf8Name.Get(), Utf8Name.Length(), NumBytes, FDateTime::UtcNow().ToUnixTimestamp(), Header);
+	ShardArchive->Serialize(Header, TarBlockBytes);
+	ShardArchive->Serialize(const_cast<uint8*>(Data), NumBytes);
+	const int64 Padding = Align(NumBytes, TarBlockBytes) - NumBytes;
+	if (Padding > 0)
+	{
+		ShardArchive->Serialize(const_cast<uint8*>(ZeroBlock), Padding);
+	}
+
+	FCaptureShardIndexEntry Entry;
+	Entry.DataOffset = CurrentShardBytes + TarBlockBytes;
+	Entry.DataBytes = NumBytes;
+	Entry.SampleIndex = CurrentShardSamples;
+	FMemory::Memcpy(Entry.Name, Utf8Name.Get(), Utf8Name.Length());
+	IndexArchive->Serialize(&Entry, sizeof(Entry));
+
+	const int64 MemberBytes = TarMemberBytes(NumBytes);
+	CurrentShardBytes += MemberBytes;
+	TotalBytes += MemberBytes;
+	++NumMembers;
+	return !ShardArchive->IsError() && !IndexArchive->IsError();
+}
+
+void FCaptureShardWriter::WriteTombstone_Locked()
+{
+	if (!IndexArchive)
+	{
+		return;
+	}
+
+	FCaptureShardIndexEntry Entry;
+	Entry.DataOffset = CurrentShardBytes;
+	Entry.SampleIndex = CurrentShardSamples;
+	Entry.Flags = FCaptureShardIndexEntry::TombstoneFlag;
+	IndexArchive->Serialize(&Entry, sizeof(Entry));
+}
+
+bool FCaptureShardWriter::AppendSample(const FString& Key, const TArray<FCaptureShardMember>& Members)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bOpen)
+	{
+		UE_LOG(LogCaptureShard, Error, TEXT("AppendSample(%s): no shard set open - call StartShardWriter first"), *Key);
+		++NumFailed;
+		return false;
+	}
+
+	// Whole samples only: roll over before a sample that would not fit (plus the end blocks)
+	int64 SampleBytes = 0;
+	for (const FCaptureShardMember& Member : Members)
+	{
+		SampleBytes += TarMemberBytes(Member.NumBytes);
+	}
+	if (!ShardArchive || (CurrentShardBytes > 0 && CurrentShardBytes + SampleBytes + 2 * TarBlockBytes > MaxShardBytes))
+	{
+		CloseShard_Locked();
+		if (!OpenShard_Locked())
+		{
+			++NumFailed;
+			return false;
+		}
+	}
+
+	// Reject bad names before anything reaches the tar
+	for (const FCaptureShardMember& Member : Members)
+	{
+		const FString Name = Key + TEXT(".") + Member.Extension;
+		if (FTCHARToUTF8(*Name).Length() > FCaptureShardIndexEntry::MaxNameBytes)
+		{
+			UE_LOG(LogCaptureShard, Error, TEXT("Shard member name longer than %d bytes: %s"), FCaptureShardIndexEntry::MaxNameBytes, *Name);
+			++NumFailed;
+			return false;
+		}
+	}
+
+	for (int32 MemberIndex = 0; MemberIndex < Members.Num(); ++MemberIndex)
+	{
+		const FCaptureShardMember& Member = Members[MemberIndex];
+		if (!WriteMember_Locked(Key + TEXT(".") + Member.Extension, Member.Data, Member.NumBytes))
+		{
+			UE_LOG(LogCaptureShard, Error, TEXT("Failed writing %s.%s to %s"), *Key, *Member.Extension, *CurrentShardPath);
+			++NumFailed;
+
+			// The written members stay in the tar; the tombstone retires their sample index and the
+			// sample after this one starts a fresh shard rather than appending to a failing file
+			WriteTombstone_Locked();
+			++CurrentShardSamples;
+			CloseShard_Locked();
+			return false;
+		}
+	}
+
+	++CurrentShardSamples;
+	++NumSamples;
+	return true;
+}
+
+bool FCaptureShardWriter::AppendCapture(const FString& OutputPath, const TArray64<uint8>& ImageData, const TArray<uint8>& Annotations)
+{
+	FString Name = OutputPath.RightChop(FCString::Strlen(PathPrefix));
+	Name.ReplaceInline(TEXT("\\"), TEXT("/"));
+
+	const FString Key = FPaths::GetBaseFilename(Name, false);
+	FString Extension = FPaths::GetExtension(Name);
+	if (Key.IsEmpty())
+	{
+		UE_LOG(LogCaptureShard, Error, TEXT("Shard path without a sample key: %s"), *OutputPath);
+		return false;
+	}
+	if (Extension.IsEmpty())
+	{
+		Extension = TEXT("bin");
+	}
+
+	TArray<FCaptureShardMember> Members;
+	Members.Add({ Extension, ImageData.GetData(), ImageData.Num() });
+	if (Annotations.Num() > 0)
+	{
+		Members.Add({ TEXT("ann"), Annotations.GetData(), Annotations.Num() });
+	}
+	return AppendSample(Key, Members);
+}
+
+FString FCaptureShardWriter::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject);
+	{
+		FScopeLock ScopeLock(&Lock);
+		Root->SetBoolField(TEXT("open"), bOpen);
+		Root->SetStringField(TEXT("current_shard"), bOpen ? CurrentShardPath : FString());
+		Root->SetNumberField(TEXT("num_shards"), NumShards);
+		Root->SetNumberField(TEXT("num_samples"), (double)NumSamples);
+		Root->SetNumberField(TEXT("num_members"), (double)NumMembers);
+		Root->SetNumberField(TEXT("total_bytes"), (double)TotalBytes);
+		Root->SetNumberField(TEXT("num_failed"), (double)NumFailed);
+		Root->SetNumberField(TEXT("max_shard_bytes"), (double)MaxShardBytes);
+	}
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+	return Output;
+}
@@ -0,0 +1,358 @@
+/******************************************************************************
+ * VantageCV - Capture Stream Sink Implementation
+ ******************************************************************************
+ * File: CaptureStreamSink.cpp
+ * Description: Listen socket, bounded frame queue and sender thread for the
+ *              binary capture stream
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureStreamSink.h"
+#include "CaptureResourcePool.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCaptureStream, Log, All);
+
+const TCHAR* FCaptureStreamSink::PathPrefix = TEXT("stream://");
+FCaptureStreamSink* FCaptureStreamSink::Instance = nullptr;
+
+namespace
+{
+	template <typename T>
+	void AppendPod(TArray<uint8>& Out, const T& Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+}
+
+FCaptureStreamSink& FCaptureStreamSink::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FCaptureStreamSink();
+	}
+	return *Instance;
+}
+
+void FCaptureStreamSink::Shutdown()
+{
+	if (Instance)
+	{
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+FCaptureStreamSink::FCaptureStreamSink()
+{
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	SpaceEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FCaptureStreamSink::~FCaptureStreamSink()
+{
+	StopStreaming();
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	FPlatformProcess::ReturnSynchEventToPool(SpaceEvent);
+}
+
+bool FCaptureStreamSink::Start(int32 Port, int32 InMaxQueuedFrames)
+{
+	if (bRunning.load() && ListenPort == Port)
+	{
+		return true;
+	}
+	StopStreaming();
+
+	MaxQueuedFrames = FMath::Max(1, InMaxQueuedFrames);
+
+	ListenSocket = FTcpSocketBuilder(TEXT("VantageCVCaptureStream"))
+		.AsReusable()
+		.AsNonBlocking()
+		.BoundToAddress(FIPv4Address::Any)
+		.BoundToPort(Port)
+		.Listening(1);
+
+	if (!ListenSocket)
+	{
+		UE_LOG(LogCaptureStream, Error, TEXT("Failed to listen on port %d"), Port);
+		return false;
+	}
+
+	ListenPort = Port;
+	bStopRequested = false;
+	bRunning = true;
+	Thread = FRunnableThread::Create(this, TEXT("VantageCVCaptureStream"), 0, TPri_Normal);
+
+	UE_LOG(LogCaptureStream, Log, TEXT("Capture stream listening on port %d (max %d queued frames)"), Port, MaxQueuedFrames);
+	return true;
+}
+
+void FCaptureStreamSink::StopStreaming()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	CloseClient();
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+	}
+
+	{
+		FScopeLock Lock(&QueueLock);
+		FramesDropped += Queue.Num();
+		Queue.Reset();
+	}
+
+	if (bRunning.exchange(false))
+	{
+		UE_LOG(LogCaptureStream, Log, TEXT("Capture stream stopped (%lld sent, %lld dropped, %lld of them with no client)"),
+			FramesSent.load(), FramesDropped.load(), FramesDroppedNoClient.load());
+	}
+	ListenPort = 0;
+}
+
+void FCaptureStreamSink::Stop()
+{
+	bStopRequested = true;
+	WorkEvent->Trigger();
+}
+
+bool FCaptureStreamSink::Publish(FCapturedImage&& Image, int32 Ticket, const FString& OutputPath, TArray<uint8>&& Annotations)
+{
+	auto DropFrame = [this, &Image]()
+	{
+		FramesDropped++;
+		if (FCaptureResourcePool::IsAvailable())
+		{
+			FCaptureResourcePool::Get().ReleaseBuffer(MoveTemp(Image.Data));
+		}
+		return false;
+	};
+
+	if (!bRunning.load() || !bClientConnected.load() || !Image.IsValid())
+	{
+		// Expected while waiting for a consumer; counted, not reported as an error
+		if (bRunning.load() && !bClientConnected.load())
+		{
+			FramesDroppedNoClient++;
+		}
+		UE_LOG(LogCaptureStream, Verbose, TEXT("Dropping %s: %s"), *OutputPath,
+			!bRunning.load() ? TEXT("stream not running") : !bClientConnected.load() ? TEXT("no client") : TEXT("invalid image"));
+		return DropFrame();
+	}
+
+	// Back-pressure with a bounded wait so a stalled consumer cannot freeze capture
+	const double Deadline = FPlatformTime::Seconds() + MaxPublishWaitSeconds;
+	for (;;)
+	{
+		{
+			FScopeLock Lock(&QueueLock);
+			if (Queue.Num() < MaxQueuedFrames)
+			{
+				break;
+			}
+		}
+		if (FPlatformTime::Seconds() >= Deadline || !bClientConnected.load())
+		{
+			UE_LOG(LogCaptureStream, Warning, TEXT("Stream queue full - dropping %s"), *OutputPath);
+			return DropFrame();
+		}
+		SpaceEvent->Wait(5);
+	}
+
+	TUniquePtr<FStreamFrame> Frame = MakeUnique<FStreamFrame>();
+
+	const FString Name = OutputPath.RightChop(FCString::Strlen(PathPrefix));
+	FTCHARToUTF8 NameUtf8(*Name);
+	Frame->Name.Append(reinterpret_cast<const uint8*>(NameUtf8.Get()), FMath::Min(NameUtf8.Length(), (int32)MAX_uint16));
+
+	Frame->Header.Ticket = Ticket;
+	Frame->Header.Width = Image.Width;
+	Frame->Header.Height = Image.Height;
+	Frame->Header.PixelLayout = (uint8)Image.Layout;
+	Frame->Header.NameBytes = (uint16)Frame->Name.Num();
+	Frame->Header.ImageBytes = (uint64)Image.Data.Num();
+	Frame->Header.AnnotationBytes = (uint32)Annotations.Num();
+	Frame->Image = MoveTemp(Image);
+	Frame->Annotations = MoveTemp(Annotations);
+
+	{
+		FScopeLock Lock(&QueueLock);
+		Frame->Header.Sequence = NextSequence++;
+		Queue.Add(MoveTemp(Frame));
+	}
+	WorkEvent->Trigger();
+	return true;
+}
+
+void FCaptureStreamSink::Flush()
+{
+	for (;;)
+	{
+		{
+			FScopeLock Lock(&QueueLock);
+			if ((Queue.Num() == 0 && !bSending.load()) || !bClientConnected.load())
+			{
+				return;
+			}
+		}
+		SpaceEvent->Wait(5);
+	}
+}
+
+TArray<uint8> FCaptureStreamSink::PackAnnotations(const TArray<FCaptureStreamObject>& Objects)
+{
+	TArray<uint8> Out;
+	Out.Reserve(4 + Objects.Num() * 64);
+
+	AppendPod(Out, (uint32)Objects.Num());
+	for (const FCaptureStreamObject& Object : Objects)
+	{
+		AppendPod(Out, Object.InstanceId);
+		AppendPod(Out, Object.BBoxMin.X);
+		AppendPod(Out, Object.BBoxMin.Y);
+		AppendPod(Out, Object.BBoxMax.X);
+		AppendPod(Out, Object.BBoxMax.Y);
+		AppendPod(Out, Object.Location.X);
+		AppendPod(Out, Object.Location.Y);
+		AppendPod(Out, Object.Location.Z);
+		AppendPod(Out, Object.Rotation.X);
+		AppendPod(Out, Object.Rotation.Y);
+		AppendPod(Out, Object.Rotation.Z);
+
+		FTCHARToUTF8 ClassUtf8(*Object.ClassName);
+		const uint16 ClassBytes = (uint16)FMath::Min(ClassUtf8.Length(), (int32)MAX_uint16);
+		AppendPod(Out, ClassBytes);
+		Out.Append(reinterpret_cast<const uint8*>(ClassUtf8.Get()), ClassBytes);
+	}
+	return Out;
+}
+
+uint32 FCaptureStreamSink::Run()
+{
+	while (!bStopRequested.load())
+	{
+		if (!ClientSocket)
+		{
+			AcceptClient();
+			if (!ClientSocket)
+			{
+				FPlatformProcess::Sleep(0.05f);
+				continue;
+			}
+		}
+
+		TUniquePtr<FStreamFrame> Frame;
+		{
+			FScopeLock Lock(&QueueLock);
+			if (Queue.Num() > 0)
+			{
+				Frame = MoveTemp(Queue[0]);
+				Queue.RemoveAt(0, 1, EAllowShrinking::No);
+				bSending = true;
+			}
+		}
+
+		if (!Frame)
+		{
+			WorkEvent->Wait(50);
+			continue;
+		}
+		SpaceEvent->Trigger();
+
+		const bool bSent =
+			SendAll(reinterpret_cast<const uint8*>(&Frame->Header), sizeof(FCaptureStreamHeader)) &&
+			SendAll(Frame->Name.GetData(), Frame->Name.Num()) &&
+			SendAll(Frame->Image.Data.GetData(), Frame->Image.Data.Num()) &&
+			SendAll(Frame->Annotations.GetData(), Frame->Annotations.Num());
+
+		(bSent ? FramesSent : FramesDropped)++;
+
+		if (FCaptureResourcePool::IsAvailable())
+		{
+			FCaptureResourcePool::Get().ReleaseBuffer(MoveTemp(Frame->Image.Data));
+		}
+		bSending = false;
+		SpaceEvent->Trigger();
+	}
+
+	return 0;
+}
+
+void FCaptureStreamSink::AcceptClient()
+{
+	if (!ListenSocket)
+	{
+		return;
+	}
+
+	bool bPending = false;
+	if (!ListenSocket->WaitForPendingConnection(bPending, FTimespan::FromMilliseconds(100)) || !bPending)
+	{
+		return;
+	}
+
+	ClientSocket = ListenSocket->Accept(TEXT("VantageCVCaptureStreamClient"));
+	if (ClientSocket)
+	{
+		ClientSocket->SetNonBlocking(false);
+		ClientSocket->SetNoDelay(true);
+
+		int32 ActualSize = 0;
+		ClientSocket->SetSendBufferSize(8 * 1024 * 1024, ActualSize);
+
+		bClientConnected = true;
+		UE_LOG(LogCaptureStream, Log, TEXT("Capture stream client connected (send buffer %d bytes)"), ActualSize);
+	}
+}
+
+bool FCaptureStreamSink::SendAll(const uint8* Data, int64 NumBytes)
+{
+	while (NumBytes > 0)
+	{
+		if (!ClientSocket || bStopRequested.load())
+		{
+			return false;
+		}
+
+		const int32 Chunk = (int32)FMath::Min<int64>(NumBytes, 1 << 20);
+		int32 BytesSent = 0;
+		if (!ClientSocket->Send(Data, Chunk, BytesSent) || BytesSent <= 0)
+		{
+			UE_LOG(LogCaptureStream, Warning, TEXT("Capture stream client disconnected"));
+			CloseClient();
+			return false;
+		}
+
+		Data += BytesSent;
+		NumBytes -= BytesSent;
+	}
+	return true;
+}
+
+void FCaptureStreamSink::CloseClient()
+{
+	if (ClientSocket)
+	{
+		ClientSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ClientSocket);
+		ClientSocket = nullptr;
+	}
+	bClientConnected = false;
+	SpaceEvent->Trigger();
+}
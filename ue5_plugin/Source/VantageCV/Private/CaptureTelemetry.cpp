@@ -0,0 +1,146 @@
+/******************************************************************************
+ * VantageCV - Capture Telemetry Implementation
+ ******************************************************************************
+ * File: CaptureTelemetry.cpp
+ * Description: Stat definitions and rolling percentile windows
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureTelemetry.h"
+#include "Misc/ScopeLock.h"
+#include "Json.h"
+
+DEFINE_STAT(STAT_VantageCV_SceneApply);
+DEFINE_STAT(STAT_VantageCV_Spawn);
+DEFINE_STAT(STAT_VantageCV_Streaming);
+DEFINE_STAT(STAT_VantageCV_RenderSubmit);
+DEFINE_STAT(STAT_VantageCV_Readback);
+DEFINE_STAT(STAT_VantageCV_Encode);
+DEFINE_STAT(STAT_VantageCV_Write);
+DEFINE_STAT(STAT_VantageCV_Annotation);
+DEFINE_STAT(STAT_VantageCV_GPULatency);
+
+namespace
+{
+	/** Nearest-rank percentile of an ascending array */
+	float Percentile(const TArray<float>& Sorted, float Fraction)
+	{
+		const int32 Rank = FMath::CeilToInt(Fraction * Sorted.Num());
+		return Sorted[FMath::Clamp(Rank - 1, 0, Sorted.Num() - 1)];
+	}
+}
+
+FCaptureTelemetry& FCaptureTelemetry::Get()
+{
+	static FCaptureTelemetry Instance;
+	return Instance;
+}
+
+const TCHAR* FCaptureTelemetry::GetStageName(ECaptureStage Stage)
+{
+	switch (Stage)
+	{
+	case ECaptureStage::SceneApply:		return TEXT("SceneApply");
+	case ECaptureStage::Spawn:			return TEXT("Spawn");
+	case ECaptureStage::Streaming:		return TEXT("Streaming");
+	case ECaptureStage::RenderSubmit:	return TEXT("RenderSubmit");
+	case ECaptureStage::GPU:			return TEXT("GPU");
+	case ECaptureStage::Readback:		return TEXT("Readback");
+	case ECaptureStage::Encode:			return TEXT("Encode");
+	case ECaptureStage::Write:			return TEXT("Write");
+	case ECaptureStage::Annotation:		return TEXT("Annotation");
+	default:							return TEXT("Unknown");
+	}
+}
+
+void FCaptureTelemetry::Record(ECaptureStage Stage, double Milliseconds)
+{
+	if (Stage >= ECaptureStage::Num)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	FStageWindow& Window = Windows[(int32)Stage];
+	if (Window.Samples.Num() < WindowSize)
+	{
+		Window.Samples.Add((float)Milliseconds);
+	}
+	else
+	{
+		Window.Samples[Window.NextIndex] = (float)Milliseconds;
+		Window.NextIndex = (Window.NextIndex + 1) % WindowSize;
+	}
+	++Window.TotalCount;
+	Window.TotalMs += Milliseconds;
+}
+
+FString FCaptureTelemetry::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject);
+	TSharedPtr<FJsonObject> StagesObject = MakeShareable(new FJsonObject);
+
+	int32 CurrentWindowSize = 0;
+	{
+		FScopeLock ScopeLock(&Lock);
+		CurrentWindowSize = WindowSize;
+
+		TArray<float> Sorted;
+		for (int32 StageIndex = 0; StageIndex < (int32)ECaptureStage::Num; ++StageIndex)
+		{
+			const FStageWindow& Window = Windows[StageIndex];
+			TSharedPtr<FJsonObject> StageObject = MakeShareable(new FJsonObject);
+			StageObject->SetNumberField(TEXT("count"), Window.Samples.Num());
+			StageObject->SetNumberField(TEXT("total_count"), (double)Window.TotalCount);
+			StageObject->SetNumberField(TEXT("total_ms"), Window.TotalMs);
+
+			if (Window.Samples.Num() > 0)
+			{
+				Sorted = Window.Samples;
+				Sorted.Sort();
+
+				double SumMs = 0.0;
+				for (float Sample : Sorted)
+				{
+					SumMs += Sample;
+				}
+				StageObject->SetNumberField(TEXT("mean_ms"), SumMs / Sorted.Num());
+				StageObject->SetNumberField(TEXT("p50_ms"), Percentile(Sorted, 0.50f));
+				StageObject->SetNumberField(TEXT("p95_ms"), Percentile(Sorted, 0.95f));
+				StageObject->SetNumberField(TEXT("p99_ms"), Percentile(Sorted, 0.99f));
+				StageObject->SetNumberField(TEXT("max_ms"), Sorted.Last());
+			}
+
+			StagesObject->SetObjectField(GetStageName((ECaptureStage)StageIndex), StageObject);
+		}
+	}
+
+	Root->SetNumberField(TEXT("window_size"), CurrentWindowSize);
+	Root->SetObjectField(TEXT("stages"), StagesObject);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+	return Output;
+}
+
+void FCaptureTelemetry::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	for (FStageWindow& Window : Windows)
+	{
+		Window = FStageWindow();
+	}
+}
+
+void FCaptureTelemetry::SetWindowSize(int32 InWindowSize)
+{
+	FScopeLock ScopeLock(&Lock);
+	WindowSize = FMath::Max(1, InWindowSize);
+	for (FStageWindow& Window : Windows)
+	{
+		Window.Samples.Reset();
+		Window.NextIndex = 0;
+	}
+}
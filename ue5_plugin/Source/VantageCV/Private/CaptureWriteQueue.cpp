@@ -0,0 +1,302 @@
+/******************************************************************************
+ * VantageCV - Capture Encode/Write Queue Implementation
+ ******************************************************************************
+ * File: CaptureWriteQueue.cpp
+ * Description: FQueuedThreadPool-backed image encoder and file writer with
+ *              bounded back-pressure
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "CaptureWriteQueue.h"
+#include "CaptureAOV.h"
+#include "CaptureResourcePool.h"
+#include "CaptureShardWriter.h"
+#include "CaptureTelemetry.h"
+#include "IImageWrapperModule.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Event.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCaptureWriteQueue, Log, All);
+
+FCaptureWriteQueue* FCaptureWriteQueue::Instance = nullptr;
+
+/**
+ * One encode + write job. Owns its pixel buffer and deletes itself when done.
+ */
+class FCaptureWriteJob : public IQueuedWork
+{
+public:
+	FCaptureWriteJob(FCaptureWriteQueue& InQueue, FCapturedImage&& InImage, FCaptureWriteQueue::FWriteFunction&& InWrite)
+		: Queue(InQueue)
+		, Image(MoveTemp(InImage))
+		, Write(MoveTemp(InWrite))
+	{
+	}
+
+	virtual void DoThreadedWork() override
+	{
+		const bool bSuccess = Write(Image);
+
+		// Pixel buffer goes back to the pool for the next capture at this size
+		if (FCaptureResourcePool::IsAvailable())
+		{
+			FCaptureResourcePool::Get().ReleaseBuffer(MoveTemp(Image.Data));
+		}
+		Queue.OnJobFinished(bSuccess);
+		delete this;
+	}
+
+	virtual void Abandon() override
+	{
+		// Pool is going away with work still queued - write inline rather than lose the frame
+		DoThreadedWork();
+	}
+
+private:
+	FCaptureWriteQueue& Queue;
+	FCapturedImage Image;
+	FCaptureWriteQueue::FWriteFunction Write;
+};
+
+FCaptureWriteQueue& FCaptureWriteQueue::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FCaptureWriteQueue();
+	}
+	Instance->Start();
+	return *Instance;
+}
+
+void FCaptureWriteQueue::Shutdown()
+{
+	if (Instance)
+	{
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+FCaptureWriteQueue::FCaptureWriteQueue()
+{
+	JobFinishedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FCaptureWriteQueue::~FCaptureWriteQueue()
+{
+	Flush();
+
+	if (ThreadPool)
+	{
+		ThreadPool->Destroy();
+		delete ThreadPool;
+		ThreadPool = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(JobFinishedEvent);
+	JobFinishedEvent = nullptr;
+
+	UE_LOG(LogCaptureWriteQueue, Log, TEXT("Write queue shut down (%lld written, %lld failed)"), TotalWritten.load(), TotalFailed.load());
+}
+
+void FCaptureWriteQueue::Start()
+{
+	// Get() calls this every time; a failed pool creation is not retried (or logged) per write
+	if (ThreadPool || bStartFailed.load())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&StartLock);
+	if (ThreadPool || bStartFailed.load())
+	{
+		return;
+	}
+
+	// LoadModuleChecked is not safe off the game thread, so resolve it once up front
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	// Leave most cores to the renderer; encoding is the only heavy work here (QOI / EXR fan out further per frame)
+	NumWorkers = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() / 4, 1, 4);
+
+	FQueuedThreadPool* NewPool = FQueuedThreadPool::Allocate();
+	if (!NewPool->Create(NumWorkers, 256 * 1024, TPri_BelowNormal, TEXT("VantageCVWriteQueue")))
+	{
+		UE_LOG(LogCaptureWriteQueue, Error, TEXT("Failed to create write queue thread pool - writes will run inline"));
+		delete NewPool;
+		NumWorkers = 0;
+		bStartFailed = true;
+		return;
+	}
+
+	ThreadPool = NewPool;
+	UE_LOG(LogCaptureWriteQueue, Log, TEXT("Write queue started with %d workers, max %d pending jobs"), NumWorkers, MaxPendingJobs.load());
+}
+
+bool FCaptureWriteQueue::Enqueue(FCapturedImage&& Image, const FString& FilePath, const FCaptureEncodeSettings& Settings,
+	TArray<uint8>&& Annotations, FOnWritten&& OnWritten)
+{
+	return EnqueueWork(MoveTemp(Image), FilePath,
+		[this, FilePath, Settings, Annotations = MoveTemp(Annotations)](const FCapturedImage& JobImage)
+		{
+			return EncodeAndWrite(JobImage, FilePath, Settings, Annotations);
+		}, MoveTemp(OnWritten));
+}
+
+bool FCaptureWriteQueue::EnqueueAOVs(FCapturedImage&& Packed, const FString& BasePath, const FCaptureAOVSelection& Selection,
+	FOnWritten&& OnWritten)
+{
+	return EnqueueWork(MoveTemp(Packed), BasePath,
+		[this, BasePath, Selection](const FCapturedImage& JobImage)
+		{
+			return ImageWrapperModule && FCaptureAOV::WriteAll(JobImage, BasePath, Selection, *ImageWrapperModule);
+		}, MoveTemp(OnWritten));
+}
+
+bool FCaptureWriteQueue::EnqueueWork(FCapturedImage&& Image, const FString& FilePath, FWriteFunction&& InWrite, FOnWritten&& OnWritten)
+{
+	if (!Image.IsValid())
+	{
+		UE_LOG(LogCaptureWriteQueue, Error, TEXT("Enqueue: invalid image for %s"), *FilePath);
+		if (FCaptureResourcePool::IsAvailable())
+		{
+			FCaptureResourcePool::Get().ReleaseBuffer(MoveTemp(Image.Data));
+		}
+		TotalFailed++;
+		if (OnWritten)
+		{
+			OnWritten(false);
+		}
+		return false;
+	}
+
+	// The completion callback rides along with the write so every path reports exactly once
+	FWriteFunction Write = OnWritten
+		? FWriteFunction([InWrite = MoveTemp(InWrite), OnWritten = MoveTemp(OnWritten)](const FCapturedImage& JobImage) mutable
+			{
+				const bool bSuccess = InWrite(JobImage);
+				OnWritten(bSuccess);
+				return bSuccess;
+			})
+		: MoveTemp(InWrite);
+
+	if (!ThreadPool)
+	{
+		const bool bSuccess = Write(Image);
+		if (FCaptureResourcePool::IsAvailable())
+		{
+			FCaptureResourcePool::Get().ReleaseBuffer(MoveTemp(Image.Data));
+		}
+		(bSuccess ? TotalWritten : TotalFailed)++;
+		WrittenSinceFlush += bSuccess ? 1 : 0;
+		return bSuccess;
+	}
+
+	// Back-pressure: never hold more than MaxPendingJobs frames in memory
+	if (NumPending.load() >= MaxPendingJobs.load())
+	{
+		const double WaitStart = FPlatformTime::Seconds();
+		while (NumPending.load() >= MaxPendingJobs.load())
+		{
+			JobFinishedEvent->Wait(10);
+		}
+		UE_LOG(LogCaptureWriteQueue, Verbose, TEXT("Write queue full - waited %.2f ms"), (FPlatformTime::Seconds() - WaitStart) * 1000.0);
+	}
+
+	NumPending++;
+	ThreadPool->AddQueuedWork(new FCaptureWriteJob(*this, MoveTemp(Image), MoveTemp(Write)));
+	return true;
+}
+
+int32 FCaptureWriteQueue::Flush()
+{
+	while (NumPending.load() > 0)
+	{
+		JobFinishedEvent->Wait(10);
+	}
+	return WrittenSinceFlush.exchange(0);
+}
+
+void FCaptureWriteQueue::SetMaxPendingJobs(int32 InMaxPendingJobs)
+{
+	MaxPendingJobs = FMath::Max(1, InMaxPendingJobs);
+	JobFinishedEvent->Trigger();
+}
+
+void FCaptureWriteQueue::OnJobFinished(bool bSuccess)
+{
+	if (bSuccess)
+	{
+		TotalWritten++;
+		WrittenSinceFlush++;
+	}
+	else
+	{
+		TotalFailed++;
+	}
+
+	NumPending--;
+	JobFinishedEvent->Trigger();
+}
+
+bool FCaptureWriteQueue::EncodeAndWrite(const FCapturedImage& Image, const FString& FilePath, const FCaptureEncodeSettings& Settings,
+	const TArray<uint8>& Annotations) const
+{
+	if (!ImageWrapperModule)
+	{
+		UE_LOG(LogCaptureWriteQueue, Error, TEXT("EncodeAndWrite: ImageWrapper module not loaded"));
+		return false;
+	}
+
+	// Files get their directory created; shard:// members go to the open shard set
+	const bool bShard = FCaptureShardWriter::IsShardPath(FilePath);
+	if (!bShard)
+	{
+		FString Directory = FPaths::GetPath(FilePath);
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		if (!PlatformFile.DirectoryExists(*Directory))
+		{
+			PlatformFile.CreateDirectoryTree(*Directory);
+		}
+	}
+
+	// Raw frames are written straight from the pixel buffer
+	TArray64<uint8> EncodedData;
+	const TArray64<uint8>* FileData = &Image.Data;
+	if (Settings.Format != ECaptureImageFormat::Raw)
+	{
+		VANTAGECV_CAPTURE_STAGE(Encode);
+		if (!FCaptureEncoder::Encode(Image, Settings, *ImageWrapperModule, EncodedData))
+		{
+			UE_LOG(LogCaptureWriteQueue, Error, TEXT("%s encoding failed for: %s"),
+				*UEnum::GetValueAsString(Settings.Format), *FilePath);
+			return false;
+		}
+		FileData = &EncodedData;
+	}
+
+	{
+		VANTAGECV_CAPTURE_STAGE(Write);
+		if (bShard)
+		{
+			if (!FCaptureShardWriter::Get().AppendCapture(FilePath, *FileData, Annotations))
+			{
+				return false;
+			}
+		}
+		else if (!FFileHelper::SaveArrayToFile(*FileData, *FilePath))
+		{
+			UE_LOG(LogCaptureWriteQueue, Error, TEXT("FFileHelper::SaveArrayToFile failed for: %s"), *FilePath);
+			return false;
+		}
+	}
+
+	UE_LOG(LogCaptureWriteQueue, Verbose, TEXT("Wrote %lld bytes to: %s"), FileData->Num(), *FilePath);
+	return true;
+}
@@ -9,6 +9,16 @@
  *****************************************************************************/
 
 #include "DataCapture.h"
+#include "CaptureWriteQueue.h"
+#include "CaptureResourcePool.h"
+#include "CaptureStreamSink.h"
+#include "CaptureShardWriter.h"
+#include "CaptureTelemetry.h"
+#include "VantageCVWorker.h"
+#include "VantageCVEventLog.h"
+#include "SegmentationStencil.h"
+#include "ActorIndexSubsystem.h"
+#include "Materials/MaterialInterface.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "ImageUtils.h"
@@ -23,9 +33,11 @@
 #include "Async/Async.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/FileHelper.h"
+#include "Misc/App.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 #include "RenderingThread.h"
+#include "ContentStreaming.h"
 #include "Engine/DirectionalLight.h"
 #include "Components/DirectionalLightComponent.h"
 #include "Engine/SkyLight.h"
@@ -33,6 +45,34 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogDataCapture, Log, All);
 
+namespace
+{
+	/** Auxiliary passes (instance mask, AOVs): only opaque geometry + custom stencil, no lighting or effects */
+	void StripCaptureShowFlags(USceneCaptureComponent2D* Component)
+	{
+		Component->bCaptureEveryFrame = false;
+		Component->bCaptureOnMovement = false;
+		Component->ShowFlags.SetLighting(false);
+		Component->ShowFlags.SetDynamicShadows(false);
+		Component->ShowFlags.SetGlobalIllumination(false);
+		Component->ShowFlags.SetAmbientOcclusion(false);
+		Component->ShowFlags.SetReflectionEnvironment(false);
+		Component->ShowFlags.SetScreenSpaceReflections(false);
+		Component->ShowFlags.SetSkyLighting(false);
+		Component->ShowFlags.SetAtmosphere(false);
+		Component->ShowFlags.SetFog(false);
+		Component->ShowFlags.SetVolumetricFog(false);
+		Component->ShowFlags.SetTranslucency(false);
+		Component->ShowFlags.SetParticles(false);
+		Component->ShowFlags.SetBloom(false);
+		Component->ShowFlags.SetMotionBlur(false);
+		Component->ShowFlags.SetTemporalAA(false);
+		Component->ShowFlags.SetAntiAliasing(false);  // No blended IDs on edges
+		Component->ShowFlags.SetEyeAdaptation(false);
+	}
+}
+
+
 ADataCapture::ADataCapture()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -48,36 +88,31 @@ ADataCapture::ADataCapture()
 		CaptureComponent->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
 		CaptureComponent->bCaptureEveryFrame = false;
 		CaptureComponent->bCaptureOnMovement = false;
-		
-		//==========================================================================
-		// MATCH VIEWPORT OUTPUT
-		//==========================================================================
-		
-		// Enable rendering features to match viewport
-		CaptureComponent->ShowFlags.SetPostProcessing(true);
-		CaptureComponent->ShowFlags.SetMotionBlur(false);
-		CaptureComponent->ShowFlags.SetBloom(false);  // Disabled - use PPV setting
-		CaptureComponent->ShowFlags.SetTemporalAA(false);  // Disabled - no temporal artifacts
-		CaptureComponent->ShowFlags.SetAmbientOcclusion(true);
-		CaptureComponent->ShowFlags.SetEyeAdaptation(false);  // CRITICAL: Disable auto-exposure here
-		CaptureComponent->ShowFlags.SetAtmosphere(true);
-		CaptureComponent->ShowFlags.SetSkyLighting(true);
-		CaptureComponent->ShowFlags.SetLighting(true);
-		CaptureComponent->ShowFlags.SetGlobalIllumination(true);
-		CaptureComponent->ShowFlags.SetTonemapper(true);
-		CaptureComponent->ShowFlags.SetColorGrading(true);
-		
-		// Use PostProcessVolume settings ONLY - no component overrides
-		CaptureComponent->PostProcessBlendWeight = 0.0f;
-		
-		// NO OVERRIDES - PostProcessVolume_1 controls all settings
+
+		// Show flags and post-process overrides come from the capture profile on the first capture
 	}
 
 	
+	// Instance mask pass: only opaque geometry + custom stencil, no lighting or effects
+	SegmentationCaptureComponent = CreateDefaultSubobject<USceneCaptureComponent2D>(TEXT("SegmentationCaptureComponent"));
+	SegmentationCaptureComponent->SetupAttachment(CaptureComponent);
+	SegmentationCaptureComponent->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
+	StripCaptureShowFlags(SegmentationCaptureComponent);
+
+	// Packed AOV pass: same stripped scene, float output; view state persists so velocity has a previous frame
+	AOVCaptureComponent = CreateDefaultSubobject<USceneCaptureComponent2D>(TEXT("AOVCaptureComponent"));
+	AOVCaptureComponent->SetupAttachment(CaptureComponent);
+	AOVCaptureComponent->CaptureSource = ESceneCaptureSource::SCS_FinalColorHDR;
+	AOVCaptureComponent->bAlwaysPersistRenderingState = true;
+	StripCaptureShowFlags(AOVCaptureComponent);
+
 	// Initialize scene center to zero (will be set in BeginPlay)
 	SceneCenter = FVector::ZeroVector;
 	InitialFOV = 90.0f;
 	ExposureBiasOverride = 0.0f;  // Neutral by default - Python sets per time-of-day state
+	ReadbackRingSize = 3;
+
+	ReadbackRing.OnComplete.BindUObject(this, &ADataCapture::HandleReadbackComplete);
 }
 
 void ADataCapture::BeginPlay()
@@ -96,14 +131,55 @@ void ADataCapture::BeginPlay()
 	
 	// Initialize default render targets
 	SetResolution(1920, 1080);
+
+	// Stencil values are only written with r.CustomDepth=3
+	FSegmentationStencil::EnsureStencilEnabled();
+	ConfigureSegmentationComponent();
 	
 	UE_LOG(LogDataCapture, Log, TEXT("DataCapture initialized - Scene Center: %s, FOV: %.1f"), 
 		*SceneCenter.ToString(), InitialFOV);
 }
 
+void ADataCapture::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Writes what was captured and gives the engine its timestep back
+	if (IsSequenceRunning())
+	{
+		FinishSequence();
+	}
+
+	// Don't drop frames that are still on the GPU
+	const int32 Flushed = ReadbackRing.Flush();
+	if (Flushed > 0)
+	{
+		UE_LOG(LogDataCapture, Log, TEXT("EndPlay flushed %d pending captures"), Flushed);
+	}
+
+	// Hand render targets back to the shared pool
+	if (CaptureComponent)
+	{
+		CaptureComponent->TextureTarget = nullptr;
+	}
+	FCaptureResourcePool& Pool = FCaptureResourcePool::Get();
+	Pool.ReleaseRenderTarget(RenderTarget);
+	Pool.ReleaseRenderTarget(SegmentationTarget);
+	RenderTarget = nullptr;
+	SegmentationTarget = nullptr;
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ADataCapture::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	// Deliver finished readbacks and poll the ones still on the GPU
+	ReadbackRing.Tick();
+
+	if (IsSequenceRunning())
+	{
+		TickSequence();
+	}
 }
 
 void ADataCapture::SetResolution(int32 Width, int32 Height)
@@ -115,21 +191,11 @@ void ADataCapture::SetResolution(int32 Width, int32 Height)
 		return;
 	}
 
-	// Create RGB render target - use linear format (SCS_FinalColorLDR is already gamma-corrected)
-	RenderTarget = NewObject<UTextureRenderTarget2D>(this);
-	RenderTarget->RenderTargetFormat = RTF_RGBA8;  // Linear format for deterministic output
-	RenderTarget->ClearColor = FLinearColor::Black;
-	RenderTarget->bAutoGenerateMips = false;
-	RenderTarget->InitAutoFormat(Width, Height);
-	RenderTarget->UpdateResourceImmediate(true);
-
-	// Create segmentation render target
-	SegmentationTarget = NewObject<UTextureRenderTarget2D>(this);
-	SegmentationTarget->RenderTargetFormat = RTF_RGBA8;
-	SegmentationTarget->ClearColor = FLinearColor::Black;
-	SegmentationTarget->bAutoGenerateMips = false;
-	SegmentationTarget->InitAutoFormat(Width, Height);
-	SegmentationTarget->UpdateResourceImmediate(true);
+	// RGB render target - use linear format (SCS_FinalColorLDR is already gamma-corrected)
+	// Targets come from the shared pool, so toggling between resolutions reuses GPU resources
+	FCaptureResourcePool& Pool = FCaptureResourcePool::Get();
+	RenderTarget = Pool.ResizeRenderTarget(RenderTarget, Width, Height, RTF_RGBA8);
+	SegmentationTarget = Pool.ResizeRenderTarget(SegmentationTarget, Width, Height, RTF_RGBA8);
 
 	if (CaptureComponent)
 	{
@@ -141,18 +207,26 @@ void ADataCapture::SetResolution(int32 Width, int32 Height)
 	UE_LOG(LogDataCapture, Log, TEXT("Set render resolution to %dx%d"), Width, Height);
 }
 
-bool ADataCapture::CaptureFrame(const FString& OutputPath, int32 Width, int32 Height)
+void ADataCapture::ConfigureCaptureComponent()
 {
-	UE_LOG(LogDataCapture, Log, TEXT("=== CaptureFrame START ==="));
-	UE_LOG(LogDataCapture, Log, TEXT("Output: %s (%dx%d)"), *OutputPath, Width, Height);
-	
-	// Ensure CaptureComponent exists
 	if (!CaptureComponent)
 	{
-		UE_LOG(LogDataCapture, Error, TEXT("CaptureComponent is null - this should never happen!"));
-		return false;
+		return;
 	}
-	
+
+	// Exposure varies per scene (time of day) and is a single value; written whenever it differs
+	if (CaptureComponent->PostProcessSettings.AutoExposureBias != ExposureBiasOverride)
+	{
+		CaptureComponent->PostProcessSettings.AutoExposureBias = ExposureBiasOverride;
+	}
+
+	// Everything else is fixed by the profile, so the component is only touched when it changes
+	const FCaptureProfile& Profile = ResolveCaptureProfile();
+	if (bCaptureComponentConfigured && Profile == AppliedCaptureProfile)
+	{
+		return;
+	}
+
 	//==========================================================================
 	// VIEWPORT MATCH CONFIGURATION
 	// Goal: Capture exactly what the viewport shows
@@ -166,20 +240,18 @@ bool ADataCapture::CaptureFrame(const FString& OutputPath, int32 Width, int32 He
 	
 	// ShowFlags: Enable features but let PostProcessVolume control intensity/settings
 	CaptureComponent->ShowFlags.SetPostProcessing(true);      // Required for PPV
-	CaptureComponent->ShowFlags.SetLighting(true);            // Required for scene
 	CaptureComponent->ShowFlags.SetTonemapper(true);          // Required for proper exposure
 	CaptureComponent->ShowFlags.SetEyeAdaptation(false);      // CRITICAL: Disable auto-exposure
 	CaptureComponent->ShowFlags.SetColorGrading(true);        // Let PPV control
 	CaptureComponent->ShowFlags.SetBloom(true);               // Let PPV control (likely disabled in PPV)
-	CaptureComponent->ShowFlags.SetAtmosphere(true);          // Atmosphere/fog
 	CaptureComponent->ShowFlags.SetSkyLighting(true);         // Sky contribution
-	CaptureComponent->ShowFlags.SetAmbientOcclusion(true);    // Let PPV control
-	CaptureComponent->ShowFlags.SetGlobalIllumination(true);  // GI/Lumen
 	CaptureComponent->ShowFlags.SetMotionBlur(false);         // Deterministic: no motion blur
 	CaptureComponent->ShowFlags.SetTemporalAA(false);         // Deterministic: no temporal effects
 	CaptureComponent->ShowFlags.SetGrain(false);              // Deterministic: no film grain
 	CaptureComponent->ShowFlags.SetVignette(false);           // Deterministic: no vignette
-	CaptureComponent->ShowFlags.SetScreenSpaceReflections(true);  // SSR for realism
+
+	// Lighting, shadows, GI, AO, reflections, fog, translucency and AA
+	Profile.ApplyTo(CaptureComponent);
 	
 	//==========================================================================
 	// EXPOSURE CONTROL
@@ -208,143 +280,1083 @@ bool ADataCapture::CaptureFrame(const FString& OutputPath, int32 Width, int32 He
 	CaptureComponent->PostProcessSettings.FilmGrainIntensity = 0.0f;
 	CaptureComponent->PostProcessSettings.bOverride_MotionBlurAmount = true;
 	CaptureComponent->PostProcessSettings.MotionBlurAmount = 0.0f;
+
+	AppliedCaptureProfile = Profile;
+	bCaptureComponentConfigured = true;
+	
+	UE_LOG(LogDataCapture, Log, TEXT("Capture Config: Profile=%s, Source=SCS_FinalColorLDR, BlendWeight=%.1f, Manual Exposure, Bias=%.1f"),
+		*Profile.Name.ToString(), CaptureComponent->PostProcessBlendWeight, ExposureBiasOverride);
+}
+
+const FCaptureProfile& ADataCapture::ResolveCaptureProfile() const
+{
+	// Registered profiles shadow built-ins of the same name
+	if (const FCaptureProfile* Custom = CustomCaptureProfiles.FindByPredicate([this](const FCaptureProfile& Profile) { return Profile.Name == CaptureProfileName; }))
+	{
+		return *Custom;
+	}
+	if (const FCaptureProfile* BuiltIn = FCaptureProfile::FindBuiltIn(CaptureProfileName))
+	{
+		return *BuiltIn;
+	}
+	return *FCaptureProfile::FindBuiltIn(TEXT("final"));
+}
+
+bool ADataCapture::SetCaptureProfile(const FString& ProfileName)
+{
+	const FName Name(*ProfileName);
+	const bool bKnown = FCaptureProfile::FindBuiltIn(Name) != nullptr
+		|| CustomCaptureProfiles.ContainsByPredicate([Name](const FCaptureProfile& Profile) { return Profile.Name == Name; });
+	if (!bKnown)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("Unknown capture profile: %s (keeping %s)"), *ProfileName, *CaptureProfileName.ToString());
+		return false;
+	}
+
+	// Applied on the next capture, and only if the feature set differs from the current one
+	CaptureProfileName = Name;
+	return true;
+}
+
+void ADataCapture::RegisterCaptureProfile(const FCaptureProfile& Profile)
+{
+	if (FCaptureProfile* Existing = CustomCaptureProfiles.FindByPredicate([&Profile](const FCaptureProfile& Custom) { return Custom.Name == Profile.Name; }))
+	{
+		*Existing = Profile;
+	}
+	else
+	{
+		CustomCaptureProfiles.Add(Profile);
+	}
+}
+
+bool ADataCapture::CaptureFrame(const FString& RequestedPath, int32 Width, int32 Height)
+{
+	const FString OutputPath = ResolveImagePath(RequestedPath);
+
+	// Ensure CaptureComponent exists
+	if (!CaptureComponent)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureComponent is null - this should never happen!"));
+		return false;
+	}
 	
-	UE_LOG(LogDataCapture, Log, TEXT("Capture Config: Source=SCS_FinalColorLDR, BlendWeight=%.1f, Manual Exposure, Bias=%.1f (ExposureBiasOverride=%.1f)"),
-		CaptureComponent->PostProcessBlendWeight, CaptureComponent->PostProcessSettings.AutoExposureBias, ExposureBiasOverride);
+	ConfigureCaptureComponent();
+	ApplyStreamingGate(Width, Height);
 
-	// Create render target (RGBA8 linear for deterministic output)
-	if (!RenderTarget || RenderTarget->SizeX != Width || RenderTarget->SizeY != Height)
+	// Pooled render target (RGBA8 linear for deterministic output)
+	RenderTarget = FCaptureResourcePool::Get().ResizeRenderTarget(RenderTarget, Width, Height, RTF_RGBA8);
+	if (!RenderTarget)
 	{
-		UE_LOG(LogDataCapture, Log, TEXT("Creating render target %dx%d"), Width, Height);
-		RenderTarget = NewObject<UTextureRenderTarget2D>(this);
-		RenderTarget->RenderTargetFormat = RTF_RGBA8;  // Linear format (SCS_FinalColorLDR has gamma baked in)
-		RenderTarget->ClearColor = FLinearColor::Black;
-		RenderTarget->bAutoGenerateMips = false;
-		RenderTarget->InitAutoFormat(Width, Height);
-		RenderTarget->UpdateResourceImmediate(true);
+		UE_LOG(LogDataCapture, Error, TEXT("Failed to get %dx%d render target"), Width, Height);
+		return false;
 	}
 	
 	// Assign render target to capture component
 	CaptureComponent->TextureTarget = RenderTarget;
 	
-	// Log camera transform for debugging
-	FVector ActorLoc = GetActorLocation();
-	FRotator ActorRot = GetActorRotation();
-	float FOV = CaptureComponent->FOVAngle;
-	
-	UE_LOG(LogDataCapture, Log, TEXT("Camera: Loc=(%.1f, %.1f, %.1f) Rot=(P:%.1f Y:%.1f R:%.1f) FOV=%.1f"),
-		ActorLoc.X, ActorLoc.Y, ActorLoc.Z,
-		ActorRot.Pitch, ActorRot.Yaw, ActorRot.Roll,
-		FOV);
-
 	// Capture the scene
-	UE_LOG(LogDataCapture, Log, TEXT("Executing CaptureScene()..."));
-	CaptureComponent->CaptureScene();
+	{
+		VANTAGECV_CAPTURE_STAGE(RenderSubmit);
+		CaptureComponent->CaptureScene();
+	}
 	
 	// Wait for GPU to complete rendering (critical for deterministic output)
+	const uint64 GPUWaitStart = FPlatformTime::Cycles64();
 	FlushRenderingCommands();
 	FRenderCommandFence Fence;
 	Fence.BeginFence();
 	Fence.Wait();
-	
-	UE_LOG(LogDataCapture, Log, TEXT("Render complete, writing to disk..."));
+	FCaptureTelemetry::Get().Record(ECaptureStage::GPU, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - GPUWaitStart));
 
 	// Save to file
-	bool bSuccess = SaveRenderTargetToFile(RenderTarget, OutputPath);
+	bool bSuccess = SaveRenderTargetToFile(RenderTarget, OutputPath, OutputEncoding);
 	
 	if (bSuccess)
 	{
-		UE_LOG(LogDataCapture, Log, TEXT("=== SUCCESS: %s (%dx%d) ==="), *OutputPath, Width, Height);
+		// One event per frame with the camera state; compiled out of shipping builds
+		VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Frame captured"),
+			{TEXT("path"), OutputPath},
+			{TEXT("width"), Width},
+			{TEXT("height"), Height},
+			{TEXT("location"), GetActorLocation()},
+			{TEXT("rotation"), GetActorRotation()},
+			{TEXT("fov"), CaptureComponent->FOVAngle});
+	}
+	else
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureFrame FAILED: %s"), *OutputPath);
+	}
+
+	return bSuccess;
+}
+
+int32 ADataCapture::CaptureFrameAsync(const FString& OutputPath, int32 Width, int32 Height)
+{
+	if (!CaptureComponent)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureFrameAsync: CaptureComponent is null"));
+		return INDEX_NONE;
+	}
+
+	ReadbackRing.Initialize(this, ReadbackRingSize);
+	ConfigureCaptureComponent();
+	ApplyStreamingGate(Width, Height);
+
+	// Blocks only if every slot is still in flight
+	const int32 SlotIndex = ReadbackRing.AcquireSlot(Width, Height);
+	if (SlotIndex == INDEX_NONE)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureFrameAsync: no readback slot available for %dx%d"), Width, Height);
+		return INDEX_NONE;
+	}
+
+	// Render into the slot target; the sync path keeps using RenderTarget
+	int32 Ticket = INDEX_NONE;
+	{
+		VANTAGECV_CAPTURE_STAGE(RenderSubmit);
+		CaptureComponent->TextureTarget = ReadbackRing.GetSlotTarget(SlotIndex);
+		CaptureComponent->CaptureScene();
+		CaptureComponent->TextureTarget = RenderTarget;
+
+		Ticket = SubmitCapture(SlotIndex, ResolveImagePath(OutputPath));
+	}
+	UE_LOG(LogDataCapture, Verbose, TEXT("Queued async capture %d: %s (%dx%d)"), Ticket, *OutputPath, Width, Height);
+	return Ticket;
+}
+
+bool ADataCapture::IsCaptureComplete(int32 Ticket) const
+{
+	return ReadbackRing.IsTicketComplete(Ticket);
+}
+
+bool ADataCapture::WaitForCapture(int32 Ticket)
+{
+	return ReadbackRing.WaitForTicket(Ticket);
+}
+
+int32 ADataCapture::FlushPendingCaptures()
+{
+	const int32 Flushed = ReadbackRing.Flush();
+	const int32 Written = FCaptureWriteQueue::Get().Flush();
+	if (FCaptureStreamSink::Get().IsRunning())
+	{
+		FCaptureStreamSink::Get().Flush();
+	}
+	UE_LOG(LogDataCapture, Log, TEXT("Flushed %d pending captures, %d files written"), Flushed, Written);
+	return Flushed;
+}
+
+void ADataCapture::HandleReadbackComplete(int32 Ticket, const FString& OutputPath, FCapturedImage&& Image)
+{
+	const bool bMask = MaskReadbackTickets.Remove(Ticket) > 0;
+	int64 Frame = INDEX_NONE;
+	TicketFrames.RemoveAndCopyValue(Ticket, Frame);
+	FCaptureAOVSelection AOVSelection;
+	bool bQueued = false;
+	if (AOVReadbackTickets.RemoveAndCopyValue(Ticket, AOVSelection))
+	{
+		// Unpacking into per-AOV images is done by the worker along with the encode
+		bQueued = FCaptureWriteQueue::Get().EnqueueAOVs(MoveTemp(Image), OutputPath, AOVSelection, MakeFrameWriteCallback(Frame, Ticket));
+	}
+	else if (FCaptureStreamSink::IsStreamPath(OutputPath))
+	{
+		// Raw pixels plus the annotations packed at submit time go straight to the consumer
+		TArray<uint8> Annotations;
+		PendingStreamAnnotations.RemoveAndCopyValue(Ticket, Annotations);
+		bQueued = FCaptureStreamSink::Get().Publish(MoveTemp(Image), Ticket, OutputPath, MoveTemp(Annotations));
+		if (Frame != INDEX_NONE)
+		{
+			FVantageCVWorker::Get().CompleteWrite(Frame, bQueued);
+		}
+	}
+	else
+	{
+		// Compression and the disk (or shard) write happen on the write queue workers
+		TArray<uint8> Annotations;
+		PendingStreamAnnotations.RemoveAndCopyValue(Ticket, Annotations);
+		bQueued = FCaptureWriteQueue::Get().Enqueue(MoveTemp(Image), OutputPath, bMask ? FCaptureEncodeSettings() : OutputEncoding,
+			MoveTemp(Annotations), MakeFrameWriteCallback(Frame, Ticket));
+	}
+	if (!bQueued && FCaptureStreamSink::IsStreamPath(OutputPath) && !FCaptureStreamSink::Get().HasClient())
+	{
+		// Nobody is listening yet; the sink counts these (GetFramesDroppedNoClient)
+		UE_LOG(LogDataCapture, Verbose, TEXT("Async capture %d dropped, no stream client: %s"), Ticket, *OutputPath);
+	}
+	else if (!bQueued)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("Async capture %d FAILED: %s"), Ticket, *OutputPath);
+	}
+	if (!bQueued && SequenceWriteFailures && SequenceFramesByTicket.Contains(Ticket))
+	{
+		FScopeLock Lock(&SequenceWriteFailures->Lock);
+		SequenceWriteFailures->Tickets.Add(Ticket);
+	}
+
+	if (ActiveBatchStatus)
+	{
+		ActiveBatchStatus->Add(Ticket, bQueued);
+	}
+}
+
+TArray<FCaptureViewResult> ADataCapture::CaptureViews(const TArray<FCaptureViewRequest>& Views)
+{
+	TArray<FCaptureViewResult> Results;
+	Results.SetNum(Views.Num());
+
+	if (!CaptureComponent)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureViews: CaptureComponent is null"));
+		return Results;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// One slot per image so no view waits on another before the shared flush
+	ReadbackRing.Initialize(this, ReadbackRingSize);
+	ConfigureCaptureComponent();
+
+	// Every view is prefetched before the first render, so streaming for later views overlaps the wait
+	if (StreamingGate.bEnabled)
+	{
+		WaitForStreaming(Views);
+	}
+
+	const FTransform OriginalTransform = CaptureComponent->GetComponentTransform();
+	const float OriginalFOV = CaptureComponent->FOVAngle;
+
+	TArray<int32> Tickets;
+	Tickets.Init(INDEX_NONE, Views.Num());
+
+	TArray<int32> MaskTickets;
+	MaskTickets.Init(INDEX_NONE, Views.Num());
+
+	const bool bWantsMasks = Views.ContainsByPredicate([](const FCaptureViewRequest& View) { return !View.MaskOutputPath.IsEmpty(); });
+	const bool bHasMaskPass = bWantsMasks && ConfigureSegmentationComponent();
+	if (bWantsMasks && !bHasMaskPass)
+	{
+		UE_LOG(LogDataCapture, Warning, TEXT("CaptureViews: masks requested but SegmentationMaterial is not set"));
+	}
+
+	TArray<int32> AOVTickets;
+	AOVTickets.Init(INDEX_NONE, Views.Num());
+
+	const bool bWantsAOVs = Views.ContainsByPredicate([](const FCaptureViewRequest& View) { return !View.AOVOutputPath.IsEmpty(); });
+	const bool bHasAOVPass = bWantsAOVs && ConfigureAOVComponent();
+	if (bWantsAOVs && !bHasAOVPass)
+	{
+		UE_LOG(LogDataCapture, Warning, TEXT("CaptureViews: AOVs requested but AOVMaterial is not set or no AOV is selected"));
+	}
+	ReadbackRing.EnsureCapacity(Views.Num() * (1 + (bHasMaskPass ? 1 : 0) + (bHasAOVPass ? 1 : 0)));
+
+	// Reductions run behind each view's mask render and are read back after the shared flush
+	TArray<FInstanceStatsRequest> StatsRequests;
+	StatsRequests.SetNum(Views.Num());
+	const bool bWantsStats = Views.ContainsByPredicate([](const FCaptureViewRequest& View) { return View.bInstanceStats; });
+	const bool bHasStatsPass = bWantsStats && ConfigureSegmentationComponent();
+
+	int32 NumRejected = 0;
+
+	// Collected from the first submit: AcquireSlot delivers older readbacks under back-pressure
+	TMap<int32, bool> BatchStatus;
+	ActiveBatchStatus = &BatchStatus;
+
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+	{
+		const FCaptureViewRequest& View = Views[ViewIndex];
+		FCaptureViewResult& Result = Results[ViewIndex];
+		Result.ViewIndex = ViewIndex;
+		Result.ImagePath = ResolveImagePath(View.OutputPath);
+		Result.Location = View.Location;
+		Result.Rotation = View.Rotation;
+		Result.FOV = View.FOV;
+
+		// Views that would yield no usable targets are dropped before any render or readback cost
+		if (VisibilityGate.MinVisibleObjects > 0)
+		{
+			Result.Visibility = EvaluateViewVisibility(View, VisibilityGate);
+			if (!Result.Visibility.bPassed)
+			{
+				Result.bRejected = true;
+				++NumRejected;
+				continue;
+			}
+			Result.Rotation = Result.Visibility.Rotation;
+		}
+
+		const int32 SlotIndex = ReadbackRing.AcquireSlot(View.Width, View.Height);
+		if (SlotIndex == INDEX_NONE)
+		{
+			UE_LOG(LogDataCapture, Error, TEXT("CaptureViews: no slot for view %d (%dx%d)"), ViewIndex, View.Width, View.Height);
+			continue;
+		}
+
+		VANTAGECV_CAPTURE_STAGE(RenderSubmit);
+		CaptureComponent->SetWorldLocationAndRotation(View.Location, Result.Rotation);
+		CaptureComponent->FOVAngle = View.FOV;
+		CaptureComponent->TextureTarget = ReadbackRing.GetSlotTarget(SlotIndex);
+		CaptureComponent->CaptureScene();
+
+		Tickets[ViewIndex] = SubmitCapture(SlotIndex, Result.ImagePath);
+
+		UTextureRenderTarget2D* MaskTarget = nullptr;
+		if (!View.MaskOutputPath.IsEmpty() && bHasMaskPass)
+		{
+			Result.MaskPath = FVantageCVWorker::Get().ResolvePath(View.MaskOutputPath);
+			MaskTickets[ViewIndex] = SubmitSegmentationCapture(Result.MaskPath, View.Width, View.Height, &MaskTarget);
+		}
+
+		if (View.bInstanceStats && bHasStatsPass)
+		{
+			if (!MaskTarget)
+			{
+				MaskTarget = RenderSegmentationTarget(View.Width, View.Height);
+			}
+			StatsRequests[ViewIndex] = FInstanceStatsPass::Enqueue(MaskTarget);
+		}
+
+		if (!View.AOVOutputPath.IsEmpty() && bHasAOVPass)
+		{
+			const FString AOVBasePath = FVantageCVWorker::Get().ResolvePath(View.AOVOutputPath);
+			Result.AOVPaths = FCaptureAOV::GetOutputPaths(AOVBasePath, AOVs);
+			AOVTickets[ViewIndex] = SubmitAOVCapture(AOVBasePath, View.Width, View.Height);
+		}
+	}
+
+	// Restore the camera the single-view API and Python expect
+	CaptureComponent->SetWorldTransform(OriginalTransform);
+	CaptureComponent->FOVAngle = OriginalFOV;
+	CaptureComponent->TextureTarget = RenderTarget;
+
+	// Single fence for the whole batch
+	ReadbackRing.Flush();
+	ActiveBatchStatus = nullptr;
+
+	// The flush already waited on the GPU, so this is one render flush with no further stall
+	if (bHasStatsPass)
+	{
+		VANTAGECV_CAPTURE_STAGE(Annotation);
+		FInstanceStatsPass::Resolve(StatsRequests);
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+		{
+			if (StatsRequests[ViewIndex].IsValid())
+			{
+				Results[ViewIndex].bHasInstanceStats = FInstanceStatsPass::GetStats(StatsRequests[ViewIndex], Results[ViewIndex].InstanceStats);
+			}
+		}
+	}
+
+	int32 NumSucceeded = 0;
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+	{
+		const bool* bQueued = BatchStatus.Find(Tickets[ViewIndex]);
+		Results[ViewIndex].bSuccess = bQueued && *bQueued;
+
+		const bool* bMaskQueued = BatchStatus.Find(MaskTickets[ViewIndex]);
+		Results[ViewIndex].bMaskSuccess = bMaskQueued && *bMaskQueued;
+
+		const bool* bAOVQueued = BatchStatus.Find(AOVTickets[ViewIndex]);
+		Results[ViewIndex].bAOVSuccess = bAOVQueued && *bAOVQueued;
+		NumSucceeded += Results[ViewIndex].bSuccess ? 1 : 0;
+	}
+
+	VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Views captured"),
+		{TEXT("captured"), NumSucceeded},
+		{TEXT("views"), Views.Num()},
+		{TEXT("rejected"), NumRejected},
+		{TEXT("time_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0});
+	return Results;
+}
+
+FCaptureStreamingReport ADataCapture::WaitForStreaming(const TArray<FCaptureViewRequest>& Views)
+{
+	FCaptureStreamingReport Report;
+	{
+		VANTAGECV_CAPTURE_STAGE_ACCUMULATE(Streaming, Report.WaitMs);
+		IStreamingManager& StreamingManager = IStreamingManager::Get();
+
+		// Texture and mesh LOD streaming is distance based, so only the view origins and screen sizes matter
+		for (const FCaptureViewRequest& View : Views)
+		{
+			const float HalfFOVRadians = FMath::DegreesToRadians(FMath::Clamp(View.FOV, 1.0f, 170.0f) * 0.5f);
+			StreamingManager.AddViewInformation(View.Location, (float)View.Width, (float)View.Width / FMath::Tan(HalfFOVRadians),
+				StreamingGate.BoostFactor, StreamingGate.bOverrideOtherViews, StreamingGate.HintDurationSeconds);
+		}
+
+		// Hidden vehicles are parked outside the scene plan and would only compete for the pool
+		for (AActor* Actor : GetAnnotatableActors(StreamingGate.PrestreamTags))
+		{
+			if (!Actor->IsHidden())
+			{
+				Actor->PrestreamTextures(StreamingGate.HintDurationSeconds, true);
+				++Report.NumPrestreamedActors;
+			}
+		}
+
+		// Full update so the new views and hints turn into requests now rather than over the next frames
+		StreamingManager.UpdateResourceStreaming(0.0f, true);
+		Report.NumPendingAtStart = StreamingManager.GetNumWantingResources();
+		Report.NumPendingAtEnd = Report.NumPendingAtStart;
+
+		// Block on the in-flight requests in short slices, re-evaluating what is still wanted after each
+		const float PollSeconds = 0.05f;
+		const double Deadline = FPlatformTime::Seconds() + StreamingGate.TimeoutSeconds;
+		while (Report.NumPendingAtEnd > StreamingGate.MaxPendingResources)
+		{
+			const double Remaining = Deadline - FPlatformTime::Seconds();
+			if (Remaining <= 0.0)
+			{
+				break;
+			}
+			const double SliceStart = FPlatformTime::Seconds();
+			StreamingManager.BlockTillAllRequestsFinished(FMath::Min((float)Remaining, PollSeconds), false);
+			const bool bNothingInFlight = FPlatformTime::Seconds() - SliceStart < 0.001;
+
+			const int32 NumPendingBefore = Report.NumPendingAtEnd;
+			StreamingManager.UpdateResourceStreaming(0.0f, true);
+			Report.NumPendingAtEnd = StreamingManager.GetNumWantingResources();
+
+			// Wanted resources with no request in flight after a full update are held back by the pool budget
+			if (bNothingInFlight && Report.NumPendingAtEnd >= NumPendingBefore)
+			{
+				break;
+			}
+		}
+		Report.bSettled = Report.NumPendingAtEnd <= StreamingGate.MaxPendingResources;
+	}
+
+	if (Report.bSettled)
+	{
+		VANTAGECV_EVENT(Verbose, TEXT("StreamingGate"), TEXT("Streaming settled"),
+			{TEXT("wait_ms"), Report.WaitMs},
+			{TEXT("pending_at_start"), Report.NumPendingAtStart},
+			{TEXT("prestreamed_actors"), Report.NumPrestreamedActors},
+			{TEXT("views"), Views.Num()});
+	}
+	else
+	{
+		VANTAGECV_EVENT(Warning, TEXT("StreamingGate"), TEXT("Streaming timed out, capturing with partial residency"),
+			{TEXT("wait_ms"), Report.WaitMs},
+			{TEXT("pending_at_start"), Report.NumPendingAtStart},
+			{TEXT("pending_at_end"), Report.NumPendingAtEnd},
+			{TEXT("timeout_s"), StreamingGate.TimeoutSeconds});
+	}
+
+	LastStreamingReport = Report;
+	return Report;
+}
+
+void ADataCapture::ApplyStreamingGate(int32 Width, int32 Height)
+{
+	if (!StreamingGate.bEnabled || !CaptureComponent)
+	{
+		return;
+	}
+
+	FCaptureViewRequest View;
+	View.Location = CaptureComponent->GetComponentLocation();
+	View.Rotation = CaptureComponent->GetComponentRotation();
+	View.FOV = CaptureComponent->FOVAngle;
+	View.Width = Width;
+	View.Height = Height;
+	WaitForStreaming({ View });
+}
+
+FCaptureVisibilityReport ADataCapture::EvaluateViewVisibility(const FCaptureViewRequest& View, const FCaptureVisibilityCriteria& Criteria) const
+{
+	FCaptureVisibilityReport Report;
+	Report.Rotation = View.Rotation;
+
+	const TArray<AActor*> Targets = GetAnnotatableActors(Criteria.TargetTags);
+	Report.NumTargets = Targets.Num();
+	if (Targets.Num() == 0 || Targets.Num() < Criteria.MinVisibleObjects)
+	{
+		Report.bPassed = Criteria.MinVisibleObjects <= 0;
+		return Report;
+	}
+
+	TArray<FCaptureWorldBox> Boxes;
+	Boxes.Reserve(Targets.Num());
+	FVector Centroid = FVector::ZeroVector;
+	for (AActor* Target : Targets)
+	{
+		FVector Origin, BoxExtent;
+		Target->GetActorBounds(false, Origin, BoxExtent);
+		Boxes.Emplace(Origin, BoxExtent);
+		Centroid += Origin;
+	}
+	Centroid /= Targets.Num();
+
+	const float NearPlane = CaptureComponent && CaptureComponent->bOverride_CustomNearClippingPlane
+		? CaptureComponent->CustomNearClippingPlane : GNearClippingPlane;
+
+	CountVisibleTargets(Targets, Boxes, View.Location,
+		FCaptureProjection(View.Location, View.Rotation, View.FOV, View.Width, View.Height, NearPlane), Criteria, Report);
+	if (Report.bPassed || !Criteria.bRetargetOnFail)
+	{
+		return Report;
+	}
+
+	// Re-pose: same position and roll, aimed at the middle of the target set
+	FRotator Retargeted = (Centroid - View.Location).Rotation();
+	Retargeted.Roll = View.Rotation.Roll;
+
+	FCaptureVisibilityReport RetargetReport = Report;
+	CountVisibleTargets(Targets, Boxes, View.Location,
+		FCaptureProjection(View.Location, Retargeted, View.FOV, View.Width, View.Height, NearPlane), Criteria, RetargetReport);
+	if (!RetargetReport.bPassed)
+	{
+		return Report;
+	}
+
+	RetargetReport.bRetargeted = true;
+	RetargetReport.Rotation = Retargeted;
+	return RetargetReport;
+}
+
+void ADataCapture::CountVisibleTargets(const TArray<AActor*>& Targets, TConstArrayView<FCaptureWorldBox> Boxes, const FVector& ViewLocation,
+	const FCaptureProjection& Projection, const FCaptureVisibilityCriteria& Criteria, FCaptureVisibilityReport& OutReport) const
+{
+	TArray<FCaptureProjectedBox> Projected;
+	Projection.ProjectBoxes(Boxes, Projected);
+
+	OutReport.NumInFrustum = 0;
+	OutReport.NumVisible = 0;
+	OutReport.NumTruncated = 0;
+	OutReport.NumOccluded = 0;
+
+	// Frustum and size test for every target in one batch; traces only for candidates
+	TArray<int32, TInlineAllocator<16>> Candidates;
+	for (int32 Index = 0; Index < Projected.Num(); ++Index)
+	{
+		const FCaptureProjectedBox& Box = Projected[Index];
+		if (!Box.bVisible)
+		{
+			continue;
+		}
+		++OutReport.NumInFrustum;
+
+		const FVector2D Size = Box.Max - Box.Min;
+		if (Box.InFrameFraction < Criteria.MinInFrameFraction || Size.X * Size.Y < Criteria.MinBoxPixels)
+		{
+			++OutReport.NumTruncated;
+			continue;
+		}
+		Candidates.Add(Index);
+	}
+
+	if (!Criteria.bOcclusionTest)
+	{
+		OutReport.NumVisible = Candidates.Num();
+	}
+	else
+	{
+		// Nearest first, and no more traces than the gate needs
+		Candidates.Sort([&Projected](int32 A, int32 B) { return Projected[A].NearestDepth < Projected[B].NearestDepth; });
+		for (int32 Index : Candidates)
+		{
+			if (OutReport.NumVisible >= Criteria.MinVisibleObjects)
+			{
+				break;
+			}
+			if (HasLineOfSight(ViewLocation, Targets[Index], Boxes[Index]))
+			{
+				++OutReport.NumVisible;
+			}
+			else
+			{
+				++OutReport.NumOccluded;
+			}
+		}
+	}
+
+	OutReport.bPassed = OutReport.NumVisible >= Criteria.MinVisibleObjects;
+}
+
+bool ADataCapture::HasLineOfSight(const FVector& ViewLocation, const AActor* Target, const FCaptureWorldBox& Box) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return true;
+	}
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(CaptureVisibilityGate), false, this);
+	if (Target)
+	{
+		// The target and anything attached to it (wheels, drivers, props) cannot occlude itself
+		Params.AddIgnoredActor(Target);
+		TArray<AActor*> AttachedActors;
+		Target->GetAttachedActors(AttachedActors, true, true);
+		Params.AddIgnoredActors(AttachedActors);
+	}
+
+	// Center, upper half and points halfway to each side; clear if any ray is unobstructed
+	const FVector Points[] =
+	{
+		Box.Center,
+		Box.Center + Box.HalfAxisZ * 0.5,
+		Box.Center + Box.HalfAxisX * 0.5,
+		Box.Center - Box.HalfAxisX * 0.5,
+		Box.Center + Box.HalfAxisY * 0.5,
+		Box.Center - Box.HalfAxisY * 0.5
+	};
+	for (const FVector& Point : Points)
+	{
+		FHitResult Hit;
+		if (!World->LineTraceSingleByChannel(Hit, ViewLocation, Point, ECC_Visibility, Params))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FString ADataCapture::GenerateBoundingBoxes(const TArray<FString>& TargetTags)
+{
+	return BuildBoundingBoxJson(GetAnnotatableActors(TargetTags), GetCaptureProjection());
+}
+
+FString ADataCapture::GenerateBoundingBoxesForView(const TArray<FString>& TargetTags, FVector Location, FRotator Rotation,
+	float FOV, int32 Width, int32 Height)
+{
+	if (!CaptureComponent)
+	{
+		return BuildBoundingBoxJson(TArray<AActor*>(), FCaptureProjection());
+	}
+
+	// Move the camera so the mask pass (attached to it) and the projection see the requested view
+	const FTransform OriginalTransform = CaptureComponent->GetComponentTransform();
+	const float OriginalFOV = CaptureComponent->FOVAngle;
+	CaptureComponent->SetWorldLocationAndRotation(Location, Rotation);
+	CaptureComponent->FOVAngle = FOV;
+
+	const FString Json = BuildBoundingBoxJson(GetAnnotatableActors(TargetTags), GetCaptureProjection(Width, Height));
+
+	CaptureComponent->SetWorldTransform(OriginalTransform);
+	CaptureComponent->FOVAngle = OriginalFOV;
+	return Json;
+}
+
+FString ADataCapture::GenerateBoundingBoxesForViewResult(const TArray<FString>& TargetTags, const FCaptureViewResult& View,
+	int32 Width, int32 Height)
+{
+	if (!View.bHasInstanceStats || !CaptureComponent)
+	{
+		return GenerateBoundingBoxesForView(TargetTags, View.Location, View.Rotation, View.FOV, Width, Height);
+	}
+
+	// The camera only moves for the projection; the mask statistics were reduced inside the batch
+	const FTransform OriginalTransform = CaptureComponent->GetComponentTransform();
+	const float OriginalFOV = CaptureComponent->FOVAngle;
+	CaptureComponent->SetWorldLocationAndRotation(View.Location, View.Rotation);
+	CaptureComponent->FOVAngle = View.FOV;
+
+	const FString Json = BuildBoundingBoxJson(GetAnnotatableActors(TargetTags), GetCaptureProjection(Width, Height), &View.InstanceStats);
+
+	CaptureComponent->SetWorldTransform(OriginalTransform);
+	CaptureComponent->FOVAngle = OriginalFOV;
+	return Json;
+}
+
+FString ADataCapture::BuildBoundingBoxJson(const TArray<AActor*>& Actors, const FCaptureProjection& Projection,
+	const TArray<FInstancePixelStats>* InstanceStats)
+{
+	VANTAGECV_CAPTURE_STAGE(Annotation);
+
+	TArray<FCaptureProjectedBox> Boxes;
+	ProjectActorBounds(Actors, Projection, Boxes);
+
+	// Mask-derived statistics replace the projected AABB for actors that carry a stencil ID
+	TMap<int32, FInstancePixelStats> PixelStats;
+	bool bHasPixelStats = false;
+	if (bPixelAccurateBoxes && Actors.Num() > 0 && Projection.IsValid())
+	{
+		TArray<FInstancePixelStats> Stats;
+		if (InstanceStats)
+		{
+			Stats = *InstanceStats;
+			bHasPixelStats = true;
+		}
+		else
+		{
+			bHasPixelStats = ComputeInstanceStats(Projection.GetWidth(), Projection.GetHeight(), Stats);
+		}
+		for (const FInstancePixelStats& Instance : Stats)
+		{
+			PixelStats.Add(Instance.InstanceId, Instance);
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> AnnotationsArray;
+	int32 NumFiltered = 0;
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
+	{
+		AActor* Actor = Actors[Index];
+		const int32 InstanceId = FSegmentationStencil::GetInstanceId(Actor);
+
+		FVector2D BBoxMin, BBoxMax;
+		bool bTruncated = false;
+		float VisibleFraction = -1.0f;
+
+		if (bHasPixelStats && InstanceId != 0)
+		{
+			const FInstancePixelStats* Stats = PixelStats.Find(InstanceId);
+			if (!Stats || Stats->VisiblePixels == 0)
+			{
+				continue;  // Off-screen or fully occluded
+			}
+
+			VisibleFraction = Stats->GetVisibleFraction();
+			if (VisibleFraction < MinVisibleFraction)
+			{
+				NumFiltered++;
+				continue;
+			}
+
+			// Pixel edges, so a single-pixel instance has width 1
+			BBoxMin = FVector2D(Stats->Min);
+			BBoxMax = FVector2D(Stats->Max + FIntPoint(1, 1));
+			bTruncated = Stats->bTruncated || Boxes[Index].bTruncated;
+		}
+		else
+		{
+			if (!Boxes[Index].bVisible)
+			{
+				continue;
+			}
+			BBoxMin = Boxes[Index].Min;
+			BBoxMax = Boxes[Index].Max;
+			bTruncated = Boxes[Index].bTruncated;
+		}
+
+		TSharedPtr<FJsonObject> AnnotationObj = MakeShareable(new FJsonObject);
+		AnnotationObj->SetStringField("class", Actor->GetClass()->GetName());
+		AnnotationObj->SetNumberField("x_min", BBoxMin.X);
+		AnnotationObj->SetNumberField("y_min", BBoxMin.Y);
+		AnnotationObj->SetNumberField("x_max", BBoxMax.X);
+		AnnotationObj->SetNumberField("y_max", BBoxMax.Y);
+		AnnotationObj->SetNumberField("width", BBoxMax.X - BBoxMin.X);
+		AnnotationObj->SetNumberField("height", BBoxMax.Y - BBoxMin.Y);
+		AnnotationObj->SetBoolField("truncated", bTruncated);
+		AnnotationObj->SetNumberField("stencil_id", InstanceId);
+		if (VisibleFraction >= 0.0f)
+		{
+			AnnotationObj->SetNumberField("visible_fraction", VisibleFraction);
+		}
+
+		AnnotationsArray.Add(MakeShareable(new FJsonValueObject(AnnotationObj)));
+	}
+
+	// Convert to JSON string
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetNumberField("image_width", Projection.GetWidth());
+	RootObj->SetNumberField("image_height", Projection.GetHeight());
+	RootObj->SetArrayField("annotations", AnnotationsArray);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+
+	VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Bounding box annotations generated"),
+		{TEXT("annotations"), AnnotationsArray.Num()},
+		{TEXT("actors_queried"), Actors.Num()},
+		{TEXT("below_visibility"), NumFiltered},
+		{TEXT("source"), bHasPixelStats ? TEXT("mask") : TEXT("projected bounds")});
+	return OutputString;
+}
+
+FString ADataCapture::GenerateInstanceAnnotations(int32 Width, int32 Height)
+{
+	VANTAGECV_CAPTURE_STAGE(Annotation);
+
+	TArray<FInstancePixelStats> Stats;
+	ComputeInstanceStats(Width, Height, Stats);
+
+	TArray<TSharedPtr<FJsonValue>> InstancesArray;
+	for (const FInstancePixelStats& Instance : Stats)
+	{
+		TSharedPtr<FJsonObject> InstanceObj = MakeShareable(new FJsonObject);
+		InstanceObj->SetNumberField("stencil_id", Instance.InstanceId);
+		if (AActor* Actor = FSegmentationStencil::FindActor(Instance.InstanceId))
+		{
+			InstanceObj->SetStringField("actor", Actor->GetName());
+			InstanceObj->SetStringField("class", Actor->GetClass()->GetName());
+		}
+		InstanceObj->SetNumberField("visible_pixels", Instance.VisiblePixels);
+		InstanceObj->SetNumberField("footprint_pixels", Instance.FootprintPixels);
+		InstanceObj->SetNumberField("visible_fraction", Instance.GetVisibleFraction());
+		if (Instance.VisiblePixels > 0)
+		{
+			InstanceObj->SetNumberField("x_min", Instance.Min.X);
+			InstanceObj->SetNumberField("y_min", Instance.Min.Y);
+			InstanceObj->SetNumberField("x_max", Instance.Max.X + 1);
+			InstanceObj->SetNumberField("y_max", Instance.Max.Y + 1);
+			InstanceObj->SetBoolField("truncated", Instance.bTruncated);
+		}
+		InstancesArray.Add(MakeShareable(new FJsonValueObject(InstanceObj)));
+	}
+
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetNumberField("image_width", Width);
+	RootObj->SetNumberField("image_height", Height);
+	RootObj->SetArrayField("instances", InstancesArray);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	return OutputString;
+}
+
+bool ADataCapture::ComputeInstanceStats(int32 Width, int32 Height, TArray<FInstancePixelStats>& OutStats)
+{
+	OutStats.Reset();
+	if (!CaptureComponent || !ConfigureSegmentationComponent())
+	{
+		return false;
+	}
+
+	UTextureRenderTarget2D* MaskTarget = RenderSegmentationTarget(Width, Height);
+	return MaskTarget && FInstanceStatsPass::Compute(MaskTarget, OutStats);
+}
+
+UTextureRenderTarget2D* ADataCapture::RenderSegmentationTarget(int32 Width, int32 Height)
+{
+	SegmentationTarget = FCaptureResourcePool::Get().ResizeRenderTarget(SegmentationTarget, Width, Height, RTF_RGBA8);
+	if (!SegmentationTarget)
+	{
+		return nullptr;
+	}
+
+	SegmentationCaptureComponent->FOVAngle = CaptureComponent->FOVAngle;
+	SegmentationCaptureComponent->TextureTarget = SegmentationTarget;
+	SegmentationCaptureComponent->CaptureScene();
+	SegmentationCaptureComponent->TextureTarget = nullptr;
+	return SegmentationTarget;
+}
+
+bool ADataCapture::GenerateSegmentationMask(const FString& OutputPath, int32 Width, int32 Height)
+{
+	if (!CaptureComponent)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureComponent not initialized"));
+		return false;
+	}
+
+	// Stencil pass: the stripped mask component renders only custom stencil IDs
+	if (ConfigureSegmentationComponent())
+	{
+		const int32 Ticket = SubmitSegmentationCapture(OutputPath, Width, Height);
+		const bool bSuccess = Ticket != INDEX_NONE && ReadbackRing.WaitForTicket(Ticket);
+		if (bSuccess)
+		{
+			VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Instance mask generated"), {TEXT("path"), OutputPath});
+		}
+		else
+		{
+			UE_LOG(LogDataCapture, Error, TEXT("Failed to generate instance mask: %s"), *OutputPath);
+		}
+		return bSuccess;
+	}
+
+	UE_LOG(LogDataCapture, Warning, TEXT("SegmentationMaterial not set - falling back to SceneColorHDR re-render"));
+
+	// Update resolution if needed
+	SegmentationTarget = FCaptureResourcePool::Get().ResizeRenderTarget(SegmentationTarget, Width, Height, RTF_RGBA8);
+	if (!SegmentationTarget)
+	{
+		return false;
+	}
+
+	// Switch to segmentation rendering mode
+	CaptureComponent->TextureTarget = SegmentationTarget;
+	CaptureComponent->CaptureSource = ESceneCaptureSource::SCS_SceneColorHDR;
+	CaptureComponent->ShowFlags.SetPostProcessing(false);
+	CaptureComponent->CaptureScene();
+
+	// Save segmentation mask
+	bool bSuccess = SaveRenderTargetToFile(SegmentationTarget, OutputPath);
+
+	// Restore normal rendering; the next capture re-applies the profile
+	CaptureComponent->TextureTarget = RenderTarget;
+	bCaptureComponentConfigured = false;
+
+	if (bSuccess)
+	{
+		VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Segmentation mask generated"), {TEXT("path"), OutputPath});
 	}
 	else
 	{
-		UE_LOG(LogDataCapture, Error, TEXT("=== FAILED: %s ==="), *OutputPath);
+		UE_LOG(LogDataCapture, Error, TEXT("Failed to generate segmentation mask: %s"), *OutputPath);
 	}
 
 	return bSuccess;
 }
 
-FString ADataCapture::GenerateBoundingBoxes(const TArray<FString>& TargetTags)
+int32 ADataCapture::CaptureFrameWithMaskAsync(const FString& OutputPath, const FString& MaskOutputPath, int32 Width, int32 Height)
+{
+	if (!ConfigureSegmentationComponent())
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureFrameWithMaskAsync: SegmentationMaterial not set"));
+		return INDEX_NONE;
+	}
+
+	ReadbackRing.EnsureCapacity(FMath::Max(ReadbackRingSize, 2));
+
+	const int32 Ticket = CaptureFrameAsync(OutputPath, Width, Height);
+	if (Ticket == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// No scene change between the two submissions, so both describe the same frame
+	SubmitSegmentationCapture(FVantageCVWorker::Get().ResolvePath(MaskOutputPath), Width, Height);
+	return Ticket;
+}
+
+int32 ADataCapture::CaptureFrameWithAOVsAsync(const FString& OutputPath, const FString& AOVBasePath, int32 Width, int32 Height)
+{
+	if (!ConfigureAOVComponent())
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("CaptureFrameWithAOVsAsync: AOVMaterial not set or no AOV selected"));
+		return INDEX_NONE;
+	}
+
+	ReadbackRing.EnsureCapacity(FMath::Max(ReadbackRingSize, 2));
+
+	const int32 Ticket = CaptureFrameAsync(OutputPath, Width, Height);
+	if (Ticket == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// No scene change between the two submissions, so both describe the same frame
+	SubmitAOVCapture(FVantageCVWorker::Get().ResolvePath(AOVBasePath), Width, Height);
+	return Ticket;
+}
+
+FString ADataCapture::GetSegmentationIdMap() const
+{
+	return FSegmentationStencil::GetIdMapJson();
+}
+
+bool ADataCapture::ConfigureSegmentationComponent()
+{
+	if (!SegmentationCaptureComponent || SegmentationMaterial.IsNull())
+	{
+		return false;
+	}
+
+	UMaterialInterface* Material = SegmentationMaterial.LoadSynchronous();
+	if (!Material)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("Failed to load SegmentationMaterial: %s"), *SegmentationMaterial.ToString());
+		return false;
+	}
+
+	TArray<FWeightedBlendable>& Blendables = SegmentationCaptureComponent->PostProcessSettings.WeightedBlendables.Array;
+	if (Blendables.Num() != 1 || Blendables[0].Object != Material)
+	{
+		Blendables.Reset();
+		Blendables.Add(FWeightedBlendable(1.0f, Material));
+		SegmentationCaptureComponent->PostProcessBlendWeight = 1.0f;
+	}
+	return true;
+}
+
+int32 ADataCapture::SubmitSegmentationCapture(const FString& MaskOutputPath, int32 Width, int32 Height, UTextureRenderTarget2D** OutTarget)
 {
-	TArray<AActor*> Actors = GetAnnotatableActors(TargetTags);
-	TArray<TSharedPtr<FJsonValue>> AnnotationsArray;
+	ReadbackRing.Initialize(this, ReadbackRingSize);
 
-	for (AActor* Actor : Actors)
+	const int32 SlotIndex = ReadbackRing.AcquireSlot(Width, Height);
+	if (SlotIndex == INDEX_NONE)
 	{
-		if (!Actor) continue;
-
-		FVector2D BBoxMin, BBoxMax;
-		if (CalculateBoundingBox(Actor, BBoxMin, BBoxMax))
-		{
-			TSharedPtr<FJsonObject> AnnotationObj = MakeShareable(new FJsonObject);
-			
-			AnnotationObj->SetStringField("class", Actor->GetClass()->GetName());
-			AnnotationObj->SetNumberField("x_min", BBoxMin.X);
-			AnnotationObj->SetNumberField("y_min", BBoxMin.Y);
-			AnnotationObj->SetNumberField("x_max", BBoxMax.X);
-			AnnotationObj->SetNumberField("y_max", BBoxMax.Y);
-			AnnotationObj->SetNumberField("width", BBoxMax.X - BBoxMin.X);
-			AnnotationObj->SetNumberField("height", BBoxMax.Y - BBoxMin.Y);
-
-			AnnotationsArray.Add(MakeShareable(new FJsonValueObject(AnnotationObj)));
-		}
+		UE_LOG(LogDataCapture, Error, TEXT("No readback slot for instance mask %dx%d"), Width, Height);
+		return INDEX_NONE;
 	}
 
-	// Convert to JSON string
-	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
-	RootObj->SetArrayField("annotations", AnnotationsArray);
-
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	// Same view as the RGB component; the mask component is attached to it
+	SegmentationCaptureComponent->FOVAngle = CaptureComponent->FOVAngle;
+	SegmentationCaptureComponent->TextureTarget = ReadbackRing.GetSlotTarget(SlotIndex);
+	SegmentationCaptureComponent->CaptureScene();
+	SegmentationCaptureComponent->TextureTarget = nullptr;
 
-	UE_LOG(LogDataCapture, Log, TEXT("Generated %d bounding box annotations"), AnnotationsArray.Num());
-	return OutputString;
+	if (OutTarget)
+	{
+		*OutTarget = ReadbackRing.GetSlotTarget(SlotIndex);
+	}
+	return SubmitCapture(SlotIndex, MaskOutputPath, true);
 }
 
-bool ADataCapture::GenerateSegmentationMask(const FString& OutputPath, int32 Width, int32 Height)
+bool ADataCapture::ConfigureAOVComponent()
 {
-	if (!CaptureComponent || !SegmentationTarget)
+	if (!AOVCaptureComponent || AOVMaterial.IsNull() || !AOVs.IsAnySelected())
 	{
-		UE_LOG(LogDataCapture, Error, TEXT("CaptureComponent or SegmentationTarget not initialized"));
 		return false;
 	}
 
-	// Update resolution if needed
-	if (SegmentationTarget->SizeX != Width || SegmentationTarget->SizeY != Height)
+	UMaterialInterface* Material = AOVMaterial.LoadSynchronous();
+	if (!Material)
 	{
-		SegmentationTarget->InitAutoFormat(Width, Height);
-		SegmentationTarget->UpdateResourceImmediate(true);
+		UE_LOG(LogDataCapture, Error, TEXT("Failed to load AOVMaterial: %s"), *AOVMaterial.ToString());
+		return false;
 	}
 
-	// Switch to segmentation rendering mode
-	CaptureComponent->TextureTarget = SegmentationTarget;
-	CaptureComponent->CaptureSource = ESceneCaptureSource::SCS_SceneColorHDR;
-	CaptureComponent->ShowFlags.SetPostProcessing(false);
-	CaptureComponent->CaptureScene();
+	TArray<FWeightedBlendable>& Blendables = AOVCaptureComponent->PostProcessSettings.WeightedBlendables.Array;
+	if (Blendables.Num() != 1 || Blendables[0].Object != Material)
+	{
+		Blendables.Reset();
+		Blendables.Add(FWeightedBlendable(1.0f, Material));
+		AOVCaptureComponent->PostProcessBlendWeight = 1.0f;
+	}
 
-	// Save segmentation mask
-	bool bSuccess = SaveRenderTargetToFile(SegmentationTarget, OutputPath);
+	// The velocity pass only runs when something consumes it; motion blur never reaches the AOV scene textures
+	AOVCaptureComponent->ShowFlags.SetMotionBlur(AOVs.bVelocity);
+	return true;
+}
 
-	// Restore normal rendering
-	CaptureComponent->TextureTarget = RenderTarget;
-	CaptureComponent->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
-	CaptureComponent->ShowFlags.SetPostProcessing(true);
+int32 ADataCapture::SubmitAOVCapture(const FString& AOVBasePath, int32 Width, int32 Height)
+{
+	if (FCaptureStreamSink::IsStreamPath(AOVBasePath))
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("AOVs cannot be streamed: %s"), *AOVBasePath);
+		return INDEX_NONE;
+	}
 
-	if (bSuccess)
+	ReadbackRing.Initialize(this, ReadbackRingSize);
+
+	const int32 SlotIndex = ReadbackRing.AcquireSlot(Width, Height, ECapturePixelLayout::RGBA32F);
+	if (SlotIndex == INDEX_NONE)
 	{
-		UE_LOG(LogDataCapture, Log, TEXT("Generated segmentation mask: %s"), *OutputPath);
+		UE_LOG(LogDataCapture, Error, TEXT("No readback slot for AOV pass %dx%d"), Width, Height);
+		return INDEX_NONE;
 	}
-	else
+
+	// Same view as the RGB component; the AOV component is attached to it
+	AOVCaptureComponent->FOVAngle = CaptureComponent->FOVAngle;
+	AOVCaptureComponent->TextureTarget = ReadbackRing.GetSlotTarget(SlotIndex);
+	AOVCaptureComponent->CaptureScene();
+	AOVCaptureComponent->TextureTarget = nullptr;
+
+	const int32 Ticket = ReadbackRing.Submit(SlotIndex, AOVBasePath);
+	if (Ticket != INDEX_NONE)
 	{
-		UE_LOG(LogDataCapture, Error, TEXT("Failed to generate segmentation mask: %s"), *OutputPath);
+		AOVReadbackTickets.Add(Ticket, AOVs);
+		TrackFrameWrite(Ticket);
 	}
+	return Ticket;
+}
 
-	return bSuccess;
+FString ADataCapture::ResolveImagePath(const FString& OutputPath) const
+{
+	const FString WorkerPath = FVantageCVWorker::Get().ResolvePath(OutputPath);
+	return FCaptureStreamSink::IsStreamPath(WorkerPath) ? WorkerPath : FCaptureEncoder::ResolveOutputPath(WorkerPath, OutputEncoding.Format);
 }
 
 FString ADataCapture::GeneratePoseAnnotations(const TArray<FString>& TargetTags)
 {
+	VANTAGECV_CAPTURE_STAGE(Annotation);
+
 	TArray<AActor*> Actors = GetAnnotatableActors(TargetTags);
 	TArray<TSharedPtr<FJsonValue>> PosesArray;
 
@@ -392,81 +1404,151 @@ FString ADataCapture::GeneratePoseAnnotations(const TArray<FString>& TargetTags)
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
 
-	UE_LOG(LogDataCapture, Log, TEXT("Generated %d pose annotations"), PosesArray.Num());
+	VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Pose annotations generated"), {TEXT("poses"), PosesArray.Num()});
 	return OutputString;
 }
 
-TArray<AActor*> ADataCapture::GetAnnotatableActors(const TArray<FString>& FilterTags) const
+bool ADataCapture::StartStreaming(int32 Port, const TArray<FString>& AnnotationTags)
 {
-	TArray<AActor*> FoundActors;
-	UWorld* World = GetWorld();
-	if (!World) return FoundActors;
+	StreamAnnotationTags = AnnotationTags;
+	return FCaptureStreamSink::Get().Start(Port);
+}
 
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		for (const FString& Tag : FilterTags)
-		{
-			if (Actor->ActorHasTag(FName(*Tag)))
-			{
-				FoundActors.Add(Actor);
-				break;
-			}
-		}
-	}
+void ADataCapture::StopStreaming()
+{
+	FCaptureStreamSink::Get().StopStreaming();
+	PendingStreamAnnotations.Reset();
+}
 
-	return FoundActors;
+bool ADataCapture::StartShardWriter(const FString& Directory, const FString& ShardPrefix, int32 MaxShardMB, const TArray<FString>& AnnotationTags)
+{
+	StreamAnnotationTags = AnnotationTags;
+	const FVantageCVWorker& Worker = FVantageCVWorker::Get();
+	return FCaptureShardWriter::Get().Open(Worker.ResolvePath(Directory), Worker.ResolvePath(ShardPrefix), (int64)FMath::Max(1, MaxShardMB) * 1024 * 1024);
 }
 
-bool ADataCapture::CalculateBoundingBox(AActor* Actor, FVector2D& OutMin, FVector2D& OutMax) const
+int32 ADataCapture::StopShardWriter()
 {
-	if (!Actor) return false;
+	// Frames still in the readback ring or write queue belong to this shard set
+	FlushPendingCaptures();
+	return FCaptureShardWriter::Get().Close();
+}
 
-	FVector Origin, BoxExtent;
-	Actor->GetActorBounds(false, Origin, BoxExtent);
+int32 ADataCapture::SubmitCapture(int32 SlotIndex, const FString& OutputPath, bool bMask)
+{
+	const int32 Ticket = ReadbackRing.Submit(SlotIndex, OutputPath);
+	if (Ticket != INDEX_NONE && bMask)
+	{
+		MaskReadbackTickets.Add(Ticket);
+	}
+	TrackFrameWrite(Ticket);
 
-	// Get 8 corners of bounding box
-	TArray<FVector> Corners;
-	Corners.Add(Origin + FVector(BoxExtent.X, BoxExtent.Y, BoxExtent.Z));
-	Corners.Add(Origin + FVector(BoxExtent.X, BoxExtent.Y, -BoxExtent.Z));
-	Corners.Add(Origin + FVector(BoxExtent.X, -BoxExtent.Y, BoxExtent.Z));
-	Corners.Add(Origin + FVector(BoxExtent.X, -BoxExtent.Y, -BoxExtent.Z));
-	Corners.Add(Origin + FVector(-BoxExtent.X, BoxExtent.Y, BoxExtent.Z));
-	Corners.Add(Origin + FVector(-BoxExtent.X, BoxExtent.Y, -BoxExtent.Z));
-	Corners.Add(Origin + FVector(-BoxExtent.X, -BoxExtent.Y, BoxExtent.Z));
-	Corners.Add(Origin + FVector(-BoxExtent.X, -BoxExtent.Y, -BoxExtent.Z));
+	// Annotations must describe the scene as rendered, not as it is when the readback lands
+	const bool bPackAnnotations = FCaptureStreamSink::IsStreamPath(OutputPath)
+		|| (FCaptureShardWriter::IsShardPath(OutputPath) && StreamAnnotationTags.Num() > 0 && !bMask);
+	if (Ticket != INDEX_NONE && bPackAnnotations)
+	{
+		const UTextureRenderTarget2D* SlotTarget = ReadbackRing.GetSlotTarget(SlotIndex);
+		PendingStreamAnnotations.Add(Ticket, PackStreamAnnotations(SlotTarget->SizeX, SlotTarget->SizeY));
+	}
+	return Ticket;
+}
 
-	// Project to screen space
-	float MinX = FLT_MAX, MinY = FLT_MAX;
-	float MaxX = -FLT_MAX, MaxY = -FLT_MAX;
+void ADataCapture::TrackFrameWrite(int32 Ticket)
+{
+	FVantageCVWorker& Worker = FVantageCVWorker::Get();
+	const int64 Frame = Worker.GetCurrentFrame();
+	if (Ticket != INDEX_NONE && Frame != INDEX_NONE)
+	{
+		TicketFrames.Add(Ticket, Frame);
+		Worker.AddPendingWrite(Frame);
+	}
+}
 
-	for (const FVector& Corner : Corners)
+FCaptureWriteQueue::FOnWritten ADataCapture::MakeFrameWriteCallback(int64 GlobalFrame, int32 Ticket) const
+{
+	TSharedPtr<FCaptureSequenceWriteFailures, ESPMode::ThreadSafe> SequenceFailures;
+	if (Ticket != INDEX_NONE && SequenceFramesByTicket.Contains(Ticket))
+	{
+		SequenceFailures = SequenceWriteFailures;
+	}
+	if (GlobalFrame == INDEX_NONE && !SequenceFailures)
 	{
-		FVector2D ScreenPos = ProjectWorldToScreen(Corner);
-		MinX = FMath::Min(MinX, ScreenPos.X);
-		MinY = FMath::Min(MinY, ScreenPos.Y);
-		MaxX = FMath::Max(MaxX, ScreenPos.X);
-		MaxY = FMath::Max(MaxY, ScreenPos.Y);
+		return FCaptureWriteQueue::FOnWritten();
 	}
 
-	OutMin = FVector2D(MinX, MinY);
-	OutMax = FVector2D(MaxX, MaxY);
+	// Runs on a write queue worker
+	return [GlobalFrame, Ticket, SequenceFailures](bool bSuccess)
+	{
+		if (GlobalFrame != INDEX_NONE)
+		{
+			FVantageCVWorker::Get().CompleteWrite(GlobalFrame, bSuccess);
+		}
+		if (SequenceFailures && !bSuccess)
+		{
+			FScopeLock Lock(&SequenceFailures->Lock);
+			SequenceFailures->Tickets.Add(Ticket);
+		}
+	};
+}
+
+TArray<uint8> ADataCapture::PackStreamAnnotations(int32 Width, int32 Height) const
+{
+	VANTAGECV_CAPTURE_STAGE(Annotation);
 
-	return true;
+	const TArray<AActor*> Actors = GetAnnotatableActors(StreamAnnotationTags);
+	TArray<FCaptureProjectedBox> Boxes;
+	ProjectActorBounds(Actors, GetCaptureProjection(Width, Height), Boxes);
+
+	TArray<FCaptureStreamObject> Objects;
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
+	{
+		if (!Boxes[Index].bVisible)
+		{
+			continue;
+		}
+
+		AActor* Actor = Actors[Index];
+		FCaptureStreamObject& Object = Objects.AddDefaulted_GetRef();
+		Object.InstanceId = FSegmentationStencil::GetInstanceId(Actor);	// Matches the mask R channel, 0 if unassigned
+		Object.BBoxMin = FVector2f(Boxes[Index].Min);
+		Object.BBoxMax = FVector2f(Boxes[Index].Max);
+		Object.Location = FVector3f(Actor->GetActorLocation());
+		const FRotator Rotation = Actor->GetActorRotation();
+		Object.Rotation = FVector3f(Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+		Object.ClassName = Actor->GetClass()->GetName();
+	}
+	return FCaptureStreamSink::PackAnnotations(Objects);
 }
 
-FVector2D ADataCapture::ProjectWorldToScreen(const FVector& WorldLocation) const
+TArray<AActor*> ADataCapture::GetAnnotatableActors(const TArray<FString>& FilterTags) const
 {
-	UWorld* World = GetWorld();
-	if (!World) return FVector2D::ZeroVector;
+	UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(GetWorld());
+	return ActorIndex ? ActorIndex->GetActorsWithAnyTag(FilterTags) : TArray<AActor*>();
+}
 
-	APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
-	if (!PC) return FVector2D::ZeroVector;
+FCaptureProjection ADataCapture::GetCaptureProjection(int32 Width, int32 Height) const
+{
+	if ((Width <= 0 || Height <= 0) && RenderTarget)
+	{
+		Width = RenderTarget->SizeX;
+		Height = RenderTarget->SizeY;
+	}
+	return FCaptureProjection::FromCaptureComponent(CaptureComponent, Width, Height);
+}
 
-	FVector2D ScreenLocation;
-	PC->ProjectWorldLocationToScreen(WorldLocation, ScreenLocation);
+void ADataCapture::ProjectActorBounds(const TArray<AActor*>& Actors, const FCaptureProjection& Projection, TArray<FCaptureProjectedBox>& OutBoxes) const
+{
+	TArray<FCaptureWorldBox> WorldBoxes;
+	WorldBoxes.Reserve(Actors.Num());
+	for (AActor* Actor : Actors)
+	{
+		FVector Origin, BoxExtent;
+		Actor->GetActorBounds(false, Origin, BoxExtent);
+		WorldBoxes.Emplace(Origin, BoxExtent);
+	}
 
-	return ScreenLocation;
+	Projection.ProjectBoxes(WorldBoxes, OutBoxes);
 }
 
 void ADataCapture::MatchViewportCamera()
@@ -543,11 +1625,14 @@ void ADataCapture::RandomizeCameraWithTarget(float MinDistance, float MaxDistanc
 	float RandomFOV = FMath::RandRange(MinFOV, MaxFOV);
 	CaptureComponent->FOVAngle = RandomFOV;
 	
-	UE_LOG(LogDataCapture, Log, TEXT("Randomized camera - Target: %s, Location: %s, Distance: %.0f cm, FOV: %.1f"), 
-		*LookTarget.ToString(), *CameraLocation.ToString(), Distance, RandomFOV);
+	VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Randomized camera"),
+		{TEXT("target"), LookTarget},
+		{TEXT("location"), CameraLocation},
+		{TEXT("distance"), Distance},
+		{TEXT("fov"), RandomFOV});
 }
 
-bool ADataCapture::SaveRenderTargetToFile(UTextureRenderTarget2D* InRenderTarget, const FString& FilePath)
+bool ADataCapture::SaveRenderTargetToFile(UTextureRenderTarget2D* InRenderTarget, const FString& FilePath, const FCaptureEncodeSettings& Settings)
 {
 	if (!InRenderTarget)
 	{
@@ -555,17 +1640,6 @@ bool ADataCapture::SaveRenderTargetToFile(UTextureRenderTarget2D* InRenderTarget
 		return false;
 	}
 
-	UE_LOG(LogDataCapture, Log, TEXT("Saving render target to: %s"), *FilePath);
-
-	// Ensure directory exists
-	FString Directory = FPaths::GetPath(FilePath);
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*Directory))
-	{
-		UE_LOG(LogDataCapture, Log, TEXT("Creating directory: %s"), *Directory);
-		PlatformFile.CreateDirectoryTree(*Directory);
-	}
-
 	// Use FImageUtils for reliable render target export
 	FTextureRenderTargetResource* RTResource = InRenderTarget->GameThread_GetRenderTargetResource();
 	if (!RTResource)
@@ -575,45 +1649,41 @@ bool ADataCapture::SaveRenderTargetToFile(UTextureRenderTarget2D* InRenderTarget
 	}
 
 	// Read pixels synchronously
-	TArray<FColor> Pixels;
-	Pixels.SetNum(InRenderTarget->SizeX * InRenderTarget->SizeY);
-	
-	UE_LOG(LogDataCapture, Log, TEXT("Reading %dx%d pixels..."), InRenderTarget->SizeX, InRenderTarget->SizeY);
-	
+	FCapturedImage Image;
+	Image.Width = InRenderTarget->SizeX;
+	Image.Height = InRenderTarget->SizeY;
+	Image.Layout = ECapturePixelLayout::BGRA8;
+	Image.Data = FCaptureResourcePool::Get().AcquireBuffer((int64)Image.Width * Image.Height * sizeof(FColor));
+
 	// SCS_FinalColorLDR already outputs tonemapped gamma-corrected values.
 	// SetLinearToGamma(false) prevents DOUBLE gamma which causes dark images.
 	FReadSurfaceDataFlags ReadFlags(RCM_UNorm);
 	ReadFlags.SetLinearToGamma(false);  // NO gamma — SCS_FinalColorLDR already bakes it in
-	if (!RTResource->ReadPixels(Pixels, ReadFlags))
+	if (!RTResource->ReadPixelsPtr(reinterpret_cast<FColor*>(Image.Data.GetData()), ReadFlags))
 	{
 		UE_LOG(LogDataCapture, Error, TEXT("Failed to read pixels from render target"));
+		FCaptureResourcePool::Get().ReleaseBuffer(MoveTemp(Image.Data));
 		return false;
 	}
 
-	// Create image wrapper and save as PNG
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-	
-	if (ImageWrapper.IsValid() && ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), 
-		InRenderTarget->SizeX, InRenderTarget->SizeY, ERGBFormat::BGRA, 8))
+	if (FCaptureStreamSink::IsStreamPath(FilePath))
 	{
-		const TArray64<uint8>& CompressedData = ImageWrapper->GetCompressed(100);
-		if (FFileHelper::SaveArrayToFile(CompressedData, *FilePath))
-		{
-			UE_LOG(LogDataCapture, Log, TEXT("Successfully saved %lld bytes to: %s"), CompressedData.Num(), *FilePath);
-			return true;
-		}
-		else
-		{
-			UE_LOG(LogDataCapture, Error, TEXT("FFileHelper::SaveArrayToFile failed for: %s"), *FilePath);
-		}
+		return FCaptureStreamSink::Get().Publish(MoveTemp(Image), INDEX_NONE, FilePath, PackStreamAnnotations(InRenderTarget->SizeX, InRenderTarget->SizeY));
 	}
-	else
+
+	TArray<uint8> Annotations;
+	if (FCaptureShardWriter::IsShardPath(FilePath) && StreamAnnotationTags.Num() > 0)
 	{
-		UE_LOG(LogDataCapture, Error, TEXT("Image wrapper SetRaw or Compress failed"));
+		Annotations = PackStreamAnnotations(InRenderTarget->SizeX, InRenderTarget->SizeY);
 	}
 
-	return false;
+	// Hand the buffer to the write queue; encoding no longer blocks the next capture
+	const int64 Frame = FVantageCVWorker::Get().GetCurrentFrame();
+	if (Frame != INDEX_NONE)
+	{
+		FVantageCVWorker::Get().AddPendingWrite(Frame);
+	}
+	return FCaptureWriteQueue::Get().Enqueue(MoveTemp(Image), FilePath, Settings, MoveTemp(Annotations), MakeFrameWriteCallback(Frame));
 }
 
 bool ADataCapture::ReadRenderTargetPixels(UTextureRenderTarget2D* InRenderTarget, TArray<FColor>& OutPixels)
@@ -629,3 +1699,411 @@ bool ADataCapture::ReadRenderTargetPixels(UTextureRenderTarget2D* InRenderTarget
 	ReadPixelFlags.SetLinearToGamma(false);  // NO gamma — SCS_FinalColorLDR already includes it
 	return RTResource->ReadPixels(OutPixels, ReadPixelFlags);
 }
+
+// ============================================================================
+// Sequence Capture
+// ============================================================================
+
+bool ADataCapture::StartSequence(const FCaptureSequenceSettings& Settings)
+{
+	if (IsSequenceRunning())
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("StartSequence: a sequence is already running (frame %d of %d)"),
+			SequenceFrameIndex, SequenceSettings.NumFrames);
+		return false;
+	}
+	if (!CaptureComponent || Settings.NumFrames <= 0 || Settings.FrameRate <= 0.0f || Settings.OutputDirectory.IsEmpty())
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("StartSequence: needs a capture component, NumFrames > 0, FrameRate > 0 and an OutputDirectory"));
+		return false;
+	}
+
+	SequenceSettings = Settings;
+	SequenceDirectory = FVantageCVWorker::Get().ResolvePath(Settings.OutputDirectory);
+	SequenceFrames.Reset();
+	SequenceFrames.Reserve(Settings.NumFrames);
+	SequenceDroppedFrames.Reset();
+	SequenceFramesByTicket.Reset();
+	SequenceWriteFailures = MakeShared<FCaptureSequenceWriteFailures, ESPMode::ThreadSafe>();
+	SequenceMovers.Reset();
+	SequenceTargets.Reset();
+	SequenceFramesQueued = 0;
+	SequenceFramesFailed = 0;
+
+	// Lanes by anchor name, as UAnchorSpawnSystem resolves them
+	SequenceLanes = Settings.Lanes;
+	UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(GetWorld());
+	for (FLaneDefinition& Lane : SequenceLanes)
+	{
+		AActor* StartActor = ActorIndex ? ActorIndex->FindActorByName(Lane.StartAnchorName) : nullptr;
+		AActor* EndActor = ActorIndex ? ActorIndex->FindActorByName(Lane.EndAnchorName) : nullptr;
+		Lane.bIsValid = StartActor && EndActor;
+		if (!Lane.bIsValid)
+		{
+			UE_LOG(LogDataCapture, Warning, TEXT("StartSequence: lane %s skipped, anchor %s not found"), *Lane.LaneId,
+				StartActor ? *Lane.EndAnchorName : *Lane.StartAnchorName);
+			continue;
+		}
+
+		Lane.StartTransform = StartActor->GetActorTransform();
+		Lane.EndTransform = EndActor->GetActorTransform();
+		const FVector Delta = Lane.EndTransform.GetLocation() - Lane.StartTransform.GetLocation();
+		Lane.Direction = Delta.GetSafeNormal();
+		Lane.Length = Delta.Size();
+		Lane.bIsValid = Lane.Length > KINDA_SMALL_NUMBER;
+	}
+
+	// Targets are fixed for the clip so their stencil IDs double as track IDs
+	FRandomStream SpeedRandom(Settings.Seed);
+	for (AActor* Actor : GetAnnotatableActors(Settings.TargetTags))
+	{
+		if (!Actor || Actor->IsHidden())
+		{
+			continue;
+		}
+		SequenceTargets.Add(Actor);
+		if (FSegmentationStencil::AssignInstanceId(Actor) == 0)
+		{
+			UE_LOG(LogDataCapture, Warning, TEXT("StartSequence: no stencil ID left for %s, its track ID is 0"), *Actor->GetName());
+		}
+
+		// Nearest lane whose centre line is within half a lane width
+		const FVector Location = Actor->GetActorLocation();
+		int32 BestLane = INDEX_NONE;
+		float BestDistance = TNumericLimits<float>::Max();
+		float BestAlong = 0.0f;
+		for (int32 LaneIndex = 0; LaneIndex < SequenceLanes.Num(); ++LaneIndex)
+		{
+			const FLaneDefinition& Lane = SequenceLanes[LaneIndex];
+			if (!Lane.bIsValid)
+			{
+				continue;
+			}
+			const FVector Start = Lane.StartTransform.GetLocation();
+			const float Along = FMath::Clamp(FVector::DotProduct(Location - Start, Lane.Direction), 0.0f, Lane.Length);
+			const float Distance = FVector::Dist2D(Location, Start + Lane.Direction * Along);
+			if (Distance <= Lane.LaneWidth * 0.5f && Distance < BestDistance)
+			{
+				BestLane = LaneIndex;
+				BestDistance = Distance;
+				BestAlong = Along;
+			}
+		}
+		if (BestLane == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FLaneDefinition& Lane = SequenceLanes[BestLane];
+		FCaptureSequenceMover& Mover = SequenceMovers.AddDefaulted_GetRef();
+		Mover.Actor = Actor;
+		Mover.LaneIndex = BestLane;
+		Mover.StartDistance = BestAlong;
+		Mover.Speed = SpeedRandom.FRandRange(Settings.MinSpeed, FMath::Max(Settings.MinSpeed, Settings.MaxSpeed));
+		Mover.Offset = Location - (Lane.StartTransform.GetLocation() + Lane.Direction * BestAlong);
+		Mover.OriginalTransform = Actor->GetActorTransform();
+	}
+
+	if (SequenceTargets.Num() == 0)
+	{
+		UE_LOG(LogDataCapture, Warning, TEXT("StartSequence: no visible actors tagged %s; frames will have no annotations"),
+			*FString::Join(Settings.TargetTags, TEXT(",")));
+	}
+
+	// Every tick advances game time by exactly one frame; positions are still computed from F / FrameRate
+	bSequencePreviousFixedTimeStep = FApp::UseFixedTimeStep();
+	SequencePreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / Settings.FrameRate);
+
+	ReadbackRing.Initialize(this, ReadbackRingSize);
+	PlaceSequenceMovers(0.0);
+	SequenceFrameIndex = 0;
+	SequenceStartSeconds = FPlatformTime::Seconds();
+	SequenceElapsedSeconds = 0.0;
+
+	UE_LOG(LogDataCapture, Log, TEXT("Sequence started: %d frames at %.1f fps, %d targets, %d moving on %d lanes -> %s"),
+		Settings.NumFrames, Settings.FrameRate, SequenceTargets.Num(), SequenceMovers.Num(), SequenceLanes.Num(), *SequenceDirectory);
+	return true;
+}
+
+void ADataCapture::StopSequence()
+{
+	if (IsSequenceRunning())
+	{
+		FinishSequence();
+	}
+}
+
+void ADataCapture::PlaceSequenceMovers(double Time)
+{
+	for (const FCaptureSequenceMover& Mover : SequenceMovers)
+	{
+		AActor* Actor = Mover.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		const FLaneDefinition& Lane = SequenceLanes[Mover.LaneIndex];
+		double Distance = Mover.StartDistance + Mover.Speed * Time;
+		Distance = SequenceSettings.bWrapLanes ? FMath::Fmod(Distance, (double)Lane.Length) : FMath::Min(Distance, (double)Lane.Length);
+
+		// No teleport, so motion vectors (velocity AOV, motion blur) see the frame-to-frame movement
+		const FVector Location = Lane.StartTransform.GetLocation() + Lane.Direction * Distance + Mover.Offset;
+		Actor->SetActorLocation(Location, false, nullptr, ETeleportType::None);
+	}
+}
+
+void ADataCapture::TickSequence()
+{
+	const int32 FrameIndex = SequenceFrameIndex;
+	const double Time = FrameIndex / (double)SequenceSettings.FrameRate;
+	PlaceSequenceMovers(Time);
+
+	const FString FrameName = FString::Printf(TEXT("frame_%06d"), FrameIndex);
+	const FString ImagePath = FPaths::Combine(SequenceDirectory, TEXT("images"), FrameName + TEXT(".png"));
+	const int32 Width = SequenceSettings.Width;
+	const int32 Height = SequenceSettings.Height;
+
+	// Back-to-back through the readback ring; blocks only when every slot is still in flight
+	const int32 Ticket = SequenceSettings.bWriteMasks
+		? CaptureFrameWithMaskAsync(ImagePath, FPaths::Combine(SequenceDirectory, TEXT("masks"), FrameName + TEXT(".png")), Width, Height)
+		: CaptureFrameAsync(ImagePath, Width, Height);
+	if (Ticket == INDEX_NONE)
+	{
+		// No image: the frame is left out of sequence.json and gt.txt and listed as dropped
+		++SequenceFramesFailed;
+		SequenceDroppedFrames.Add(FrameIndex);
+		VANTAGECV_EVENT(Warning, TEXT("DataCapture"), TEXT("Sequence frame dropped"),
+			{TEXT("frame"), FrameIndex});
+		if (++SequenceFrameIndex >= SequenceSettings.NumFrames)
+		{
+			FinishSequence();
+		}
+		return;
+	}
+	++SequenceFramesQueued;
+
+	// Projected boxes: CPU only, so annotating never waits on the GPU
+	TArray<AActor*> Targets;
+	Targets.Reserve(SequenceTargets.Num());
+	for (const TWeakObjectPtr<AActor>& Target : SequenceTargets)
+	{
+		if (AActor* Actor = Target.Get())
+		{
+			Targets.Add(Actor);
+		}
+	}
+	TArray<FCaptureProjectedBox> Boxes;
+	ProjectActorBounds(Targets, GetCaptureProjection(Width, Height), Boxes);
+
+	SequenceFramesByTicket.Add(Ticket, SequenceFrames.Num());
+	FCaptureSequenceFrame& Frame = SequenceFrames.AddDefaulted_GetRef();
+	Frame.FrameIndex = FrameIndex;
+	Frame.Ticket = Ticket;
+	Frame.ImagePath = ResolveImagePath(ImagePath);
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
+	{
+		if (!Boxes[Index].bVisible)
+		{
+			continue;
+		}
+
+		AActor* Actor = Targets[Index];
+		FCaptureSequenceObject& Object = Frame.Objects.AddDefaulted_GetRef();
+		Object.Annotation.ClassName = Actor->GetClass()->GetName();
+		Object.Annotation.BBoxMin = Boxes[Index].Min;
+		Object.Annotation.BBoxMax = Boxes[Index].Max;
+		Object.Annotation.Location = Actor->GetActorLocation();
+		Object.Annotation.Rotation = Actor->GetActorRotation();
+		Object.Annotation.InstanceID = FSegmentationStencil::GetInstanceId(Actor);
+		Object.bTruncated = Boxes[Index].bTruncated;
+
+		const FCaptureSequenceMover* Mover = SequenceMovers.FindByPredicate(
+			[Actor](const FCaptureSequenceMover& Candidate) { return Candidate.Actor.Get() == Actor; });
+		if (Mover)
+		{
+			const FLaneDefinition& Lane = SequenceLanes[Mover->LaneIndex];
+			const bool bStopped = !SequenceSettings.bWrapLanes && Mover->StartDistance + Mover->Speed * Time >= Lane.Length;
+			Object.Velocity = bStopped ? FVector::ZeroVector : Lane.Direction * Mover->Speed;
+			Object.LaneId = Lane.LaneId;
+		}
+	}
+
+	VANTAGECV_EVENT(Verbose, TEXT("DataCapture"), TEXT("Sequence frame queued"),
+		{TEXT("frame"), FrameIndex},
+		{TEXT("ticket"), Ticket},
+		{TEXT("objects"), Frame.Objects.Num()});
+
+	if (++SequenceFrameIndex >= SequenceSettings.NumFrames)
+	{
+		FinishSequence();
+	}
+}
+
+void ADataCapture::FinishSequence()
+{
+	const int32 FramesTicked = SequenceFrameIndex;
+	SequenceFrameIndex = INDEX_NONE;
+
+	FlushPendingCaptures();
+	SequenceElapsedSeconds = FPlatformTime::Seconds() - SequenceStartSeconds;
+
+	FApp::SetUseFixedTimeStep(bSequencePreviousFixedTimeStep);
+	FApp::SetFixedDeltaTime(SequencePreviousFixedDeltaTime);
+
+	for (const FCaptureSequenceMover& Mover : SequenceMovers)
+	{
+		if (AActor* Actor = Mover.Actor.Get())
+		{
+			Actor->SetActorTransform(Mover.OriginalTransform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+
+	DropFailedSequenceFrames();
+	const bool bWritten = WriteSequenceAnnotations();
+	UE_LOG(LogDataCapture, Log, TEXT("Sequence finished: %d/%d frames queued, %d failed, %.1f fps%s"),
+		SequenceFramesQueued, SequenceSettings.NumFrames, SequenceFramesFailed,
+		SequenceElapsedSeconds > 0.0 ? FramesTicked / SequenceElapsedSeconds : 0.0,
+		bWritten ? TEXT("") : TEXT(" - annotations NOT written"));
+}
+
+void ADataCapture::DropFailedSequenceFrames()
+{
+	// Every write has reported by now (FinishSequence flushed the ring and the write queue)
+	TSet<int32> FailedTickets;
+	if (SequenceWriteFailures)
+	{
+		FScopeLock Lock(&SequenceWriteFailures->Lock);
+		FailedTickets = MoveTemp(SequenceWriteFailures->Tickets);
+	}
+	SequenceWriteFailures.Reset();
+	SequenceFramesByTicket.Reset();
+	if (FailedTickets.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 NumDropped = SequenceFrames.RemoveAll([this, &FailedTickets](const FCaptureSequenceFrame& Frame)
+	{
+		if (!FailedTickets.Contains(Frame.Ticket))
+		{
+			return false;
+		}
+		SequenceDroppedFrames.Add(Frame.FrameIndex);
+		VANTAGECV_EVENT(Warning, TEXT("DataCapture"), TEXT("Sequence frame dropped"),
+			{TEXT("frame"), Frame.FrameIndex},
+			{TEXT("ticket"), Frame.Ticket});
+		return true;
+	});
+	SequenceDroppedFrames.Sort();
+	SequenceFramesFailed += NumDropped;
+	SequenceFramesQueued -= NumDropped;
+}
+
+bool ADataCapture::WriteSequenceAnnotations() const
+{
+	auto MakeVector = [](const FVector& Value)
+	{
+		TArray<TSharedPtr<FJsonValue>> Array;
+		Array.Add(MakeShareable(new FJsonValueNumber(Value.X)));
+		Array.Add(MakeShareable(new FJsonValueNumber(Value.Y)));
+		Array.Add(MakeShareable(new FJsonValueNumber(Value.Z)));
+		return Array;
+	};
+
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetNumberField("frame_rate", SequenceSettings.FrameRate);
+	RootObj->SetNumberField("num_frames", SequenceFrames.Num());
+
+	// Frames whose image could not be submitted, read back or written; "frames" and gt.txt skip them
+	TArray<TSharedPtr<FJsonValue>> DroppedArray;
+	for (const int32 Dropped : SequenceDroppedFrames)
+	{
+		DroppedArray.Add(MakeShareable(new FJsonValueNumber(Dropped)));
+	}
+	RootObj->SetArrayField("dropped_frames", DroppedArray);
+	RootObj->SetNumberField("image_width", SequenceSettings.Width);
+	RootObj->SetNumberField("image_height", SequenceSettings.Height);
+	RootObj->SetNumberField("seed", SequenceSettings.Seed);
+
+	TSharedPtr<FJsonObject> CameraObj = MakeShareable(new FJsonObject);
+	CameraObj->SetArrayField("location", MakeVector(CaptureComponent->GetComponentLocation()));
+	const FRotator CameraRotation = CaptureComponent->GetComponentRotation();
+	CameraObj->SetArrayField("rotation", MakeVector(FVector(CameraRotation.Pitch, CameraRotation.Yaw, CameraRotation.Roll)));
+	CameraObj->SetNumberField("fov", CaptureComponent->FOVAngle);
+	RootObj->SetObjectField("camera", CameraObj);
+
+	// MOTChallenge ground truth: frame (1-based), id, left, top, width, height, conf, x, y, z
+	FString GroundTruth;
+	TArray<TSharedPtr<FJsonValue>> FramesArray;
+	FramesArray.Reserve(SequenceFrames.Num());
+	for (const FCaptureSequenceFrame& Frame : SequenceFrames)
+	{
+		TArray<TSharedPtr<FJsonValue>> ObjectsArray;
+		for (const FCaptureSequenceObject& Object : Frame.Objects)
+		{
+			const FObjectAnnotation& Annotation = Object.Annotation;
+			TSharedPtr<FJsonObject> ObjectObj = MakeShareable(new FJsonObject);
+			ObjectObj->SetNumberField("instance_id", Annotation.InstanceID);
+			ObjectObj->SetStringField("class", Annotation.ClassName);
+			ObjectObj->SetNumberField("x_min", Annotation.BBoxMin.X);
+			ObjectObj->SetNumberField("y_min", Annotation.BBoxMin.Y);
+			ObjectObj->SetNumberField("x_max", Annotation.BBoxMax.X);
+			ObjectObj->SetNumberField("y_max", Annotation.BBoxMax.Y);
+			ObjectObj->SetBoolField("truncated", Object.bTruncated);
+			ObjectObj->SetArrayField("location", MakeVector(Annotation.Location));
+			ObjectObj->SetArrayField("rotation", MakeVector(FVector(Annotation.Rotation.Pitch, Annotation.Rotation.Yaw, Annotation.Rotation.Roll)));
+			ObjectObj->SetArrayField("velocity", MakeVector(Object.Velocity));
+			ObjectObj->SetStringField("lane", Object.LaneId);
+			ObjectsArray.Add(MakeShareable(new FJsonValueObject(ObjectObj)));
+
+			GroundTruth.Appendf(TEXT("%d,%d,%.2f,%.2f,%.2f,%.2f,1,-1,-1,-1\n"), Frame.FrameIndex + 1, Annotation.InstanceID,
+				Annotation.BBoxMin.X, Annotation.BBoxMin.Y, Annotation.BBoxMax.X - Annotation.BBoxMin.X, Annotation.BBoxMax.Y - Annotation.BBoxMin.Y);
+		}
+
+		TSharedPtr<FJsonObject> FrameObj = MakeShareable(new FJsonObject);
+		FrameObj->SetNumberField("frame", Frame.FrameIndex);
+		FrameObj->SetNumberField("time", Frame.FrameIndex / (double)SequenceSettings.FrameRate);
+		FrameObj->SetStringField("image", FPaths::GetCleanFilename(Frame.ImagePath));
+		FrameObj->SetArrayField("objects", ObjectsArray);
+		FramesArray.Add(MakeShareable(new FJsonValueObject(FrameObj)));
+	}
+	RootObj->SetArrayField("frames", FramesArray);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+
+	const FString AnnotationsDir = FPaths::Combine(SequenceDirectory, TEXT("annotations"));
+	const bool bJson = FFileHelper::SaveStringToFile(OutputString, *FPaths::Combine(AnnotationsDir, TEXT("sequence.json")));
+	const bool bGroundTruth = FFileHelper::SaveStringToFile(GroundTruth, *FPaths::Combine(AnnotationsDir, TEXT("gt.txt")));
+	if (!bJson || !bGroundTruth)
+	{
+		UE_LOG(LogDataCapture, Error, TEXT("Failed to write sequence annotations to %s"), *AnnotationsDir);
+		return false;
+	}
+	return true;
+}
+
+FString ADataCapture::GetSequenceStatus() const
+{
+	const double Elapsed = IsSequenceRunning() ? FPlatformTime::Seconds() - SequenceStartSeconds : SequenceElapsedSeconds;
+
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetBoolField("running", IsSequenceRunning());
+	RootObj->SetNumberField("frame", IsSequenceRunning() ? SequenceFrameIndex : SequenceFrames.Num() + SequenceDroppedFrames.Num());
+	RootObj->SetNumberField("num_frames", SequenceSettings.NumFrames);
+	RootObj->SetNumberField("frames_queued", SequenceFramesQueued);
+	RootObj->SetNumberField("frames_failed", SequenceFramesFailed);
+	RootObj->SetNumberField("targets", SequenceTargets.Num());
+	RootObj->SetNumberField("movers", SequenceMovers.Num());
+	RootObj->SetNumberField("frames_per_second", Elapsed > 0.0 ? SequenceFrames.Num() / Elapsed : 0.0);
+	RootObj->SetStringField("output_directory", SequenceDirectory);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	return OutputString;
+}
@@ -16,14 +16,17 @@
  *****************************************************************************/
 
 #include "DomainRandomization.h"
+#include "ActorIndexSubsystem.h"
+#include "ActorPoolSubsystem.h"
+#include "SceneStateDelta.h"
 #include "Engine/DirectionalLight.h"
 #include "Components/DirectionalLightComponent.h"
 #include "Engine/SkyLight.h"
 #include "Components/SkyLightComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "EngineUtils.h"
-#include "Materials/MaterialInstanceDynamic.h"
-#include "Engine/StaticMeshActor.h"
+#include "MaterialInstanceCache.h"
+#include "Components/StaticMeshComponent.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Camera/CameraComponent.h"
 #include "Engine/LocalPlayer.h"
@@ -34,6 +37,120 @@ class ASkyAtmosphere;
 
 DEFINE_LOG_CATEGORY_STATIC(LogDomainRandomization, Log, All);
 
+// ============================================================================
+// Sampling (shared by the seeded serial path and precomputed frame plans)
+// ============================================================================
+// Templated on the random source: FRandomStream for ApplyRandomizationWithSeed
+// (one stream per call, same draw sequence as before), FCounterRandom for
+// planned frames (one stream per frame and category).
+// ============================================================================
+
+namespace
+{
+	template <typename RandomType>
+	void SampleSky(const FSkyRandomizationConfig& SkyConfig, RandomType& Random, FPlannedSky& OutSky)
+	{
+		OutSky.bApply = SkyConfig.bRandomizeColor;
+		if (!OutSky.bApply)
+		{
+			return;
+		}
+
+		// Select random color from palette, with slight variation
+		if (SkyConfig.SkyColorPalette.Num() > 0)
+		{
+			int32 ColorIndex = Random.RandRange(0, SkyConfig.SkyColorPalette.Num() - 1);
+			FLinearColor SkyColor = SkyConfig.SkyColorPalette[ColorIndex];
+			SkyColor.R += Random.FRandRange(-0.1f, 0.1f);
+			SkyColor.G += Random.FRandRange(-0.1f, 0.1f);
+			SkyColor.B += Random.FRandRange(-0.1f, 0.1f);
+			OutSky.Color = SkyColor.GetClamped();
+			OutSky.bHasColor = true;
+		}
+
+		// Randomize sky light intensity
+		OutSky.Intensity = Random.FRandRange(0.5f, 2.0f);
+	}
+
+	template <typename RandomType>
+	void SampleLighting(const FLightingRandomizationConfig& LightingConfig, RandomType& Random, FPlannedLighting& OutLighting)
+	{
+		OutLighting.bApply = LightingConfig.bEnabled;
+		if (!OutLighting.bApply)
+		{
+			return;
+		}
+
+		// Randomize intensity - ENFORCE MINIMUM 50.0 for proper capture exposure
+		float MinIntensity = FMath::Max(LightingConfig.IntensityRange.X, 50.0f);
+		float MaxIntensity = FMath::Max(LightingConfig.IntensityRange.Y, 100.0f);
+		OutLighting.Intensity = Random.FRandRange(MinIntensity, MaxIntensity);
+
+		// Randomize sun angle (elevation and azimuth)
+		OutLighting.Elevation = Random.FRandRange(LightingConfig.ElevationRange.X, LightingConfig.ElevationRange.Y);
+		OutLighting.Azimuth = Random.FRandRange(LightingConfig.AzimuthRange.X, LightingConfig.AzimuthRange.Y);
+
+		// Randomize color temperature
+		OutLighting.Temperature = Random.FRandRange(LightingConfig.TemperatureRange.X, LightingConfig.TemperatureRange.Y);
+
+		// Randomize shadow intensity if enabled
+		OutLighting.bHasShadowAmount = LightingConfig.bRandomizeShadows;
+		if (OutLighting.bHasShadowAmount)
+		{
+			OutLighting.ShadowAmount = Random.FRandRange(
+				LightingConfig.ShadowIntensityRange.X,
+				LightingConfig.ShadowIntensityRange.Y);
+		}
+	}
+
+	template <typename RandomType>
+	FPlannedDistractor SampleDistractor(const FDistractorConfig& DistractorConfig, RandomType& Random)
+	{
+		FPlannedDistractor Distractor;
+
+		// Select random shape mesh
+		Distractor.MeshPath = TEXT("/Engine/BasicShapes/Cube.Cube");
+		if (DistractorConfig.bRandomShapes)
+		{
+			switch (Random.RandRange(0, 2))
+			{
+				case 1: Distractor.MeshPath = TEXT("/Engine/BasicShapes/Sphere.Sphere"); break;
+				case 2: Distractor.MeshPath = TEXT("/Engine/BasicShapes/Cylinder.Cylinder"); break;
+				default: break;
+			}
+		}
+
+		// Random position around the controller
+		float Distance = Random.FRandRange(DistractorConfig.DistanceRange.X, DistractorConfig.DistanceRange.Y);
+		float Angle = Random.FRandRange(0.0f, 360.0f);
+		float Height = Random.FRandRange(DistractorConfig.HeightRange.X, DistractorConfig.HeightRange.Y);
+		Distractor.Offset = FVector(
+			Distance * FMath::Cos(FMath::DegreesToRadians(Angle)),
+			Distance * FMath::Sin(FMath::DegreesToRadians(Angle)),
+			Height);
+
+		// Random rotation (FRotator arguments evaluate in unspecified order; keep P, Y, R explicit)
+		const float Pitch = Random.FRandRange(0.0f, 360.0f);
+		const float Yaw = Random.FRandRange(0.0f, 360.0f);
+		const float Roll = Random.FRandRange(0.0f, 360.0f);
+		Distractor.Rotation = FRotator(Pitch, Yaw, Roll);
+
+		// Random scale
+		Distractor.Scale = Random.FRandRange(DistractorConfig.ScaleRange.X, DistractorConfig.ScaleRange.Y);
+
+		// Random color if enabled
+		Distractor.bHasColor = DistractorConfig.bRandomColors;
+		if (Distractor.bHasColor)
+		{
+			const float R = Random.FRandRange(0.0f, 1.0f);
+			const float G = Random.FRandRange(0.0f, 1.0f);
+			const float B = Random.FRandRange(0.0f, 1.0f);
+			Distractor.Color = FLinearColor(R, G, B);
+		}
+		return Distractor;
+	}
+}
+
 ADomainRandomization::ADomainRandomization()
 {
 	PrimaryActorTick.bCanEverTick = false;
@@ -72,10 +189,9 @@ void ADomainRandomization::InitializeVehicleSystem()
 	}
 
 	// Find all actors with "Vehicle" tag
-	for (TActorIterator<AActor> It(World); It; ++It)
+	for (AActor* Actor : GetTaggedVehicles())
 	{
-		AActor* Actor = *It;
-		if (Actor && Actor->ActorHasTag(FName("Vehicle")))
+		if (Actor)
 		{
 			// Store the EDITOR-PLACED transform - this is the correct scale
 			FTransform OriginalTransform = Actor->GetTransform();
@@ -168,6 +284,74 @@ void ADomainRandomization::ApplyRandomizationWithSeed(int32 Seed)
 	ApplyRandomization();
 }
 
+FDomainRandomizationPlan ADomainRandomization::PlanFrame(const FDomainRandomizationConfig& InConfig, int32 Seed, int64 FrameIndex)
+{
+	FDomainRandomizationPlan Plan;
+	Plan.FrameIndex = FrameIndex;
+
+	FCounterRandom SkyRandom(Seed, FrameIndex, EScenePlanStream::Sky);
+	SampleSky(InConfig.Sky, SkyRandom, Plan.Sky);
+
+	FCounterRandom LightingRandom(Seed, FrameIndex, EScenePlanStream::Lighting);
+	SampleLighting(InConfig.Lighting, LightingRandom, Plan.Lighting);
+
+	if (InConfig.Distractors.bEnabled)
+	{
+		FCounterRandom DistractorRandom(Seed, FrameIndex, EScenePlanStream::Distractors);
+		const int32 NumDistractors = DistractorRandom.RandRange(
+			InConfig.Distractors.CountRange.X,
+			InConfig.Distractors.CountRange.Y);
+		Plan.Distractors.Reserve(NumDistractors);
+		for (int32 i = 0; i < NumDistractors; ++i)
+		{
+			Plan.Distractors.Add(SampleDistractor(InConfig.Distractors, DistractorRandom));
+		}
+	}
+	return Plan;
+}
+
+void ADomainRandomization::PlanFrames(int32 Seed, int32 FirstFrame, int32 NumFrames)
+{
+	if (Seed != PlanSeed)
+	{
+		// Plans from another seed must never be applied
+		PlanQueue.Reset();
+		PlanSeed = Seed;
+	}
+
+	// Copy the config: the task must not read actor state
+	PlanQueue.Launch(FirstFrame, NumFrames, [PlanConfig = Config, Seed](int64 FrameIndex)
+	{
+		return PlanFrame(PlanConfig, Seed, FrameIndex);
+	});
+
+	UE_LOG(LogDomainRandomization, Log, 
+		TEXT("Planning frames %d-%d (Seed: %d) on worker threads"), FirstFrame, FirstFrame + NumFrames - 1, Seed);
+}
+
+void ADomainRandomization::ApplyPlannedFrame(int32 FrameIndex)
+{
+	FDomainRandomizationPlan Plan;
+	if (!PlanQueue.Take(FrameIndex, Plan))
+	{
+		Plan = PlanFrame(Config, PlanSeed, FrameIndex);
+	}
+
+	ClearDistractors();
+	ApplyPlannedSky(Plan.Sky);
+	ApplyPlannedLighting(Plan.Lighting);
+	for (const FPlannedDistractor& Distractor : Plan.Distractors)
+	{
+		if (AActor* DistractorActor = SpawnSingleDistractor(Distractor))
+		{
+			SpawnedDistractors.Add(DistractorActor);
+		}
+	}
+
+	UE_LOG(LogDomainRandomization, Log, 
+		TEXT("Applied planned frame %d (%d distractors, %d plans ready)"), FrameIndex, Plan.Distractors.Num(), PlanQueue.NumReady());
+}
+
 void ADomainRandomization::RandomizeGround()
 {
 	// Ground randomization disabled - no ground component
@@ -193,27 +377,9 @@ void ADomainRandomization::RandomizeSky()
 
 	if (SkyLight && SkyLight->GetLightComponent())
 	{
-		// Select random color from palette
-		if (Config.Sky.SkyColorPalette.Num() > 0)
-		{
-			int32 ColorIndex = RandomStream.RandRange(0, Config.Sky.SkyColorPalette.Num() - 1);
-			FLinearColor SkyColor = Config.Sky.SkyColorPalette[ColorIndex];
-			
-			// Apply with slight randomization
-			SkyColor.R += GetRandomFloat(-0.1f, 0.1f);
-			SkyColor.G += GetRandomFloat(-0.1f, 0.1f);
-			SkyColor.B += GetRandomFloat(-0.1f, 0.1f);
-			SkyColor = SkyColor.GetClamped();
-
-			SkyLight->GetLightComponent()->SetLightColor(SkyColor);
-
-			UE_LOG(LogDomainRandomization, Verbose, 
-				TEXT("Sky color set to palette index %d with variation"), ColorIndex);
-		}
-
-		// Randomize sky light intensity
-		float SkyIntensity = GetRandomFloat(0.5f, 2.0f);
-		SkyLight->GetLightComponent()->SetIntensity(SkyIntensity);
+		FPlannedSky Sky;
+		SampleSky(Config.Sky, RandomStream, Sky);
+		ApplyPlannedSky(Sky);
 	}
 	else
 	{
@@ -222,6 +388,30 @@ void ADomainRandomization::RandomizeSky()
 	}
 }
 
+void ADomainRandomization::ApplyPlannedSky(const FPlannedSky& Sky)
+{
+	if (!Sky.bApply)
+	{
+		return;
+	}
+
+	ASkyLight* SkyLight = nullptr;
+	for (TActorIterator<ASkyLight> It(GetWorld()); It; ++It)
+	{
+		SkyLight = *It;
+		break;
+	}
+
+	if (SkyLight && SkyLight->GetLightComponent())
+	{
+		if (Sky.bHasColor)
+		{
+			SkyLight->GetLightComponent()->SetLightColor(Sky.Color);
+		}
+		SkyLight->GetLightComponent()->SetIntensity(Sky.Intensity);
+	}
+}
+
 void ADomainRandomization::RandomizeLighting()
 {
 	if (!Config.Lighting.bEnabled)
@@ -237,46 +427,45 @@ void ADomainRandomization::RandomizeLighting()
 		return;
 	}
 
+	FPlannedLighting Lighting;
+	SampleLighting(Config.Lighting, RandomStream, Lighting);
+	ApplyPlannedLighting(Lighting);
+}
+
+void ADomainRandomization::ApplyPlannedLighting(const FPlannedLighting& Lighting)
+{
+	if (!Lighting.bApply)
+	{
+		return;
+	}
+
+	ADirectionalLight* Sun = FindDirectionalLight();
+	if (!Sun || !Sun->GetComponent())
+	{
+		UE_LOG(LogDomainRandomization, Warning, 
+			TEXT("No DirectionalLight found in scene"));
+		return;
+	}
+
 	UDirectionalLightComponent* LightComp = Sun->GetComponent();
 
-	// Randomize intensity - ENFORCE MINIMUM 50.0 for proper capture exposure
-	float MinIntensity = FMath::Max(Config.Lighting.IntensityRange.X, 50.0f);
-	float MaxIntensity = FMath::Max(Config.Lighting.IntensityRange.Y, 100.0f);
-	float Intensity = GetRandomFloat(MinIntensity, MaxIntensity);
-	LightComp->SetIntensity(Intensity);
-	UE_LOG(LogDomainRandomization, Log, TEXT("Set DirectionalLight intensity to %.1f"), Intensity);
-
-	// Randomize sun angle (elevation and azimuth)
-	float Elevation = GetRandomFloat(
-		Config.Lighting.ElevationRange.X,
-		Config.Lighting.ElevationRange.Y);
-	float Azimuth = GetRandomFloat(
-		Config.Lighting.AzimuthRange.X,
-		Config.Lighting.AzimuthRange.Y);
-	
+	LightComp->SetIntensity(Lighting.Intensity);
+	UE_LOG(LogDomainRandomization, Log, TEXT("Set DirectionalLight intensity to %.1f"), Lighting.Intensity);
+
 	// Convert to rotation (pitch = elevation, yaw = azimuth)
-	FRotator SunRotation(-Elevation, Azimuth, 0.0f);
+	FRotator SunRotation(-Lighting.Elevation, Lighting.Azimuth, 0.0f);
 	Sun->SetActorRotation(SunRotation);
 
-	// Randomize color temperature
-	float Temperature = GetRandomFloat(
-		Config.Lighting.TemperatureRange.X,
-		Config.Lighting.TemperatureRange.Y);
-	FLinearColor LightColor = FLinearColor::MakeFromColorTemperature(Temperature);
-	LightComp->SetLightColor(LightColor);
+	LightComp->SetLightColor(FLinearColor::MakeFromColorTemperature(Lighting.Temperature));
 
-	// Randomize shadow intensity if enabled
-	if (Config.Lighting.bRandomizeShadows)
+	if (Lighting.bHasShadowAmount)
 	{
-		float ShadowIntensity = GetRandomFloat(
-			Config.Lighting.ShadowIntensityRange.X,
-			Config.Lighting.ShadowIntensityRange.Y);
-		LightComp->SetShadowAmount(ShadowIntensity);
+		LightComp->SetShadowAmount(Lighting.ShadowAmount);
 	}
 
 	UE_LOG(LogDomainRandomization, Log, 
 		TEXT("Lighting: Intensity=%.2f, Elevation=%.1f, Azimuth=%.1f, Temp=%.0fK"),
-		Intensity, Elevation, Azimuth, Temperature);
+		Lighting.Intensity, Lighting.Elevation, Lighting.Azimuth, Lighting.Temperature);
 }
 
 void ADomainRandomization::SetDistractorsEnabled(bool bEnabled)
@@ -299,7 +488,7 @@ void ADomainRandomization::SpawnDistractors()
 
 	for (int32 i = 0; i < NumDistractors; ++i)
 	{
-		AActor* Distractor = SpawnSingleDistractor();
+		AActor* Distractor = SpawnSingleDistractor(SampleDistractor(Config.Distractors, RandomStream));
 		if (Distractor)
 		{
 			SpawnedDistractors.Add(Distractor);
@@ -310,7 +499,7 @@ void ADomainRandomization::SpawnDistractors()
 		TEXT("Spawned %d distractor objects"), SpawnedDistractors.Num());
 }
 
-AActor* ADomainRandomization::SpawnSingleDistractor()
+AActor* ADomainRandomization::SpawnSingleDistractor(const FPlannedDistractor& Distractor)
 {
 	UWorld* World = GetWorld();
 	if (!World)
@@ -318,81 +507,29 @@ AActor* ADomainRandomization::SpawnSingleDistractor()
 		return nullptr;
 	}
 
-	// Select random shape mesh
-	FString MeshPath;
-	if (Config.Distractors.bRandomShapes)
-	{
-		int32 ShapeIndex = RandomStream.RandRange(0, 2);
-		switch (ShapeIndex)
-		{
-			case 0: MeshPath = TEXT("/Engine/BasicShapes/Cube.Cube"); break;
-			case 1: MeshPath = TEXT("/Engine/BasicShapes/Sphere.Sphere"); break;
-			case 2: MeshPath = TEXT("/Engine/BasicShapes/Cylinder.Cylinder"); break;
-		}
-	}
-	else
-	{
-		MeshPath = TEXT("/Engine/BasicShapes/Cube.Cube");
-	}
-
-	UStaticMesh* Mesh = Cast<UStaticMesh>(
-		StaticLoadObject(UStaticMesh::StaticClass(), nullptr, *MeshPath));
-	if (!Mesh)
-	{
-		return nullptr;
-	}
-
-	// Calculate random position
-	float Distance = GetRandomFloat(
-		Config.Distractors.DistanceRange.X,
-		Config.Distractors.DistanceRange.Y);
-	float Angle = GetRandomFloat(0.0f, 360.0f);
-	float Height = GetRandomFloat(
-		Config.Distractors.HeightRange.X,
-		Config.Distractors.HeightRange.Y);
+	FVector Location = GetActorLocation() + Distractor.Offset;
 
-	FVector Location = GetActorLocation() + FVector(
-		Distance * FMath::Cos(FMath::DegreesToRadians(Angle)),
-		Distance * FMath::Sin(FMath::DegreesToRadians(Angle)),
-		Height);
+	// Reuse a parked shape of the same mesh, else spawn one
+	AActor* DistractorActor = UActorPoolSubsystem::AcquireOrSpawn(World, Distractor.MeshPath, Location, Distractor.Rotation, NAME_None,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
 
-	// Random rotation
-	FRotator Rotation(
-		GetRandomFloat(0.0f, 360.0f),
-		GetRandomFloat(0.0f, 360.0f),
-		GetRandomFloat(0.0f, 360.0f));
-
-	// Random scale
-	float Scale = GetRandomFloat(
-		Config.Distractors.ScaleRange.X,
-		Config.Distractors.ScaleRange.Y);
-
-	// Spawn static mesh actor
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = 
-		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-	AStaticMeshActor* DistractorActor = World->SpawnActor<AStaticMeshActor>(
-		AStaticMeshActor::StaticClass(), Location, Rotation, SpawnParams);
-
-	if (DistractorActor)
+	UStaticMeshComponent* MeshComp = DistractorActor ? DistractorActor->FindComponentByClass<UStaticMeshComponent>() : nullptr;
+	if (MeshComp)
 	{
-		UStaticMeshComponent* MeshComp = DistractorActor->GetStaticMeshComponent();
-		MeshComp->SetStaticMesh(Mesh);
-		MeshComp->SetWorldScale3D(FVector(Scale));
+		MeshComp->SetWorldScale3D(FVector(Distractor.Scale));
 
-		// Random color if enabled
-		if (Config.Distractors.bRandomColors)
+		// Random color if enabled; pooled distractors keep their MID across scenes
+		UMaterialInstanceCacheSubsystem* MaterialCache = UMaterialInstanceCacheSubsystem::Get(World);
+		if (MaterialCache && Distractor.bHasColor)
 		{
-			UMaterialInstanceDynamic* DynMat = MeshComp->CreateAndSetMaterialInstanceDynamic(0);
-			if (DynMat)
-			{
-				FLinearColor RandomColor(
-					GetRandomFloat(0.0f, 1.0f),
-					GetRandomFloat(0.0f, 1.0f),
-					GetRandomFloat(0.0f, 1.0f));
-				DynMat->SetVectorParameterValue(FName("BaseColor"), RandomColor);
-			}
+			FMaterialParameterBatch Batch;
+			Batch.SetVector(FName("BaseColor"), Distractor.Color);
+			MaterialCache->ApplyParameters(MeshComp, 0, Batch);
+		}
+		else if (MaterialCache)
+		{
+			// A reused distractor may still carry last scene's color
+			MaterialCache->RestoreBaseMaterial(MeshComp, 0);
 		}
 
 		// Tag as distractor for annotation exclusion
@@ -404,11 +541,19 @@ AActor* ADomainRandomization::SpawnSingleDistractor()
 
 void ADomainRandomization::ClearDistractors()
 {
+	UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(GetWorld());
 	for (AActor* Distractor : SpawnedDistractors)
 	{
 		if (Distractor && Distractor->IsValidLowLevel())
 		{
-			Distractor->Destroy();
+			if (ActorPool)
+			{
+				ActorPool->Release(Distractor);
+			}
+			else
+			{
+				Distractor->Destroy();
+			}
 		}
 	}
 
@@ -495,6 +640,10 @@ void ADomainRandomization::RegisterVehicle(AActor* Vehicle)
 		if (!Vehicle->ActorHasTag(FName("Vehicle")))
 		{
 			Vehicle->Tags.Add(FName("Vehicle"));
+			if (UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(GetWorld()))
+			{
+				ActorIndex->ReindexActor(Vehicle);
+			}
 		}
 
 		UE_LOG(LogDomainRandomization, Log, 
@@ -538,8 +687,8 @@ int32 ADomainRandomization::HideAllVehicles()
 		TEXT("=== AUTHORITATIVE CLEANUP: HideAllVehicles ==="));
 
 	int32 HiddenCount = 0;
+	int32 ChangedCount = 0;
 	int32 FailedCount = 0;
-	const float UndergroundZ = -100000.0f;  // 1km below ground
 
 	UWorld* World = GetWorld();
 	if (!World)
@@ -549,26 +698,20 @@ int32 ADomainRandomization::HideAllVehicles()
 		return 0;
 	}
 
-	// WORLD SWEEP: Iterate ALL actors with "Vehicle" tag
-	for (TActorIterator<AActor> It(World); It; ++It)
+	// WORLD SWEEP: every actor with "Vehicle" tag, via the actor index (no per-call world scan).
+	// HARD CLEANUP (hide, no collision, underground) is only applied to vehicles not already
+	// in that state, so vehicles hidden by the previous frame cost no render/physics updates.
+	for (AActor* Actor : GetTaggedVehicles())
 	{
-		AActor* Actor = *It;
-		if (Actor && Actor->ActorHasTag(FName("Vehicle")))
+		if (Actor)
 		{
-			// Perform HARD CLEANUP:
-			// 1. Hide
-			// 2. Disable collision
-			// 3. Move underground
-			Actor->SetActorHiddenInGame(true);
-			Actor->SetActorEnableCollision(false);
-			
-			FVector CurrentLoc = Actor->GetActorLocation();
-			Actor->SetActorLocation(FVector(CurrentLoc.X, CurrentLoc.Y, UndergroundZ));
-			
+			if (FSceneStateDelta::ApplyHiddenParked(Actor))
+			{
+				ChangedCount++;
+				UE_LOG(LogDomainRandomization, Verbose, 
+					TEXT("  Hidden: %s"), *Actor->GetName());
+			}
 			HiddenCount++;
-			
-			UE_LOG(LogDomainRandomization, Verbose, 
-				TEXT("  Hidden: %s"), *Actor->GetName());
 		}
 	}
 
@@ -577,11 +720,7 @@ int32 ADomainRandomization::HideAllVehicles()
 	{
 		if (Vehicle && Vehicle->IsValidLowLevel() && !Vehicle->IsHidden())
 		{
-			Vehicle->SetActorHiddenInGame(true);
-			Vehicle->SetActorEnableCollision(false);
-			
-			FVector CurrentLoc = Vehicle->GetActorLocation();
-			Vehicle->SetActorLocation(FVector(CurrentLoc.X, CurrentLoc.Y, UndergroundZ));
+			FSceneStateDelta::ApplyHiddenParked(Vehicle);
 			
 			FailedCount++;  // This means world sweep missed something!
 			
@@ -590,7 +729,7 @@ int32 ADomainRandomization::HideAllVehicles()
 		}
 	}
 
-	// VERIFICATION
+	// VERIFICATION: independent world sweep, catches vehicles the tag index missed
 	int32 StillVisible = GetVisibleVehicleCountWorldSweep();
 	if (StillVisible > 0)
 	{
@@ -600,12 +739,22 @@ int32 ADomainRandomization::HideAllVehicles()
 	else
 	{
 		UE_LOG(LogDomainRandomization, Log, 
-			TEXT("=== CLEANUP VERIFIED: %d vehicles hidden, 0 visible ==="), HiddenCount);
+			TEXT("=== CLEANUP VERIFIED: %d vehicles hidden (%d changed), 0 visible ==="), HiddenCount, ChangedCount);
 	}
 
 	return HiddenCount;
 }
 
+TArray<AActor*> ADomainRandomization::GetTaggedVehicles() const
+{
+	TArray<AActor*> Vehicles;
+	if (UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(GetWorld()))
+	{
+		ActorIndex->GetActorsWithTag(FName("Vehicle"), Vehicles);
+	}
+	return Vehicles;
+}
+
 int32 ADomainRandomization::GetVisibleVehicleCountWorldSweep() const
 {
 	int32 VisibleCount = 0;
@@ -617,7 +766,8 @@ int32 ADomainRandomization::GetVisibleVehicleCountWorldSweep() const
 		return 0;
 	}
 
-	// WORLD SWEEP: Check ALL actors with "Vehicle" tag
+	// WORLD SWEEP: Check ALL actors with "Vehicle" tag. Deliberately not the actor index,
+	// so it stays an independent check of HideAllVehicles
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
 		AActor* Actor = *It;
@@ -0,0 +1,230 @@
+/******************************************************************************
+ * VantageCV - Ground Height Subsystem Implementation
+ ******************************************************************************
+ * File: GroundHeightSubsystem.cpp
+ * Description: Async-built heightfield and batched ground-height queries
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "GroundHeightSubsystem.h"
+#include "Engine/World.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGroundHeight, Log, All);
+
+namespace
+{
+	/** Same trace window GetGroundZ always used: 5 m above to 10 m below */
+	constexpr float TraceAbove = 500.0f;
+	constexpr float TraceBelow = 1000.0f;
+
+	/** Upper bound on heightfield samples; cell size grows to stay under it */
+	constexpr int64 MaxSamples = 1024 * 1024;
+
+	/** Neighbouring samples further apart than this are a step (curb), not a slope */
+	constexpr float MaxInterpolatedStep = 5.0f;
+}
+
+UGroundHeightSubsystem* UGroundHeightSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGroundHeightSubsystem>() : nullptr;
+}
+
+bool UGroundHeightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::Editor;
+}
+
+void UGroundHeightSubsystem::Deinitialize()
+{
+	Invalidate();
+	Super::Deinitialize();
+}
+
+void UGroundHeightSubsystem::BuildHeightfield(const FBox& InRegion, float InCellSize)
+{
+	UWorld* World = GetWorld();
+	if (!World || !InRegion.IsValid)
+	{
+		return;
+	}
+
+	if (InRegion == RequestedRegion && InCellSize == RequestedCellSize && (bHeightfieldReady || PendingTraces > 0))
+	{
+		return;
+	}
+
+	Invalidate();
+	RequestedRegion = InRegion;
+	RequestedCellSize = InCellSize;
+
+	Region = FBox2D(FVector2D(InRegion.Min), FVector2D(InRegion.Max));
+	TraceTopZ = InRegion.Max.Z + TraceAbove;
+	TraceBottomZ = InRegion.Min.Z - TraceBelow;
+
+	const FVector2D Size = Region.GetSize();
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	const double MinCellSize = FMath::Sqrt(Size.X * Size.Y / (double)MaxSamples);
+	CellSize = FMath::Max(CellSize, (float)MinCellSize);
+
+	NumX = FMath::CeilToInt32(Size.X / CellSize) + 1;
+	NumY = FMath::CeilToInt32(Size.Y / CellSize) + 1;
+	const int32 NumSamples = NumX * NumY;
+
+	Heights.SetNumZeroed(NumSamples);
+	HasHeight.Init(false, NumSamples);
+
+	const FCollisionQueryParams QueryParams = MakeQueryParams();
+	const FTraceDelegate Delegate = FTraceDelegate::CreateUObject(this, &UGroundHeightSubsystem::HandleTraceDone, Generation);
+	for (int32 SampleY = 0; SampleY < NumY; ++SampleY)
+	{
+		for (int32 SampleX = 0; SampleX < NumX; ++SampleX)
+		{
+			const double X = Region.Min.X + SampleX * CellSize;
+			const double Y = Region.Min.Y + SampleY * CellSize;
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+				FVector(X, Y, TraceTopZ), FVector(X, Y, TraceBottomZ), ECC_WorldStatic,
+				QueryParams, FCollisionResponseParams::DefaultResponseParam, &Delegate,
+				(uint32)(SampleY * NumX + SampleX));
+		}
+	}
+	PendingTraces = NumSamples;
+
+	UE_LOG(LogGroundHeight, Log, TEXT("Building ground heightfield: %dx%d samples at %.1f cm"), NumX, NumY, CellSize);
+}
+
+void UGroundHeightSubsystem::Invalidate()
+{
+	// Traces already queued still complete; the generation check drops them
+	Generation++;
+	PendingTraces = 0;
+	bHeightfieldReady = false;
+	Heights.Reset();
+	HasHeight.Reset();
+	NumX = NumY = 0;
+	RequestedRegion = FBox(ForceInit);
+	RequestedCellSize = 0.0f;
+}
+
+void UGroundHeightSubsystem::HandleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 TraceGeneration)
+{
+	if (TraceGeneration != Generation || !Heights.IsValidIndex((int32)Datum.UserData))
+	{
+		return;
+	}
+
+	const int32 Index = (int32)Datum.UserData;
+	if (Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit)
+	{
+		Heights[Index] = Datum.OutHits[0].ImpactPoint.Z;
+		HasHeight[Index] = true;
+	}
+
+	if (--PendingTraces == 0)
+	{
+		bHeightfieldReady = true;
+		UE_LOG(LogGroundHeight, Log, TEXT("Ground heightfield ready (%d samples)"), Heights.Num());
+	}
+}
+
+void UGroundHeightSubsystem::GetGroundHeights(TConstArrayView<FVector> Points, TArray<float>& OutHeights)
+{
+	OutHeights.SetNumUninitialized(Points.Num());
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		const FVector& Point = Points[Index];
+		float GroundZ = 0.0f;
+		if (SampleHeightfield(Point, GroundZ))
+		{
+			NumHeightfieldHits++;
+		}
+		else
+		{
+			NumTraceFallbacks++;
+			if (!TraceGround(Point + FVector(0, 0, TraceAbove), Point - FVector(0, 0, TraceBelow), GroundZ))
+			{
+				GroundZ = Point.Z;
+			}
+		}
+		OutHeights[Index] = GroundZ;
+	}
+}
+
+float UGroundHeightSubsystem::GetGroundHeight(const FVector& Point)
+{
+	TArray<float> Result;
+	GetGroundHeights(MakeArrayView(&Point, 1), Result);
+	return Result[0];
+}
+
+bool UGroundHeightSubsystem::SampleHeightfield(const FVector& Point, float& OutZ) const
+{
+	if (!bHeightfieldReady || !Region.IsInside(FVector2D(Point)))
+	{
+		return false;
+	}
+
+	const double FX = (Point.X - Region.Min.X) / CellSize;
+	const double FY = (Point.Y - Region.Min.Y) / CellSize;
+	const int32 X0 = FMath::Clamp(FMath::FloorToInt32(FX), 0, NumX - 1);
+	const int32 Y0 = FMath::Clamp(FMath::FloorToInt32(FY), 0, NumY - 1);
+	const int32 X1 = FMath::Min(X0 + 1, NumX - 1);
+	const int32 Y1 = FMath::Min(Y0 + 1, NumY - 1);
+	const int32 Corners[4] = { Y0 * NumX + X0, Y0 * NumX + X1, Y1 * NumX + X0, Y1 * NumX + X1 };
+
+	bool bAllValid = true;
+	float MinZ = FLT_MAX, MaxZ = -FLT_MAX;
+	for (const int32 Corner : Corners)
+	{
+		bAllValid &= HasHeight[Corner];
+		MinZ = FMath::Min(MinZ, Heights[Corner]);
+		MaxZ = FMath::Max(MaxZ, Heights[Corner]);
+	}
+
+	// Across a step or next to a hole the exact point is traced instead
+	if (!bAllValid || MaxZ - MinZ > MaxInterpolatedStep)
+	{
+		return false;
+	}
+
+	OutZ = FMath::BiLerp(Heights[Corners[0]], Heights[Corners[1]], Heights[Corners[2]], Heights[Corners[3]],
+		(float)(FX - X0), (float)(FY - Y0));
+	return true;
+}
+
+bool UGroundHeightSubsystem::TraceGround(const FVector& Start, const FVector& End, float& OutZ) const
+{
+	UWorld* World = GetWorld();
+	FHitResult HitResult;
+	if (World && World->LineTraceSingleByChannel(HitResult, Start, End, ECC_WorldStatic, MakeQueryParams()))
+	{
+		OutZ = HitResult.ImpactPoint.Z;
+		return true;
+	}
+	return false;
+}
+
+FCollisionQueryParams UGroundHeightSubsystem::MakeQueryParams() const
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(VantageCVGroundHeight), true);
+	return QueryParams;
+}
+
+FString UGroundHeightSubsystem::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetBoolField("ready", bHeightfieldReady);
+	RootObj->SetNumberField("samples_x", NumX);
+	RootObj->SetNumberField("samples_y", NumY);
+	RootObj->SetNumberField("cell_size", CellSize);
+	RootObj->SetNumberField("pending_traces", PendingTraces);
+	RootObj->SetNumberField("heightfield_hits", (double)NumHeightfieldHits);
+	RootObj->SetNumberField("trace_fallbacks", (double)NumTraceFallbacks);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	return OutputString;
+}
@@ -0,0 +1,431 @@
+/******************************************************************************
+ * VantageCV - Lighting Preset Subsystem Implementation
+ ******************************************************************************
+ * File: LightingPresetSubsystem.cpp
+ * Description: Preset registry, cached light handles and change-tracked
+ *              sky capture
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "LightingPresetSubsystem.h"
+#include "SceneStateDelta.h"
+#include "DataCapture.h"
+#include "Engine/DirectionalLight.h"
+#include "Engine/PointLight.h"
+#include "Engine/SpotLight.h"
+#include "Engine/SkyLight.h"
+#include "Engine/TextureCube.h"
+#include "Components/DirectionalLightComponent.h"
+#include "Components/SkyLightComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogLightingPreset, Log, All);
+
+namespace
+{
+	/** Sun direction change (degrees) below which the sky capture is still valid */
+	constexpr float SunRotationTolerance = 0.01f;
+
+	/** Sun roll of the reference level, shared by the Python time-of-day states */
+	constexpr float TimeOfDaySunRoll = -55.49f;
+
+	bool IsSceneLight(const AActor* Actor)
+	{
+		return Actor && (Actor->IsA<APointLight>() || Actor->IsA<ASpotLight>() || Actor->IsA<ADirectionalLight>());
+	}
+
+	FVantageCVLightingPreset MakeTimeOfDayPreset(const TCHAR* Name, float SunPitch, float SunYaw, float SkyIntensity, float ExposureBias)
+	{
+		FVantageCVLightingPreset Preset;
+		Preset.Name = FName(Name);
+		Preset.SunRotation = FRotator(SunPitch, SunYaw, TimeOfDaySunRoll);
+		Preset.SkyIntensity = SkyIntensity;
+		Preset.ExposureBias = ExposureBias;
+		return Preset;
+	}
+}
+
+ULightingPresetSubsystem* ULightingPresetSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<ULightingPresetSubsystem>() : nullptr;
+}
+
+bool ULightingPresetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::Editor;
+}
+
+void ULightingPresetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	RegisterBuiltInPresets();
+	for (const FVantageCVLightingPreset& Preset : ConfiguredPresets)
+	{
+		RegisterPreset(Preset);
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+			FOnActorSpawned::FDelegate::CreateUObject(this, &ULightingPresetSubsystem::HandleActorSpawned));
+	}
+}
+
+void ULightingPresetSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	UE_LOG(LogLightingPreset, Log, TEXT("Lighting presets: %lld applies, %lld sky recaptures, %lld skipped"),
+		NumApplies, NumRecaptures, NumRecapturesSkipped);
+
+	Presets.Reset();
+	Cubemaps.Reset();
+	SceneLights.Reset();
+	Super::Deinitialize();
+}
+
+void ULightingPresetSubsystem::RegisterBuiltInPresets()
+{
+	// Bright uniform capture lighting (formerly hard-coded in SceneController::SetupPerfectLighting)
+	FVantageCVLightingPreset Perfect;
+	Perfect.Name = FName(TEXT("Perfect"));
+	Perfect.SunRotation = FRotator(-45.0f, 0.0f, 0.0f);
+	Perfect.SunIntensity = 50.0f;
+	Perfect.bSetSunColor = true;
+	Perfect.SunColor = FLinearColor::White;
+	Perfect.SunTemperature = 6500.0f;
+	Perfect.SkyIntensity = 2.0f;
+	Perfect.bSetSkyColor = true;
+	Perfect.SkyColor = FLinearColor(0.9f, 0.95f, 1.0f);
+	RegisterPreset(Perfect);
+
+	// Same values as DEFAULT_TIME_STATES in time_augmentation_controller.py
+	RegisterPreset(MakeTimeOfDayPreset(TEXT("dawn"), -8.0f, 105.0f, 0.3f, 1.5f));
+	RegisterPreset(MakeTimeOfDayPreset(TEXT("morning"), -20.5f, 173.0f, 1.0f, 3.0f));
+	RegisterPreset(MakeTimeOfDayPreset(TEXT("noon"), -21.5f, 175.0f, 1.0f, 2.5f));
+	RegisterPreset(MakeTimeOfDayPreset(TEXT("afternoon"), -21.0f, 177.0f, 1.0f, 3.0f));
+	RegisterPreset(MakeTimeOfDayPreset(TEXT("sunset"), -10.0f, 255.0f, 0.4f, 1.0f));
+	RegisterPreset(MakeTimeOfDayPreset(TEXT("night"), 15.0f, 270.0f, 0.05f, 3.0f));
+}
+
+void ULightingPresetSubsystem::RegisterPreset(const FVantageCVLightingPreset& Preset)
+{
+	if (Preset.Name.IsNone())
+	{
+		UE_LOG(LogLightingPreset, Warning, TEXT("RegisterPreset: preset has no name"));
+		return;
+	}
+	Presets.Add(Preset.Name, Preset);
+}
+
+const FVantageCVLightingPreset* ULightingPresetSubsystem::FindPreset(FName PresetName) const
+{
+	return Presets.Find(PresetName);
+}
+
+bool ULightingPresetSubsystem::ApplyPreset(FName PresetName, bool bSpawnMissingLights)
+{
+	const FVantageCVLightingPreset* Preset = Presets.Find(PresetName);
+	if (!Preset)
+	{
+		UE_LOG(LogLightingPreset, Warning, TEXT("Unknown lighting preset: %s"), *PresetName.ToString());
+		return false;
+	}
+	return ApplyPreset(*Preset, bSpawnMissingLights);
+}
+
+bool ULightingPresetSubsystem::ApplyPresetWithExposure(FName PresetName, bool bSpawnMissingLights)
+{
+	if (!ApplyPreset(PresetName, bSpawnMissingLights))
+	{
+		return false;
+	}
+
+	const float ExposureBias = Presets.FindChecked(PresetName).ExposureBias;
+	for (TActorIterator<ADataCapture> It(GetWorld()); It; ++It)
+	{
+		It->SetExposureBiasOverride(ExposureBias);
+	}
+	return true;
+}
+
+bool ULightingPresetSubsystem::ApplyPreset(const FVantageCVLightingPreset& Preset, bool bSpawnMissingLights)
+{
+	ADirectionalLight* SunLight = GetSun(bSpawnMissingLights);
+	ASkyLight* Sky = GetSkyLight(bSpawnMissingLights);
+	if (!SunLight && !Sky)
+	{
+		UE_LOG(LogLightingPreset, Warning, TEXT("ApplyPreset %s: level has no sun or sky light"), *Preset.Name.ToString());
+		return false;
+	}
+
+	++NumApplies;
+
+	// Writes only what differs, so lights already matching the preset are not re-dirtied
+	auto CountChange = [this](bool bChanged)
+	{
+		++(bChanged ? NumParametersWritten : NumParametersSkipped);
+		return bChanged;
+	};
+
+	if (SunLight)
+	{
+		if (Preset.bSetSunRotation)
+		{
+			CountChange(FSceneStateDelta::ApplyTransform(SunLight, SunLight->GetActorLocation(), Preset.SunRotation));
+		}
+
+		if (UDirectionalLightComponent* SunComp = Cast<UDirectionalLightComponent>(SunLight->GetLightComponent()))
+		{
+			if (Preset.SunIntensity >= 0.0f && CountChange(!FMath::IsNearlyEqual(SunComp->Intensity, Preset.SunIntensity)))
+			{
+				SunComp->SetIntensity(Preset.SunIntensity);
+			}
+			if (Preset.bSetSunColor && CountChange(!SunComp->GetLightColor().Equals(Preset.SunColor)))
+			{
+				SunComp->SetLightColor(Preset.SunColor);
+			}
+			if (Preset.SunTemperature > 0.0f && CountChange(!FMath::IsNearlyEqual(SunComp->Temperature, Preset.SunTemperature)))
+			{
+				SunComp->SetTemperature(Preset.SunTemperature);
+			}
+		}
+	}
+
+	USkyLightComponent* SkyComp = Sky ? Sky->GetLightComponent() : nullptr;
+	if (SkyComp)
+	{
+		if (Preset.SkyIntensity >= 0.0f && CountChange(!FMath::IsNearlyEqual(SkyComp->Intensity, Preset.SkyIntensity)))
+		{
+			SkyComp->SetIntensity(Preset.SkyIntensity);
+		}
+		if (Preset.bSetSkyColor && CountChange(!SkyComp->GetLightColor().Equals(Preset.SkyColor)))
+		{
+			SkyComp->SetLightColor(Preset.SkyColor);
+		}
+
+		// Pre-captured presets swap the source texture; the rest (and failed loads) use scene capture
+		UTextureCube* Cubemap = Preset.SkyCubemapPath.IsEmpty() ? nullptr : LoadCubemap(Preset.SkyCubemapPath);
+		if (Cubemap)
+		{
+			if (SkyComp->SourceType != SLS_SpecifiedCubemap || SkyComp->Cubemap != Cubemap)
+			{
+				SkyComp->SourceType = SLS_SpecifiedCubemap;
+				SkyComp->SetCubemap(Cubemap);
+				SkyComp->SetCaptureIsDirty();
+				bHasSkyCapture = false;
+				++NumCubemapSwaps;
+			}
+		}
+		else
+		{
+			if (SkyComp->SourceType != SLS_CapturedScene)
+			{
+				SkyComp->SourceType = SLS_CapturedScene;
+				bHasSkyCapture = false;
+			}
+			UpdateSkyCapture();
+		}
+	}
+
+	ActivePreset = Preset.Name;
+	return true;
+}
+
+bool ULightingPresetSubsystem::UpdateSkyCapture(bool bForce)
+{
+	ASkyLight* Sky = SkyLight.Get();
+	USkyLightComponent* SkyComp = Sky ? Sky->GetLightComponent() : nullptr;
+	if (!SkyComp || SkyComp->SourceType != SLS_CapturedScene || SkyComp->bRealTimeCapture)
+	{
+		return false;
+	}
+
+	// Sky intensity and color scale the capture at shading time; only the sun direction changes what is captured
+	const ADirectionalLight* SunLight = Sun.Get();
+	const FRotator SunRotation = SunLight ? SunLight->GetActorRotation() : FRotator::ZeroRotator;
+	if (!bForce && bHasSkyCapture && SunRotation.Equals(CapturedSunRotation, SunRotationTolerance))
+	{
+		++NumRecapturesSkipped;
+		return false;
+	}
+
+	SkyComp->RecaptureSky();
+	bHasSkyCapture = true;
+	CapturedSunRotation = SunRotation;
+	++NumRecaptures;
+	return true;
+}
+
+ADirectionalLight* ULightingPresetSubsystem::GetSun(bool bSpawnIfMissing)
+{
+	if (ADirectionalLight* Cached = Sun.Get())
+	{
+		return Cached;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Use first directional light found
+	for (TActorIterator<ADirectionalLight> It(World); It; ++It)
+	{
+		Sun = *It;
+		bHasSkyCapture = false;
+		return *It;
+	}
+
+	if (!bSpawnIfMissing)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = FName(TEXT("VantageCV_Sun"));
+	ADirectionalLight* Spawned = World->SpawnActor<ADirectionalLight>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	if (Spawned)
+	{
+		UE_LOG(LogLightingPreset, Log, TEXT("Created new directional light: VantageCV_Sun"));
+		Sun = Spawned;
+		bHasSkyCapture = false;
+	}
+	return Spawned;
+}
+
+ASkyLight* ULightingPresetSubsystem::GetSkyLight(bool bSpawnIfMissing)
+{
+	if (ASkyLight* Cached = SkyLight.Get())
+	{
+		return Cached;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	for (TActorIterator<ASkyLight> It(World); It; ++It)
+	{
+		SkyLight = *It;
+		bHasSkyCapture = false;
+		return *It;
+	}
+
+	if (!bSpawnIfMissing)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = FName(TEXT("VantageCV_SkyLight"));
+	ASkyLight* Spawned = World->SpawnActor<ASkyLight>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	if (Spawned)
+	{
+		UE_LOG(LogLightingPreset, Log, TEXT("Created new sky light: VantageCV_SkyLight"));
+		SkyLight = Spawned;
+		bHasSkyCapture = false;
+	}
+	return Spawned;
+}
+
+void ULightingPresetSubsystem::GetSceneLights(TArray<ALight*>& OutLights)
+{
+	RefreshSceneLights();
+
+	OutLights.Reset(SceneLights.Num());
+	for (int32 Index = SceneLights.Num() - 1; Index >= 0; --Index)
+	{
+		if (ALight* Light = SceneLights[Index].Get())
+		{
+			OutLights.Add(Light);
+		}
+		else
+		{
+			SceneLights.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void ULightingPresetSubsystem::RefreshSceneLights()
+{
+	if (bSceneLightsBuilt)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	SceneLights.Reset();
+	for (TActorIterator<ALight> It(World); It; ++It)
+	{
+		if (IsSceneLight(*It))
+		{
+			SceneLights.Add(*It);
+		}
+	}
+	bSceneLightsBuilt = true;
+}
+
+void ULightingPresetSubsystem::HandleActorSpawned(AActor* Actor)
+{
+	// Before the first lookup the initial sweep will find it anyway
+	if (bSceneLightsBuilt && IsSceneLight(Actor))
+	{
+		SceneLights.Add(Cast<ALight>(Actor));
+	}
+}
+
+UTextureCube* ULightingPresetSubsystem::LoadCubemap(const FString& CubemapPath)
+{
+	if (TObjectPtr<UTextureCube>* Cached = Cubemaps.Find(CubemapPath))
+	{
+		return Cached->Get();
+	}
+
+	UTextureCube* Cubemap = LoadObject<UTextureCube>(nullptr, *CubemapPath);
+	if (!Cubemap)
+	{
+		UE_LOG(LogLightingPreset, Warning, TEXT("Failed to load sky cubemap: %s"), *CubemapPath);
+	}
+
+	// Failed paths are cached as null so they are not retried every apply
+	Cubemaps.Add(CubemapPath, Cubemap);
+	return Cubemap;
+}
+
+FString ULightingPresetSubsystem::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetNumberField(TEXT("num_presets"), Presets.Num());
+	Root->SetStringField(TEXT("active_preset"), ActivePreset.ToString());
+	Root->SetBoolField(TEXT("has_sun"), Sun.IsValid());
+	Root->SetBoolField(TEXT("has_sky_light"), SkyLight.IsValid());
+	Root->SetNumberField(TEXT("num_scene_lights"), SceneLights.Num());
+	Root->SetNumberField(TEXT("num_cubemaps"), Cubemaps.Num());
+	Root->SetNumberField(TEXT("applies"), (double)NumApplies);
+	Root->SetNumberField(TEXT("parameters_written"), (double)NumParametersWritten);
+	Root->SetNumberField(TEXT("parameters_skipped"), (double)NumParametersSkipped);
+	Root->SetNumberField(TEXT("recaptures"), (double)NumRecaptures);
+	Root->SetNumberField(TEXT("recaptures_skipped"), (double)NumRecapturesSkipped);
+	Root->SetNumberField(TEXT("cubemap_swaps"), (double)NumCubemapSwaps);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+	return Output;
+}
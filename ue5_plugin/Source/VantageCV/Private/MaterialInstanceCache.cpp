@@ -0,0 +1,198 @@
+/******************************************************************************
+ * VantageCV - Material Instance Cache Implementation
+ ******************************************************************************
+ * File: MaterialInstanceCache.cpp
+ * Description: Per-slot MID reuse and by-index parameter updates
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "MaterialInstanceCache.h"
+#include "Components/MeshComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/World.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMaterialCache, Log, All);
+
+namespace
+{
+	/** New components between sweeps for destroyed ones */
+	constexpr int32 PruneInterval = 256;
+}
+
+UMaterialInstanceCacheSubsystem* UMaterialInstanceCacheSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UMaterialInstanceCacheSubsystem>() : nullptr;
+}
+
+bool UMaterialInstanceCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::Editor;
+}
+
+void UMaterialInstanceCacheSubsystem::Deinitialize()
+{
+	UE_LOG(LogMaterialCache, Log, TEXT("Material cache: %lld MIDs created, %lld reused"), NumCreated, NumReused);
+	Entries.Reset();
+	Super::Deinitialize();
+}
+
+UMaterialInstanceDynamic* UMaterialInstanceCacheSubsystem::GetOrCreate(UMeshComponent* Component, int32 SlotIndex)
+{
+	FCachedSlot* Slot = FindOrCreateSlot(Component, SlotIndex);
+	return Slot ? Slot->Instance.Get() : nullptr;
+}
+
+bool UMaterialInstanceCacheSubsystem::ApplyParameters(UMeshComponent* Component, int32 SlotIndex, const FMaterialParameterBatch& Batch)
+{
+	FCachedSlot* Slot = FindOrCreateSlot(Component, SlotIndex);
+	UMaterialInstanceDynamic* Instance = Slot ? Slot->Instance.Get() : nullptr;
+	if (!Instance)
+	{
+		return false;
+	}
+
+	// Indices are resolved once per slot; afterwards writes skip the parameter name search
+	for (const TPair<FName, float>& Scalar : Batch.Scalars)
+	{
+		const int32* Index = Slot->ScalarIndices.Find(Scalar.Key);
+		if (!Index || !Instance->SetScalarParameterValueByIndex(*Index, Scalar.Value))
+		{
+			int32 NewIndex = INDEX_NONE;
+			if (Instance->InitializeScalarParameterAndGetIndex(Scalar.Key, Scalar.Value, NewIndex))
+			{
+				Slot->ScalarIndices.Add(Scalar.Key, NewIndex);
+			}
+		}
+	}
+
+	for (const TPair<FName, FLinearColor>& Vector : Batch.Vectors)
+	{
+		const int32* Index = Slot->VectorIndices.Find(Vector.Key);
+		if (!Index || !Instance->SetVectorParameterValueByIndex(*Index, Vector.Value))
+		{
+			int32 NewIndex = INDEX_NONE;
+			if (Instance->InitializeVectorParameterAndGetIndex(Vector.Key, Vector.Value, NewIndex))
+			{
+				Slot->VectorIndices.Add(Vector.Key, NewIndex);
+			}
+		}
+	}
+	return true;
+}
+
+void UMaterialInstanceCacheSubsystem::RestoreBaseMaterial(UMeshComponent* Component, int32 SlotIndex)
+{
+	const TArray<FCachedSlot>* Slots = Component ? Entries.Find(Component) : nullptr;
+	if (!Slots || !Slots->IsValidIndex(SlotIndex))
+	{
+		return;
+	}
+
+	UMaterialInterface* BaseMaterial = (*Slots)[SlotIndex].BaseMaterial.Get();
+	if (BaseMaterial && Component->GetMaterial(SlotIndex) != BaseMaterial)
+	{
+		Component->SetMaterial(SlotIndex, BaseMaterial);
+	}
+}
+
+UMaterialInstanceCacheSubsystem::FCachedSlot* UMaterialInstanceCacheSubsystem::FindOrCreateSlot(UMeshComponent* Component, int32 SlotIndex)
+{
+	if (!Component || SlotIndex < 0 || SlotIndex >= Component->GetNumMaterials())
+	{
+		return nullptr;
+	}
+
+	TArray<FCachedSlot>* Slots = Entries.Find(Component);
+	if (!Slots)
+	{
+		if (++InsertsSincePrune >= PruneInterval)
+		{
+			PruneStaleEntries();
+		}
+		Slots = &Entries.Add(Component);
+	}
+	if (Slots->Num() <= SlotIndex)
+	{
+		Slots->SetNum(SlotIndex + 1);
+	}
+
+	FCachedSlot& Slot = (*Slots)[SlotIndex];
+	UMaterialInterface* Current = Component->GetMaterial(SlotIndex);
+
+	if (UMaterialInstanceDynamic* Cached = Slot.Instance.Get())
+	{
+		// Still ours, or restored to the base material since: reassign without allocating
+		if (Current == Cached || Current == Slot.BaseMaterial.Get())
+		{
+			if (Current != Cached)
+			{
+				Component->SetMaterial(SlotIndex, Cached);
+			}
+			NumReused++;
+			return &Slot;
+		}
+
+		// Someone assigned a different material; the old MID has the wrong parent
+		Slot = FCachedSlot();
+	}
+
+	if (!Current)
+	{
+		return nullptr;
+	}
+
+	// MID created outside the cache (e.g. by a blueprint): adopt it
+	if (UMaterialInstanceDynamic* Existing = Cast<UMaterialInstanceDynamic>(Current))
+	{
+		Slot.Instance = Existing;
+		Slot.BaseMaterial = Existing->Parent.Get();
+		NumReused++;
+		return &Slot;
+	}
+
+	UMaterialInstanceDynamic* Instance = UMaterialInstanceDynamic::Create(Current, Component);
+	if (!Instance)
+	{
+		return nullptr;
+	}
+
+	Component->SetMaterial(SlotIndex, Instance);
+	Slot.Instance = Instance;
+	Slot.BaseMaterial = Current;
+	NumCreated++;
+	return &Slot;
+}
+
+void UMaterialInstanceCacheSubsystem::PruneStaleEntries()
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	InsertsSincePrune = 0;
+}
+
+FString UMaterialInstanceCacheSubsystem::GetStatsJson() const
+{
+	int32 NumSlots = 0;
+	for (const TPair<TWeakObjectPtr<UMeshComponent>, TArray<FCachedSlot>>& Entry : Entries)
+	{
+		NumSlots += Entry.Value.Num();
+	}
+
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetNumberField("components", Entries.Num());
+	RootObj->SetNumberField("slots", NumSlots);
+	RootObj->SetNumberField("created", (double)NumCreated);
+	RootObj->SetNumberField("reused", (double)NumReused);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	return OutputString;
+}
@@ -1,9 +1,14 @@
 // Copyright VantageCV Research. All Rights Reserved.
 
 #include "ResearchController.h"
+#include "CaptureWriteQueue.h"
+#include "CaptureResourcePool.h"
+#include "SegmentationStencil.h"
+#include "ActorPoolSubsystem.h"
+#include "LightingPresetSubsystem.h"
+#include "CaptureTelemetry.h"
+#include "VantageCVWorker.h"
 #include "Engine/World.h"
-#include "Engine/StaticMesh.h"
-#include "Components/StaticMeshComponent.h"
 #include "ImageUtils.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
@@ -42,7 +47,15 @@ void AResearchController::BeginPlay()
 
 void AResearchController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    FlushPendingWrites();
     ClearVehicles();
+
+    if (CaptureComponent)
+    {
+        CaptureComponent->TextureTarget = nullptr;
+    }
+    FCaptureResourcePool::Get().ReleaseRenderTarget(RenderTarget);
+    RenderTarget = nullptr;
     Super::EndPlay(EndPlayReason);
 
     RESEARCH_LOG(ResearchController, "EndPlay - Research Controller destroyed");
@@ -62,16 +75,17 @@ bool AResearchController::InitializeScene(const FString& SceneId, int32 Seed)
     LogInfo(TEXT("SceneController"), TEXT("Initializing scene"),
         {
             {TEXT("scene_id"), SceneId},
-            {TEXT("seed"), FString::FromInt(Seed)}
+            {TEXT("seed"), Seed}
         });
 
+    // Seeded from the frame this worker renders next (its first owned frame, or the resume watermark)
     CurrentSceneId = SceneId;
-    CurrentSeed = Seed;
+    CurrentSeed = FVantageCVWorker::GetFrameSeed(Seed, FVantageCVWorker::Get().GetSeedFrame());
     FrameCounter = 0;
     bIsInitialized = true;
 
     // Seed random stream
-    FMath::RandInit(Seed);
+    FMath::RandInit(CurrentSeed);
 
     // Clear any existing vehicles
     ClearVehicles();
@@ -79,7 +93,7 @@ bool AResearchController::InitializeScene(const FString& SceneId, int32 Seed)
     LogInfo(TEXT("SceneController"), TEXT("Scene initialized successfully"),
         {
             {TEXT("scene_id"), CurrentSceneId},
-            {TEXT("is_initialized"), TEXT("true")}
+            {TEXT("is_initialized"), true}
         });
 
     return true;
@@ -87,15 +101,16 @@ bool AResearchController::InitializeScene(const FString& SceneId, int32 Seed)
 
 void AResearchController::ResetScene(int32 NewSeed)
 {
+    // Step over the other workers' frames so their seeds never collide with ours
     if (NewSeed < 0)
     {
-        NewSeed = CurrentSeed + 1;
+        NewSeed = CurrentSeed + FVantageCVWorker::Get().GetNumWorkers();
     }
 
     LogInfo(TEXT("SceneController"), TEXT("Resetting scene"),
         {
-            {TEXT("previous_seed"), FString::FromInt(CurrentSeed)},
-            {TEXT("new_seed"), FString::FromInt(NewSeed)}
+            {TEXT("previous_seed"), CurrentSeed},
+            {TEXT("new_seed"), NewSeed}
         });
 
     ClearVehicles();
@@ -108,16 +123,21 @@ void AResearchController::SetTimeOfDay(bool bIsDay)
 {
     bIsDaytime = bIsDay;
 
+    // Sun direction and sky intensity swap in from the cached preset; no light lookup per call
+    const FName PresetName(bIsDay ? TEXT("noon") : TEXT("night"));
+    ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(GetWorld());
+    if (!LightingPresets || !LightingPresets->ApplyPresetWithExposure(PresetName))
+    {
+        LogError(TEXT("SceneController"), TEXT("Failed to apply time of day preset"),
+            TEXT("Level has no directional or sky light"));
+        return;
+    }
+
     LogInfo(TEXT("SceneController"), TEXT("Time of day changed"),
         {
-            {TEXT("time"), bIsDay ? TEXT("day") : TEXT("night")}
+            {TEXT("time"), bIsDay ? TEXT("day") : TEXT("night")},
+            {TEXT("preset"), PresetName.ToString()}
         });
-
-    // TODO: Implement lighting changes
-    // This would typically adjust:
-    // - Directional light intensity and angle
-    // - Sky light
-    // - Post-process settings
 }
 
 // ========================================
@@ -140,58 +160,16 @@ AActor* AResearchController::SpawnVehicle(const FResearchVehicleData& VehicleDat
         return nullptr;
     }
 
-    // Load vehicle mesh/blueprint
-    UClass* VehicleClass = LoadClass<AActor>(nullptr, *VehicleData.AssetPath);
-    
-    AActor* SpawnedActor = nullptr;
+    // Blueprint or static mesh, reused from the actor pool when one is parked
+    AActor* SpawnedActor = UActorPoolSubsystem::AcquireOrSpawn(World, VehicleData.AssetPath, VehicleData.Location, VehicleData.Rotation,
+        FName(*VehicleData.InstanceId));
 
-    if (VehicleClass)
-    {
-        // Spawn from blueprint
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.Name = FName(*VehicleData.InstanceId);
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-        SpawnedActor = World->SpawnActor<AActor>(
-            VehicleClass,
-            VehicleData.Location,
-            VehicleData.Rotation,
-            SpawnParams
-        );
-    }
-    else
+    if (!SpawnedActor)
     {
-        // Try loading as static mesh and spawn with mesh component
-        UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, *VehicleData.AssetPath);
-        
-        if (Mesh)
-        {
-            FActorSpawnParameters SpawnParams;
-            SpawnParams.Name = FName(*VehicleData.InstanceId);
-            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-            SpawnedActor = World->SpawnActor<AActor>(
-                AActor::StaticClass(),
-                VehicleData.Location,
-                VehicleData.Rotation,
-                SpawnParams
-            );
-
-            if (SpawnedActor)
-            {
-                UStaticMeshComponent* MeshComp = NewObject<UStaticMeshComponent>(SpawnedActor);
-                MeshComp->SetStaticMesh(Mesh);
-                MeshComp->RegisterComponent();
-                SpawnedActor->SetRootComponent(MeshComp);
-            }
-        }
-        else
-        {
-            LogError(TEXT("VehicleSpawner"), TEXT("Spawn failed"), 
-                TEXT("Could not load asset"),
-                FString::Printf(TEXT("Check that asset exists at path: %s"), *VehicleData.AssetPath));
-            return nullptr;
-        }
+        LogError(TEXT("VehicleSpawner"), TEXT("Spawn failed"), 
+            TEXT("Could not load asset"),
+            FString::Printf(TEXT("Check that asset exists at path: %s"), *VehicleData.AssetPath));
+        return nullptr;
     }
 
     if (SpawnedActor)
@@ -202,14 +180,14 @@ AActor* AResearchController::SpawnVehicle(const FResearchVehicleData& VehicleDat
         // Store reference
         SpawnedVehicles.Add(SpawnedActor);
         VehicleInstanceMap.Add(VehicleData.InstanceId, SpawnedActor);
+        FSegmentationStencil::AssignInstanceId(SpawnedActor);
 
         LogInfo(TEXT("VehicleSpawner"), TEXT("Vehicle spawned successfully"),
             {
                 {TEXT("instance_id"), VehicleData.InstanceId},
                 {TEXT("class"), VehicleData.VehicleClass},
-                {TEXT("location"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"), 
-                    VehicleData.Location.X, VehicleData.Location.Y, VehicleData.Location.Z)},
-                {TEXT("scale"), FString::Printf(TEXT("%.2f"), VehicleData.Scale)}
+                {TEXT("location"), VehicleData.Location},
+                {TEXT("scale"), VehicleData.Scale}
             });
     }
     else
@@ -224,7 +202,7 @@ int32 AResearchController::SpawnVehicles(const TArray<FResearchVehicleData>& Veh
 {
     LogInfo(TEXT("VehicleSpawner"), TEXT("Batch spawn request"),
         {
-            {TEXT("count"), FString::FromInt(Vehicles.Num())}
+            {TEXT("count"), Vehicles.Num()}
         });
 
     int32 SuccessCount = 0;
@@ -240,9 +218,9 @@ int32 AResearchController::SpawnVehicles(const TArray<FResearchVehicleData>& Veh
 
     LogInfo(TEXT("VehicleSpawner"), TEXT("Batch spawn completed"),
         {
-            {TEXT("requested"), FString::FromInt(Vehicles.Num())},
-            {TEXT("spawned"), FString::FromInt(SuccessCount)},
-            {TEXT("failed"), FString::FromInt(Vehicles.Num() - SuccessCount)}
+            {TEXT("requested"), Vehicles.Num()},
+            {TEXT("spawned"), SuccessCount},
+            {TEXT("failed"), Vehicles.Num() - SuccessCount}
         });
 
     return SuccessCount;
@@ -252,11 +230,21 @@ void AResearchController::ClearVehicles()
 {
     int32 Count = SpawnedVehicles.Num();
 
+    // Parked for reuse; the pool releases stencil IDs
+    UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(GetWorld());
     for (AActor* Vehicle : SpawnedVehicles)
     {
         if (Vehicle && IsValid(Vehicle))
         {
-            Vehicle->Destroy();
+            if (ActorPool)
+            {
+                ActorPool->Release(Vehicle);
+            }
+            else
+            {
+                FSegmentationStencil::ReleaseInstanceId(Vehicle);
+                Vehicle->Destroy();
+            }
         }
     }
 
@@ -265,7 +253,7 @@ void AResearchController::ClearVehicles()
 
     LogInfo(TEXT("VehicleSpawner"), TEXT("Vehicles cleared"),
         {
-            {TEXT("count"), FString::FromInt(Count)}
+            {TEXT("count"), Count}
         });
 }
 
@@ -290,9 +278,9 @@ void AResearchController::SetupCaptureComponent()
 
     LogInfo(TEXT("CameraSystem"), TEXT("Capture component initialized"),
         {
-            {TEXT("width"), FString::FromInt(CameraConfig.Width)},
-            {TEXT("height"), FString::FromInt(CameraConfig.Height)},
-            {TEXT("fov"), FString::Printf(TEXT("%.1f"), CameraConfig.FOV)}
+            {TEXT("width"), CameraConfig.Width},
+            {TEXT("height"), CameraConfig.Height},
+            {TEXT("fov"), CameraConfig.FOV}
         });
 }
 
@@ -303,9 +291,8 @@ void AResearchController::UpdateRenderTarget(int32 Width, int32 Height)
         return; // No change needed
     }
 
-    RenderTarget = NewObject<UTextureRenderTarget2D>(this);
-    RenderTarget->InitCustomFormat(Width, Height, PF_B8G8R8A8, false);
-    RenderTarget->UpdateResourceImmediate();
+    // PF_B8G8R8A8 with sRGB, shared with other capture actors through the pool
+    RenderTarget = FCaptureResourcePool::Get().ResizeRenderTarget(RenderTarget, Width, Height, RTF_RGBA8_SRGB);
 
     if (CaptureComponent)
     {
@@ -314,8 +301,8 @@ void AResearchController::UpdateRenderTarget(int32 Width, int32 Height)
 
     LogInfo(TEXT("CameraSystem"), TEXT("Render target updated"),
         {
-            {TEXT("width"), FString::FromInt(Width)},
-            {TEXT("height"), FString::FromInt(Height)}
+            {TEXT("width"), Width},
+            {TEXT("height"), Height}
         });
 }
 
@@ -337,15 +324,13 @@ void AResearchController::ConfigureCamera(const FResearchCameraConfig& Config)
 
     LogInfo(TEXT("CameraSystem"), TEXT("Camera configured"),
         {
-            {TEXT("location"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"),
-                Config.Location.X, Config.Location.Y, Config.Location.Z)},
-            {TEXT("rotation"), FString::Printf(TEXT("(%.1f, %.1f, %.1f)"),
-                Config.Rotation.Pitch, Config.Rotation.Yaw, Config.Rotation.Roll)},
-            {TEXT("fov"), FString::Printf(TEXT("%.1f"), Config.FOV)},
-            {TEXT("fx"), FString::Printf(TEXT("%.2f"), FocalLengthPx)},
-            {TEXT("fy"), FString::Printf(TEXT("%.2f"), FocalLengthPx)},
-            {TEXT("cx"), FString::Printf(TEXT("%.1f"), Config.Width / 2.0f)},
-            {TEXT("cy"), FString::Printf(TEXT("%.1f"), Config.Height / 2.0f)}
+            {TEXT("location"), Config.Location},
+            {TEXT("rotation"), Config.Rotation},
+            {TEXT("fov"), Config.FOV},
+            {TEXT("fx"), FocalLengthPx},
+            {TEXT("fy"), FocalLengthPx},
+            {TEXT("cx"), Config.Width / 2.0f},
+            {TEXT("cy"), Config.Height / 2.0f}
         });
 }
 
@@ -360,10 +345,8 @@ FResearchFrameResult AResearchController::CaptureFrame(int32 FrameIndex, const F
 
     double StartTime = FPlatformTime::Seconds();
 
-    LogInfo(TEXT("RenderCapture"), TEXT("Frame render start"),
-        {
-            {TEXT("frame_index"), FString::FromInt(FrameIndex)}
-        });
+    VANTAGECV_EVENT(Verbose, TEXT("RenderCapture"), TEXT("Frame render start"),
+        {TEXT("frame_index"), FrameIndex});
 
     if (!CaptureComponent || !RenderTarget)
     {
@@ -372,13 +355,17 @@ FResearchFrameResult AResearchController::CaptureFrame(int32 FrameIndex, const F
     }
 
     // Capture the scene
-    CaptureComponent->CaptureScene();
+    {
+        VANTAGECV_CAPTURE_STAGE(RenderSubmit);
+        CaptureComponent->CaptureScene();
+    }
 
     // Save to disk
-    if (SaveRenderTargetToDisk(OutputPath))
+    const FString ImagePath = FCaptureEncoder::ResolveOutputPath(OutputPath, CameraConfig.Encoding.Format);
+    if (SaveRenderTargetToDisk(ImagePath))
     {
         Result.bSuccess = true;
-        Result.ImagePath = OutputPath;
+        Result.ImagePath = ImagePath;
     }
     else
     {
@@ -388,18 +375,29 @@ FResearchFrameResult AResearchController::CaptureFrame(int32 FrameIndex, const F
     double EndTime = FPlatformTime::Seconds();
     Result.RenderTimeMs = (EndTime - StartTime) * 1000.0f;
 
-    LogInfo(TEXT("RenderCapture"), TEXT("Frame render complete"),
-        {
-            {TEXT("frame_index"), FString::FromInt(FrameIndex)},
-            {TEXT("success"), Result.bSuccess ? TEXT("true") : TEXT("false")},
-            {TEXT("image_path"), Result.ImagePath},
-            {TEXT("render_time_ms"), FString::Printf(TEXT("%.2f"), Result.RenderTimeMs)}
-        });
+    VANTAGECV_EVENT(Verbose, TEXT("RenderCapture"), TEXT("Frame render complete"),
+        {TEXT("frame_index"), FrameIndex},
+        {TEXT("success"), Result.bSuccess},
+        {TEXT("image_path"), Result.ImagePath},
+        {TEXT("render_time_ms"), Result.RenderTimeMs});
 
     FrameCounter++;
     return Result;
 }
 
+int32 AResearchController::FlushPendingWrites()
+{
+    const int32 Written = FCaptureWriteQueue::Get().Flush();
+
+    LogInfo(TEXT("RenderCapture"), TEXT("Pending writes flushed"),
+        {
+            {TEXT("files_written"), Written},
+            {TEXT("total_failed"), FCaptureWriteQueue::Get().GetTotalFailed()}
+        });
+
+    return Written;
+}
+
 void AResearchController::SetOutputDirectory(const FString& Path)
 {
     OutputDirectory = Path;
@@ -430,40 +428,22 @@ bool AResearchController::SaveRenderTargetToDisk(const FString& FilePath)
         return false;
     }
 
-    // Read pixels
-    TArray<FColor> Pixels;
-    Pixels.SetNumUninitialized(CameraConfig.Width * CameraConfig.Height);
+    // Read pixels straight into the buffer handed to the write queue
+    FCapturedImage Image;
+    Image.Width = CameraConfig.Width;
+    Image.Height = CameraConfig.Height;
+    Image.Layout = ECapturePixelLayout::BGRA8;
+    Image.Data = FCaptureResourcePool::Get().AcquireBuffer((int64)Image.Width * Image.Height * sizeof(FColor));
 
     FReadSurfaceDataFlags ReadFlags(RCM_UNorm);
-    Resource->ReadPixels(Pixels, ReadFlags);
-
-    // Compress to PNG
-    IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
-    TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-
-    if (!ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor),
-        CameraConfig.Width, CameraConfig.Height, ERGBFormat::BGRA, 8))
+    if (!Resource->ReadPixelsPtr(reinterpret_cast<FColor*>(Image.Data.GetData()), ReadFlags))
     {
+        FCaptureResourcePool::Get().ReleaseBuffer(MoveTemp(Image.Data));
         return false;
     }
 
-    // Get compressed data
-    TArray64<uint8> CompressedData = ImageWrapper->GetCompressed(100);
-    if (CompressedData.Num() == 0)
-    {
-        return false;
-    }
-
-    // Ensure directory exists
-    FString Directory = FPaths::GetPath(FilePath);
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
-    {
-        PlatformFile.CreateDirectoryTree(*Directory);
-    }
-
-    // Write to file
-    return FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
+    // Encoding and the disk write run on the write queue workers
+    return FCaptureWriteQueue::Get().Enqueue(MoveTemp(Image), FilePath, CameraConfig.Encoding);
 }
 
 // ========================================
@@ -516,37 +496,22 @@ TArray<FString> AResearchController::GetAllVehicleBoundsJSON() const
 // Logging
 // ========================================
 
-void AResearchController::LogInfo(const FString& Module, const FString& Message, const TMap<FString, FString>& Data)
+void AResearchController::LogInfo(const TCHAR* Module, const TCHAR* Message, std::initializer_list<FVantageCVEventField> Fields)
 {
-    FString DataStr;
-    for (const auto& Pair : Data)
-    {
-        if (!DataStr.IsEmpty())
-        {
-            DataStr += TEXT(", ");
-        }
-        DataStr += FString::Printf(TEXT("\"%s\": \"%s\""), *Pair.Key, *Pair.Value);
-    }
-
-    if (DataStr.IsEmpty())
-    {
-        UE_LOG(LogResearchController, Log, TEXT("[%s] %s"), *Module, *Message);
-    }
-    else
+    if (FVantageCVEventLog::IsEnabled(EVantageCVEventLevel::Info))
     {
-        UE_LOG(LogResearchController, Log, TEXT("[%s] %s | {%s}"), *Module, *Message, *DataStr);
+        FVantageCVEventLog::Get().Write(EVantageCVEventLevel::Info, Module, Message, Fields);
     }
 }
 
-void AResearchController::LogError(const FString& Module, const FString& Message, const FString& Reason, const FString& SuggestedFix)
+void AResearchController::LogError(const TCHAR* Module, const TCHAR* Message, const FString& Reason, const FString& SuggestedFix)
 {
     if (SuggestedFix.IsEmpty())
     {
-        UE_LOG(LogResearchController, Error, TEXT("[%s] %s | Reason: %s"), *Module, *Message, *Reason);
+        FVantageCVEventLog::Get().Write(EVantageCVEventLevel::Error, Module, Message, {{TEXT("reason"), Reason}});
     }
     else
     {
-        UE_LOG(LogResearchController, Error, TEXT("[%s] %s | Reason: %s | Suggested fix: %s"),
-            *Module, *Message, *Reason, *SuggestedFix);
+        FVantageCVEventLog::Get().Write(EVantageCVEventLevel::Error, Module, Message, {{TEXT("reason"), Reason}, {TEXT("fix"), SuggestedFix}});
     }
 }
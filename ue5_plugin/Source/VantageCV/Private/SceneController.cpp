@@ -9,17 +9,17 @@
  *****************************************************************************/
 
 #include "SceneController.h"
+#include "ActorIndexSubsystem.h"
+#include "MaterialInstanceCache.h"
+#include "LightingPresetSubsystem.h"
 #include "Engine/DirectionalLight.h"
 #include "Engine/PointLight.h"
 #include "Engine/SpotLight.h"
-#include "Engine/SkyLight.h"
 #include "Engine/StaticMeshActor.h"
 #include "Components/DirectionalLightComponent.h"
 #include "Components/PointLightComponent.h"
 #include "Components/SpotLightComponent.h"
-#include "Components/SkyLightComponent.h"
 #include "Components/StaticMeshComponent.h"
-#include "Materials/MaterialInstanceDynamic.h"
 #include "Camera/CameraActor.h"
 #include "Camera/CameraComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -131,6 +131,14 @@ void ASceneController::RandomizeMaterials(const TArray<FString>& TargetTags)
 	
 	int32 ModifiedCount = 0;
 
+	// MIDs are created once per component slot and reused by later passes
+	UMaterialInstanceCacheSubsystem* MaterialCache = UMaterialInstanceCacheSubsystem::Get(World);
+	if (!MaterialCache)
+	{
+		return;
+	}
+
+	FMaterialParameterBatch Batch;
 	for (AActor* Actor : TargetActors)
 	{
 		if (!Actor) continue;
@@ -142,28 +150,24 @@ void ASceneController::RandomizeMaterials(const TArray<FString>& TargetTags)
 		{
 			if (!MeshComp) continue;
 
-			// Create dynamic material instance for randomization
 			for (int32 i = 0; i < MeshComp->GetNumMaterials(); ++i)
 			{
-				UMaterialInterface* Material = MeshComp->GetMaterial(i);
-				if (!Material) continue;
-
-				UMaterialInstanceDynamic* DynMaterial = MeshComp->CreateAndSetMaterialInstanceDynamic(i);
-				if (DynMaterial)
+				// Randomize material parameters for PCB-like surfaces (non-metallic, slightly rough)
+				Batch.Reset();
+				Batch.SetScalar(FName("Metallic"), FMath::RandRange(0.0f, 0.2f));  // PCBs are not metallic
+				Batch.SetScalar(FName("Roughness"), FMath::RandRange(0.4f, 0.8f));  // Slightly rough fiberglass
+				Batch.SetScalar(FName("Specular"), FMath::RandRange(0.3f, 0.6f));  // Moderate specular
+
+				// Randomize base color tint (subtle variation)
+				FLinearColor RandomTint = FLinearColor(
+					FMath::RandRange(0.9f, 1.1f),
+					FMath::RandRange(0.9f, 1.1f),
+					FMath::RandRange(0.9f, 1.1f)
+				);
+				Batch.SetVector(FName("BaseColorTint"), RandomTint);
+
+				if (MaterialCache->ApplyParameters(MeshComp, i, Batch))
 				{
-					// Randomize material parameters for PCB-like surfaces (non-metallic, slightly rough)
-					DynMaterial->SetScalarParameterValue(FName("Metallic"), FMath::RandRange(0.0f, 0.2f));  // PCBs are not metallic
-					DynMaterial->SetScalarParameterValue(FName("Roughness"), FMath::RandRange(0.4f, 0.8f));  // Slightly rough fiberglass
-					DynMaterial->SetScalarParameterValue(FName("Specular"), FMath::RandRange(0.3f, 0.6f));  // Moderate specular
-					
-					// Randomize base color tint (subtle variation)
-					FLinearColor RandomTint = FLinearColor(
-						FMath::RandRange(0.9f, 1.1f),
-						FMath::RandRange(0.9f, 1.1f),
-						FMath::RandRange(0.9f, 1.1f)
-					);
-					DynMaterial->SetVectorParameterValue(FName("BaseColorTint"), RandomTint);
-					
 					ModifiedCount++;
 				}
 			}
@@ -264,6 +268,14 @@ void ASceneController::ClearSpawnedObjects()
 
 void ASceneController::SetLightingPreset(const FString& PresetName)
 {
+	// Registered presets (time of day, Perfect, configured) are fixed parameter sets, exposure included
+	ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(GetWorld());
+	if (LightingPresets && LightingPresets->FindPreset(FName(*PresetName)))
+	{
+		LightingPresets->ApplyPresetWithExposure(FName(*PresetName));
+		return;
+	}
+
 	if (PresetName == TEXT("IndustrialLED"))
 	{
 		RandomizeLighting(50000.0f, 100000.0f, 5000.0f, 6500.0f);
@@ -285,48 +297,17 @@ void ASceneController::SetLightingPreset(const FString& PresetName)
 TArray<ALight*> ASceneController::GetSceneLights() const
 {
 	TArray<ALight*> Lights;
-	UWorld* World = GetWorld();
-	if (!World) return Lights;
-
-	// Find all light types (Point, Spot, Directional)
-	for (TActorIterator<APointLight> It(World); It; ++It)
+	if (ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(GetWorld()))
 	{
-		Lights.Add(*It);
+		LightingPresets->GetSceneLights(Lights);
 	}
-	
-	for (TActorIterator<ASpotLight> It(World); It; ++It)
-	{
-		Lights.Add(*It);
-	}
-	
-	for (TActorIterator<ADirectionalLight> It(World); It; ++It)
-	{
-		Lights.Add(*It);
-	}
-
 	return Lights;
 }
 
 TArray<AActor*> ASceneController::GetActorsByTags(const TArray<FString>& FilterTags) const
 {
-	TArray<AActor*> FoundActors;
-	UWorld* World = GetWorld();
-	if (!World) return FoundActors;
-
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		for (const FString& Tag : FilterTags)
-		{
-			if (Actor->ActorHasTag(FName(*Tag)))
-			{
-				FoundActors.Add(Actor);
-				break;
-			}
-		}
-	}
-
-	return FoundActors;
+	UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(GetWorld());
+	return ActorIndex ? ActorIndex->GetActorsWithAnyTag(FilterTags) : TArray<AActor*>();
 }
 
 FRotator ASceneController::GetRandomRotation() const
@@ -351,82 +332,31 @@ FVector ASceneController::GetRandomLocation(const FVector& Center, float Radius)
 }
 void ASceneController::SetupPerfectLighting()
 {
-	UWorld* World = GetWorld();
-	if (!World)
+	ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(GetWorld());
+	if (!LightingPresets)
 	{
 		UE_LOG(LogSceneController, Error, TEXT("SetupPerfectLighting: World is null"));
 		return;
 	}
 
-	// Find or create main directional light (sun)
-	ADirectionalLight* SunLight = nullptr;
-	for (TActorIterator<ADirectionalLight> It(World); It; ++It)
+	// Creates VantageCV_Sun / VantageCV_SkyLight if the level has none
+	if (!LightingPresets->ApplyPresetWithExposure(FName(TEXT("Perfect")), true))
 	{
-		SunLight = *It;
-		break;  // Use first directional light found
-	}
-
-	if (!SunLight)
-	{
-		// Create new directional light if none exists
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Name = FName(TEXT("VantageCV_Sun"));
-		SunLight = World->SpawnActor<ADirectionalLight>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
-		UE_LOG(LogSceneController, Log, TEXT("Created new directional light: VantageCV_Sun"));
+		UE_LOG(LogSceneController, Error, TEXT("SetupPerfectLighting: Failed to apply Perfect preset"));
+		return;
 	}
 
-	if (SunLight)
+	if (ADirectionalLight* SunLight = LightingPresets->GetSun())
 	{
 		UDirectionalLightComponent* LightComp = SunLight->GetComponent();
 		if (LightComp)
 		{
-			// PERFECT LIGHTING SETTINGS - EXTREMELY BRIGHT for captures
-			LightComp->SetIntensity(50.0f);  // MAXIMUM brightness for dark captures
-			LightComp->SetLightColor(FLinearColor::White);  // Pure white
-			LightComp->SetTemperature(6500.0f);  // Daylight
-			
-			// Optimal sun angle: 45 degrees elevation, front lighting
-			SunLight->SetActorRotation(FRotator(-45.0f, 0.0f, 0.0f));
-			
 			// Soft shadows for realism
 			LightComp->SetCastShadows(true);
 			LightComp->DynamicShadowDistanceMovableLight = 20000.0f;
 			LightComp->CascadeDistributionExponent = 2.0f;
-			
-			UE_LOG(LogSceneController, Log, TEXT("Configured sun: Intensity=10.0, Angle=45deg, White 6500K"));
 		}
 	}
 
-	// Find or create sky light for ambient fill
-	ASkyLight* SkyLight = nullptr;
-	for (TActorIterator<ASkyLight> It(World); It; ++It)
-	{
-		SkyLight = *It;
-		break;
-	}
-
-	if (!SkyLight)
-	{
-		// Create sky light if missing
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Name = FName(TEXT("VantageCV_SkyLight"));
-		SkyLight = World->SpawnActor<ASkyLight>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
-		UE_LOG(LogSceneController, Log, TEXT("Created new sky light: VantageCV_SkyLight"));
-	}
-
-	if (SkyLight)
-	{
-		USkyLightComponent* SkyComp = SkyLight->GetLightComponent();
-		if (SkyComp)
-		{
-			// Bright ambient lighting to eliminate dark shadows
-			SkyComp->SetIntensity(2.0f);  // Strong ambient
-			SkyComp->SetLightColor(FLinearColor(0.9f, 0.95f, 1.0f));  // Slightly blue sky
-			SkyComp->RecaptureSky();
-			
-			UE_LOG(LogSceneController, Log, TEXT("Configured sky light: Intensity=2.0, Blue tint"));
-		}
-	}
-
-	UE_LOG(LogSceneController, Log, TEXT("Perfect lighting setup complete - bright uniform illumination"));
-}
\ No newline at end of file
+	UE_LOG(LogSceneController, Log, TEXT("Perfect lighting setup complete - Sun 50.0 at 45deg White 6500K, sky 2.0 blue tint"));
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * VantageCV - Scene Planner Implementation
+ ******************************************************************************
+ * File: ScenePlanner.cpp
+ * Description: Counter-based random number generation
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "ScenePlanner.h"
+
+namespace
+{
+	/** SplitMix64 finalizer: full-avalanche 64-bit mix */
+	uint64 Mix64(uint64 Value)
+	{
+		Value += 0x9E3779B97F4A7C15ull;
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+}
+
+FCounterRandom::FCounterRandom(int32 Seed, int64 FrameIndex, EScenePlanStream Stream)
+{
+	Key = Mix64((uint64)(uint32)Seed);
+	Key = Mix64(Key ^ (uint64)FrameIndex);
+	Key = Mix64(Key ^ (uint64)Stream);
+}
+
+uint64 FCounterRandom::NextBits()
+{
+	return Mix64(Key + (uint64)(Counter++) * 0xD1B54A32D192ED03ull);
+}
+
+float FCounterRandom::FRand()
+{
+	// Top 24 bits: every value exactly representable, strictly below 1
+	return (float)(NextBits() >> 40) * (1.0f / 16777216.0f);
+}
+
+float FCounterRandom::FRandRange(float Min, float Max)
+{
+	return Min + (Max - Min) * FRand();
+}
+
+int32 FCounterRandom::RandRange(int32 Min, int32 Max)
+{
+	const int64 Range = (int64)Max - (int64)Min + 1;
+	if (Range <= 0)
+	{
+		return Min;
+	}
+	return Min + (int32)((NextBits() >> 32) % (uint64)Range);
+}
+
+bool FCounterRandom::RandBool(float TrueProbability)
+{
+	return FRand() < TrueProbability;
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * VantageCV - Scene State Delta Implementation
+ ******************************************************************************
+ * File: SceneStateDelta.cpp
+ * Description: Compare-then-set actor state updates
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "SceneStateDelta.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	constexpr float LocationTolerance = 0.01f;  // cm
+	constexpr float RotationTolerance = 0.001f; // degrees
+	constexpr float ScaleTolerance = 0.0001f;
+}
+
+bool FSceneStateDelta::ApplyVisibility(AActor* Actor, bool bVisible)
+{
+	if (!Actor)
+	{
+		return false;
+	}
+
+	bool bChanged = false;
+	if (Actor->IsHidden() == bVisible)
+	{
+		Actor->SetActorHiddenInGame(!bVisible);
+		bChanged = true;
+	}
+	if (Actor->GetActorEnableCollision() != bVisible)
+	{
+		Actor->SetActorEnableCollision(bVisible);
+		bChanged = true;
+	}
+	return bChanged;
+}
+
+bool FSceneStateDelta::ApplyTransform(AActor* Actor, const FVector& Location, const FRotator& Rotation)
+{
+	if (!Actor)
+	{
+		return false;
+	}
+
+	if (Actor->GetActorLocation().Equals(Location, LocationTolerance) &&
+		Actor->GetActorRotation().Equals(Rotation, RotationTolerance))
+	{
+		return false;
+	}
+
+	Actor->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	return true;
+}
+
+bool FSceneStateDelta::ApplyScale(AActor* Actor, const FVector& Scale)
+{
+	if (!Actor || Actor->GetActorScale3D().Equals(Scale, ScaleTolerance))
+	{
+		return false;
+	}
+
+	Actor->SetActorScale3D(Scale);
+	return true;
+}
+
+bool FSceneStateDelta::ApplyHiddenParked(AActor* Actor)
+{
+	if (!Actor || IsHiddenParked(Actor))
+	{
+		return false;
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+
+	const FVector CurrentLoc = Actor->GetActorLocation();
+	if (!FMath::IsNearlyEqual(CurrentLoc.Z, HiddenZ, LocationTolerance))
+	{
+		Actor->SetActorLocation(FVector(CurrentLoc.X, CurrentLoc.Y, HiddenZ));
+	}
+	return true;
+}
+
+bool FSceneStateDelta::IsHiddenParked(const AActor* Actor)
+{
+	return Actor && Actor->IsHidden() && !Actor->GetActorEnableCollision() &&
+		FMath::IsNearlyEqual(Actor->GetActorLocation().Z, HiddenZ, LocationTolerance);
+}
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * VantageCV - Segmentation Stencil Implementation
+ ******************************************************************************
+ * File: SegmentationStencil.cpp
+ * Description: Stencil ID allocator and custom depth setup
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "SegmentationStencil.h"
+#include "InstanceStatsPass.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSegmentationStencil, Log, All);
+
+static_assert(FSegmentationStencil::MaxInstanceId == FInstanceStatsPass::MaxInstanceId,
+	"Stencil IDs must fit the instance stats reduction");
+
+namespace
+{
+	/** Game-thread only; index = stencil ID, slot 0 unused (background) */
+	TWeakObjectPtr<AActor> GInstanceActors[FSegmentationStencil::MaxInstanceId + 1];
+	TMap<TWeakObjectPtr<AActor>, int32> GActorToId;
+	int32 GNextSearchId = 1;
+
+	void ApplyStencil(AActor* Actor, int32 InstanceId)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+		for (UPrimitiveComponent* Primitive : Primitives)
+		{
+			Primitive->SetRenderCustomDepth(InstanceId != 0);
+			Primitive->SetCustomDepthStencilValue(InstanceId);
+		}
+	}
+}
+
+int32 FSegmentationStencil::AssignInstanceId(AActor* Actor)
+{
+	check(IsInGameThread());
+
+	if (!Actor)
+	{
+		return 0;
+	}
+
+	if (const int32* Existing = GActorToId.Find(Actor))
+	{
+		ApplyStencil(Actor, *Existing);
+		return *Existing;
+	}
+
+	// Round-robin so a freshly released ID is not immediately handed to the next actor
+	int32 InstanceId = 0;
+	for (int32 Pass = 0; Pass < 2 && InstanceId == 0; ++Pass)
+	{
+		for (int32 Offset = 0; Offset < MaxInstanceId; ++Offset)
+		{
+			const int32 Candidate = 1 + (GNextSearchId - 1 + Offset) % MaxInstanceId;
+			if (!GInstanceActors[Candidate].IsValid())
+			{
+				InstanceId = Candidate;
+				break;
+			}
+		}
+
+		if (InstanceId == 0)
+		{
+			PurgeStale();
+		}
+	}
+
+	if (InstanceId == 0)
+	{
+		// Every ID is held by a live actor - share one rather than leave the actor unmasked
+		InstanceId = GNextSearchId;
+		UE_LOG(LogSegmentationStencil, Warning, TEXT("More than %d live instances - reusing stencil ID %d for %s"),
+			MaxInstanceId, InstanceId, *Actor->GetName());
+		GActorToId.Remove(GInstanceActors[InstanceId]);
+	}
+
+	GInstanceActors[InstanceId] = Actor;
+	GActorToId.Add(Actor, InstanceId);
+	GNextSearchId = 1 + InstanceId % MaxInstanceId;
+
+	ApplyStencil(Actor, InstanceId);
+	return InstanceId;
+}
+
+void FSegmentationStencil::ReleaseInstanceId(AActor* Actor)
+{
+	check(IsInGameThread());
+
+	int32 InstanceId = 0;
+	if (Actor && GActorToId.RemoveAndCopyValue(Actor, InstanceId))
+	{
+		GInstanceActors[InstanceId].Reset();
+		ApplyStencil(Actor, 0);
+	}
+}
+
+int32 FSegmentationStencil::GetInstanceId(const AActor* Actor)
+{
+	// Weak pointer keys cannot be built from a const pointer; the lookup does not modify the actor
+	const int32* InstanceId = Actor ? GActorToId.Find(TWeakObjectPtr<AActor>(const_cast<AActor*>(Actor))) : nullptr;
+	return InstanceId ? *InstanceId : 0;
+}
+
+AActor* FSegmentationStencil::FindActor(int32 InstanceId)
+{
+	return (InstanceId > 0 && InstanceId <= MaxInstanceId) ? GInstanceActors[InstanceId].Get() : nullptr;
+}
+
+void FSegmentationStencil::Reset()
+{
+	for (TWeakObjectPtr<AActor>& Actor : GInstanceActors)
+	{
+		Actor.Reset();
+	}
+	GActorToId.Reset();
+	GNextSearchId = 1;
+}
+
+FString FSegmentationStencil::GetIdMapJson()
+{
+	TArray<TSharedPtr<FJsonValue>> InstancesArray;
+	for (int32 InstanceId = 1; InstanceId <= MaxInstanceId; ++InstanceId)
+	{
+		AActor* Actor = GInstanceActors[InstanceId].Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> InstanceObj = MakeShareable(new FJsonObject);
+		InstanceObj->SetNumberField("stencil_id", InstanceId);
+		InstanceObj->SetStringField("actor", Actor->GetName());
+		InstanceObj->SetStringField("class", Actor->GetClass()->GetName());
+		InstancesArray.Add(MakeShareable(new FJsonValueObject(InstanceObj)));
+	}
+
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetArrayField("instances", InstancesArray);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	return OutputString;
+}
+
+void FSegmentationStencil::EnsureStencilEnabled()
+{
+	// 3 = "Enabled with Stencil"; without it CustomStencil reads as 0 everywhere
+	IConsoleVariable* CustomDepthVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.CustomDepth"));
+	if (CustomDepthVar && CustomDepthVar->GetInt() != 3)
+	{
+		CustomDepthVar->Set(3, ECVF_SetByCode);
+		UE_LOG(LogSegmentationStencil, Log, TEXT("r.CustomDepth set to 3 for instance segmentation"));
+	}
+}
+
+void FSegmentationStencil::PurgeStale()
+{
+	for (auto It = GActorToId.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			GInstanceActors[It->Value].Reset();
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * VantageCV - Spawn Asset Cache Implementation
+ ******************************************************************************
+ * File: SpawnAssetCache.cpp
+ * Description: Async preload and positive/negative caching of spawn assets
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "SpawnAssetCache.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "UObject/SoftObjectPath.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSpawnAssetCache, Log, All);
+
+FSpawnAssetCache* FSpawnAssetCache::Instance = nullptr;
+
+FSpawnAssetCache& FSpawnAssetCache::Get()
+{
+	if (!Instance)
+	{
+		check(IsInGameThread());
+		Instance = new FSpawnAssetCache();
+	}
+	return *Instance;
+}
+
+void FSpawnAssetCache::Shutdown()
+{
+	if (Instance)
+	{
+		UE_LOG(LogSpawnAssetCache, Log, TEXT("Spawn asset cache shut down (%d cached, %d failed, %lld hits, %lld blocking loads)"),
+			Instance->Cache.Num(), Instance->FailedPaths.Num(), Instance->NumHits, Instance->NumBlockingLoads);
+
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+int32 FSpawnAssetCache::Preload(const TArray<FString>& AssetPaths)
+{
+	check(IsInGameThread());
+
+	TArray<FString> NewPaths;
+	TArray<FSoftObjectPath> NewObjectPaths;
+	for (const FString& AssetPath : AssetPaths)
+	{
+		if (AssetPath.IsEmpty() || Cache.Contains(AssetPath) || FailedPaths.Contains(AssetPath) ||
+			PendingLoads.Contains(AssetPath) || NewPaths.Contains(AssetPath))
+		{
+			continue;
+		}
+		NewPaths.Add(AssetPath);
+		NewObjectPaths.Add(FSoftObjectPath(AssetPath));
+	}
+
+	if (NewPaths.Num() == 0)
+	{
+		return 0;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(NewObjectPaths,
+		FStreamableDelegate::CreateRaw(this, &FSpawnAssetCache::HandlePreloadComplete, NewPaths));
+
+	// Already-loaded assets complete inside RequestAsyncLoad; only track what is still in flight
+	for (const FString& AssetPath : NewPaths)
+	{
+		if (Handle.IsValid() && !Cache.Contains(AssetPath) && !FailedPaths.Contains(AssetPath))
+		{
+			PendingLoads.Add(AssetPath, Handle);
+		}
+	}
+
+	UE_LOG(LogSpawnAssetCache, Log, TEXT("Preloading %d spawn assets (%d in flight)"), NewPaths.Num(), PendingLoads.Num());
+	return NewPaths.Num();
+}
+
+void FSpawnAssetCache::WaitForPreloads()
+{
+	check(IsInGameThread());
+
+	TArray<FString> Paths;
+	PendingLoads.GetKeys(Paths);
+	for (const FString& AssetPath : Paths)
+	{
+		Resolve(AssetPath);
+	}
+}
+
+FSpawnAsset FSpawnAssetCache::Resolve(const FString& AssetPath)
+{
+	check(IsInGameThread());
+
+	if (const FCachedAsset* Cached = Cache.Find(AssetPath))
+	{
+		NumHits++;
+		return FSpawnAsset{Cached->Class, Cached->Mesh};
+	}
+	if (FailedPaths.Contains(AssetPath))
+	{
+		NumHits++;
+		return FSpawnAsset();
+	}
+
+	TSharedPtr<FStreamableHandle> Pending;
+	if (PendingLoads.RemoveAndCopyValue(AssetPath, Pending))
+	{
+		// Finish the preload rather than issue a second load for the same package
+		Pending->WaitUntilComplete();
+		if (const FCachedAsset* Cached = Cache.Find(AssetPath))
+		{
+			return FSpawnAsset{Cached->Class, Cached->Mesh};
+		}
+		return Store(AssetPath, FSoftObjectPath(AssetPath).ResolveObject());
+	}
+
+	NumBlockingLoads++;
+	UE_LOG(LogSpawnAssetCache, Verbose, TEXT("Blocking load of non-preloaded spawn asset: %s"), *AssetPath);
+	return Store(AssetPath, FSoftObjectPath(AssetPath).TryLoad());
+}
+
+void FSpawnAssetCache::ClearFailedPaths()
+{
+	FailedPaths.Reset();
+}
+
+FSpawnAsset FSpawnAssetCache::Store(const FString& AssetPath, UObject* LoadedObject)
+{
+	FSpawnAsset Result;
+
+	UClass* LoadedClass = Cast<UClass>(LoadedObject);
+	if (LoadedClass && LoadedClass->IsChildOf(AActor::StaticClass()))
+	{
+		Result.Class = LoadedClass;
+	}
+	else
+	{
+		Result.Mesh = Cast<UStaticMesh>(LoadedObject);
+	}
+
+	if (!Result.IsValid())
+	{
+		UE_LOG(LogSpawnAssetCache, Warning, TEXT("Spawn asset is not an actor class or static mesh: %s"), *AssetPath);
+		FailedPaths.Add(AssetPath);
+		return Result;
+	}
+
+	FCachedAsset& Entry = Cache.Add(AssetPath);
+	Entry.Class = Result.Class;
+	Entry.Mesh = Result.Mesh;
+	return Result;
+}
+
+void FSpawnAssetCache::HandlePreloadComplete(TArray<FString> AssetPaths)
+{
+	for (const FString& AssetPath : AssetPaths)
+	{
+		PendingLoads.Remove(AssetPath);
+		if (!Cache.Contains(AssetPath) && !FailedPaths.Contains(AssetPath))
+		{
+			if (Store(AssetPath, FSoftObjectPath(AssetPath).ResolveObject()).IsValid())
+			{
+				NumPreloaded++;
+			}
+		}
+	}
+}
+
+FString FSpawnAssetCache::GetStatsJson() const
+{
+	int32 NumClasses = 0;
+	for (const TPair<FString, FCachedAsset>& Pair : Cache)
+	{
+		NumClasses += Pair.Value.Class ? 1 : 0;
+	}
+
+	TSharedPtr<FJsonObject> RootObj = MakeShareable(new FJsonObject);
+	RootObj->SetNumberField("cached_classes", NumClasses);
+	RootObj->SetNumberField("cached_meshes", Cache.Num() - NumClasses);
+	RootObj->SetNumberField("failed", FailedPaths.Num());
+	RootObj->SetNumberField("pending", PendingLoads.Num());
+	RootObj->SetNumberField("hits", (double)NumHits);
+	RootObj->SetNumberField("blocking_loads", (double)NumBlockingLoads);
+	RootObj->SetNumberField("preloaded", (double)NumPreloaded);
+
+	TArray<TSharedPtr<FJsonValue>> FailedArray;
+	for (const FString& AssetPath : FailedPaths)
+	{
+		FailedArray.Add(MakeShareable(new FJsonValueString(AssetPath)));
+	}
+	RootObj->SetArrayField("failed_paths", FailedArray);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(RootObj.ToSharedRef(), Writer);
+	return OutputString;
+}
+
+void FSpawnAssetCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TPair<FString, FCachedAsset>& Pair : Cache)
+	{
+		Collector.AddReferencedObject(Pair.Value.Class);
+		Collector.AddReferencedObject(Pair.Value.Mesh);
+	}
+}
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * VantageCV - Spawn Footprint Grid Implementation
+ ******************************************************************************
+ * File: SpawnFootprintGrid.cpp
+ * Description: Uniform-grid insert/query and oriented-box SAT for spawn footprints
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "SpawnFootprintGrid.h"
+
+FSpawnFootprint FSpawnFootprint::FromTransform(const FTransform& Transform, const FBox& LocalBounds)
+{
+	FSpawnFootprint Footprint;
+
+	const FVector Scale = Transform.GetScale3D().GetAbs();
+	const FVector LocalExtent = LocalBounds.IsValid ? LocalBounds.GetExtent() : FVector::ZeroVector;
+	const FVector LocalCenter = LocalBounds.IsValid ? LocalBounds.GetCenter() : FVector::ZeroVector;
+
+	const FVector WorldCenter = Transform.TransformPosition(LocalCenter);
+	Footprint.Center = FVector2D(WorldCenter.X, WorldCenter.Y);
+
+	double SinYaw, CosYaw;
+	FMath::SinCos(&SinYaw, &CosYaw, FMath::DegreesToRadians(Transform.Rotator().Yaw));
+	Footprint.AxisX = FVector2D(CosYaw, SinYaw);
+	Footprint.AxisY = FVector2D(-SinYaw, CosYaw);
+	Footprint.HalfExtent = FVector2D(LocalExtent.X * Scale.X, LocalExtent.Y * Scale.Y);
+	return Footprint;
+}
+
+FBox2D FSpawnFootprint::GetBounds() const
+{
+	const FVector2D Reach(
+		HalfExtent.X * FMath::Abs(AxisX.X) + HalfExtent.Y * FMath::Abs(AxisY.X),
+		HalfExtent.X * FMath::Abs(AxisX.Y) + HalfExtent.Y * FMath::Abs(AxisY.Y));
+	return FBox2D(Center - Reach, Center + Reach);
+}
+
+FSpawnFootprintGrid::FSpawnFootprintGrid(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+{
+}
+
+void FSpawnFootprintGrid::SetCellSize(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	Reset();
+}
+
+void FSpawnFootprintGrid::Reset()
+{
+	Footprints.Reset();
+	FootprintBounds.Reset();
+	Cells.Reset();
+	VisitStamps.Reset();
+	QueryStamp = 0;
+}
+
+void FSpawnFootprintGrid::Add(const FSpawnFootprint& Footprint)
+{
+	const int32 Index = Footprints.Add(Footprint);
+	const FBox2D Bounds = FootprintBounds.Add_GetRef(Footprint.GetBounds());
+	VisitStamps.Add(0);
+
+	FIntPoint CellMin, CellMax;
+	GetCellRange(Bounds, CellMin, CellMax);
+	for (int32 CellY = CellMin.Y; CellY <= CellMax.Y; ++CellY)
+	{
+		for (int32 CellX = CellMin.X; CellX <= CellMax.X; ++CellX)
+		{
+			Cells.FindOrAdd(FIntPoint(CellX, CellY)).Add(Index);
+		}
+	}
+}
+
+bool FSpawnFootprintGrid::Overlaps(const FSpawnFootprint& Footprint, float Clearance) const
+{
+	if (Footprints.Num() == 0)
+	{
+		return false;
+	}
+
+	FBox2D QueryBounds = Footprint.GetBounds();
+	QueryBounds = QueryBounds.ExpandBy(FMath::Max(Clearance, 0.0f));
+
+	if (++QueryStamp == 0)
+	{
+		// Stamp wrapped: clear so stale stamps cannot alias the new query
+		FMemory::Memzero(VisitStamps.GetData(), VisitStamps.Num() * sizeof(uint32));
+		QueryStamp = 1;
+	}
+
+	FIntPoint CellMin, CellMax;
+	GetCellRange(QueryBounds, CellMin, CellMax);
+	for (int32 CellY = CellMin.Y; CellY <= CellMax.Y; ++CellY)
+	{
+		for (int32 CellX = CellMin.X; CellX <= CellMax.X; ++CellX)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(CellX, CellY));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const int32 Index : *Cell)
+			{
+				if (VisitStamps[Index] == QueryStamp)
+				{
+					continue;
+				}
+				VisitStamps[Index] = QueryStamp;
+
+				if (QueryBounds.Intersect(FootprintBounds[Index]) && Intersect(Footprint, Footprints[Index], Clearance))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool FSpawnFootprintGrid::Intersect(const FSpawnFootprint& A, const FSpawnFootprint& B, float Clearance)
+{
+	const FVector2D Delta = B.Center - A.Center;
+	const FVector2D Axes[4] = { A.AxisX, A.AxisY, B.AxisX, B.AxisY };
+	const double Grow = FMath::Max(Clearance, 0.0f);
+
+	for (const FVector2D& Axis : Axes)
+	{
+		const double RadiusA = A.HalfExtent.X * FMath::Abs(A.AxisX | Axis) + A.HalfExtent.Y * FMath::Abs(A.AxisY | Axis) + Grow;
+		const double RadiusB = B.HalfExtent.X * FMath::Abs(B.AxisX | Axis) + B.HalfExtent.Y * FMath::Abs(B.AxisY | Axis);
+		if (FMath::Abs(Delta | Axis) > RadiusA + RadiusB)
+		{
+			return false;  // Separating axis found
+		}
+	}
+	return true;
+}
+
+void FSpawnFootprintGrid::GetCellRange(const FBox2D& Bounds, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+	OutMin = FIntPoint(FMath::FloorToInt32(Bounds.Min.X / CellSize), FMath::FloorToInt32(Bounds.Min.Y / CellSize));
+	OutMax = FIntPoint(FMath::FloorToInt32(Bounds.Max.X / CellSize), FMath::FloorToInt32(Bounds.Max.Y / CellSize));
+}
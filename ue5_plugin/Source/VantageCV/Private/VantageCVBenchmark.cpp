@@ -0,0 +1,670 @@
+/******************************************************************************
+ * VantageCV - Benchmark Implementation
+ ******************************************************************************
+ * File: VantageCVBenchmark.cpp
+ * Description: Capture, spawn, anchor and annotation benchmark suites over a
+ *              synthetic layout, the VantageCV.Benchmark console command and
+ *              the VantageCV.Benchmark.* threshold automation tests
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "VantageCVBenchmark.h"
+#include "AnchorSpawnSystem.h"
+#include "DataCapture.h"
+#include "CaptureWriteQueue.h"
+#include "CaptureTelemetry.h"
+#include "ActorIndexSubsystem.h"
+#include "ActorPoolSubsystem.h"
+#include "SegmentationStencil.h"
+#include "VantageCVWorker.h"
+#include "Engine/Engine.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+#include "RHI.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogVantageCVBenchmark, Log, All);
+
+const FVector FVantageCVBenchmark::BenchmarkOrigin(0.0f, 0.0f, -200000.0f);
+
+namespace
+{
+	const TCHAR* const BenchmarkAssetPath = TEXT("/Engine/BasicShapes/Cube.Cube");
+	const TCHAR* const BenchmarkTag = TEXT("VantageCVBenchmark");
+	constexpr int32 BenchmarkSeed = 1337;
+	constexpr int32 NumBenchmarkLanes = 4;
+
+	const FIntPoint CaptureResolutions[] = { FIntPoint(640, 480), FIntPoint(1920, 1080), FIntPoint(3840, 2160) };
+	const int32 SpawnVehicleCounts[] = { 50, 200, 500 };
+	const int32 AnchorCounts[] = { 50, 200, 1000, 5000 };
+	const int32 AnnotationTargetCounts[] = { 10, 100, 500 };
+
+	double Percentile(const TArray<double>& Sorted, double Fraction)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0;
+		}
+		const double Position = Fraction * (Sorted.Num() - 1);
+		const int32 Lower = FMath::FloorToInt(Position);
+		const int32 Upper = FMath::Min(Lower + 1, Sorted.Num() - 1);
+		return FMath::Lerp(Sorted[Lower], Sorted[Upper], Position - Lower);
+	}
+
+	/** Count, mean, min, p50, p95 and max of a set of timings; keys match FCaptureTelemetry's per-stage stats */
+	TSharedPtr<FJsonObject> MakeTimingObject(TArray<double> SamplesMs)
+	{
+		SamplesMs.Sort();
+		double TotalMs = 0.0;
+		for (double Sample : SamplesMs)
+		{
+			TotalMs += Sample;
+		}
+
+		TSharedPtr<FJsonObject> Timing = MakeShareable(new FJsonObject);
+		Timing->SetNumberField(TEXT("count"), SamplesMs.Num());
+		Timing->SetNumberField(TEXT("mean_ms"), SamplesMs.Num() > 0 ? TotalMs / SamplesMs.Num() : 0.0);
+		Timing->SetNumberField(TEXT("min_ms"), SamplesMs.Num() > 0 ? SamplesMs[0] : 0.0);
+		Timing->SetNumberField(TEXT("p50_ms"), Percentile(SamplesMs, 0.50));
+		Timing->SetNumberField(TEXT("p95_ms"), Percentile(SamplesMs, 0.95));
+		Timing->SetNumberField(TEXT("max_ms"), SamplesMs.Num() > 0 ? SamplesMs.Last() : 0.0);
+		return Timing;
+	}
+
+	double ElapsedMs(double StartSeconds)
+	{
+		return (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	}
+
+	/** Anchor actor with a real transform, findable by name through the actor index (renamed if Name is taken) */
+	AActor* SpawnAnchor(UWorld* World, const FString& Name, const FVector& Location, const FRotator& Rotation)
+	{
+		FActorSpawnParameters Params;
+		Params.Name = FName(*Name);
+		Params.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AActor* Anchor = World->SpawnActor<ATargetPoint>(ATargetPoint::StaticClass(), Location, Rotation, Params);
+#if WITH_EDITOR
+		if (Anchor)
+		{
+			Anchor->SetActorLabel(Name);
+		}
+#endif
+		return Anchor;
+	}
+
+	void DestroyActors(TArray<AActor*>& Actors)
+	{
+		for (AActor* Actor : Actors)
+		{
+			if (IsValid(Actor))
+			{
+				Actor->Destroy();
+			}
+		}
+		Actors.Reset();
+	}
+
+	ADataCapture* FindDataCapture(UWorld* World)
+	{
+		for (TActorIterator<ADataCapture> It(World); It; ++It)
+		{
+			if (IsValid(*It))
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+
+	FString GetFrameDirectory()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("VantageCV/Benchmarks/Frames");
+	}
+
+	// ------------------------------------------------------------------------
+	// Capture: CaptureFrame calls per resolution, then the write queue drained
+	// ------------------------------------------------------------------------
+	TArray<TSharedPtr<FJsonValue>> RunCaptureSuite(ADataCapture* DataCapture, int32 Iterations)
+	{
+		TArray<TSharedPtr<FJsonValue>> Cases;
+		for (const FIntPoint& Resolution : CaptureResolutions)
+		{
+			const FString CaseName = FString::Printf(TEXT("%dx%d"), Resolution.X, Resolution.Y);
+			const FString FramePrefix = GetFrameDirectory() / CaseName;
+
+			// Warm-up: render target allocation and first-use shader work
+			DataCapture->CaptureFrame(FramePrefix + TEXT("_warmup.png"), Resolution.X, Resolution.Y);
+			FCaptureWriteQueue::Get().Flush();
+			FCaptureTelemetry::Get().Reset();
+
+			TArray<double> CallMs;
+			int32 NumFailed = 0;
+			const double CaseStart = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double CallStart = FPlatformTime::Seconds();
+				if (!DataCapture->CaptureFrame(FString::Printf(TEXT("%s_%04d.png"), *FramePrefix, Iteration), Resolution.X, Resolution.Y))
+				{
+					++NumFailed;
+				}
+				CallMs.Add(ElapsedMs(CallStart));
+			}
+			const double FlushStart = FPlatformTime::Seconds();
+			FCaptureWriteQueue::Get().Flush();
+			const double FlushMs = ElapsedMs(FlushStart);
+			const double CaseSeconds = FPlatformTime::Seconds() - CaseStart;
+
+			TSharedPtr<FJsonObject> Case = MakeShareable(new FJsonObject);
+			Case->SetStringField(TEXT("Case"), CaseName);
+			Case->SetNumberField(TEXT("Width"), Resolution.X);
+			Case->SetNumberField(TEXT("Height"), Resolution.Y);
+			Case->SetNumberField(TEXT("Frames"), Iterations);
+			Case->SetNumberField(TEXT("Failed"), NumFailed);
+			// On disk, not just submitted: the final flush is part of the rate
+			Case->SetNumberField(TEXT("FramesPerSecond"), CaseSeconds > 0.0 ? Iterations / CaseSeconds : 0.0);
+			Case->SetObjectField(TEXT("CaptureFrame"), MakeTimingObject(CallMs));
+			Case->SetNumberField(TEXT("FlushMs"), FlushMs);
+
+			TSharedPtr<FJsonObject> Stages;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FCaptureTelemetry::Get().GetStatsJson());
+			if (FJsonSerializer::Deserialize(Reader, Stages) && Stages.IsValid())
+			{
+				Case->SetObjectField(TEXT("Stages"), Stages);
+			}
+
+			UE_LOG(LogVantageCVBenchmark, Log, TEXT("Capture %s: %.1f fps (%d frames)"), *CaseName, Case->GetNumberField(TEXT("FramesPerSecond")), Iterations);
+			Cases.Add(MakeShareable(new FJsonValueObject(Case)));
+		}
+		return Cases;
+	}
+
+	// ------------------------------------------------------------------------
+	// Spawn: parking slots + lanes sized for the vehicle count
+	// ------------------------------------------------------------------------
+	TArray<TSharedPtr<FJsonValue>> RunSpawnSuite(UWorld* World, int32 Iterations)
+	{
+		TArray<FVehicleSpawnConfig> VehicleConfigs;
+		VehicleConfigs.AddDefaulted_GetRef().AssetPath = BenchmarkAssetPath;
+
+		TArray<TSharedPtr<FJsonValue>> Cases;
+		for (const int32 NumVehicles : SpawnVehicleCounts)
+		{
+			const int32 NumParking = NumVehicles / 2;
+			const int32 VehiclesPerLane = FMath::DivideAndRoundUp(NumVehicles - NumParking, NumBenchmarkLanes);
+
+			// Slots 5 m apart in rows of 20; lanes long enough for 8 m spacing
+			FAnchorSpawnConfig Config;
+			Config.ParkingPositionJitter = 10.0f;
+			TArray<AActor*> Anchors;
+			for (int32 SlotIndex = 0; SlotIndex < NumParking; ++SlotIndex)
+			{
+				const FString Name = FString::Printf(TEXT("VantageCVBench_Park_%d"), SlotIndex);
+				const FVector Location = BenchmarkOrigin + FVector((SlotIndex % 20) * 500.0f, (SlotIndex / 20) * 800.0f, 0.0f);
+				if (AActor* Anchor = SpawnAnchor(World, Name, Location, FRotator::ZeroRotator))
+				{
+					Anchors.Add(Anchor);
+					Config.ParkingAnchors.Add(Anchor->GetName());
+				}
+			}
+			for (int32 LaneIndex = 0; LaneIndex < NumBenchmarkLanes; ++LaneIndex)
+			{
+				const FVector Start = BenchmarkOrigin + FVector(0.0f, -2000.0f - LaneIndex * 600.0f, 0.0f);
+				const FVector End = Start + FVector(VehiclesPerLane * 800.0f + 1000.0f, 0.0f, 0.0f);
+				AActor* StartAnchor = SpawnAnchor(World, FString::Printf(TEXT("VantageCVBench_Lane%d_Start"), LaneIndex), Start, FRotator::ZeroRotator);
+				AActor* EndAnchor = SpawnAnchor(World, FString::Printf(TEXT("VantageCVBench_Lane%d_End"), LaneIndex), End, FRotator::ZeroRotator);
+				if (StartAnchor && EndAnchor)
+				{
+					Anchors.Add(StartAnchor);
+					Anchors.Add(EndAnchor);
+
+					FLaneDefinition& Lane = Config.Lanes.AddDefaulted_GetRef();
+					Lane.LaneId = FString::Printf(TEXT("bench_lane_%d"), LaneIndex);
+					Lane.StartAnchorName = StartAnchor->GetName();
+					Lane.EndAnchorName = EndAnchor->GetName();
+				}
+			}
+
+			TStrongObjectPtr<UAnchorSpawnSystem> SpawnSystem(NewObject<UAnchorSpawnSystem>());
+			SpawnSystem->Initialize(World, Config, BenchmarkSeed);
+
+			TArray<double> TotalMs;
+			TArray<double> ParkingMs;
+			TArray<double> LaneMs;
+			TArray<double> ClearMs;
+			int32 NumSpawned = 0;
+
+			// Iteration 0 is the warm-up (asset load, pool fill); later passes reuse pooled actors
+			for (int32 Iteration = 0; Iteration <= Iterations; ++Iteration)
+			{
+				SpawnSystem->ReinitializeWithSeed(BenchmarkSeed + Iteration);
+
+				const double ParkingStart = FPlatformTime::Seconds();
+				const TArray<FSpawnResult> Parked = SpawnSystem->SpawnParkingVehicles(VehicleConfigs, NumParking);
+				const double LaneStart = FPlatformTime::Seconds();
+				const TArray<FSpawnResult> Driving = SpawnSystem->SpawnLaneVehicles(VehicleConfigs, VehiclesPerLane);
+				const double SpawnEnd = FPlatformTime::Seconds();
+
+				NumSpawned = SpawnSystem->GetSpawnedActors().Num();
+
+				const double ClearStart = FPlatformTime::Seconds();
+				SpawnSystem->ClearAllSpawned();
+				if (Iteration > 0)
+				{
+					ParkingMs.Add((LaneStart - ParkingStart) * 1000.0);
+					LaneMs.Add((SpawnEnd - LaneStart) * 1000.0);
+					TotalMs.Add((SpawnEnd - ParkingStart) * 1000.0);
+					ClearMs.Add(ElapsedMs(ClearStart));
+				}
+			}
+
+			TSharedPtr<FJsonObject> Case = MakeShareable(new FJsonObject);
+			Case->SetStringField(TEXT("Case"), FString::Printf(TEXT("%d vehicles"), NumVehicles));
+			Case->SetNumberField(TEXT("Vehicles"), NumVehicles);
+			Case->SetNumberField(TEXT("ParkingSlots"), NumParking);
+			Case->SetNumberField(TEXT("Lanes"), NumBenchmarkLanes);
+			Case->SetNumberField(TEXT("VehiclesPerLane"), VehiclesPerLane);
+			Case->SetNumberField(TEXT("Spawned"), NumSpawned);
+			Case->SetObjectField(TEXT("Total"), MakeTimingObject(TotalMs));
+			Case->SetObjectField(TEXT("SpawnParkingVehicles"), MakeTimingObject(ParkingMs));
+			Case->SetObjectField(TEXT("SpawnLaneVehicles"), MakeTimingObject(LaneMs));
+			Case->SetObjectField(TEXT("ClearAllSpawned"), MakeTimingObject(ClearMs));
+
+			UE_LOG(LogVantageCVBenchmark, Log, TEXT("Spawn %d vehicles: %d spawned"), NumVehicles, NumSpawned);
+			Cases.Add(MakeShareable(new FJsonValueObject(Case)));
+
+			DestroyActors(Anchors);
+		}
+		return Cases;
+	}
+
+	// ------------------------------------------------------------------------
+	// Anchors: ResolveAnchors against a growing number of anchor actors
+	// ------------------------------------------------------------------------
+	TArray<TSharedPtr<FJsonValue>> RunAnchorSuite(UWorld* World, int32 Iterations)
+	{
+		TArray<TSharedPtr<FJsonValue>> Cases;
+		for (const int32 NumAnchors : AnchorCounts)
+		{
+			FAnchorSpawnConfig Config;
+			TArray<AActor*> Anchors;
+			for (int32 AnchorIndex = 0; AnchorIndex < NumAnchors; ++AnchorIndex)
+			{
+				const FVector Location = BenchmarkOrigin + FVector((AnchorIndex % 100) * 500.0f, (AnchorIndex / 100) * 800.0f, 0.0f);
+				if (AActor* Anchor = SpawnAnchor(World, FString::Printf(TEXT("VantageCVBench_Anchor_%d"), AnchorIndex), Location, FRotator::ZeroRotator))
+				{
+					Anchors.Add(Anchor);
+					Config.ParkingAnchors.Add(Anchor->GetName());
+				}
+			}
+
+			// Initialize resolves once, which is also the warm-up (index build)
+			TStrongObjectPtr<UAnchorSpawnSystem> SpawnSystem(NewObject<UAnchorSpawnSystem>());
+			SpawnSystem->Initialize(World, Config, BenchmarkSeed);
+
+			TArray<double> ResolveMs;
+			int32 NumResolved = 0;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double Start = FPlatformTime::Seconds();
+				NumResolved = SpawnSystem->ResolveAnchors();
+				ResolveMs.Add(ElapsedMs(Start));
+			}
+
+			UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(World);
+
+			TSharedPtr<FJsonObject> Case = MakeShareable(new FJsonObject);
+			Case->SetStringField(TEXT("Case"), FString::Printf(TEXT("%d anchors"), NumAnchors));
+			Case->SetNumberField(TEXT("Anchors"), NumAnchors);
+			Case->SetNumberField(TEXT("Resolved"), NumResolved);
+			Case->SetNumberField(TEXT("WorldActors"), ActorIndex ? ActorIndex->GetNumIndexedActors() : 0);
+			Case->SetObjectField(TEXT("ResolveAnchors"), MakeTimingObject(ResolveMs));
+
+			UE_LOG(LogVantageCVBenchmark, Log, TEXT("ResolveAnchors %d anchors: %d resolved"), NumAnchors, NumResolved);
+			Cases.Add(MakeShareable(new FJsonValueObject(Case)));
+
+			DestroyActors(Anchors);
+		}
+		return Cases;
+	}
+
+	// ------------------------------------------------------------------------
+	// Annotation: targets in a grid in front of the capture camera
+	// ------------------------------------------------------------------------
+	TArray<TSharedPtr<FJsonValue>> RunAnnotationSuite(UWorld* World, ADataCapture* DataCapture, int32 Iterations)
+	{
+		UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(World);
+		UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(World);
+		const TArray<FString> TargetTags = { BenchmarkTag };
+
+		const FVector CameraLocation = DataCapture->GetActorLocation();
+		const FRotationMatrix CameraAxes(DataCapture->GetActorRotation());
+
+		TArray<TSharedPtr<FJsonValue>> Cases;
+		for (const int32 NumTargets : AnnotationTargetCounts)
+		{
+			// Square grid 20-60 m ahead, inside a 90 degree view
+			TArray<AActor*> Targets;
+			const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumTargets));
+			for (int32 TargetIndex = 0; TargetIndex < NumTargets && ActorPool; ++TargetIndex)
+			{
+				const int32 Row = TargetIndex / GridSize;
+				const int32 Column = TargetIndex % GridSize;
+				const float Depth = 2000.0f + Row * (4000.0f / GridSize);
+				const float Lateral = (Column - GridSize * 0.5f + 0.5f) * (Depth * 1.6f / GridSize);
+				const FVector Location = CameraLocation + CameraAxes.GetScaledAxis(EAxis::X) * Depth + CameraAxes.GetScaledAxis(EAxis::Y) * Lateral;
+
+				AActor* Target = ActorPool->Acquire(BenchmarkAssetPath, Location, FRotator::ZeroRotator);
+				if (!Target)
+				{
+					continue;
+				}
+				Target->Tags.Add(FName(BenchmarkTag));
+				if (ActorIndex)
+				{
+					ActorIndex->ReindexActor(Target);
+				}
+				FSegmentationStencil::AssignInstanceId(Target);
+				Targets.Add(Target);
+			}
+
+			DataCapture->GenerateBoundingBoxes(TargetTags);
+
+			TArray<double> BoxMs;
+			TArray<double> PoseMs;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double BoxStart = FPlatformTime::Seconds();
+				DataCapture->GenerateBoundingBoxes(TargetTags);
+				BoxMs.Add(ElapsedMs(BoxStart));
+
+				const double PoseStart = FPlatformTime::Seconds();
+				DataCapture->GeneratePoseAnnotations(TargetTags);
+				PoseMs.Add(ElapsedMs(PoseStart));
+			}
+
+			TSharedPtr<FJsonObject> Case = MakeShareable(new FJsonObject);
+			Case->SetStringField(TEXT("Case"), FString::Printf(TEXT("%d targets"), NumTargets));
+			Case->SetNumberField(TEXT("Targets"), Targets.Num());
+			Case->SetObjectField(TEXT("GenerateBoundingBoxes"), MakeTimingObject(BoxMs));
+			Case->SetObjectField(TEXT("GeneratePoseAnnotations"), MakeTimingObject(PoseMs));
+
+			UE_LOG(LogVantageCVBenchmark, Log, TEXT("Annotation %d targets done"), Targets.Num());
+			Cases.Add(MakeShareable(new FJsonValueObject(Case)));
+
+			// Parked for the next case; the pool untags them and releases their stencil IDs
+			for (AActor* Target : Targets)
+			{
+				ActorPool->Release(Target);
+			}
+		}
+		return Cases;
+	}
+
+	bool IsSuiteSelected(const TArray<FString>& Selected, const TCHAR* Suite)
+	{
+		return Selected.Num() == 0 || Selected.Contains(TEXT("all")) || Selected.Contains(Suite);
+	}
+}
+
+FString FVantageCVBenchmark::GetDefaultOutputPath()
+{
+	return FPaths::ProjectSavedDir() / FString::Printf(TEXT("VantageCV/Benchmarks/benchmark_%s_%s.json"),
+		*FVantageCVWorker::Get().GetWorkerTag(), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+}
+
+FString FVantageCVBenchmark::Run(UWorld* World, const FString& Suites, int32 Iterations, const FString& OutputPath)
+{
+	if (!World || !IsInGameThread())
+	{
+		UE_LOG(LogVantageCVBenchmark, Error, TEXT("Benchmark needs a world and must run on the game thread"));
+		return TEXT("{}");
+	}
+	Iterations = FMath::Max(1, Iterations);
+
+	// Names compare case-insensitively (FString ==)
+	TArray<FString> Selected;
+	Suites.ParseIntoArray(Selected, TEXT(","), true);
+	for (FString& Suite : Selected)
+	{
+		Suite.TrimStartAndEndInline();
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetStringField(TEXT("TimestampUtc"), FDateTime::UtcNow().ToIso8601());
+	Root->SetStringField(TEXT("Map"), World->GetMapName());
+	Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("Host"), FPlatformProcess::ComputerName());
+	Root->SetStringField(TEXT("CPU"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	Root->SetNumberField(TEXT("LogicalCores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	Root->SetStringField(TEXT("GPU"), GRHIAdapterName);
+	Root->SetStringField(TEXT("WorkerTag"), FVantageCVWorker::Get().GetWorkerTag());
+	Root->SetNumberField(TEXT("Iterations"), Iterations);
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// Anything queued before the run would be billed to the first capture case
+	FCaptureWriteQueue::Get().Flush();
+
+	ADataCapture* DataCapture = FindDataCapture(World);
+	ADataCapture* TemporaryCapture = nullptr;
+	if (!DataCapture && (IsSuiteSelected(Selected, TEXT("Capture")) || IsSuiteSelected(Selected, TEXT("Annotation"))))
+	{
+		UE_LOG(LogVantageCVBenchmark, Warning, TEXT("No DataCapture in %s - using a temporary one at the benchmark origin"), *World->GetMapName());
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		TemporaryCapture = World->SpawnActor<ADataCapture>(ADataCapture::StaticClass(), BenchmarkOrigin + FVector(0.0f, 0.0f, 300.0f), FRotator::ZeroRotator, Params);
+		DataCapture = TemporaryCapture;
+	}
+	Root->SetBoolField(TEXT("bTemporaryCamera"), TemporaryCapture != nullptr);
+
+	if (IsSuiteSelected(Selected, TEXT("Capture")) && DataCapture)
+	{
+		Root->SetArrayField(TEXT("Capture"), RunCaptureSuite(DataCapture, Iterations));
+	}
+	if (IsSuiteSelected(Selected, TEXT("Spawn")))
+	{
+		Root->SetArrayField(TEXT("Spawn"), RunSpawnSuite(World, Iterations));
+	}
+	if (IsSuiteSelected(Selected, TEXT("Anchors")))
+	{
+		Root->SetArrayField(TEXT("Anchors"), RunAnchorSuite(World, Iterations));
+	}
+	if (IsSuiteSelected(Selected, TEXT("Annotation")) && DataCapture)
+	{
+		Root->SetArrayField(TEXT("Annotation"), RunAnnotationSuite(World, DataCapture, Iterations));
+	}
+
+	if (TemporaryCapture)
+	{
+		TemporaryCapture->Destroy();
+	}
+	Root->SetNumberField(TEXT("ElapsedSeconds"), FPlatformTime::Seconds() - StartSeconds);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+	const FString FilePath = OutputPath.IsEmpty() ? GetDefaultOutputPath() : OutputPath;
+	if (FFileHelper::SaveStringToFile(Output, *FilePath))
+	{
+		UE_LOG(LogVantageCVBenchmark, Log, TEXT("Benchmark results written to %s"), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogVantageCVBenchmark, Error, TEXT("Failed to write benchmark results to %s"), *FilePath);
+	}
+	return Output;
+}
+
+// VantageCV.Benchmark [Suites] [Iterations] [OutputPath]
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+	TEXT("VantageCV.Benchmark"),
+	TEXT("Run capture/spawn/anchor/annotation benchmarks: VantageCV.Benchmark [Capture,Spawn,Anchors,Annotation|all] [Iterations=10] [OutputPath]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		const FString Suites = Args.Num() > 0 ? Args[0] : FString();
+		const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10;
+		const FString OutputPath = Args.Num() > 2 ? Args[2] : FString();
+		FVantageCVBenchmark::Run(World, Suites, Iterations, OutputPath);
+	})
+);
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 AutomationIterations = 5;
+
+	/** Per-case budget checked by the automation tests; Metric is a dotted path into the case object */
+	struct FBenchmarkThreshold
+	{
+		const TCHAR* Suite;
+		const TCHAR* Case;
+		const TCHAR* Metric;
+		double Limit;
+		bool bMinimum;
+	};
+
+	// Reference-map budgets on a farm node; VantageCV.Benchmark.ThresholdScale loosens the timing ones
+	const FBenchmarkThreshold BenchmarkThresholds[] =
+	{
+		{ TEXT("Capture"), TEXT("640x480"), TEXT("Failed"), 0.0, false },
+		{ TEXT("Capture"), TEXT("640x480"), TEXT("FramesPerSecond"), 30.0, true },
+		{ TEXT("Capture"), TEXT("1920x1080"), TEXT("Failed"), 0.0, false },
+		{ TEXT("Capture"), TEXT("1920x1080"), TEXT("FramesPerSecond"), 10.0, true },
+		{ TEXT("Capture"), TEXT("3840x2160"), TEXT("Failed"), 0.0, false },
+		{ TEXT("Capture"), TEXT("3840x2160"), TEXT("FramesPerSecond"), 2.0, true },
+		{ TEXT("Spawn"), TEXT("50 vehicles"), TEXT("Spawned"), 50.0, true },
+		{ TEXT("Spawn"), TEXT("50 vehicles"), TEXT("Total.p95_ms"), 20.0, false },
+		{ TEXT("Spawn"), TEXT("200 vehicles"), TEXT("Spawned"), 200.0, true },
+		{ TEXT("Spawn"), TEXT("200 vehicles"), TEXT("Total.p95_ms"), 60.0, false },
+		{ TEXT("Spawn"), TEXT("500 vehicles"), TEXT("Spawned"), 500.0, true },
+		{ TEXT("Spawn"), TEXT("500 vehicles"), TEXT("Total.p95_ms"), 150.0, false },
+		{ TEXT("Anchors"), TEXT("50 anchors"), TEXT("Resolved"), 50.0, true },
+		{ TEXT("Anchors"), TEXT("50 anchors"), TEXT("ResolveAnchors.p95_ms"), 2.0, false },
+		{ TEXT("Anchors"), TEXT("200 anchors"), TEXT("Resolved"), 200.0, true },
+		{ TEXT("Anchors"), TEXT("200 anchors"), TEXT("ResolveAnchors.p95_ms"), 5.0, false },
+		{ TEXT("Anchors"), TEXT("1000 anchors"), TEXT("Resolved"), 1000.0, true },
+		{ TEXT("Anchors"), TEXT("1000 anchors"), TEXT("ResolveAnchors.p95_ms"), 20.0, false },
+		{ TEXT("Anchors"), TEXT("5000 anchors"), TEXT("Resolved"), 5000.0, true },
+		{ TEXT("Anchors"), TEXT("5000 anchors"), TEXT("ResolveAnchors.p95_ms"), 100.0, false },
+		{ TEXT("Annotation"), TEXT("10 targets"), TEXT("GenerateBoundingBoxes.p95_ms"), 2.0, false },
+		{ TEXT("Annotation"), TEXT("100 targets"), TEXT("GenerateBoundingBoxes.p95_ms"), 10.0, false },
+		{ TEXT("Annotation"), TEXT("500 targets"), TEXT("GenerateBoundingBoxes.p95_ms"), 50.0, false },
+		{ TEXT("Annotation"), TEXT("500 targets"), TEXT("GeneratePoseAnnotations.p95_ms"), 50.0, false },
+	};
+
+	TAutoConsoleVariable<float> CVarBenchmarkThresholdScale(
+		TEXT("VantageCV.Benchmark.ThresholdScale"),
+		1.0f,
+		TEXT("Multiplier on the benchmark automation test timing budgets (fps minimums are divided by it)"));
+
+	/** Running game or PIE world; benchmarks spawn actors, so the editor world is never used */
+	UWorld* FindBenchmarkWorld()
+	{
+		if (!GEngine)
+		{
+			return nullptr;
+		}
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World())
+			{
+				return Context.World();
+			}
+		}
+		return nullptr;
+	}
+
+	bool GetCaseMetric(const TSharedPtr<FJsonObject>& Case, const FString& Metric, double& OutValue)
+	{
+		TArray<FString> Path;
+		Metric.ParseIntoArray(Path, TEXT("."), true);
+		TSharedPtr<FJsonObject> Object = Case;
+		for (int32 Index = 0; Object.IsValid() && Index < Path.Num() - 1; ++Index)
+		{
+			const TSharedPtr<FJsonObject>* Child = nullptr;
+			Object = Object->TryGetObjectField(Path[Index], Child) ? *Child : nullptr;
+		}
+		return Object.IsValid() && Path.Num() > 0 && Object->TryGetNumberField(Path.Last(), OutValue);
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FVantageCVBenchmarkTest, "VantageCV.Benchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FVantageCVBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const TCHAR* Suite : { TEXT("Capture"), TEXT("Spawn"), TEXT("Anchors"), TEXT("Annotation") })
+	{
+		OutBeautifiedNames.Add(Suite);
+		OutTestCommands.Add(Suite);
+	}
+}
+
+bool FVantageCVBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = FindBenchmarkWorld();
+	if (!World)
+	{
+		AddError(TEXT("No game or PIE world - run the benchmark tests on the reference map with -game or in PIE"));
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FVantageCVBenchmark::Run(World, Parameters, AutomationIterations, FString()));
+	const TArray<TSharedPtr<FJsonValue>>* Cases = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetArrayField(Parameters, Cases))
+	{
+		AddError(FString::Printf(TEXT("Benchmark suite %s produced no results"), *Parameters));
+		return false;
+	}
+
+	const double Scale = FMath::Max(0.01, (double)CVarBenchmarkThresholdScale.GetValueOnGameThread());
+	for (const FBenchmarkThreshold& Threshold : BenchmarkThresholds)
+	{
+		if (Parameters != Threshold.Suite)
+		{
+			continue;
+		}
+
+		const TSharedPtr<FJsonValue>* Match = Cases->FindByPredicate([&Threshold](const TSharedPtr<FJsonValue>& Value)
+		{
+			return Value->AsObject().IsValid() && Value->AsObject()->GetStringField(TEXT("Case")) == Threshold.Case;
+		});
+		double Value = 0.0;
+		if (!Match || !GetCaseMetric((*Match)->AsObject(), Threshold.Metric, Value))
+		{
+			AddError(FString::Printf(TEXT("%s %s: no %s in the results"), Threshold.Suite, Threshold.Case, Threshold.Metric));
+			continue;
+		}
+
+		// Counts are exact; only timings and rates scale
+		const bool bTiming = FString(Threshold.Metric).EndsWith(TEXT("_ms")) || FCString::Strcmp(Threshold.Metric, TEXT("FramesPerSecond")) == 0;
+		const double Limit = !bTiming ? Threshold.Limit : (Threshold.bMinimum ? Threshold.Limit / Scale : Threshold.Limit * Scale);
+		const FString What = FString::Printf(TEXT("%s %s %s"), Threshold.Suite, Threshold.Case, Threshold.Metric);
+		if (Threshold.bMinimum)
+		{
+			TestTrue(FString::Printf(TEXT("%s = %.2f (minimum %.2f)"), *What, Value, Limit), Value >= Limit);
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("%s = %.2f (maximum %.2f)"), *What, Value, Limit), Value <= Limit);
+		}
+	}
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
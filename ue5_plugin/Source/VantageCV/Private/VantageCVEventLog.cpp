@@ -0,0 +1,487 @@
+/******************************************************************************
+ * VantageCV - Event Log Implementation
+ ******************************************************************************
+ * File: VantageCVEventLog.cpp
+ * Description: Lock-free event ring, JSON line formatting and the writer
+ *              thread for structured events
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "VantageCVEventLog.h"
+#include "VantageCVWorker.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogVantageCVEvents, Log, All);
+
+std::atomic<uint8> FVantageCVEventLog::RuntimeLevel{(uint8)EVantageCVEventLevel::Info};
+FVantageCVEventLog* FVantageCVEventLog::Instance = nullptr;
+
+static_assert((FVantageCVEventLog::Capacity & (FVantageCVEventLog::Capacity - 1)) == 0, "Event ring capacity must be a power of two");
+
+namespace
+{
+	constexpr float DrainIntervalSeconds = 0.1f;
+
+	const TCHAR* LevelNames[] = { TEXT("Error"), TEXT("Warning"), TEXT("Info"), TEXT("Verbose"), TEXT("VeryVerbose") };
+
+	/** Level strings in the file, matching the Python logging module names */
+	const TCHAR* LevelJsonNames[] = { TEXT("ERROR"), TEXT("WARNING"), TEXT("INFO"), TEXT("DEBUG"), TEXT("TRACE") };
+
+	void AppendJsonString(FString& Out, FStringView Value)
+	{
+		Out.AppendChar(TEXT('"'));
+		for (const TCHAR Char : Value)
+		{
+			switch (Char)
+			{
+			case TEXT('"'): Out.Append(TEXT("\\\"")); break;
+			case TEXT('\\'): Out.Append(TEXT("\\\\")); break;
+			case TEXT('\n'): Out.Append(TEXT("\\n")); break;
+			case TEXT('\r'): Out.Append(TEXT("\\r")); break;
+			case TEXT('\t'): Out.Append(TEXT("\\t")); break;
+			default:
+				if (Char < 0x20)
+				{
+					Out.Appendf(TEXT("\\u%04x"), (uint32)Char);
+				}
+				else
+				{
+					Out.AppendChar(Char);
+				}
+			}
+		}
+		Out.AppendChar(TEXT('"'));
+	}
+
+	void AppendNumber(FString& Out, double Value)
+	{
+		if (FMath::IsFinite(Value))
+		{
+			Out.Appendf(TEXT("%.6g"), Value);
+		}
+		else
+		{
+			Out.Append(TEXT("null"));
+		}
+	}
+}
+
+FVantageCVEventLog& FVantageCVEventLog::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FVantageCVEventLog();
+	}
+	return *Instance;
+}
+
+void FVantageCVEventLog::Shutdown()
+{
+	if (Instance)
+	{
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+void FVantageCVEventLog::SetLevel(EVantageCVEventLevel Level)
+{
+	RuntimeLevel.store((uint8)Level, std::memory_order_relaxed);
+	if ((int32)Level > VANTAGECV_EVENT_COMPILED_LEVEL)
+	{
+		UE_LOG(LogVantageCVEvents, Warning, TEXT("Event level %s is above the compiled-in level %s; those events are compiled out"),
+			GetLevelName(Level), GetLevelName((EVantageCVEventLevel)VANTAGECV_EVENT_COMPILED_LEVEL));
+	}
+}
+
+bool FVantageCVEventLog::ParseLevel(const FString& Name, EVantageCVEventLevel& OutLevel)
+{
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(LevelNames); ++Index)
+	{
+		if (Name.Equals(LevelNames[Index], ESearchCase::IgnoreCase))
+		{
+			OutLevel = (EVantageCVEventLevel)Index;
+			return true;
+		}
+	}
+	return false;
+}
+
+const TCHAR* FVantageCVEventLog::GetLevelName(EVantageCVEventLevel Level)
+{
+	return (uint8)Level < UE_ARRAY_COUNT(LevelNames) ? LevelNames[(uint8)Level] : TEXT("Unknown");
+}
+
+FVantageCVEventLog::FVantageCVEventLog()
+{
+	Records = MakeUnique<FEventRecord[]>(Capacity);
+	for (int32 Index = 0; Index < Capacity; ++Index)
+	{
+		Records[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+
+	BaseTime = FDateTime::UtcNow();
+	BaseSeconds = FPlatformTime::Seconds();
+
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	DrainedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+	ParseCommandLine();
+
+	Thread = FRunnableThread::Create(this, TEXT("VantageCVEventLog"), 0, TPri_BelowNormal);
+}
+
+FVantageCVEventLog::~FVantageCVEventLog()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	// Events queued after the thread's last pass
+	Drain();
+
+	if (FileWriter)
+	{
+		FileWriter->Close();
+		delete FileWriter;
+		FileWriter = nullptr;
+	}
+
+	UE_LOG(LogVantageCVEvents, Log, TEXT("Event log closed (%lld written, %lld dropped)"), NumWritten.load(), NumDropped.load());
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	FPlatformProcess::ReturnSynchEventToPool(DrainedEvent);
+}
+
+void FVantageCVEventLog::ParseCommandLine()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString LevelName;
+	if (FParse::Value(CommandLine, TEXT("VantageCVEventLevel="), LevelName))
+	{
+		EVantageCVEventLevel Level;
+		if (ParseLevel(LevelName, Level))
+		{
+			SetLevel(Level);
+		}
+		else
+		{
+			UE_LOG(LogVantageCVEvents, Warning, TEXT("Unknown -VantageCVEventLevel=%s, keeping %s"), *LevelName, GetLevelName(GetLevel()));
+		}
+	}
+
+	FParse::Bool(CommandLine, TEXT("VantageCVEventEcho="), bEcho);
+
+	bool bWriteFile = true;
+	FParse::Bool(CommandLine, TEXT("VantageCVEventFile="), bWriteFile);
+	if (!bWriteFile)
+	{
+		return;
+	}
+
+	FString Directory = FPaths::ProjectSavedDir() / TEXT("VantageCV/Logs");
+	FParse::Value(CommandLine, TEXT("VantageCVEventDir="), Directory);
+
+	// Same naming as the Python ResearchLogger (<module>_<timestamp>.jsonl), per worker
+	FilePath = Directory / FString::Printf(TEXT("events_%s_%s.jsonl"),
+		*FVantageCVWorker::Get().GetWorkerTag(), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	FileWriter = IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_AllowRead);
+	if (!FileWriter)
+	{
+		UE_LOG(LogVantageCVEvents, Error, TEXT("Failed to open event log %s"), *FilePath);
+		FilePath.Empty();
+		return;
+	}
+
+	UE_LOG(LogVantageCVEvents, Log, TEXT("Event log: %s (level %s, compiled up to %s)"), *FilePath,
+		GetLevelName(GetLevel()), GetLevelName((EVantageCVEventLevel)VANTAGECV_EVENT_COMPILED_LEVEL));
+}
+
+void FVantageCVEventLog::Write(EVantageCVEventLevel Level, const TCHAR* Module, const TCHAR* Message, std::initializer_list<FVantageCVEventField> Fields)
+{
+	// Claim a slot (bounded MPMC queue: a slot is free when its sequence equals the position)
+	FEventRecord* Record = nullptr;
+	uint64 Position = EnqueuePosition.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		FEventRecord& Slot = Records[Position & (Capacity - 1)];
+		const int64 Diff = (int64)Slot.Sequence.load(std::memory_order_acquire) - (int64)Position;
+		if (Diff == 0)
+		{
+			if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+			{
+				Record = &Slot;
+				break;
+			}
+		}
+		else if (Diff < 0)
+		{
+			NumDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+		{
+			Position = EnqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	Record->Seconds = FPlatformTime::Seconds();
+	Record->Frame = GFrameCounter;
+	Record->Level = Level;
+	Record->Module = Module;
+	Record->Message = Message;
+	Record->NumFields = 0;
+	Record->TextLength = 0;
+
+	for (const FVantageCVEventField& Field : Fields)
+	{
+		if (Record->NumFields == MaxFields)
+		{
+			break;
+		}
+
+		FStoredField& Stored = Record->Fields[Record->NumFields++];
+		Stored.Key = Field.Key;
+		Stored.Type = Field.Type;
+		Stored.Int = Field.Int;
+		Stored.Float[0] = Field.Float[0];
+		Stored.Float[1] = Field.Float[1];
+		Stored.Float[2] = Field.Float[2];
+
+		if (Field.Type == FVantageCVEventField::EType::String)
+		{
+			// Truncated to what is left of the inline buffer
+			const int32 Length = FMath::Min(Field.String.Len(), TextCapacity - (int32)Record->TextLength);
+			FMemory::Memcpy(Record->Text + Record->TextLength, Field.String.GetData(), Length * sizeof(TCHAR));
+			Stored.TextOffset = Record->TextLength;
+			Stored.TextLength = (uint16)Length;
+			Record->TextLength += (uint16)Length;
+		}
+	}
+
+	Record->Sequence.store(Position + 1, std::memory_order_release);
+
+	if (Level <= EVantageCVEventLevel::Warning)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+void FVantageCVEventLog::Flush()
+{
+	const uint64 Target = EnqueuePosition.load(std::memory_order_acquire);
+	for (;;)
+	{
+		{
+			FScopeLock Lock(&DrainLock);
+			if (DequeuePosition >= Target)
+			{
+				break;
+			}
+		}
+		WorkEvent->Trigger();
+		DrainedEvent->Wait(5);
+	}
+
+	FScopeLock Lock(&DrainLock);
+	if (FileWriter)
+	{
+		FileWriter->Flush();
+	}
+}
+
+int32 FVantageCVEventLog::Drain()
+{
+	FScopeLock Lock(&DrainLock);
+
+	FString Json;
+	FString Echo;
+	FString Batch;
+	int32 NumDrained = 0;
+
+	for (;;)
+	{
+		FEventRecord& Slot = Records[DequeuePosition & (Capacity - 1)];
+		if (Slot.Sequence.load(std::memory_order_acquire) != DequeuePosition + 1)
+		{
+			break;
+		}
+
+		FormatRecord(Slot, Json, Echo);
+		const EVantageCVEventLevel Level = Slot.Level;
+
+		// Release the slot for the producer one lap ahead
+		Slot.Sequence.store(DequeuePosition + Capacity, std::memory_order_release);
+		++DequeuePosition;
+		++NumDrained;
+
+		Batch.Append(Json);
+		Batch.AppendChar(TEXT('\n'));
+
+		if (bEcho)
+		{
+			switch (Level)
+			{
+			case EVantageCVEventLevel::Error:
+				UE_LOG(LogVantageCVEvents, Error, TEXT("%s"), *Echo);
+				break;
+			case EVantageCVEventLevel::Warning:
+				UE_LOG(LogVantageCVEvents, Warning, TEXT("%s"), *Echo);
+				break;
+			default:
+				UE_LOG(LogVantageCVEvents, Log, TEXT("%s"), *Echo);
+				break;
+			}
+		}
+	}
+
+	if (NumDrained > 0)
+	{
+		if (FileWriter)
+		{
+			FTCHARToUTF8 Utf8(*Batch);
+			FileWriter->Serialize((void*)Utf8.Get(), Utf8.Length());
+		}
+		NumWritten.fetch_add(NumDrained, std::memory_order_relaxed);
+		DrainedEvent->Trigger();
+	}
+	return NumDrained;
+}
+
+void FVantageCVEventLog::FormatRecord(const FEventRecord& Record, FString& OutJson, FString& OutEcho) const
+{
+	OutJson.Reset();
+	OutEcho.Reset();
+
+	const FDateTime Timestamp = BaseTime + FTimespan::FromSeconds(Record.Seconds - BaseSeconds);
+
+	OutJson.Append(TEXT("{\"timestamp\": "));
+	AppendJsonString(OutJson, Timestamp.ToIso8601());
+	OutJson.Append(TEXT(", \"module\": "));
+	AppendJsonString(OutJson, Record.Module);
+	OutJson.Appendf(TEXT(", \"level\": \"%s\", \"message\": "), LevelJsonNames[(uint8)Record.Level]);
+	AppendJsonString(OutJson, Record.Message);
+	OutJson.Appendf(TEXT(", \"frame\": %llu"), Record.Frame);
+
+	OutEcho.Appendf(TEXT("[%s] %s"), Record.Module, Record.Message);
+	if (Record.NumFields > 0)
+	{
+		OutEcho.Append(TEXT(" | {"));
+	}
+
+	for (int32 Index = 0; Index < Record.NumFields; ++Index)
+	{
+		const FStoredField& Field = Record.Fields[Index];
+		OutJson.Append(TEXT(", "));
+		AppendJsonString(OutJson, Field.Key);
+		OutJson.Append(TEXT(": "));
+
+		const int32 ValueStart = OutJson.Len();
+		switch (Field.Type)
+		{
+		case FVantageCVEventField::EType::Int:
+			OutJson.Appendf(TEXT("%lld"), Field.Int);
+			break;
+		case FVantageCVEventField::EType::Float:
+			AppendNumber(OutJson, Field.Float[0]);
+			break;
+		case FVantageCVEventField::EType::Bool:
+			OutJson.Append(Field.Int ? TEXT("true") : TEXT("false"));
+			break;
+		case FVantageCVEventField::EType::String:
+			AppendJsonString(OutJson, FStringView(Record.Text + Field.TextOffset, Field.TextLength));
+			break;
+		case FVantageCVEventField::EType::Vector:
+			OutJson.AppendChar(TEXT('['));
+			AppendNumber(OutJson, Field.Float[0]);
+			OutJson.Append(TEXT(", "));
+			AppendNumber(OutJson, Field.Float[1]);
+			OutJson.Append(TEXT(", "));
+			AppendNumber(OutJson, Field.Float[2]);
+			OutJson.AppendChar(TEXT(']'));
+			break;
+		}
+
+		// Echo reuses the JSON value text, strings unquoted like the old LogInfo output
+		OutEcho.Appendf(TEXT("%s%s="), Index > 0 ? TEXT(", ") : TEXT(""), Field.Key);
+		if (Field.Type == FVantageCVEventField::EType::String)
+		{
+			OutEcho.Append(FStringView(Record.Text + Field.TextOffset, Field.TextLength));
+		}
+		else
+		{
+			OutEcho.Append(FStringView(*OutJson + ValueStart, OutJson.Len() - ValueStart));
+		}
+	}
+
+	if (Record.NumFields > 0)
+	{
+		OutEcho.AppendChar(TEXT('}'));
+	}
+	OutJson.AppendChar(TEXT('}'));
+}
+
+FString FVantageCVEventLog::GetStatsJson() const
+{
+	const uint64 Enqueued = EnqueuePosition.load(std::memory_order_relaxed);
+	uint64 Dequeued;
+	{
+		FScopeLock Lock(&DrainLock);
+		Dequeued = DequeuePosition;
+	}
+
+	FString Json;
+	Json.Appendf(TEXT("{\"Level\": \"%s\", \"CompiledLevel\": \"%s\", \"File\": "),
+		GetLevelName(GetLevel()), GetLevelName((EVantageCVEventLevel)VANTAGECV_EVENT_COMPILED_LEVEL));
+	AppendJsonString(Json, FilePath);
+	Json.Appendf(TEXT(", \"Echo\": %s, \"Written\": %lld, \"Dropped\": %lld, \"Queued\": %llu, \"Capacity\": %d}"),
+		bEcho ? TEXT("true") : TEXT("false"), NumWritten.load(), NumDropped.load(), Enqueued - Dequeued, Capacity);
+	return Json;
+}
+
+uint32 FVantageCVEventLog::Run()
+{
+	while (!bStopRequested.load())
+	{
+		WorkEvent->Wait(FTimespan::FromSeconds(DrainIntervalSeconds));
+		Drain();
+	}
+	return 0;
+}
+
+void FVantageCVEventLog::Stop()
+{
+	bStopRequested = true;
+	WorkEvent->Trigger();
+}
+
+static FAutoConsoleCommand EventLevelCommand(
+	TEXT("VantageCV.EventLevel"),
+	TEXT("Set the structured event level: VantageCV.EventLevel <Error|Warning|Info|Verbose|VeryVerbose>"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		EVantageCVEventLevel Level;
+		if (Args.Num() == 0 || !FVantageCVEventLog::ParseLevel(Args[0], Level))
+		{
+			UE_LOG(LogVantageCVEvents, Display, TEXT("Event level: %s (compiled up to %s)"),
+				FVantageCVEventLog::GetLevelName(FVantageCVEventLog::GetLevel()),
+				FVantageCVEventLog::GetLevelName((EVantageCVEventLevel)VANTAGECV_EVENT_COMPILED_LEVEL));
+			return;
+		}
+		FVantageCVEventLog::SetLevel(Level);
+		UE_LOG(LogVantageCVEvents, Display, TEXT("Event level set to %s"), FVantageCVEventLog::GetLevelName(Level));
+	})
+);
@@ -12,7 +12,17 @@
 #include "IRemoteControlModule.h"
 #include "RemoteControlPreset.h"
 #include "DataCapture.h"
+#include "CaptureWriteQueue.h"
+#include "CaptureResourcePool.h"
+#include "CaptureStreamSink.h"
+#include "CaptureShardWriter.h"
+#include "SpawnAssetCache.h"
+#include "VantageCVWorker.h"
+#include "VantageCVRecipe.h"
+#include "VantageCVEventLog.h"
 #include "EngineUtils.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
 #include "Engine/World.h"
 
 #define LOCTEXT_NAMESPACE "FVantageCVModule"
@@ -47,7 +57,20 @@ static FAutoConsoleCommand CaptureFrameCommand(
 void FVantageCVModule::StartupModule()
 {
 	UE_LOG(LogVantageCV, Log, TEXT("VantageCV Module Starting..."));
-	
+
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FVantageCVModule::OnPostEngineInit);
+
+	UE_LOG(LogVantageCV, Log, TEXT("VantageCV Module Started Successfully"));
+}
+
+void FVantageCVModule::OnPostEngineInit()
+{
+	// Worker identity from the command line; starts the heartbeat before the first scene arrives
+	FVantageCVWorker::Get();
+
+	// Event file is named after the worker, so it opens once the worker is configured
+	FVantageCVEventLog::Get();
+
 	// Verify Remote Control module is available
 	if (IRemoteControlModule* RemoteControlModule = FModuleManager::GetModulePtr<IRemoteControlModule>("RemoteControl"))
 	{
@@ -58,13 +81,20 @@ void FVantageCVModule::StartupModule()
 	{
 		UE_LOG(LogVantageCV, Error, TEXT("Remote Control Module Not Found - Plugin functionality will be limited"));
 	}
-	
-	UE_LOG(LogVantageCV, Log, TEXT("VantageCV Module Started Successfully"));
 }
 
 void FVantageCVModule::ShutdownModule()
 {
 	UE_LOG(LogVantageCV, Log, TEXT("VantageCV Module Shutting Down..."));
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FVantageCVRecipeRunner::Shutdown();
+	FVantageCVWorker::Shutdown();
+	FCaptureStreamSink::Shutdown();
+	FCaptureWriteQueue::Shutdown();
+	FCaptureShardWriter::Shutdown();
+	FCaptureResourcePool::Shutdown();
+	FSpawnAssetCache::Shutdown();
+	FVantageCVEventLog::Shutdown();
 	UnregisterRemoteControlEndpoints();
 	UE_LOG(LogVantageCV, Log, TEXT("VantageCV Module Shutdown Complete"));
 }
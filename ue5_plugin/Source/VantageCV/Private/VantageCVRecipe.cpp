@@ -0,0 +1,1446 @@
+/******************************************************************************
+ * VantageCV - Recipe Runner Implementation
+ ******************************************************************************
+ * File: VantageCVRecipe.cpp
+ * Description: YAML subset reader, research_v2 / anchors / vehicles config
+ *              mapping, the ticker-driven frame loop and the
+ *              VantageCV.RunRecipe console command
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "VantageCVRecipe.h"
+#include "VantageCVSubsystem.h"
+#include "VantageCVWorker.h"
+#include "DomainRandomization.h"
+#include "ScenePlanner.h"
+#include "ActorPoolSubsystem.h"
+#include "ActorIndexSubsystem.h"
+#include "SegmentationStencil.h"
+#include "GroundHeightSubsystem.h"
+#include "CaptureWriteQueue.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogVantageCVRecipe, Log, All);
+
+FVantageCVRecipeRunner* FVantageCVRecipeRunner::Instance = nullptr;
+
+namespace
+{
+	/** Frames per anchor / randomization planning batch (one batch is sampled ahead) */
+	constexpr int32 PlanBatchSize = 256;
+	constexpr int32 ProgressLogInterval = 100;
+
+	// ========================================
+	// YAML subset reader
+	// ========================================
+
+	struct FYamlLine
+	{
+		int32 Number = 0;
+		int32 Indent = 0;
+		FString Text;
+	};
+
+	bool IsSequenceItem(const FString& Text)
+	{
+		return Text == TEXT("-") || Text.StartsWith(TEXT("- "));
+	}
+
+	/** Line without its comment ('#' at the start or after whitespace, outside quotes) */
+	FString StripComment(const FString& Line)
+	{
+		TCHAR Quote = 0;
+		for (int32 Index = 0; Index < Line.Len(); ++Index)
+		{
+			const TCHAR Char = Line[Index];
+			if (Quote)
+			{
+				if (Char == TEXT('\\') && Quote == TEXT('"'))
+				{
+					++Index;
+				}
+				else if (Char == Quote)
+				{
+					Quote = 0;
+				}
+			}
+			else if (Char == TEXT('"') || Char == TEXT('\''))
+			{
+				Quote = Char;
+			}
+			else if (Char == TEXT('#') && (Index == 0 || FChar::IsWhitespace(Line[Index - 1])))
+			{
+				return Line.Left(Index);
+			}
+		}
+		return Line;
+	}
+
+	/** Index of the ':' ending a mapping key (followed by a space or the end), outside quotes and brackets */
+	int32 FindKeySeparator(const FString& Text)
+	{
+		TCHAR Quote = 0;
+		int32 Depth = 0;
+		for (int32 Index = 0; Index < Text.Len(); ++Index)
+		{
+			const TCHAR Char = Text[Index];
+			if (Quote)
+			{
+				if (Char == TEXT('\\') && Quote == TEXT('"'))
+				{
+					++Index;
+				}
+				else if (Char == Quote)
+				{
+					Quote = 0;
+				}
+			}
+			else if (Char == TEXT('"') || Char == TEXT('\''))
+			{
+				Quote = Char;
+			}
+			else if (Char == TEXT('[') || Char == TEXT('{'))
+			{
+				++Depth;
+			}
+			else if (Char == TEXT(']') || Char == TEXT('}'))
+			{
+				--Depth;
+			}
+			else if (Char == TEXT(':') && Depth == 0 && (Index + 1 == Text.Len() || FChar::IsWhitespace(Text[Index + 1])))
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	bool IsYamlNumber(const FString& Text)
+	{
+		int32 Index = 0;
+		if (Index < Text.Len() && (Text[Index] == TEXT('-') || Text[Index] == TEXT('+')))
+		{
+			++Index;
+		}
+		int32 Digits = 0;
+		while (Index < Text.Len() && FChar::IsDigit(Text[Index]))
+		{
+			++Index;
+			++Digits;
+		}
+		if (Index < Text.Len() && Text[Index] == TEXT('.'))
+		{
+			++Index;
+			while (Index < Text.Len() && FChar::IsDigit(Text[Index]))
+			{
+				++Index;
+				++Digits;
+			}
+		}
+		if (Digits == 0)
+		{
+			return false;
+		}
+		if (Index < Text.Len() && (Text[Index] == TEXT('e') || Text[Index] == TEXT('E')))
+		{
+			++Index;
+			if (Index < Text.Len() && (Text[Index] == TEXT('-') || Text[Index] == TEXT('+')))
+			{
+				++Index;
+			}
+			const int32 ExponentStart = Index;
+			while (Index < Text.Len() && FChar::IsDigit(Text[Index]))
+			{
+				++Index;
+			}
+			if (Index == ExponentStart)
+			{
+				return false;
+			}
+		}
+		return Index == Text.Len();
+	}
+
+	/** Plain (unquoted) scalar: null, bool (PyYAML spellings), number or string */
+	TSharedPtr<FJsonValue> MakePlainScalar(const FString& Text)
+	{
+		if (Text.IsEmpty() || Text == TEXT("~") || Text.Equals(TEXT("null"), ESearchCase::IgnoreCase))
+		{
+			return MakeShared<FJsonValueNull>();
+		}
+		if (Text.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("yes"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("on"), ESearchCase::IgnoreCase))
+		{
+			return MakeShared<FJsonValueBoolean>(true);
+		}
+		if (Text.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("no"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("off"), ESearchCase::IgnoreCase))
+		{
+			return MakeShared<FJsonValueBoolean>(false);
+		}
+		if (IsYamlNumber(Text))
+		{
+			return MakeShared<FJsonValueNumber>(FCString::Atod(*Text));
+		}
+		return MakeShared<FJsonValueString>(Text);
+	}
+
+	class FYamlReader
+	{
+	public:
+		bool Read(const FString& Text, TSharedPtr<FJsonObject>& OutRoot, FString& OutError)
+		{
+			TArray<FString> RawLines;
+			Text.ParseIntoArrayLines(RawLines, false);
+
+			for (int32 LineIndex = 0; LineIndex < RawLines.Num(); ++LineIndex)
+			{
+				const FString& Raw = RawLines[LineIndex];
+				int32 Indent = 0;
+				while (Indent < Raw.Len() && Raw[Indent] == TEXT(' '))
+				{
+					++Indent;
+				}
+
+				const FString Content = StripComment(Raw).TrimEnd();
+				if (Content.Len() <= Indent)
+				{
+					continue;
+				}
+				if (Raw[Indent] == TEXT('\t'))
+				{
+					OutError = FString::Printf(TEXT("line %d: tab indentation"), LineIndex + 1);
+					return false;
+				}
+				if (Indent == 0 && (Content == TEXT("---") || Content == TEXT("...")))
+				{
+					continue;
+				}
+
+				FYamlLine& Line = Lines.AddDefaulted_GetRef();
+				Line.Number = LineIndex + 1;
+				Line.Indent = Indent;
+				Line.Text = Content.Mid(Indent);
+			}
+
+			OutRoot = MakeShared<FJsonObject>();
+			if (Lines.Num() == 0)
+			{
+				return true;
+			}
+
+			const TSharedPtr<FJsonValue> Root = ParseBlock(Lines[0].Indent);
+			if (Error.IsEmpty() && Cursor < Lines.Num())
+			{
+				Fail(Lines[Cursor].Number, TEXT("unexpected indentation"));
+			}
+			if (Error.IsEmpty() && (!Root.IsValid() || Root->Type != EJson::Object))
+			{
+				Fail(Lines[0].Number, TEXT("top level must be a mapping"));
+			}
+			if (!Error.IsEmpty())
+			{
+				OutError = Error;
+				return false;
+			}
+
+			OutRoot = Root->AsObject();
+			return true;
+		}
+
+	private:
+		TSharedPtr<FJsonValue> ParseBlock(int32 Indent)
+		{
+			return IsSequenceItem(Lines[Cursor].Text) ? ParseSequence(Indent) : ParseMap(Indent);
+		}
+
+		TSharedPtr<FJsonValue> ParseMap(int32 Indent)
+		{
+			TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+			while (Cursor < Lines.Num() && Error.IsEmpty())
+			{
+				const FYamlLine& Line = Lines[Cursor];
+				if (Line.Indent < Indent)
+				{
+					break;
+				}
+				if (Line.Indent > Indent)
+				{
+					Fail(Line.Number, TEXT("unexpected indentation"));
+					break;
+				}
+
+				const int32 Separator = FindKeySeparator(Line.Text);
+				if (Separator == INDEX_NONE || IsSequenceItem(Line.Text))
+				{
+					Fail(Line.Number, TEXT("expected 'key: value'"));
+					break;
+				}
+
+				const int32 LineNumber = Line.Number;
+				const FString KeyText = Line.Text.Left(Separator).TrimEnd();
+				const FString Rest = Line.Text.Mid(Separator + 1).TrimStartAndEnd();
+				++Cursor;
+
+				if (KeyText.IsEmpty() || KeyText[0] == TEXT('?') || KeyText[0] == TEXT('&') || KeyText[0] == TEXT('*') || KeyText[0] == TEXT('!'))
+				{
+					Fail(LineNumber, TEXT("unsupported key (complex keys, anchors and tags are not supported)"));
+					break;
+				}
+				FString Key = KeyText;
+				if (KeyText[0] == TEXT('"') || KeyText[0] == TEXT('\''))
+				{
+					int32 Position = 0;
+					if (!ReadQuoted(KeyText, Position, Key, LineNumber) || Position != KeyText.Len())
+					{
+						Fail(LineNumber, TEXT("malformed quoted key"));
+						break;
+					}
+				}
+
+				TSharedPtr<FJsonValue> Value;
+				if (!Rest.IsEmpty())
+				{
+					Value = ParseInline(Rest, LineNumber);
+				}
+				else if (Cursor < Lines.Num() && Lines[Cursor].Indent > Indent)
+				{
+					Value = ParseBlock(Lines[Cursor].Indent);
+				}
+				else if (Cursor < Lines.Num() && Lines[Cursor].Indent == Indent && IsSequenceItem(Lines[Cursor].Text))
+				{
+					// "key:" followed by "- item" at the key's own indentation
+					Value = ParseSequence(Indent);
+				}
+				else
+				{
+					Value = MakeShared<FJsonValueNull>();
+				}
+
+				if (Object->HasField(Key))
+				{
+					Fail(LineNumber, FString::Printf(TEXT("duplicate key '%s'"), *Key));
+					break;
+				}
+				Object->SetField(Key, Value);
+			}
+			return MakeShared<FJsonValueObject>(Object);
+		}
+
+		TSharedPtr<FJsonValue> ParseSequence(int32 Indent)
+		{
+			TArray<TSharedPtr<FJsonValue>> Items;
+			while (Cursor < Lines.Num() && Error.IsEmpty())
+			{
+				FYamlLine& Line = Lines[Cursor];
+				if (Line.Indent < Indent || (Line.Indent == Indent && !IsSequenceItem(Line.Text)))
+				{
+					break;
+				}
+				if (Line.Indent > Indent)
+				{
+					Fail(Line.Number, TEXT("unexpected indentation"));
+					break;
+				}
+
+				const FString Rest = Line.Text.Mid(1).TrimStart();
+				if (Rest.IsEmpty())
+				{
+					++Cursor;
+					if (Cursor < Lines.Num() && Lines[Cursor].Indent > Indent)
+					{
+						Items.Add(ParseBlock(Lines[Cursor].Indent));
+					}
+					else
+					{
+						Items.Add(MakeShared<FJsonValueNull>());
+					}
+				}
+				else if (IsSequenceItem(Rest) || FindKeySeparator(Rest) != INDEX_NONE)
+				{
+					// Block item starting on the dash line ("- id: lane_1"): re-read the line at the item's column
+					Line.Indent += Line.Text.Len() - Rest.Len();
+					Line.Text = Rest;
+					Items.Add(ParseBlock(Line.Indent));
+				}
+				else
+				{
+					Items.Add(ParseInline(Rest, Line.Number));
+					++Cursor;
+				}
+			}
+			return MakeShared<FJsonValueArray>(Items);
+		}
+
+		/** Value on the same line as its key or dash: scalar or flow collection */
+		TSharedPtr<FJsonValue> ParseInline(const FString& Text, int32 LineNumber)
+		{
+			const TCHAR First = Text[0];
+			if (First == TEXT('&') || First == TEXT('*') || First == TEXT('!') || First == TEXT('|') || First == TEXT('>') || First == TEXT('%') || First == TEXT('@'))
+			{
+				Fail(LineNumber, TEXT("unsupported value (anchors, aliases, tags and block scalars are not supported)"));
+				return MakeShared<FJsonValueNull>();
+			}
+
+			int32 Position = 0;
+			TSharedPtr<FJsonValue> Value = ParseFlowValue(Text, Position, LineNumber, false);
+			SkipWhitespace(Text, Position);
+			if (Error.IsEmpty() && Position != Text.Len())
+			{
+				Fail(LineNumber, TEXT("unexpected characters after value"));
+			}
+			return Value;
+		}
+
+		TSharedPtr<FJsonValue> ParseFlowValue(const FString& Text, int32& Position, int32 LineNumber, bool bInFlow)
+		{
+			SkipWhitespace(Text, Position);
+			if (Position >= Text.Len())
+			{
+				return MakeShared<FJsonValueNull>();
+			}
+
+			const TCHAR First = Text[Position];
+			if (First == TEXT('['))
+			{
+				++Position;
+				TArray<TSharedPtr<FJsonValue>> Items;
+				SkipWhitespace(Text, Position);
+				if (Position < Text.Len() && Text[Position] == TEXT(']'))
+				{
+					++Position;
+					return MakeShared<FJsonValueArray>(Items);
+				}
+				while (Error.IsEmpty())
+				{
+					Items.Add(ParseFlowValue(Text, Position, LineNumber, true));
+					SkipWhitespace(Text, Position);
+					if (Position < Text.Len() && Text[Position] == TEXT(','))
+					{
+						++Position;
+						continue;
+					}
+					if (Position < Text.Len() && Text[Position] == TEXT(']'))
+					{
+						++Position;
+						break;
+					}
+					Fail(LineNumber, TEXT("expected ',' or ']'"));
+				}
+				return MakeShared<FJsonValueArray>(Items);
+			}
+
+			if (First == TEXT('{'))
+			{
+				++Position;
+				TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+				SkipWhitespace(Text, Position);
+				if (Position < Text.Len() && Text[Position] == TEXT('}'))
+				{
+					++Position;
+					return MakeShared<FJsonValueObject>(Object);
+				}
+				while (Error.IsEmpty())
+				{
+					SkipWhitespace(Text, Position);
+					FString Key;
+					if (Position < Text.Len() && (Text[Position] == TEXT('"') || Text[Position] == TEXT('\'')))
+					{
+						ReadQuoted(Text, Position, Key, LineNumber);
+					}
+					else
+					{
+						const int32 Start = Position;
+						while (Position < Text.Len() && Text[Position] != TEXT(':') && Text[Position] != TEXT(',') && Text[Position] != TEXT('}'))
+						{
+							++Position;
+						}
+						Key = Text.Mid(Start, Position - Start).TrimEnd();
+					}
+					SkipWhitespace(Text, Position);
+					if (Position >= Text.Len() || Text[Position] != TEXT(':'))
+					{
+						Fail(LineNumber, TEXT("expected ':' in inline mapping"));
+						break;
+					}
+					++Position;
+					Object->SetField(Key, ParseFlowValue(Text, Position, LineNumber, true));
+					SkipWhitespace(Text, Position);
+					if (Position < Text.Len() && Text[Position] == TEXT(','))
+					{
+						++Position;
+						continue;
+					}
+					if (Position < Text.Len() && Text[Position] == TEXT('}'))
+					{
+						++Position;
+						break;
+					}
+					Fail(LineNumber, TEXT("expected ',' or '}'"));
+				}
+				return MakeShared<FJsonValueObject>(Object);
+			}
+
+			if (First == TEXT('"') || First == TEXT('\''))
+			{
+				FString Value;
+				ReadQuoted(Text, Position, Value, LineNumber);
+				return MakeShared<FJsonValueString>(Value);
+			}
+
+			// Plain scalar: the rest of the line, or up to the next flow delimiter
+			const int32 Start = Position;
+			while (Position < Text.Len() && !(bInFlow && (Text[Position] == TEXT(',') || Text[Position] == TEXT(']') || Text[Position] == TEXT('}'))))
+			{
+				++Position;
+			}
+			return MakePlainScalar(Text.Mid(Start, Position - Start).TrimStartAndEnd());
+		}
+
+		bool ReadQuoted(const FString& Text, int32& Position, FString& OutValue, int32 LineNumber)
+		{
+			const TCHAR Quote = Text[Position++];
+			OutValue.Reset();
+			while (Position < Text.Len())
+			{
+				const TCHAR Char = Text[Position++];
+				if (Quote == TEXT('\'') && Char == TEXT('\''))
+				{
+					if (Position < Text.Len() && Text[Position] == TEXT('\''))
+					{
+						OutValue.AppendChar(TEXT('\''));
+						++Position;
+						continue;
+					}
+					return true;
+				}
+				if (Quote == TEXT('"') && Char == TEXT('"'))
+				{
+					return true;
+				}
+				if (Quote == TEXT('"') && Char == TEXT('\\') && Position < Text.Len())
+				{
+					const TCHAR Escaped = Text[Position++];
+					OutValue.AppendChar(Escaped == TEXT('n') ? TEXT('\n') : Escaped == TEXT('t') ? TEXT('\t') : Escaped);
+					continue;
+				}
+				OutValue.AppendChar(Char);
+			}
+			Fail(LineNumber, TEXT("unterminated quoted string"));
+			return false;
+		}
+
+		static void SkipWhitespace(const FString& Text, int32& Position)
+		{
+			while (Position < Text.Len() && FChar::IsWhitespace(Text[Position]))
+			{
+				++Position;
+			}
+		}
+
+		void Fail(int32 LineNumber, const FString& Reason)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = FString::Printf(TEXT("line %d: %s"), LineNumber, *Reason);
+			}
+		}
+
+		TArray<FYamlLine> Lines;
+		int32 Cursor = 0;
+		FString Error;
+	};
+
+	// ========================================
+	// Config field access
+	// ========================================
+
+	TSharedPtr<FJsonObject> GetObject(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+	{
+		const TSharedPtr<FJsonValue> Value = Object.IsValid() ? Object->TryGetField(Field) : nullptr;
+		return Value.IsValid() && Value->Type == EJson::Object ? Value->AsObject() : nullptr;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> GetArray(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+	{
+		const TSharedPtr<FJsonValue> Value = Object.IsValid() ? Object->TryGetField(Field) : nullptr;
+		return Value.IsValid() && Value->Type == EJson::Array ? Value->AsArray() : TArray<TSharedPtr<FJsonValue>>();
+	}
+
+	double GetNumber(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, double Default)
+	{
+		double Value = Default;
+		return Object.IsValid() && Object->TryGetNumberField(Field, Value) ? Value : Default;
+	}
+
+	FString GetString(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, const FString& Default)
+	{
+		FString Value;
+		return Object.IsValid() && Object->TryGetStringField(Field, Value) ? Value : Default;
+	}
+
+	TArray<FString> GetStrings(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+	{
+		TArray<FString> Strings;
+		for (const TSharedPtr<FJsonValue>& Value : GetArray(Object, Field))
+		{
+			FString String;
+			if (Value.IsValid() && Value->TryGetString(String))
+			{
+				Strings.Add(String);
+			}
+		}
+		return Strings;
+	}
+
+	/** Relative paths resolve against BaseDir; the {worker} token is applied for multi-instance runs */
+	FString ResolveOutputPath(const FString& BaseDir, const FString& Path)
+	{
+		const FString Combined = FPaths::IsRelative(Path) ? FPaths::Combine(BaseDir, Path) : Path;
+		return FVantageCVWorker::Get().ResolvePath(FPaths::ConvertRelativePathToFull(Combined));
+	}
+
+	bool LoadResearchConfig(const TSharedPtr<FJsonObject>& Root, const FString& RepositoryRoot, FVantageCVRecipe& Recipe, FString& OutError)
+	{
+		Recipe.ExperimentName = GetString(Root, TEXT("experiment_name"), TEXT("research_v2"));
+		Recipe.Seed = (int32)GetNumber(Root, TEXT("random_seed"), Recipe.Seed);
+		Recipe.NumImages = (int32)GetNumber(Root, TEXT("num_images"), Recipe.NumImages);
+
+		// research_v2 only distinguishes day and night; other names pass through to the preset registry
+		const FString TimeOfDay = GetString(GetObject(Root, TEXT("scene")), TEXT("time_of_day"), TEXT("day"));
+		Recipe.LightingPreset = TimeOfDay == TEXT("day") ? FString(TEXT("noon")) : TimeOfDay;
+
+		const TSharedPtr<FJsonObject> Vehicles = GetObject(Root, TEXT("vehicles"));
+		if (const TSharedPtr<FJsonObject> Counts = GetObject(Vehicles, TEXT("count_distribution")))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : Counts->Values)
+			{
+				FRecipeCountBucket& Bucket = Recipe.CountBuckets.AddDefaulted_GetRef();
+				FString MinText = Entry.Key;
+				FString MaxText = Entry.Key;
+				Entry.Key.Split(TEXT("-"), &MinText, &MaxText);
+				Bucket.Min = FCString::Atoi(*MinText);
+				Bucket.Max = FCString::Atoi(*MaxText);
+				Bucket.Weight = Entry.Value.IsValid() ? (float)Entry.Value->AsNumber() : 0.0f;
+				if (Bucket.Min < 1 || Bucket.Max < Bucket.Min)
+				{
+					OutError = FString::Printf(TEXT("vehicles.count_distribution: invalid bucket '%s'"), *Entry.Key);
+					return false;
+				}
+			}
+		}
+		if (Recipe.CountBuckets.Num() == 0)
+		{
+			Recipe.CountBuckets.AddDefaulted();
+			Recipe.CountBuckets[0].Weight = 1.0f;
+		}
+
+		const TSharedPtr<FJsonObject> Weights = GetObject(Vehicles, TEXT("class_weights"));
+		const TSharedPtr<FJsonObject> Actors = GetObject(Vehicles, TEXT("vehicle_actors"));
+		if (Actors.IsValid())
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : Actors->Values)
+			{
+				FRecipeVehicleClass VehicleClass;
+				VehicleClass.Name = Entry.Key;
+				VehicleClass.Weight = (float)GetNumber(Weights, *Entry.Key, Weights.IsValid() ? 0.0 : 1.0);
+				VehicleClass.ActorNames = GetStrings(Actors, *Entry.Key);
+				if (VehicleClass.Weight > 0.0f && VehicleClass.ActorNames.Num() > 0)
+				{
+					Recipe.VehicleClasses.Add(MoveTemp(VehicleClass));
+				}
+			}
+		}
+		if (Recipe.VehicleClasses.Num() == 0)
+		{
+			OutError = TEXT("vehicles.vehicle_actors: no class with a positive weight and level actors");
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject> Camera = GetObject(Root, TEXT("camera"));
+		Recipe.CameraLocation = FVector(
+			GetNumber(Camera, TEXT("x_position"), 0.0) * 100.0,
+			GetNumber(Camera, TEXT("y_position"), 0.0) * 100.0,
+			GetNumber(Camera, TEXT("height"), 1.5) * 100.0);
+		Recipe.CameraRotation = FRotator(
+			GetNumber(Camera, TEXT("pitch"), 0.0),
+			GetNumber(Camera, TEXT("yaw"), 0.0),
+			GetNumber(Camera, TEXT("roll"), 0.0));
+		Recipe.CameraFOV = (float)GetNumber(Camera, TEXT("fov"), Recipe.CameraFOV);
+		Recipe.CameraFOVJitter = (float)GetNumber(Camera, TEXT("fov_jitter"), 0.0);
+		Recipe.Width = (int32)GetNumber(Camera, TEXT("width"), Recipe.Width);
+		Recipe.Height = (int32)GetNumber(Camera, TEXT("height_px"), Recipe.Height);
+
+		Recipe.ImageFormat = GetString(GetObject(Root, TEXT("render")), TEXT("image_format"), Recipe.ImageFormat);
+
+		const TSharedPtr<FJsonObject> Output = GetObject(Root, TEXT("output"));
+		const FString BaseDir = ResolveOutputPath(RepositoryRoot, GetString(Output, TEXT("base_dir"), TEXT("data/research_v2")));
+		Recipe.ImagesDir = FPaths::Combine(BaseDir, GetString(Output, TEXT("images_subdir"), TEXT("images")));
+		Recipe.AnnotationsDir = FPaths::Combine(BaseDir, GetString(Output, TEXT("annotations_subdir"), TEXT("annotations")));
+		Recipe.MetadataDir = FPaths::Combine(BaseDir, GetString(Output, TEXT("metadata_subdir"), TEXT("metadata")));
+		return true;
+	}
+
+	/** Same fields and defaults as AnchorSpawnConfig.from_yaml */
+	void LoadAnchorConfig(const TSharedPtr<FJsonObject>& Root, FAnchorSpawnConfig& Config)
+	{
+		for (const TSharedPtr<FJsonValue>& Locked : GetArray(Root, TEXT("locked_actors")))
+		{
+			FString Name;
+			if (Locked->Type == EJson::Object)
+			{
+				Name = GetString(Locked->AsObject(), TEXT("name"), FString());
+			}
+			else
+			{
+				Locked->TryGetString(Name);
+			}
+			if (!Name.IsEmpty())
+			{
+				Config.LockedActors.Add(Name);
+			}
+		}
+
+		const TSharedPtr<FJsonObject> Parking = GetObject(Root, TEXT("parking"));
+		Config.ParkingAnchors = GetStrings(Parking, TEXT("anchors"));
+		Config.ParkingPositionJitter = (float)GetNumber(Parking, TEXT("position_jitter_cm"), 10.0);
+		Config.ParkingYawJitter = (float)GetNumber(Parking, TEXT("yaw_jitter_degrees"), 5.0);
+		Config.ReverseParkingProbability = (float)GetNumber(Parking, TEXT("reverse_probability"), 0.3);
+
+		// Current format nests definitions under lanes; legacy files make lanes the list itself
+		const TSharedPtr<FJsonObject> Lanes = GetObject(Root, TEXT("lanes"));
+		const TArray<TSharedPtr<FJsonValue>> LaneList = Lanes.IsValid() ? GetArray(Lanes, TEXT("definitions")) : GetArray(Root, TEXT("lanes"));
+		Config.LaneLateralJitter = (float)GetNumber(Lanes, TEXT("lateral_jitter_cm"), 30.0);
+		Config.LaneYawJitter = (float)GetNumber(Lanes, TEXT("yaw_jitter_degrees"), 2.0);
+		for (const TSharedPtr<FJsonValue>& LaneValue : LaneList)
+		{
+			const TSharedPtr<FJsonObject> LaneObject = LaneValue->Type == EJson::Object ? LaneValue->AsObject() : nullptr;
+			if (!LaneObject.IsValid() || !LaneObject->HasField(TEXT("id")))
+			{
+				continue;
+			}
+			FLaneDefinition& Lane = Config.Lanes.AddDefaulted_GetRef();
+			Lane.LaneId = GetString(LaneObject, TEXT("id"), FString());
+			Lane.StartAnchorName = GetString(LaneObject, TEXT("start"), FString());
+			Lane.EndAnchorName = GetString(LaneObject, TEXT("end"), FString());
+			Lane.LaneWidth = (float)GetNumber(LaneObject, TEXT("width_cm"), 350.0);
+		}
+
+		const TSharedPtr<FJsonObject> Sidewalk = GetObject(Root, TEXT("sidewalk"));
+		Config.SidewalkBounds.Anchor1Name = GetString(Sidewalk, TEXT("anchor_1"), FString());
+		Config.SidewalkBounds.Anchor2Name = GetString(Sidewalk, TEXT("anchor_2"), FString());
+	}
+
+	void LoadVehiclesConfig(const TSharedPtr<FJsonObject>& Root, FVantageCVRecipe& Recipe)
+	{
+		// Offsets are per mesh type and the level actors are not mapped to types, so only the default applies
+		const TSharedPtr<FJsonObject> Default = GetObject(GetObject(Root, TEXT("vehicles")), TEXT("default"));
+		Recipe.RotationOffset = (float)GetNumber(Default, TEXT("rotation_offset"), 0.0);
+
+		if (const TSharedPtr<FJsonObject> Prewarm = GetObject(GetObject(Root, TEXT("pool")), TEXT("prewarm")))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : Prewarm->Values)
+			{
+				Recipe.PoolPrewarm.Add(Entry.Key, Entry.Value.IsValid() ? (int32)Entry.Value->AsNumber() : 0);
+			}
+		}
+	}
+
+	// ========================================
+	// Per-frame sampling
+	// ========================================
+
+	int32 SampleVehicleCount(const TArray<FRecipeCountBucket>& Buckets, FCounterRandom& Random)
+	{
+		float TotalWeight = 0.0f;
+		for (const FRecipeCountBucket& Bucket : Buckets)
+		{
+			TotalWeight += Bucket.Weight;
+		}
+
+		float Pick = Random.FRand() * TotalWeight;
+		for (const FRecipeCountBucket& Bucket : Buckets)
+		{
+			if (Pick < Bucket.Weight || &Bucket == &Buckets.Last())
+			{
+				return Random.RandRange(Bucket.Min, Bucket.Max);
+			}
+			Pick -= Bucket.Weight;
+		}
+		return 1;
+	}
+
+	/** Weighted class, then a random actor of it not used yet this frame (empty once the class is exhausted) */
+	FString SampleVehicleActor(const TArray<FRecipeVehicleClass>& Classes, const TSet<FString>& Used, FCounterRandom& Random, FString& OutClass)
+	{
+		float TotalWeight = 0.0f;
+		for (const FRecipeVehicleClass& VehicleClass : Classes)
+		{
+			TotalWeight += VehicleClass.Weight;
+		}
+
+		float Pick = Random.FRand() * TotalWeight;
+		const FRecipeVehicleClass* Picked = &Classes.Last();
+		for (const FRecipeVehicleClass& VehicleClass : Classes)
+		{
+			if (Pick < VehicleClass.Weight)
+			{
+				Picked = &VehicleClass;
+				break;
+			}
+			Pick -= VehicleClass.Weight;
+		}
+
+		const int32 NumActors = Picked->ActorNames.Num();
+		const int32 Start = Random.RandRange(0, NumActors - 1);
+		for (int32 Offset = 0; Offset < NumActors; ++Offset)
+		{
+			const FString& ActorName = Picked->ActorNames[(Start + Offset) % NumActors];
+			if (!Used.Contains(ActorName))
+			{
+				OutClass = Picked->Name;
+				return ActorName;
+			}
+		}
+		return FString();
+	}
+
+	FAnchorSpawnPlanParams MakePlanParams(const FVantageCVRecipe& Recipe)
+	{
+		// Only slot transforms are used (vehicles are level actors, not assets), so one config suffices
+		const int32 MaxVehicles = Recipe.GetMaxVehicles();
+		const int32 NumLanes = Recipe.AnchorConfig.Lanes.Num();
+
+		FAnchorSpawnPlanParams Params;
+		Params.NumVehicleConfigs = 1;
+		Params.MaxParkingVehicles = MaxVehicles;
+		Params.VehiclesPerLane = NumLanes > 0 ? FMath::DivideAndRoundUp(MaxVehicles, NumLanes) : 0;
+		return Params;
+	}
+
+	TSharedPtr<FJsonValue> ParseJsonValue(const FString& Json)
+	{
+		TSharedPtr<FJsonValue> Value;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		if (Json.IsEmpty() || !FJsonSerializer::Deserialize(Reader, Value) || !Value.IsValid())
+		{
+			return MakeShared<FJsonValueNull>();
+		}
+		return Value;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> MakeVectorArray(const FVector& Vector)
+	{
+		return { MakeShared<FJsonValueNumber>(Vector.X), MakeShared<FJsonValueNumber>(Vector.Y), MakeShared<FJsonValueNumber>(Vector.Z) };
+	}
+
+	/** research_v2.config.VehicleClass in declaration order; COCO category IDs are 1-based indices */
+	const TCHAR* const VehicleCategories[] = { TEXT("car"), TEXT("truck"), TEXT("bus"), TEXT("motorcycle"), TEXT("bicycle") };
+
+	/** 0 for a class the pipeline does not know */
+	int32 GetCategoryId(const FString& ClassName)
+	{
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(VehicleCategories); ++Index)
+		{
+			if (ClassName.Equals(VehicleCategories[Index], ESearchCase::IgnoreCase))
+			{
+				return Index + 1;
+			}
+		}
+		return 0;
+	}
+
+	FString SerializeJson(const TSharedPtr<FJsonObject>& Object)
+	{
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+		return Json;
+	}
+}
+
+// ========================================
+// Recipe
+// ========================================
+
+int32 FVantageCVRecipe::GetMaxVehicles() const
+{
+	int32 MaxVehicles = 1;
+	for (const FRecipeCountBucket& Bucket : CountBuckets)
+	{
+		MaxVehicles = FMath::Max(MaxVehicles, Bucket.Max);
+	}
+	return MaxVehicles;
+}
+
+TSharedPtr<FJsonObject> FVantageCVRecipe::LoadYaml(const FString& Path, FString& OutError)
+{
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Path))
+	{
+		OutError = FString::Printf(TEXT("%s: cannot read file"), *Path);
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	FYamlReader Reader;
+	if (!Reader.Read(Text, Root, OutError))
+	{
+		OutError = FString::Printf(TEXT("%s: %s"), *Path, *OutError);
+		return nullptr;
+	}
+	return Root;
+}
+
+bool FVantageCVRecipe::Load(const FString& ResearchPath, const FString& AnchorsPath, const FString& VehiclesPath,
+	FVantageCVRecipe& OutRecipe, FString& OutError)
+{
+	OutRecipe = FVantageCVRecipe();
+
+	const FString FullResearchPath = FPaths::ConvertRelativePathToFull(ResearchPath);
+	const TSharedPtr<FJsonObject> Research = LoadYaml(FullResearchPath, OutError);
+	if (!Research.IsValid())
+	{
+		return false;
+	}
+
+	// configs/research_v2.yaml -> repository root, where the Python pipeline resolves output.base_dir
+	const FString RepositoryRoot = FPaths::GetPath(FPaths::GetPath(FullResearchPath));
+	if (!LoadResearchConfig(Research, RepositoryRoot, OutRecipe, OutError))
+	{
+		OutError = FString::Printf(TEXT("%s: %s"), *FullResearchPath, *OutError);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> Anchors = LoadYaml(FPaths::ConvertRelativePathToFull(AnchorsPath), OutError);
+	if (!Anchors.IsValid())
+	{
+		return false;
+	}
+	LoadAnchorConfig(Anchors, OutRecipe.AnchorConfig);
+
+	if (!VehiclesPath.IsEmpty())
+	{
+		const TSharedPtr<FJsonObject> Vehicles = LoadYaml(FPaths::ConvertRelativePathToFull(VehiclesPath), OutError);
+		if (!Vehicles.IsValid())
+		{
+			return false;
+		}
+		LoadVehiclesConfig(Vehicles, OutRecipe);
+	}
+
+	UE_LOG(LogVantageCVRecipe, Log, TEXT("Loaded recipe '%s': %d frames, seed %d, %d vehicle classes, %d parking anchors, %d lanes -> %s"),
+		*OutRecipe.ExperimentName, OutRecipe.NumImages, OutRecipe.Seed, OutRecipe.VehicleClasses.Num(),
+		OutRecipe.AnchorConfig.ParkingAnchors.Num(), OutRecipe.AnchorConfig.Lanes.Num(), *OutRecipe.ImagesDir);
+	return true;
+}
+
+// ========================================
+// Runner
+// ========================================
+
+FVantageCVRecipeRunner& FVantageCVRecipeRunner::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FVantageCVRecipeRunner();
+	}
+	return *Instance;
+}
+
+void FVantageCVRecipeRunner::Shutdown()
+{
+	if (Instance)
+	{
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+FVantageCVRecipeRunner::~FVantageCVRecipeRunner()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+}
+
+bool FVantageCVRecipeRunner::Start(UWorld* InWorld, const FVantageCVRecipe& InRecipe, int32 NumFrames, bool bInQuitWhenDone, FString& OutError)
+{
+	if (!InWorld)
+	{
+		OutError = TEXT("No valid world found");
+		return false;
+	}
+
+	if (IsRunning())
+	{
+		UE_LOG(LogVantageCVRecipe, Warning, TEXT("Replacing running recipe '%s'"), *Recipe.ExperimentName);
+		bQuitWhenDone = false;
+		Stop();
+	}
+
+	SpawnSystem.Reset(NewObject<UAnchorSpawnSystem>());
+	if (!SpawnSystem->Initialize(InWorld, InRecipe.AnchorConfig, InRecipe.Seed))
+	{
+		SpawnSystem.Reset();
+		OutError = TEXT("None of the recipe's anchors were found in the level");
+		return false;
+	}
+
+	Recipe = InRecipe;
+	World = InWorld;
+	DomainRandomization.Reset();
+	for (TActorIterator<ADomainRandomization> It(InWorld); It; ++It)
+	{
+		DomainRandomization = *It;
+		break;
+	}
+
+	// This worker's share of [0, TotalFrames), minus frames a previous run already completed
+	const int32 TotalFrames = NumFrames > 0 ? NumFrames : Recipe.NumImages;
+	Frames = FVantageCVWorker::Get().GetPendingFrames(TotalFrames);
+	Frames.RemoveAll([TotalFrames](int64 Frame) { return Frame >= TotalFrames; });
+
+	NextFrame = 0;
+	NumSucceeded = 0;
+	NumFailed = 0;
+	NumRejected = 0;
+	bQuitWhenDone = bInQuitWhenDone;
+	bFinished = false;
+
+	if (UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(InWorld))
+	{
+		for (const TPair<FString, int32>& Entry : Recipe.PoolPrewarm)
+		{
+			ActorPool->Prewarm(Entry.Key, Entry.Value);
+		}
+	}
+
+	// The time of day is fixed for the run; DomainRandomization varies the sun per frame on top of it
+	UVantageCVSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UVantageCVSubsystem>() : nullptr;
+	if (Subsystem && !Recipe.LightingPreset.IsEmpty() && !Subsystem->ApplyLightingPreset(Recipe.LightingPreset, true))
+	{
+		UE_LOG(LogVantageCVRecipe, Warning, TEXT("Lighting preset '%s' could not be applied"), *Recipe.LightingPreset);
+	}
+
+	// An empty batch binds seed and layout, so frames never planned ahead sample the same values on the spot
+	SpawnSystem->PlanFrames(Recipe.Seed, 0, 0, MakePlanParams(Recipe));
+	if (ADomainRandomization* Randomization = DomainRandomization.Get())
+	{
+		Randomization->PlanFrames(Recipe.Seed, 0, 0);
+	}
+	PlanBatch(0);
+
+	StartSeconds = FPlatformTime::Seconds();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FVantageCVRecipeRunner::Tick));
+
+	UE_LOG(LogVantageCVRecipe, Log, TEXT("Running recipe '%s': %d frames on %s%s"),
+		*Recipe.ExperimentName, Frames.Num(), *FVantageCVWorker::Get().GetWorkerTag(),
+		DomainRandomization.IsValid() ? TEXT(" with DomainRandomization") : TEXT(""));
+	return true;
+}
+
+void FVantageCVRecipeRunner::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+		Finish();
+	}
+}
+
+void FVantageCVRecipeRunner::PlanBatch(int32 FirstIndex)
+{
+	// A worker of several owns every Nth frame; contiguous batches would mostly go unused, so its frames sample on the spot
+	if (FirstIndex >= Frames.Num() || FVantageCVWorker::Get().GetNumWorkers() > 1)
+	{
+		return;
+	}
+
+	const int32 LastIndex = FMath::Min(FirstIndex + PlanBatchSize, Frames.Num()) - 1;
+	const int64 FirstFrame = Frames[FirstIndex];
+	const int32 NumPlanned = (int32)(Frames[LastIndex] - FirstFrame + 1);
+
+	SpawnSystem->PlanFrames(Recipe.Seed, FirstFrame, NumPlanned, MakePlanParams(Recipe));
+	if (ADomainRandomization* Randomization = DomainRandomization.Get())
+	{
+		Randomization->PlanFrames(Recipe.Seed, (int32)FirstFrame, NumPlanned);
+	}
+}
+
+bool FVantageCVRecipeRunner::Tick(float DeltaTime)
+{
+	if (!World.IsValid() || NextFrame >= Frames.Num())
+	{
+		if (!World.IsValid())
+		{
+			UE_LOG(LogVantageCVRecipe, Error, TEXT("World went away after %d of %d frames"), NextFrame, Frames.Num());
+		}
+		TickerHandle.Reset();
+		Finish();
+		return false;
+	}
+
+	if (NextFrame % PlanBatchSize == 0)
+	{
+		PlanBatch(NextFrame + PlanBatchSize);
+	}
+
+	// The frame is reported done only once its annotation JSON is on disk; RenderScene is not given FrameIndex
+	const int64 GlobalFrame = Frames[NextFrame];
+	FVantageCVWorker::Get().BeginFrame(GlobalFrame);
+	// Rejected frames have no image, so they are reported failed and stay in FailedFrames for a retry
+	const EFrameResult Result = RenderFrame(GlobalFrame);
+	FVantageCVWorker::Get().CompleteFrame(GlobalFrame, Result == EFrameResult::Succeeded);
+	switch (Result)
+	{
+	case EFrameResult::Succeeded:	++NumSucceeded; break;
+	case EFrameResult::Rejected:	++NumRejected; break;
+	case EFrameResult::Failed:		++NumFailed; break;
+	}
+	++NextFrame;
+
+	if (NextFrame % ProgressLogInterval == 0)
+	{
+		const double Elapsed = FPlatformTime::Seconds() - StartSeconds;
+		UE_LOG(LogVantageCVRecipe, Log, TEXT("Recipe progress: %d / %d frames (%d failed, %d rejected), %.2f fps"),
+			NextFrame, Frames.Num(), NumFailed, NumRejected, Elapsed > 0.0 ? NextFrame / Elapsed : 0.0);
+	}
+	return true;
+}
+
+FVantageCVRecipeRunner::EFrameResult FVantageCVRecipeRunner::RenderFrame(int64 GlobalFrame)
+{
+	UWorld* CurrentWorld = World.Get();
+	UVantageCVSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UVantageCVSubsystem>() : nullptr;
+	if (!Subsystem)
+	{
+		return EFrameResult::Failed;
+	}
+
+	// 1. Vehicle count and level actors
+	FCounterRandom VehicleRandom(Recipe.Seed, GlobalFrame, EScenePlanStream::Vehicles);
+	const int32 NumVehicles = SampleVehicleCount(Recipe.CountBuckets, VehicleRandom);
+	TSet<FString> Used;
+	TArray<FString> ActorNames;
+	TArray<FString> ActorClasses;
+	for (int32 Index = 0; Index < NumVehicles; ++Index)
+	{
+		FString VehicleClass;
+		const FString ActorName = SampleVehicleActor(Recipe.VehicleClasses, Used, VehicleRandom, VehicleClass);
+		if (!ActorName.IsEmpty())
+		{
+			Used.Add(ActorName);
+			ActorNames.Add(ActorName);
+			ActorClasses.Add(VehicleClass);
+		}
+	}
+
+	// 2. Parking and lane slots, shuffled together so both are used at low counts
+	const FAnchorSpawnPlan Plan = SpawnSystem->TakePlannedFrame(GlobalFrame);
+	TArray<FTransform> Slots;
+	for (const FPlannedAnchorSpawn& Spawn : Plan.Parking)
+	{
+		Slots.Add(Spawn.Transform);
+	}
+	for (const FPlannedAnchorSpawn& Spawn : Plan.Lanes)
+	{
+		Slots.Add(Spawn.Transform);
+	}
+	for (int32 Index = Slots.Num() - 1; Index > 0; --Index)
+	{
+		Slots.Swap(Index, VehicleRandom.RandRange(0, Index));
+	}
+	if (Slots.Num() < ActorNames.Num())
+	{
+		UE_LOG(LogVantageCVRecipe, Warning, TEXT("Frame %lld: %d vehicles but only %d slots"), GlobalFrame, ActorNames.Num(), Slots.Num());
+		ActorNames.SetNum(Slots.Num());
+		ActorClasses.SetNum(Slots.Num());
+	}
+
+	TArray<FVector> Locations;
+	for (int32 Index = 0; Index < ActorNames.Num(); ++Index)
+	{
+		Locations.Add(Slots[Index].GetLocation());
+	}
+	TArray<float> GroundZ;
+	if (UGroundHeightSubsystem* GroundHeights = UGroundHeightSubsystem::Get(CurrentWorld))
+	{
+		GroundHeights->GetGroundHeights(Locations, GroundZ);
+	}
+
+	FVantageCVSceneRequest Request;
+	Request.bHideAllVehicles = true;
+	Request.TargetTags = { TEXT("Vehicle") };
+
+	for (int32 Index = 0; Index < ActorNames.Num(); ++Index)
+	{
+		FVantageCVActorState& State = Request.ActorStates.AddDefaulted_GetRef();
+		State.ActorName = ActorNames[Index];
+		State.Location = Locations[Index];
+		if (GroundZ.IsValidIndex(Index))
+		{
+			State.Location.Z = GroundZ[Index];
+		}
+		State.Rotation = Slots[Index].Rotator();
+		State.Rotation.Yaw += Recipe.RotationOffset;
+	}
+
+	// Recipe vehicles without the Vehicle tag are hidden explicitly
+	for (const FRecipeVehicleClass& VehicleClass : Recipe.VehicleClasses)
+	{
+		for (const FString& ActorName : VehicleClass.ActorNames)
+		{
+			if (!ActorNames.Contains(ActorName))
+			{
+				FVantageCVActorState& State = Request.ActorStates.AddDefaulted_GetRef();
+				State.ActorName = ActorName;
+				State.bVisible = false;
+			}
+		}
+	}
+
+	// 3. Sky, sun and distractors
+	if (ADomainRandomization* Randomization = DomainRandomization.Get())
+	{
+		Randomization->ApplyPlannedFrame((int32)GlobalFrame);
+	}
+
+	// 4. Camera
+	FCounterRandom CameraRandom(Recipe.Seed, GlobalFrame, EScenePlanStream::Camera);
+	const FString FrameName = FString::Printf(TEXT("frame_%06lld"), GlobalFrame);
+	FCaptureViewRequest& View = Request.Cameras.AddDefaulted_GetRef();
+	View.Location = Recipe.CameraLocation;
+	View.Rotation = Recipe.CameraRotation;
+	View.FOV = Recipe.CameraFOV + CameraRandom.FRandRange(-Recipe.CameraFOVJitter, Recipe.CameraFOVJitter);
+	View.Width = Recipe.Width;
+	View.Height = Recipe.Height;
+	View.OutputPath = FPaths::Combine(Recipe.ImagesDir, FrameName + TEXT(".") + Recipe.ImageFormat);
+	View.TargetTags = Request.TargetTags;
+
+	const FVantageCVSceneResponse Response = Subsystem->RenderScene(Request);
+	if (!Response.bSuccess || Response.Views.Num() == 0)
+	{
+		UE_LOG(LogVantageCVRecipe, Error, TEXT("Frame %lld failed: %s"), GlobalFrame, *Response.ErrorMessage);
+		return EFrameResult::Failed;
+	}
+	for (const FString& Missing : Response.MissingActors)
+	{
+		UE_LOG(LogVantageCVRecipe, Warning, TEXT("Frame %lld: vehicle actor %s not found in the level"), GlobalFrame, *Missing);
+	}
+
+	// Rejected by the visibility gate: no image, so no annotation either
+	const FCaptureViewResult& Result = Response.Views[0];
+	if (Result.bRejected)
+	{
+		UE_LOG(LogVantageCVRecipe, Verbose, TEXT("Frame %lld rejected by the visibility gate"), GlobalFrame);
+		return EFrameResult::Rejected;
+	}
+
+	// 5. Annotations, in research_v2 FrameAnnotation.to_dict() form (COCO image_id = F + 1)
+	TMap<int32, int32> VehicleByInstanceId;
+	if (UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(CurrentWorld))
+	{
+		for (int32 Index = 0; Index < ActorNames.Num(); ++Index)
+		{
+			const int32 InstanceId = FSegmentationStencil::GetInstanceId(ActorIndex->FindActorByName(ActorNames[Index]));
+			if (InstanceId != 0)
+			{
+				VehicleByInstanceId.Add(InstanceId, Index);
+			}
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> InstanceArray;
+	int32 NumValid = 0;
+	const TSharedPtr<FJsonValue> Boxes = ParseJsonValue(Result.BoundingBoxesJson);
+	const TArray<TSharedPtr<FJsonValue>>* BoxArray = nullptr;
+	if (Boxes->Type == EJson::Object && Boxes->AsObject()->TryGetArrayField(TEXT("annotations"), BoxArray))
+	{
+		for (const TSharedPtr<FJsonValue>& BoxValue : *BoxArray)
+		{
+			const TSharedPtr<FJsonObject> Box = BoxValue->AsObject();
+			const int32 InstanceId = (int32)Box->GetNumberField(TEXT("stencil_id"));
+			const int32* VehicleIndex = VehicleByInstanceId.Find(InstanceId);
+			const FString ClassName = VehicleIndex ? ActorClasses[*VehicleIndex] : FString();
+			const int32 CategoryId = GetCategoryId(ClassName);
+			const double Width = Box->GetNumberField(TEXT("width"));
+			const double Height = Box->GetNumberField(TEXT("height"));
+			double VisibleFraction = 1.0;
+			Box->TryGetNumberField(TEXT("visible_fraction"), VisibleFraction);
+
+			TSharedPtr<FJsonObject> BBox = MakeShareable(new FJsonObject);
+			BBox->SetNumberField(TEXT("x"), Box->GetNumberField(TEXT("x_min")));
+			BBox->SetNumberField(TEXT("y"), Box->GetNumberField(TEXT("y_min")));
+			BBox->SetNumberField(TEXT("width"), Width);
+			BBox->SetNumberField(TEXT("height"), Height);
+			BBox->SetNumberField(TEXT("area"), Width * Height);
+
+			TArray<TSharedPtr<FJsonValue>> Issues;
+			if (CategoryId == 0)
+			{
+				Issues.Add(MakeShared<FJsonValueString>(TEXT("Not a recipe vehicle class")));
+			}
+
+			TSharedPtr<FJsonObject> Instance = MakeShareable(new FJsonObject);
+			Instance->SetStringField(TEXT("instance_id"), VehicleIndex ? ActorNames[*VehicleIndex] : FString::Printf(TEXT("stencil_%d"), InstanceId));
+			Instance->SetNumberField(TEXT("category_id"), CategoryId);
+			Instance->SetStringField(TEXT("category_name"), ClassName);
+			Instance->SetObjectField(TEXT("bbox"), BBox);
+			Instance->SetNumberField(TEXT("area"), Width * Height);
+			Instance->SetNumberField(TEXT("truncation"), Box->GetBoolField(TEXT("truncated")) ? 1.0 : 0.0);
+			Instance->SetBoolField(TEXT("is_occluded"), VisibleFraction < 1.0);
+			Instance->SetBoolField(TEXT("is_valid"), CategoryId != 0);
+			Instance->SetArrayField(TEXT("validation_issues"), Issues);
+			Instance->SetNumberField(TEXT("stencil_id"), InstanceId);
+			InstanceArray.Add(MakeShareable(new FJsonValueObject(Instance)));
+			NumValid += CategoryId != 0 ? 1 : 0;
+		}
+	}
+
+	TSharedPtr<FJsonObject> Annotation = MakeShareable(new FJsonObject);
+	Annotation->SetNumberField(TEXT("frame_index"), GlobalFrame);
+	Annotation->SetNumberField(TEXT("image_id"), GlobalFrame + 1);
+	Annotation->SetStringField(TEXT("image_filename"), FPaths::GetCleanFilename(Result.ImagePath));
+	Annotation->SetArrayField(TEXT("image_size"), { MakeShared<FJsonValueNumber>(Recipe.Width), MakeShared<FJsonValueNumber>(Recipe.Height) });
+	Annotation->SetNumberField(TEXT("num_instances"), InstanceArray.Num());
+	Annotation->SetNumberField(TEXT("num_valid"), NumValid);
+	Annotation->SetArrayField(TEXT("instances"), InstanceArray);
+
+	// Recipe extras, ignored by the research_v2 readers
+	Annotation->SetStringField(TEXT("experiment"), Recipe.ExperimentName);
+	Annotation->SetNumberField(TEXT("seed"), Recipe.Seed);
+
+	TSharedPtr<FJsonObject> CameraObject = MakeShareable(new FJsonObject);
+	CameraObject->SetArrayField(TEXT("location"), MakeVectorArray(Result.Location));
+	CameraObject->SetArrayField(TEXT("rotation"), MakeVectorArray(FVector(Result.Rotation.Pitch, Result.Rotation.Yaw, Result.Rotation.Roll)));
+	CameraObject->SetNumberField(TEXT("fov"), View.FOV);
+	Annotation->SetObjectField(TEXT("camera"), CameraObject);
+
+	TArray<TSharedPtr<FJsonValue>> VehicleArray;
+	for (int32 Index = 0; Index < ActorNames.Num(); ++Index)
+	{
+		TSharedPtr<FJsonObject> Vehicle = MakeShareable(new FJsonObject);
+		Vehicle->SetStringField(TEXT("actor"), ActorNames[Index]);
+		Vehicle->SetStringField(TEXT("class"), ActorClasses[Index]);
+		Vehicle->SetArrayField(TEXT("location"), MakeVectorArray(Request.ActorStates[Index].Location));
+		Vehicle->SetNumberField(TEXT("yaw"), Request.ActorStates[Index].Rotation.Yaw);
+		VehicleArray.Add(MakeShareable(new FJsonValueObject(Vehicle)));
+	}
+	Annotation->SetArrayField(TEXT("vehicles"), VehicleArray);
+	Annotation->SetField(TEXT("poses"), ParseJsonValue(Response.PosesJson));
+
+	const FString AnnotationPath = FPaths::Combine(Recipe.AnnotationsDir, FrameName + TEXT(".json"));
+	if (!FFileHelper::SaveStringToFile(SerializeJson(Annotation), *AnnotationPath))
+	{
+		UE_LOG(LogVantageCVRecipe, Error, TEXT("Frame %lld: failed to write %s"), GlobalFrame, *AnnotationPath);
+		return EFrameResult::Failed;
+	}
+	return EFrameResult::Succeeded;
+}
+
+void FVantageCVRecipeRunner::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+	bFinished = true;
+
+	FCaptureWriteQueue::Get().Flush();
+
+	const FString SummaryPath = FPaths::Combine(Recipe.MetadataDir, FString::Printf(TEXT("recipe_%s.json"), *FVantageCVWorker::Get().GetWorkerTag()));
+	FFileHelper::SaveStringToFile(GetStatusJson(), *SummaryPath);
+	SpawnSystem.Reset();
+
+	UE_LOG(LogVantageCVRecipe, Log, TEXT("Recipe '%s' finished: %d succeeded, %d rejected, %d failed of %d in %.1f s"),
+		*Recipe.ExperimentName, NumSucceeded, NumRejected, NumFailed, Frames.Num(), FPlatformTime::Seconds() - StartSeconds);
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, NumFailed > 0 ? 1 : 0);
+	}
+}
+
+FString FVantageCVRecipeRunner::GetStatusJson() const
+{
+	const double Elapsed = StartSeconds > 0.0 ? FPlatformTime::Seconds() - StartSeconds : 0.0;
+
+	TSharedPtr<FJsonObject> Status = MakeShareable(new FJsonObject);
+	Status->SetStringField(TEXT("experiment"), Recipe.ExperimentName);
+	Status->SetStringField(TEXT("worker"), FVantageCVWorker::Get().GetWorkerTag());
+	Status->SetBoolField(TEXT("running"), IsRunning());
+	Status->SetBoolField(TEXT("finished"), bFinished);
+	Status->SetNumberField(TEXT("frames"), Frames.Num());
+	Status->SetNumberField(TEXT("frames_done"), NextFrame);
+	Status->SetNumberField(TEXT("succeeded"), NumSucceeded);
+	Status->SetNumberField(TEXT("rejected"), NumRejected);
+	Status->SetNumberField(TEXT("failed"), NumFailed);
+	Status->SetNumberField(TEXT("current_frame"), Frames.IsValidIndex(NextFrame) ? Frames[NextFrame] : -1);
+	Status->SetNumberField(TEXT("elapsed_seconds"), Elapsed);
+	Status->SetNumberField(TEXT("frames_per_second"), Elapsed > 0.0 ? NextFrame / Elapsed : 0.0);
+	Status->SetStringField(TEXT("images_dir"), Recipe.ImagesDir);
+	Status->SetStringField(TEXT("annotations_dir"), Recipe.AnnotationsDir);
+	return SerializeJson(Status);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs RunRecipeCommand(
+	TEXT("VantageCV.RunRecipe"),
+	TEXT("Render a generation recipe in-process: VantageCV.RunRecipe <research.yaml> <anchors.yaml> <vehicles.yaml> [NumFrames] [-quit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		TArray<FString> Positional;
+		bool bQuit = false;
+		for (const FString& Arg : Args)
+		{
+			if (Arg.Equals(TEXT("-quit"), ESearchCase::IgnoreCase))
+			{
+				bQuit = true;
+			}
+			else
+			{
+				Positional.Add(Arg);
+			}
+		}
+
+		FString Error;
+		FVantageCVRecipe Recipe;
+		if (Positional.Num() < 3)
+		{
+			Error = TEXT("Usage: VantageCV.RunRecipe <research.yaml> <anchors.yaml> <vehicles.yaml> [NumFrames] [-quit]");
+		}
+		else if (FVantageCVRecipe::Load(Positional[0], Positional[1], Positional[2], Recipe, Error))
+		{
+			// -ExecCmds runs without a world context; fall back to the play world
+			UWorld* TargetWorld = World ? World : (GEngine ? GEngine->GetCurrentPlayWorld() : nullptr);
+			const int32 NumFrames = Positional.Num() > 3 ? FCString::Atoi(*Positional[3]) : 0;
+			if (FVantageCVRecipeRunner::Get().Start(TargetWorld, Recipe, NumFrames, bQuit, Error))
+			{
+				return;
+			}
+		}
+
+		UE_LOG(LogVantageCVRecipe, Error, TEXT("VantageCV.RunRecipe: %s"), *Error);
+		if (bQuit)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+	})
+);
+
+static FAutoConsoleCommand StopRecipeCommand(
+	TEXT("VantageCV.StopRecipe"),
+	TEXT("Stop the running recipe after the current frame"),
+	FConsoleCommandDelegate::CreateStatic([]()
+	{
+		FVantageCVRecipeRunner::Get().Stop();
+	})
+);
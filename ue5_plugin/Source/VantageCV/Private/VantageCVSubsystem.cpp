@@ -10,7 +10,23 @@
 #include "VantageCVSubsystem.h"
 #include "DataCapture.h"
 #include "SceneController.h"
+#include "CaptureWriteQueue.h"
+#include "CaptureResourcePool.h"
+#include "SegmentationStencil.h"
+#include "ActorIndexSubsystem.h"
+#include "ActorPoolSubsystem.h"
+#include "MaterialInstanceCache.h"
+#include "SpawnAssetCache.h"
+#include "GroundHeightSubsystem.h"
+#include "LightingPresetSubsystem.h"
+#include "CaptureTelemetry.h"
+#include "CaptureShardWriter.h"
+#include "VantageCVWorker.h"
+#include "VantageCVBenchmark.h"
+#include "VantageCVRecipe.h"
+#include "VantageCVEventLog.h"
 #include "EngineUtils.h"
+#include "Algo/Count.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 
@@ -19,6 +35,16 @@ DEFINE_LOG_CATEGORY_STATIC(LogVantageCVSubsystem, Log, All);
 void UVantageCVSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+
+	// Distractor shapes are spawned every scene; configured vehicle/prop paths load alongside them
+	TArray<FString> AssetPaths = {
+		TEXT("/Engine/BasicShapes/Cube.Cube"),
+		TEXT("/Engine/BasicShapes/Sphere.Sphere"),
+		TEXT("/Engine/BasicShapes/Cylinder.Cylinder")
+	};
+	AssetPaths.Append(PreloadAssetPaths);
+	FSpawnAssetCache::Get().Preload(AssetPaths);
+
 	UE_LOG(LogVantageCVSubsystem, Log, TEXT("VantageCV Subsystem Initialized - Remote Control functions available"));
 }
 
@@ -110,3 +136,591 @@ bool UVantageCVSubsystem::RandomizeScene()
 	UE_LOG(LogVantageCVSubsystem, Warning, TEXT("No SceneController actor found in level"));
 	return false;
 }
+
+int32 UVantageCVSubsystem::FlushCaptureWrites()
+{
+	FCaptureWriteQueue& WriteQueue = FCaptureWriteQueue::Get();
+	const int32 Written = WriteQueue.Flush();
+	UE_LOG(LogVantageCVSubsystem, Log, TEXT("FlushCaptureWrites: %d files written (%lld total, %lld failed)"),
+		Written, WriteQueue.GetTotalWritten(), WriteQueue.GetTotalFailed());
+	return Written;
+}
+
+void UVantageCVSubsystem::SetMaxPendingWrites(int32 MaxPendingWrites)
+{
+	FCaptureWriteQueue::Get().SetMaxPendingJobs(MaxPendingWrites);
+	UE_LOG(LogVantageCVSubsystem, Log, TEXT("Max pending writes set to %d"), FMath::Max(1, MaxPendingWrites));
+}
+
+FString UVantageCVSubsystem::GetResourcePoolStats()
+{
+	return FCaptureResourcePool::Get().GetStatsJson();
+}
+
+void UVantageCVSubsystem::TrimResourcePool()
+{
+	FCaptureResourcePool::Get().Trim();
+}
+
+int32 UVantageCVSubsystem::PrewarmActorPool(const TMap<FString, int32>& AssetCounts)
+{
+	UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(FindTargetWorld());
+	if (!ActorPool)
+	{
+		UE_LOG(LogVantageCVSubsystem, Warning, TEXT("PrewarmActorPool: no valid world found"));
+		return 0;
+	}
+
+	// Load every asset in parallel before spawning instead of one blocking load per path
+	TArray<FString> AssetPaths;
+	AssetCounts.GetKeys(AssetPaths);
+	FSpawnAssetCache::Get().Preload(AssetPaths);
+	FSpawnAssetCache::Get().WaitForPreloads();
+
+	int32 NumSpawned = 0;
+	for (const TPair<FString, int32>& Pair : AssetCounts)
+	{
+		NumSpawned += ActorPool->Prewarm(Pair.Key, Pair.Value);
+	}
+	return NumSpawned;
+}
+
+FString UVantageCVSubsystem::GetActorPoolStats()
+{
+	UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(FindTargetWorld());
+	return ActorPool ? ActorPool->GetStatsJson() : FString(TEXT("{}"));
+}
+
+int32 UVantageCVSubsystem::TrimActorPool(int32 MaxIdlePerAsset)
+{
+	UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(FindTargetWorld());
+	return ActorPool ? ActorPool->Trim(MaxIdlePerAsset) : 0;
+}
+
+FString UVantageCVSubsystem::GetMaterialCacheStats()
+{
+	UMaterialInstanceCacheSubsystem* MaterialCache = UMaterialInstanceCacheSubsystem::Get(FindTargetWorld());
+	return MaterialCache ? MaterialCache->GetStatsJson() : FString(TEXT("{}"));
+}
+
+int32 UVantageCVSubsystem::PreloadSpawnAssets(const TArray<FString>& AssetPaths, bool bWaitForCompletion)
+{
+	const int32 NumRequested = FSpawnAssetCache::Get().Preload(AssetPaths);
+	if (bWaitForCompletion)
+	{
+		FSpawnAssetCache::Get().WaitForPreloads();
+	}
+	return NumRequested;
+}
+
+FString UVantageCVSubsystem::GetSpawnAssetCacheStats()
+{
+	return FSpawnAssetCache::Get().GetStatsJson();
+}
+
+TArray<float> UVantageCVSubsystem::GetGroundHeights(const TArray<FVector>& Points)
+{
+	TArray<float> Heights;
+	if (UGroundHeightSubsystem* GroundHeights = UGroundHeightSubsystem::Get(FindTargetWorld()))
+	{
+		GroundHeights->GetGroundHeights(Points, Heights);
+	}
+	else
+	{
+		UE_LOG(LogVantageCVSubsystem, Warning, TEXT("GetGroundHeights: no valid world found"));
+		for (const FVector& Point : Points)
+		{
+			Heights.Add(Point.Z);
+		}
+	}
+	return Heights;
+}
+
+void UVantageCVSubsystem::BuildGroundHeightfield(const FVector& RegionMin, const FVector& RegionMax, float CellSize)
+{
+	if (UGroundHeightSubsystem* GroundHeights = UGroundHeightSubsystem::Get(FindTargetWorld()))
+	{
+		GroundHeights->BuildHeightfield(FBox(RegionMin.ComponentMin(RegionMax), RegionMin.ComponentMax(RegionMax)), CellSize);
+	}
+}
+
+FString UVantageCVSubsystem::GetGroundHeightStats()
+{
+	UGroundHeightSubsystem* GroundHeights = UGroundHeightSubsystem::Get(FindTargetWorld());
+	return GroundHeights ? GroundHeights->GetStatsJson() : FString(TEXT("{}"));
+}
+
+FString UVantageCVSubsystem::GetShardWriterStats()
+{
+	return FCaptureShardWriter::Get().GetStatsJson();
+}
+
+FString UVantageCVSubsystem::GetCaptureTelemetry()
+{
+	return FCaptureTelemetry::Get().GetStatsJson();
+}
+
+void UVantageCVSubsystem::ResetCaptureTelemetry(int32 WindowSize)
+{
+	if (WindowSize > 0)
+	{
+		FCaptureTelemetry::Get().SetWindowSize(WindowSize);
+	}
+	FCaptureTelemetry::Get().Reset();
+}
+
+void UVantageCVSubsystem::ConfigureWorker(int32 WorkerIndex, int32 NumWorkers, int32 TotalFrames, int32 ResumeFrame)
+{
+	FVantageCVWorker::Get().Configure(WorkerIndex, NumWorkers, TotalFrames, ResumeFrame);
+	FVantageCVWorker::Get().WriteHeartbeat();
+}
+
+FString UVantageCVSubsystem::GetWorkerStatus()
+{
+	return FVantageCVWorker::Get().GetStatusJson();
+}
+
+TArray<int32> UVantageCVSubsystem::GetWorkerFrames(int32 MaxFrames)
+{
+	TArray<int32> Frames;
+	for (int64 Frame : FVantageCVWorker::Get().GetPendingFrames(FMath::Max(0, MaxFrames)))
+	{
+		Frames.Add((int32)Frame);
+	}
+	return Frames;
+}
+
+void UVantageCVSubsystem::ReportFrameComplete(int32 FrameIndex, bool bSuccess)
+{
+	FVantageCVWorker::Get().CompleteFrame(FrameIndex, bSuccess);
+}
+
+FString UVantageCVSubsystem::RunBenchmarks(const FString& Suites, int32 Iterations, const FString& OutputPath)
+{
+	return FVantageCVBenchmark::Run(FindTargetWorld(), Suites, Iterations, OutputPath);
+}
+
+bool UVantageCVSubsystem::RunRecipe(const FString& ResearchPath, const FString& AnchorsPath, const FString& VehiclesPath, int32 NumFrames)
+{
+	FString Error;
+	FVantageCVRecipe Recipe;
+	if (!FVantageCVRecipe::Load(ResearchPath, AnchorsPath, VehiclesPath, Recipe, Error) ||
+		!FVantageCVRecipeRunner::Get().Start(FindTargetWorld(), Recipe, NumFrames, false, Error))
+	{
+		UE_LOG(LogVantageCVSubsystem, Error, TEXT("RunRecipe: %s"), *Error);
+		return false;
+	}
+	return true;
+}
+
+FString UVantageCVSubsystem::GetRecipeStatus()
+{
+	return FVantageCVRecipeRunner::Get().GetStatusJson();
+}
+
+void UVantageCVSubsystem::StopRecipe()
+{
+	FVantageCVRecipeRunner::Get().Stop();
+}
+
+bool UVantageCVSubsystem::SetEventLogLevel(const FString& Level)
+{
+	EVantageCVEventLevel ParsedLevel;
+	if (!FVantageCVEventLog::ParseLevel(Level, ParsedLevel))
+	{
+		UE_LOG(LogVantageCVSubsystem, Warning, TEXT("SetEventLogLevel: unknown level '%s'"), *Level);
+		return false;
+	}
+	FVantageCVEventLog::SetLevel(ParsedLevel);
+	return true;
+}
+
+FString UVantageCVSubsystem::GetEventLogStats()
+{
+	FVantageCVEventLog& EventLog = FVantageCVEventLog::Get();
+	EventLog.Flush();
+	return EventLog.GetStatsJson();
+}
+
+bool UVantageCVSubsystem::ApplyLightingPreset(const FString& PresetName, bool bSpawnMissingLights)
+{
+	UWorld* World = FindTargetWorld();
+	ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(World);
+	return LightingPresets && LightingPresets->ApplyPresetWithExposure(FName(*PresetName), bSpawnMissingLights);
+}
+
+void UVantageCVSubsystem::RegisterLightingPreset(const FVantageCVLightingPreset& Preset)
+{
+	if (ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(FindTargetWorld()))
+	{
+		LightingPresets->RegisterPreset(Preset);
+	}
+}
+
+FString UVantageCVSubsystem::GetLightingPresetStats()
+{
+	ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(FindTargetWorld());
+	return LightingPresets ? LightingPresets->GetStatsJson() : FString(TEXT("{}"));
+}
+
+FVantageCVSceneResponse UVantageCVSubsystem::RenderScene(const FVantageCVSceneRequest& Request)
+{
+	FVantageCVSceneResponse Response;
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (Request.FrameIndex >= 0)
+	{
+		FVantageCVWorker::Get().BeginFrame(Request.FrameIndex);
+	}
+
+	UWorld* World = FindTargetWorld();
+	if (!World)
+	{
+		Response.ErrorMessage = TEXT("No valid world found");
+		UE_LOG(LogVantageCVSubsystem, Error, TEXT("RenderScene: %s"), *Response.ErrorMessage);
+		if (Request.FrameIndex >= 0)
+		{
+			FVantageCVWorker::Get().CompleteFrame(Request.FrameIndex, false);
+		}
+		return Response;
+	}
+
+	ADataCapture* DataCapture = nullptr;
+	for (TActorIterator<ADataCapture> It(World); It; ++It)
+	{
+		if (IsValid(*It))
+		{
+			DataCapture = *It;
+			break;
+		}
+	}
+	if (!DataCapture && Request.Cameras.Num() > 0)
+	{
+		Response.ErrorMessage = TEXT("No DataCapture actor found in level");
+		UE_LOG(LogVantageCVSubsystem, Error, TEXT("RenderScene: %s"), *Response.ErrorMessage);
+		if (Request.FrameIndex >= 0)
+		{
+			FVantageCVWorker::Get().CompleteFrame(Request.FrameIndex, false);
+		}
+		return Response;
+	}
+
+	FSceneDeltaStats DeltaStats;
+
+	// 1. Spawns: previous scene's actors are reused in place where asset and tag match
+	{
+		VANTAGECV_CAPTURE_STAGE_ACCUMULATE(Spawn, Response.SpawnMs);
+		if (Request.bClearPreviousSpawns)
+		{
+			UpdateSceneSpawns(World, Request.Spawns, Response, DeltaStats);
+		}
+		else
+		{
+			UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(World);
+			for (const FVantageCVSpawnRequest& SpawnRequest : Request.Spawns)
+			{
+				AActor* Spawned = SpawnSceneActor(World, SpawnRequest);
+				Response.SpawnedActors.Add(Spawned ? Spawned->GetName() : FString());
+				if (Spawned && ActorPool)
+				{
+					ActorPool->GetSceneSpawns().Add({ Spawned, SpawnRequest.AssetPath, SpawnRequest.Tag });
+				}
+				DeltaStats.Record(true);
+			}
+		}
+	}
+
+	// 2. Existing actors
+	{
+		VANTAGECV_CAPTURE_STAGE_ACCUMULATE(SceneApply, Response.SceneApplyMs);
+		TSet<const AActor*> SceneActors;
+		if (UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(World))
+		{
+			for (const UActorPoolSubsystem::FSceneSpawn& SceneSpawn : ActorPool->GetSceneSpawns())
+			{
+				SceneActors.Add(SceneSpawn.Actor.Get());
+			}
+		}
+
+		for (const FVantageCVActorState& State : Request.ActorStates)
+		{
+			AActor* Actor = FindActorByName(World, State.ActorName);
+			if (!Actor)
+			{
+				Response.MissingActors.Add(State.ActorName);
+				continue;
+			}
+
+			bool bChanged = FSceneStateDelta::ApplyTransform(Actor, State.Location, State.Rotation);
+			bChanged |= FSceneStateDelta::ApplyVisibility(Actor, State.bVisible);
+			DeltaStats.Record(bChanged);
+			SceneActors.Add(Actor);
+		}
+
+		// 3. Every other vehicle hidden; ones the previous scene already hid are left alone
+		if (Request.bHideAllVehicles)
+		{
+			TArray<AActor*> Vehicles;
+			if (UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(World))
+			{
+				ActorIndex->GetActorsWithTag(FName("Vehicle"), Vehicles);
+			}
+			for (AActor* Vehicle : Vehicles)
+			{
+				if (Vehicle && !SceneActors.Contains(Vehicle))
+				{
+					DeltaStats.Record(FSceneStateDelta::ApplyHiddenParked(Vehicle));
+				}
+			}
+		}
+
+		Response.NumActorsUpdated = DeltaStats.NumUpdated;
+		Response.NumActorsSkipped = DeltaStats.NumSkipped;
+
+		// 4. Lighting / exposure
+		ApplyLighting(World, Request.Lighting);
+	}
+
+	// 5. Capture every camera behind one readback flush
+	if (DataCapture)
+	{
+		DataCapture->SetExposureBiasOverride(Request.Lighting.ExposureBias);
+		if (!Request.CaptureProfile.IsEmpty())
+		{
+			DataCapture->SetCaptureProfile(Request.CaptureProfile);
+		}
+
+		const double CaptureStart = FPlatformTime::Seconds();
+		// Mask statistics for pixel-accurate boxes are reduced inside the batch, not per view afterwards
+		TArray<FCaptureViewRequest> Cameras = Request.Cameras;
+		if (Request.bBoundingBoxes && DataCapture->bPixelAccurateBoxes)
+		{
+			for (FCaptureViewRequest& Camera : Cameras)
+			{
+				Camera.bInstanceStats = true;
+			}
+		}
+		Response.Views = DataCapture->CaptureViews(Cameras);
+		Response.CaptureMs = (FPlatformTime::Seconds() - CaptureStart) * 1000.0;
+		Response.StreamingMs = DataCapture->StreamingGate.bEnabled ? DataCapture->GetLastStreamingReport().WaitMs : 0.0f;
+
+		// 6. Annotations (the generators record the Annotation stage themselves)
+		const double AnnotationStart = FPlatformTime::Seconds();
+		if (Request.bBoundingBoxes)
+		{
+			// Each view gets boxes from its own camera; the top-level JSON keeps the first view
+			for (int32 ViewIndex = 0; ViewIndex < Response.Views.Num(); ++ViewIndex)
+			{
+				FCaptureViewResult& View = Response.Views[ViewIndex];
+				if (View.bRejected)
+				{
+					continue;
+				}
+				const FCaptureViewRequest& Camera = Request.Cameras[ViewIndex];
+				View.BoundingBoxesJson = DataCapture->GenerateBoundingBoxesForViewResult(
+					Request.TargetTags, View, Camera.Width, Camera.Height);
+			}
+			Response.BoundingBoxesJson = Response.Views.Num() > 0
+				? Response.Views[0].BoundingBoxesJson
+				: DataCapture->GenerateBoundingBoxes(Request.TargetTags);
+		}
+		if (Request.bPoses)
+		{
+			Response.PosesJson = DataCapture->GeneratePoseAnnotations(Request.TargetTags);
+		}
+		Response.AnnotationMs = (FPlatformTime::Seconds() - AnnotationStart) * 1000.0;
+	}
+
+	if (Request.bWaitForWrites)
+	{
+		FCaptureWriteQueue::Get().Flush();
+	}
+
+	// Views rejected by the visibility gate are reported, not failures
+	Response.bSuccess = !Response.Views.ContainsByPredicate([](const FCaptureViewResult& View) { return !View.bSuccess && !View.bRejected; });
+	Response.NumViewsRejected = Algo::CountIf(Response.Views, [](const FCaptureViewResult& View) { return View.bRejected; });
+	if (!Response.bSuccess)
+	{
+		Response.ErrorMessage = TEXT("One or more views failed to capture");
+	}
+	Response.ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	if (Request.FrameIndex >= 0)
+	{
+		FVantageCVWorker::Get().CompleteFrame(Request.FrameIndex, Response.bSuccess);
+	}
+
+	UE_LOG(LogVantageCVSubsystem, Log, TEXT("RenderScene: %d states, %d spawns, %d views, %d rejected (%d actors updated, %d unchanged) in %.2f ms"),
+		Request.ActorStates.Num(), Request.Spawns.Num(), Response.Views.Num(), Response.NumViewsRejected,
+		Response.NumActorsUpdated, Response.NumActorsSkipped, Response.ElapsedMs);
+	return Response;
+}
+
+UWorld* UVantageCVSubsystem::FindTargetWorld() const
+{
+	if (!GEngine)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = GEngine->GetCurrentPlayWorld();
+	if (!World)
+	{
+		World = GEngine->GetWorld();
+	}
+	return World;
+}
+
+AActor* UVantageCVSubsystem::FindActorByName(UWorld* World, const FString& ActorName) const
+{
+	UActorIndexSubsystem* ActorIndex = UActorIndexSubsystem::Get(World);
+	return ActorIndex ? ActorIndex->FindActorByName(ActorName) : nullptr;
+}
+
+AActor* UVantageCVSubsystem::SpawnSceneActor(UWorld* World, const FVantageCVSpawnRequest& SpawnRequest)
+{
+	AActor* NewActor = UActorPoolSubsystem::AcquireOrSpawn(World, SpawnRequest.AssetPath, SpawnRequest.Location, SpawnRequest.Rotation);
+	if (!NewActor)
+	{
+		UE_LOG(LogVantageCVSubsystem, Error, TEXT("RenderScene: failed to load asset %s"), *SpawnRequest.AssetPath);
+		return nullptr;
+	}
+
+	NewActor->SetActorScale3D(FVector(SpawnRequest.Scale));
+	if (!SpawnRequest.Tag.IsEmpty())
+	{
+		NewActor->Tags.Add(FName(*SpawnRequest.Tag));
+	}
+	FSegmentationStencil::AssignInstanceId(NewActor);
+	return NewActor;
+}
+
+void UVantageCVSubsystem::UpdateSceneSpawns(UWorld* World, const TArray<FVantageCVSpawnRequest>& Spawns,
+	FVantageCVSceneResponse& Response, FSceneDeltaStats& Stats)
+{
+	// Worlds without a pool keep no scene list: nothing to reuse or release
+	UActorPoolSubsystem* ActorPool = UActorPoolSubsystem::Get(World);
+	TArray<UActorPoolSubsystem::FSceneSpawn> NoSceneSpawns;
+	TArray<UActorPoolSubsystem::FSceneSpawn>& SceneSpawns = ActorPool ? ActorPool->GetSceneSpawns() : NoSceneSpawns;
+
+	TArray<AActor*> Matched;
+	Matched.SetNumZeroed(Spawns.Num());
+	TBitArray<> PreviousUsed(false, SceneSpawns.Num());
+
+	for (int32 SpawnIndex = 0; SpawnIndex < Spawns.Num(); ++SpawnIndex)
+	{
+		const FVantageCVSpawnRequest& SpawnRequest = Spawns[SpawnIndex];
+		for (int32 PrevIndex = 0; PrevIndex < SceneSpawns.Num(); ++PrevIndex)
+		{
+			AActor* Previous = SceneSpawns[PrevIndex].Actor.Get();
+			if (PreviousUsed[PrevIndex] || !Previous ||
+				SceneSpawns[PrevIndex].AssetPath != SpawnRequest.AssetPath ||
+				SceneSpawns[PrevIndex].Tag != SpawnRequest.Tag)
+			{
+				continue;
+			}
+
+			PreviousUsed[PrevIndex] = true;
+			Matched[SpawnIndex] = Previous;
+
+			bool bChanged = FSceneStateDelta::ApplyTransform(Previous, SpawnRequest.Location, SpawnRequest.Rotation);
+			bChanged |= FSceneStateDelta::ApplyScale(Previous, FVector(SpawnRequest.Scale));
+			if (Previous->IsHidden())
+			{
+				Previous->SetActorHiddenInGame(false);
+				bChanged = true;
+			}
+			Stats.Record(bChanged);
+			break;
+		}
+	}
+
+	// Leftovers go back first so their pool slots can serve this scene's new spawns
+	for (int32 PrevIndex = 0; PrevIndex < SceneSpawns.Num(); ++PrevIndex)
+	{
+		AActor* Previous = SceneSpawns[PrevIndex].Actor.Get();
+		if (!PreviousUsed[PrevIndex] && Previous)
+		{
+			ActorPool->Release(Previous);
+		}
+	}
+	SceneSpawns.Reset();
+
+	for (int32 SpawnIndex = 0; SpawnIndex < Spawns.Num(); ++SpawnIndex)
+	{
+		AActor* Spawned = Matched[SpawnIndex];
+		if (!Spawned)
+		{
+			Spawned = SpawnSceneActor(World, Spawns[SpawnIndex]);
+			Stats.Record(true);
+		}
+
+		Response.SpawnedActors.Add(Spawned ? Spawned->GetName() : FString());
+		if (Spawned && ActorPool)
+		{
+			SceneSpawns.Add({ Spawned, Spawns[SpawnIndex].AssetPath, Spawns[SpawnIndex].Tag });
+		}
+	}
+}
+
+void UVantageCVSubsystem::ApplyLighting(UWorld* World, const FVantageCVLightingState& Lighting)
+{
+	ULightingPresetSubsystem* LightingPresets = ULightingPresetSubsystem::Get(World);
+	if (!LightingPresets)
+	{
+		return;
+	}
+
+	// Explicit values layer over the requested registered preset, or else the active one
+	const FVantageCVLightingPreset* BasePreset = nullptr;
+	if (!Lighting.Preset.IsEmpty())
+	{
+		BasePreset = LightingPresets->FindPreset(FName(*Lighting.Preset));
+		// Tracked per world, so a new world (map change, PIE restart) starts without the preset
+		if (!BasePreset && Lighting.Preset != LightingPresets->GetRequestedPreset())
+		{
+			// SceneController presets re-roll random values, so they only run when the name changes
+			for (TActorIterator<ASceneController> It(World); It; ++It)
+			{
+				It->SetLightingPreset(Lighting.Preset);
+				LightingPresets->UpdateSkyCapture();
+				break;
+			}
+		}
+		LightingPresets->SetRequestedPreset(Lighting.Preset);
+	}
+	else
+	{
+		BasePreset = LightingPresets->FindPreset(LightingPresets->GetActivePreset());
+	}
+
+	const bool bRequestsPreset = BasePreset && !Lighting.Preset.IsEmpty();
+	if (!bRequestsPreset && !Lighting.bSetSun && Lighting.SkyIntensity < 0.0f)
+	{
+		return;
+	}
+
+	FVantageCVLightingPreset Preset;
+	if (BasePreset)
+	{
+		Preset = *BasePreset;
+	}
+	else
+	{
+		Preset.bSetSunRotation = false;
+	}
+
+	if (Lighting.bSetSun)
+	{
+		Preset.bSetSunRotation = true;
+		Preset.SunRotation = Lighting.SunRotation;
+		Preset.SunIntensity = Lighting.SunIntensity;
+	}
+	if (Lighting.SkyIntensity >= 0.0f)
+	{
+		Preset.SkyIntensity = Lighting.SkyIntensity;
+	}
+
+	// Only values that differ are written; the sky is recaptured only if the sun moved
+	LightingPresets->ApplyPreset(Preset);
+}
@@ -0,0 +1,416 @@
+/******************************************************************************
+ * VantageCV - Render Worker Implementation
+ ******************************************************************************
+ * File: VantageCVWorker.cpp
+ * Description: Command-line worker identity, frame watermark and periodic
+ *              heartbeat file
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "VantageCVWorker.h"
+#include "CaptureWriteQueue.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "RHI.h"
+#include "Json.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogVantageCVWorker, Log, All);
+
+const TCHAR* FVantageCVWorker::WorkerToken = TEXT("{worker}");
+FVantageCVWorker* FVantageCVWorker::Instance = nullptr;
+
+namespace
+{
+	constexpr int32 ThroughputWindow = 32;
+}
+
+FVantageCVWorker& FVantageCVWorker::Get()
+{
+	if (!Instance)
+	{
+		Instance = new FVantageCVWorker();
+	}
+	return *Instance;
+}
+
+void FVantageCVWorker::Shutdown()
+{
+	if (Instance)
+	{
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+FVantageCVWorker::FVantageCVWorker()
+{
+	StartSeconds = FPlatformTime::Seconds();
+	HeartbeatDirectory = FPaths::ProjectSavedDir() / TEXT("VantageCV/Workers");
+	ParseCommandLine();
+
+	if (HeartbeatSeconds > 0.0f)
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FVantageCVWorker::TickHeartbeat), HeartbeatSeconds);
+	}
+}
+
+FVantageCVWorker::~FVantageCVWorker()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+
+	// Last record is the final state; the coordinator tells a clean exit from a hang by its age
+	if (HeartbeatSeconds > 0.0f)
+	{
+		WriteHeartbeat();
+	}
+}
+
+void FVantageCVWorker::ParseCommandLine()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	int32 ParsedIndex = 0;
+	int32 ParsedNumWorkers = 1;
+	int64 ParsedTotalFrames = 0;
+	int64 ParsedResumeFrame = 0;
+	FParse::Value(CommandLine, TEXT("VantageCVWorker="), ParsedIndex);
+	FParse::Value(CommandLine, TEXT("VantageCVNumWorkers="), ParsedNumWorkers);
+	FParse::Value(CommandLine, TEXT("VantageCVTotalFrames="), ParsedTotalFrames);
+	FParse::Value(CommandLine, TEXT("VantageCVResumeFrame="), ParsedResumeFrame);
+	FParse::Value(CommandLine, TEXT("VantageCVHeartbeatDir="), HeartbeatDirectory);
+	FParse::Value(CommandLine, TEXT("VantageCVHeartbeatSeconds="), HeartbeatSeconds);
+
+	Configure(ParsedIndex, ParsedNumWorkers, ParsedTotalFrames, ParsedResumeFrame);
+
+	if (FParse::Param(CommandLine, TEXT("VantageCVResume")))
+	{
+		LoadPreviousHeartbeat();
+	}
+
+	UE_LOG(LogVantageCVWorker, Log, TEXT("Worker %d of %d (%s), resume frame %lld, heartbeat every %.1f s to %s"),
+		WorkerIndex, NumWorkers, *GetWorkerTag(), GetGlobalFrame(ResumeLocalIndex), HeartbeatSeconds, *GetHeartbeatPath());
+}
+
+void FVantageCVWorker::Configure(int32 InWorkerIndex, int32 InNumWorkers, int64 InTotalFrames, int64 ResumeFrame)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	NumWorkers = FMath::Max(1, InNumWorkers);
+	WorkerIndex = FMath::Clamp(InWorkerIndex, 0, NumWorkers - 1);
+	if (InWorkerIndex != WorkerIndex)
+	{
+		UE_LOG(LogVantageCVWorker, Warning, TEXT("Worker index %d out of range for %d workers - using %d"), InWorkerIndex, NumWorkers, WorkerIndex);
+	}
+	TotalFrames = FMath::Max<int64>(0, InTotalFrames);
+
+	// First owned frame at or after ResumeFrame
+	ResumeLocalIndex = FMath::Max<int64>(0, FMath::DivideAndRoundUp<int64>(ResumeFrame - WorkerIndex, NumWorkers));
+	DurableResumeLocalIndex = ResumeLocalIndex;
+	ProcessedAhead.Reset();
+	PendingWrites.Reset();
+	FailedFrames.Reset();
+	RetryFrames.Reset();
+	RecentCompletions.Reset();
+	CurrentFrame = INDEX_NONE;
+	NumCompleted = 0;
+	NumFailed = 0;
+	NumWriteFailures = 0;
+}
+
+FString FVantageCVWorker::GetWorkerTag() const
+{
+	return FString::Printf(TEXT("w%02d"), WorkerIndex);
+}
+
+FString FVantageCVWorker::ResolvePath(const FString& Path) const
+{
+	if (!Path.Contains(WorkerToken))
+	{
+		return Path;
+	}
+	return Path.Replace(WorkerToken, *GetWorkerTag());
+}
+
+TArray<int64> FVantageCVWorker::GetPendingFrames(int32 MaxFrames) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TArray<int64> Frames = RetryFrames.Array();
+	Frames.Sort();
+	if (Frames.Num() > MaxFrames)
+	{
+		Frames.SetNum(FMath::Max(0, MaxFrames));
+	}
+	for (int64 LocalIndex = ResumeLocalIndex; Frames.Num() < MaxFrames; ++LocalIndex)
+	{
+		const int64 GlobalFrame = GetGlobalFrame(LocalIndex);
+		if (TotalFrames > 0 && GlobalFrame >= TotalFrames)
+		{
+			break;
+		}
+		if (!ProcessedAhead.Contains(LocalIndex))
+		{
+			Frames.Add(GlobalFrame);
+		}
+	}
+	return Frames;
+}
+
+int64 FVantageCVWorker::GetSeedFrame() const
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (CurrentFrame != INDEX_NONE)
+		{
+			return CurrentFrame;
+		}
+	}
+	const TArray<int64> Next = GetPendingFrames(1);
+	FScopeLock ScopeLock(&Lock);
+	return Next.Num() > 0 ? Next[0] : GetGlobalFrame(ResumeLocalIndex);
+}
+
+void FVantageCVWorker::BeginFrame(int64 GlobalFrame)
+{
+	FScopeLock ScopeLock(&Lock);
+	CurrentFrame = GlobalFrame;
+}
+
+void FVantageCVWorker::CompleteFrame(int64 GlobalFrame, bool bSuccess)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (!OwnsFrame(GlobalFrame))
+	{
+		UE_LOG(LogVantageCVWorker, Warning, TEXT("Frame %lld is not owned by worker %d of %d - not counted"), GlobalFrame, WorkerIndex, NumWorkers);
+		return;
+	}
+
+	const int64 LocalIndex = (GlobalFrame - WorkerIndex) / NumWorkers;
+	if (LocalIndex >= ResumeLocalIndex)
+	{
+		ProcessedAhead.Add(LocalIndex);
+		AdvanceWatermark_Locked();
+		AdvanceDurableWatermark_Locked();
+	}
+
+	// A retried frame leaves FailedFrames on success; a later failed write lists it again
+	RetryFrames.Remove(GlobalFrame);
+	if (bSuccess)
+	{
+		++NumCompleted;
+		FailedFrames.Remove(GlobalFrame);
+	}
+	else
+	{
+		++NumFailed;
+		FailedFrames.Add(GlobalFrame);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	LastCompletionSeconds = Now;
+	RecentCompletions.Add(Now);
+	if (RecentCompletions.Num() > ThroughputWindow)
+	{
+		RecentCompletions.RemoveAt(0);
+	}
+	if (CurrentFrame == GlobalFrame)
+	{
+		CurrentFrame = INDEX_NONE;
+	}
+}
+
+void FVantageCVWorker::AdvanceWatermark_Locked()
+{
+	while (ProcessedAhead.Remove(ResumeLocalIndex) > 0)
+	{
+		++ResumeLocalIndex;
+	}
+}
+
+int64 FVantageCVWorker::GetCurrentFrame() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return CurrentFrame;
+}
+
+void FVantageCVWorker::AddPendingWrite(int64 GlobalFrame)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (OwnsFrame(GlobalFrame))
+	{
+		++PendingWrites.FindOrAdd((GlobalFrame - WorkerIndex) / NumWorkers);
+	}
+}
+
+void FVantageCVWorker::CompleteWrite(int64 GlobalFrame, bool bSuccess)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OwnsFrame(GlobalFrame))
+	{
+		return;
+	}
+
+	const int64 LocalIndex = (GlobalFrame - WorkerIndex) / NumWorkers;
+	int32* Outstanding = PendingWrites.Find(LocalIndex);
+	if (Outstanding && --(*Outstanding) <= 0)
+	{
+		PendingWrites.Remove(LocalIndex);
+	}
+
+	if (!bSuccess)
+	{
+		++NumWriteFailures;
+		FailedFrames.Add(GlobalFrame);
+	}
+	AdvanceDurableWatermark_Locked();
+}
+
+void FVantageCVWorker::AdvanceDurableWatermark_Locked()
+{
+	while (DurableResumeLocalIndex < ResumeLocalIndex && !PendingWrites.Contains(DurableResumeLocalIndex))
+	{
+		++DurableResumeLocalIndex;
+	}
+}
+
+FString FVantageCVWorker::GetStatusJson() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return BuildStatusJson_Locked();
+}
+
+FString FVantageCVWorker::BuildStatusJson_Locked() const
+{
+	const double Now = FPlatformTime::Seconds();
+	const int64 NumOwned = TotalFrames > 0 ? FMath::DivideAndRoundUp<int64>(FMath::Max<int64>(0, TotalFrames - WorkerIndex), NumWorkers) : 0;
+	const double FramesPerSecond = RecentCompletions.Num() > 1
+		? (RecentCompletions.Num() - 1) / FMath::Max(RecentCompletions.Last() - RecentCompletions[0], 1e-6)
+		: 0.0;
+
+	TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetNumberField(TEXT("worker_index"), WorkerIndex);
+	Root->SetNumberField(TEXT("num_workers"), NumWorkers);
+	Root->SetStringField(TEXT("worker_tag"), GetWorkerTag());
+	Root->SetNumberField(TEXT("process_id"), FPlatformProcess::GetCurrentProcessId());
+	Root->SetStringField(TEXT("host"), FPlatformProcess::ComputerName());
+	Root->SetStringField(TEXT("gpu"), GRHIAdapterName);
+	Root->SetNumberField(TEXT("heartbeat_sequence"), (double)HeartbeatSequence);
+	Root->SetStringField(TEXT("timestamp_utc"), FDateTime::UtcNow().ToIso8601());
+	Root->SetNumberField(TEXT("uptime_seconds"), Now - StartSeconds);
+
+	Root->SetNumberField(TEXT("total_frames"), (double)TotalFrames);
+	Root->SetNumberField(TEXT("owned_frames"), (double)NumOwned);
+	Root->SetNumberField(TEXT("current_frame"), (double)CurrentFrame);
+	Root->SetNumberField(TEXT("resume_frame"), (double)GetGlobalFrame(ResumeLocalIndex));
+	Root->SetNumberField(TEXT("durable_resume_frame"), (double)GetGlobalFrame(DurableResumeLocalIndex));
+	Root->SetNumberField(TEXT("num_completed"), (double)NumCompleted);
+	Root->SetNumberField(TEXT("num_failed"), (double)NumFailed);
+	Root->SetNumberField(TEXT("num_remaining"), NumOwned > 0 ? (double)FMath::Max<int64>(0, NumOwned - ResumeLocalIndex - ProcessedAhead.Num()) : -1.0);
+	Root->SetNumberField(TEXT("frames_per_second"), FramesPerSecond);
+	Root->SetNumberField(TEXT("seconds_since_last_frame"), LastCompletionSeconds > 0.0 ? Now - LastCompletionSeconds : -1.0);
+	Root->SetNumberField(TEXT("pending_writes"), FCaptureWriteQueue::Get().GetNumPending());
+	Root->SetNumberField(TEXT("frames_awaiting_writes"), PendingWrites.Num());
+	Root->SetNumberField(TEXT("num_write_failures"), (double)NumWriteFailures);
+
+	TArray<int64> SortedFailed = FailedFrames.Array();
+	SortedFailed.Sort();
+	TArray<TSharedPtr<FJsonValue>> Failed;
+	for (int64 Frame : SortedFailed)
+	{
+		Failed.Add(MakeShareable(new FJsonValueNumber((double)Frame)));
+	}
+	Root->SetArrayField(TEXT("failed_frames"), Failed);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+	return Output;
+}
+
+FString FVantageCVWorker::GetHeartbeatPath() const
+{
+	return HeartbeatDirectory / FString::Printf(TEXT("%s.heartbeat.json"), *GetWorkerTag());
+}
+
+bool FVantageCVWorker::TickHeartbeat(float DeltaTime)
+{
+	WriteHeartbeat();
+	return true;
+}
+
+void FVantageCVWorker::WriteHeartbeat()
+{
+	FString Json;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		++HeartbeatSequence;
+		Json = BuildStatusJson_Locked();
+	}
+
+	// Write-then-rename so the coordinator never reads a partial record
+	const FString Path = GetHeartbeatPath();
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Json, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+	{
+		UE_LOG(LogVantageCVWorker, Warning, TEXT("Failed to write heartbeat: %s"), *Path);
+	}
+}
+
+void FVantageCVWorker::LoadPreviousHeartbeat()
+{
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *GetHeartbeatPath()))
+	{
+		UE_LOG(LogVantageCVWorker, Log, TEXT("-VantageCVResume: no previous heartbeat at %s, starting from frame 0"), *GetHeartbeatPath());
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogVantageCVWorker, Warning, TEXT("-VantageCVResume: unreadable heartbeat %s"), *GetHeartbeatPath());
+		return;
+	}
+
+	// Only a record from the same partition describes frames this worker owns
+	if ((int32)Root->GetNumberField(TEXT("num_workers")) != NumWorkers || (int32)Root->GetNumberField(TEXT("worker_index")) != WorkerIndex)
+	{
+		UE_LOG(LogVantageCVWorker, Warning, TEXT("-VantageCVResume: heartbeat is from another partition, starting from frame 0"));
+		return;
+	}
+
+	const int64 ResumeFrame = (int64)Root->GetNumberField(TEXT("durable_resume_frame"));
+	Configure(WorkerIndex, NumWorkers, TotalFrames, ResumeFrame);
+
+	// Frames that failed last run are still owed; they stay listed until re-rendered and are handed out first
+	const TArray<TSharedPtr<FJsonValue>>* Failed = nullptr;
+	if (Root->TryGetArrayField(TEXT("failed_frames"), Failed))
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (const TSharedPtr<FJsonValue>& Frame : *Failed)
+		{
+			const int64 GlobalFrame = (int64)Frame->AsNumber();
+			if (OwnsFrame(GlobalFrame) && GlobalFrame < GetGlobalFrame(ResumeLocalIndex))
+			{
+				FailedFrames.Add(GlobalFrame);
+				RetryFrames.Add(GlobalFrame);
+			}
+		}
+	}
+
+	UE_LOG(LogVantageCVWorker, Log, TEXT("-VantageCVResume: resuming at frame %lld (%d failed frames carried over)"), ResumeFrame, FailedFrames.Num());
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * VantageCV - Actor Index Subsystem Header
+ ******************************************************************************
+ * File: ActorIndexSubsystem.h
+ * Description: Per-world index of actors by name, editor label and tag so
+ *              anchor resolution, annotation and cleanup avoid full-world
+ *              TActorIterator sweeps
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActorIndexSubsystem.generated.h"
+
+/**
+ * World-level actor index.
+ *
+ * Built on first lookup, then kept current through the world's actor spawned /
+ * destroyed handlers and level streaming add/remove. Newly spawned actors are
+ * indexed lazily on the next lookup, so tags added right after SpawnActor are
+ * picked up. Tags edited later on an indexed actor (Remote Control, Blueprint)
+ * are re-read on the first tag lookup of each frame and whenever a tag lookup
+ * finds nothing; ReindexActor makes a same-frame edit visible immediately.
+ */
+UCLASS()
+class VANTAGECV_API UActorIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Index for the world, or nullptr (e.g. null world or unsupported world type) */
+	static UActorIndexSubsystem* Get(const UWorld* World);
+
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Find by object name (case-insensitive) or, in editor builds, by actor label */
+	AActor* FindActorByName(const FString& ActorName);
+
+	/** Actors carrying the tag, in index order */
+	void GetActorsWithTag(FName Tag, TArray<AActor*>& OutActors);
+
+	/** Actors carrying any of the tags, each listed once */
+	TArray<AActor*> GetActorsWithAnyTag(const TArray<FString>& Tags);
+
+	/** Re-read an actor's name, label and tags (on the next lookup) after they changed */
+	void ReindexActor(AActor* Actor);
+
+	/** Drop and rebuild the whole index with one world sweep */
+	void Rebuild();
+
+	int32 GetNumIndexedActors();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Build on first use and index actors spawned since the last lookup */
+	void Refresh();
+
+	/** Re-index actors whose Tags no longer match the keys they were indexed under */
+	void RefreshTags();
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleLevelAdded(ULevel* Level, UWorld* InWorld);
+	void HandleLevelRemoved(ULevel* Level, UWorld* InWorld);
+
+	/** Keys the actor was indexed under, so removal does not depend on its current state */
+	struct FIndexedKeys
+	{
+		FName Name;
+		FString Label;
+		TArray<FName> Tags;
+	};
+
+	TMap<FName, TWeakObjectPtr<AActor>> ActorsByName;
+	TMap<FString, TWeakObjectPtr<AActor>> ActorsByLabel;
+	TMap<FName, TArray<TWeakObjectPtr<AActor>>> ActorsByTag;
+	TMap<TWeakObjectPtr<AActor>, FIndexedKeys> IndexedActors;
+
+	/** Spawned since the last lookup; indexed on Refresh */
+	TArray<TWeakObjectPtr<AActor>> PendingActors;
+
+	bool bBuilt = false;
+
+	/** GFrameCounter of the last RefreshTags */
+	uint64 TagsCheckedFrame = 0;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
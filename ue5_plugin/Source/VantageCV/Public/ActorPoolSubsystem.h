@@ -0,0 +1,140 @@
+/******************************************************************************
+ * VantageCV - Actor Pool Subsystem Header
+ ******************************************************************************
+ * File: ActorPoolSubsystem.h
+ * Description: Per-asset pool of spawned actors (vehicles, props, distractors)
+ *              that parks released actors and reuses them in the next scene
+ *              instead of destroying and respawning them
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "ActorPoolSubsystem.generated.h"
+
+/**
+ * Idle actors and counters for one asset path
+ */
+USTRUCT()
+struct FActorPoolBucket
+{
+	GENERATED_BODY()
+
+	/** Parked actors ready for reuse */
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Idle;
+
+	int32 NumInUse = 0;
+	int64 NumSpawned = 0;
+	int64 NumReused = 0;
+};
+
+/**
+ * World-level actor pool keyed by asset path (blueprint class or static mesh).
+ *
+ * Release() hides the actor, disables collision and tick, strips its tags,
+ * renames it out of the way and parks it far below the level. Acquire() hands
+ * it back at the new transform with its spawn-time tags, scale and name, so
+ * callers treat it exactly like a freshly spawned actor (re-apply materials,
+ * extra tags and stencil IDs as before).
+ */
+UCLASS()
+class VANTAGECV_API UActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Tag carried by parked actors (and only by them) */
+	static const FName PooledTag;
+
+	/** Pool for the world, or nullptr */
+	static UActorPoolSubsystem* Get(const UWorld* World);
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Reuse a parked actor for the asset or spawn a new one.
+	 * @param AssetPath - Blueprint class or static mesh object path
+	 * @param RequestedName - Object name to give the actor if free (NAME_None = any)
+	 * @return Active actor, or nullptr if the asset failed to load
+	 */
+	AActor* Acquire(const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+		FName RequestedName = NAME_None,
+		ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+	/**
+	 * Acquire from the world's pool, or spawn a plain actor when the world has none
+	 * (unsupported world type). Release and the Destroy fallbacks handle either.
+	 */
+	static AActor* AcquireOrSpawn(UWorld* World, const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+		FName RequestedName = NAME_None,
+		ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+	/** Park a pooled actor for reuse. Actors the pool did not create are destroyed. */
+	void Release(AActor* Actor);
+
+	/** Actor was created by this pool (active or parked) */
+	bool IsPooled(const AActor* Actor) const;
+
+	/**
+	 * Spawn parked actors until the asset has at least Count idle.
+	 * @return Number of actors spawned
+	 */
+	int32 Prewarm(const FString& AssetPath, int32 Count);
+
+	/** Destroy idle actors beyond MaxIdlePerAsset for every asset */
+	int32 Trim(int32 MaxIdlePerAsset = 0);
+
+	/** Per-asset counters as JSON */
+	FString GetStatsJson() const;
+
+	/** Actor placed by a RenderScene spawn request, with the asset and tag it was requested with */
+	struct FSceneSpawn
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FString AssetPath;
+		FString Tag;
+	};
+
+	/**
+	 * Spawns of the last RenderScene call in this world. Kept with the world rather than
+	 * the engine subsystem so the bridge (CDO) and in-engine callers share one list.
+	 */
+	TArray<FSceneSpawn>& GetSceneSpawns() { return SceneSpawns; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Spawn-time state restored on every Acquire */
+	struct FPooledActorInfo
+	{
+		FString AssetPath;
+		TArray<FName> BaselineTags;
+		FVector BaselineScale = FVector::OneVector;
+		bool bBaselineTickEnabled = true;
+		bool bActive = false;
+	};
+
+	/** Spawn a new actor and record its baseline state; counters are left to the caller */
+	AActor* SpawnPooled(const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+		FName RequestedName, ESpawnActorCollisionHandlingMethod CollisionHandling);
+
+	/** Spawn a new actor from the asset (class, else static mesh) */
+	static AActor* SpawnFromAsset(UWorld* World, const FString& AssetPath, const FVector& Location, const FRotator& Rotation,
+		FName RequestedName, ESpawnActorCollisionHandlingMethod CollisionHandling);
+
+	void Park(AActor* Actor, FPooledActorInfo& Info);
+	void Activate(AActor* Actor, FPooledActorInfo& Info, const FVector& Location, const FRotator& Rotation, FName RequestedName);
+
+	UPROPERTY()
+	TMap<FString, FActorPoolBucket> Buckets;
+
+	TMap<TWeakObjectPtr<AActor>, FPooledActorInfo> PooledActors;
+
+	TArray<FSceneSpawn> SceneSpawns;
+};
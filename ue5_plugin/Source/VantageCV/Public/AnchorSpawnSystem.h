@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "SpawnFootprintGrid.h"
+#include "ScenePlanner.h"
+#include "VantageCVEventLog.h"
 #include "AnchorSpawnSystem.generated.h"
 
 /**
@@ -156,6 +159,10 @@ struct FVehicleSpawnConfig
     /** Scale multiplier */
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     float Scale = 1.0f;
+
+    /** Unscaled half-extent for the pre-spawn overlap test when the asset is not a static mesh (blueprints) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector FootprintHalfExtent = FVector(250.0f, 100.0f, 75.0f);
 };
 
 /**
@@ -198,12 +205,26 @@ struct FAnchorSpawnConfig
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     float LaneYawJitter = 2.0f;
 
+    // ========== Overlap Configuration ==========
+
+    /** Minimum gap between spawned footprints (in cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float FootprintClearance = 20.0f;
+
+    /** Broadphase grid cell size, about one vehicle length (in cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float FootprintGridCellSize = 600.0f;
+
     // ========== Sidewalk Configuration ==========
 
     /** Sidewalk bounds definition */
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FSidewalkBounds SidewalkBounds;
 
+    /** Sample spacing of the cached ground heightfield over the sidewalk bounds (in cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float GroundHeightfieldCellSize = 25.0f;
+
     // ========== Locked Actors ==========
 
     /** Background/environment actors that must never be modified */
@@ -240,6 +261,52 @@ private:
     int32 CallCount = 0;
 };
 
+/**
+ * Counts a frame plan is sampled for (mirrors the Spawn* call arguments)
+ */
+struct FAnchorSpawnPlanParams
+{
+    /** Number of vehicle configs the plan indexes into */
+    int32 NumVehicleConfigs = 0;
+
+    /** Parking vehicles (-1 = fill all slots) */
+    int32 MaxParkingVehicles = -1;
+
+    int32 VehiclesPerLane = 2;
+
+    /** Number of prop asset paths the plan indexes into */
+    int32 NumPropAssets = 0;
+
+    int32 PropCount = 0;
+
+    bool operator==(const FAnchorSpawnPlanParams& Other) const
+    {
+        return NumVehicleConfigs == Other.NumVehicleConfigs && MaxParkingVehicles == Other.MaxParkingVehicles &&
+            VehiclesPerLane == Other.VehiclesPerLane && NumPropAssets == Other.NumPropAssets && PropCount == Other.PropCount;
+    }
+};
+
+/**
+ * One planned spawn; AssetIndex refers to the vehicle configs or prop paths passed to ApplyPlan
+ */
+struct FPlannedAnchorSpawn
+{
+    FString AnchorName;
+    int32 AssetIndex = 0;
+    FTransform Transform;
+};
+
+/**
+ * Complete anchor layout for one frame. Prop transforms are not yet ground-aligned.
+ */
+struct FAnchorSpawnPlan
+{
+    int64 FrameIndex = 0;
+    TArray<FPlannedAnchorSpawn> Parking;
+    TArray<FPlannedAnchorSpawn> Lanes;
+    TArray<FPlannedAnchorSpawn> Props;
+};
+
 /**
  * Anchor-based Spawn System
  * 
@@ -262,13 +329,13 @@ public:
      * Initialize the spawn system with a world reference and config
      * @param InWorld The world to spawn in
      * @param Config Spawn configuration
-     * @param Seed Random seed for determinism
+     * @param Seed Base random seed; the stream uses GetFrameSeed(Seed, worker's current or next frame)
      * @return True if initialization successful
      */
     bool Initialize(UWorld* InWorld, const FAnchorSpawnConfig& Config, int32 Seed);
 
     /**
-     * Re-initialize with a new seed (keeps same config)
+     * Re-initialize with a new base seed (keeps same config), offset by the worker frame like Initialize
      */
     void ReinitializeWithSeed(int32 NewSeed);
 
@@ -354,6 +421,38 @@ public:
         int32 Count
     );
 
+    // ========================================
+    // Precomputed Frame Plans
+    // ========================================
+
+    /**
+     * Sample the layout (slots, modes, jitter, lane positions, prop positions and assets)
+     * for one frame from (Seed, FrameIndex) alone. Reads only config and resolved anchors.
+     */
+    FAnchorSpawnPlan PlanFrame(int32 Seed, int64 FrameIndex, const FAnchorSpawnPlanParams& Params) const;
+
+    /**
+     * Compute plans for frames [FirstFrame, FirstFrame + NumFrames) on worker threads,
+     * from a snapshot of the current config and anchors
+     */
+    void PlanFrames(int32 Seed, int64 FirstFrame, int32 NumFrames, const FAnchorSpawnPlanParams& Params);
+
+    /**
+     * Planned layout for the frame (waits for its batch if still running, samples it
+     * on the spot if it was never planned)
+     */
+    FAnchorSpawnPlan TakePlannedFrame(int64 FrameIndex);
+
+    /**
+     * Spawn a plan: overlap tests, ground alignment and spawning happen here
+     * @return Spawn results (parking, then lanes, then props)
+     */
+    TArray<FSpawnResult> ApplyPlan(
+        const FAnchorSpawnPlan& Plan,
+        const TArray<FVehicleSpawnConfig>& VehicleConfigs,
+        const TArray<FString>& PropAssetPaths
+    );
+
     // ========================================
     // Cleanup
     // ========================================
@@ -378,19 +477,20 @@ public:
     // ========================================
 
     /**
-     * Check if a spawn transform would overlap with existing vehicles
-     * @param Transform Proposed spawn transform
-     * @param VehicleExtent Half-extent of vehicle bounds
+     * Check if a spawn transform would overlap with existing spawned footprints
+     * @param Transform Proposed spawn transform (scale included)
+     * @param LocalBounds Unscaled local-space bounds of the asset
      * @return True if overlap detected
      */
-    bool CheckOverlap(const FTransform& Transform, const FVector& VehicleExtent) const;
+    bool CheckOverlap(const FTransform& Transform, const FBox& LocalBounds) const;
 
     // ========================================
     // Logging
     // ========================================
 
-    void LogInfo(const FString& Module, const FString& Message, const TMap<FString, FString>& Data = {});
-    void LogError(const FString& Module, const FString& Message, const FString& Reason, const FString& SuggestedFix = TEXT(""));
+    /** Structured events through FVantageCVEventLog; Module and Message must be literals */
+    void LogInfo(const TCHAR* Module, const TCHAR* Message, std::initializer_list<FVantageCVEventField> Fields = {});
+    void LogError(const TCHAR* Module, const TCHAR* Message, const FString& Reason, const FString& SuggestedFix = FString());
     void LogSpawnResult(const FSpawnResult& Result);
 
 protected:
@@ -414,6 +514,14 @@ protected:
     // Instance counter for unique IDs
     int32 InstanceCounter = 0;
 
+    // Oriented footprints of everything spawned this scene (overlap broadphase)
+    FSpawnFootprintGrid FootprintGrid;
+
+    // Frame plans computed ahead by PlanFrames
+    TScenePlanQueue<FAnchorSpawnPlan> PlanQueue;
+    int32 PlanSeed = 0;
+    FAnchorSpawnPlanParams PlanParams;
+
     // ========================================
     // Internal Helpers
     // ========================================
@@ -427,9 +535,40 @@ protected:
     /** Compute random position within sidewalk bounds */
     FVector ComputeSidewalkPosition();
 
-    /** Apply ground alignment via raycast */
+    /** Apply ground alignment via the cached heightfield (raycast outside it) */
     float GetGroundZ(const FVector& Location) const;
 
+    /** Local bounds used before spawn: static mesh bounds, else the config's footprint extent */
+    FBox GetAssetLocalBounds(const FVehicleSpawnConfig& VehicleConfig) const;
+
+    /** Add a spawned actor's real footprint (component bounds at its final transform) */
+    void RegisterFootprint(AActor* Actor);
+
+    /** Thread-safe plan sampling against a config/anchor snapshot */
+    static FAnchorSpawnPlan PlanFrameFrom(
+        const FAnchorSpawnConfig& PlanConfig,
+        const TMap<FString, FAnchorDefinition>& Anchors,
+        int32 Seed,
+        int64 FrameIndex,
+        const FAnchorSpawnPlanParams& Params
+    );
+
+    /** Overlap test, spawn and bookkeeping shared by parking and lane vehicles */
+    FSpawnResult SpawnVehicleAt(
+        const TCHAR* Module,
+        const FString& AnchorName,
+        const FString& InstancePrefix,
+        const FTransform& SpawnTransform,
+        const FVehicleSpawnConfig& VehicleConfig
+    );
+
+    /** Ground-align props in one batch, then spawn them */
+    TArray<FSpawnResult> SpawnPropsAt(
+        TArray<FVector> Locations,
+        const TArray<FRotator>& Rotations,
+        const TArray<FString>& AssetPaths
+    );
+
     /** Spawn actor from asset path */
     AActor* SpawnActorFromAsset(const FString& AssetPath, const FTransform& Transform, const FString& InstanceId);
 
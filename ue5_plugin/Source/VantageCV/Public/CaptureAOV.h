@@ -0,0 +1,84 @@
+/******************************************************************************
+ * VantageCV - Capture AOV Header
+ ******************************************************************************
+ * File: CaptureAOV.h
+ * Description: Selection and CPU-side unpacking of the auxiliary outputs
+ *              (depth, world normal, instance ID, velocity) rendered into one
+ *              packed RGBA32F target alongside each RGB capture
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CaptureReadback.h"
+#include "CaptureAOV.generated.h"
+
+class IImageWrapperModule;
+
+/**
+ * AOVs written from one packed AOV capture
+ */
+USTRUCT(BlueprintType)
+struct VANTAGECV_API FCaptureAOVSelection
+{
+	GENERATED_BODY()
+
+	/** SceneDepth in cm, single-channel float EXR (<base>_depth.exr) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bDepth = true;
+
+	/** World-space unit normal, half-float EXR with RGB = XYZ (<base>_normal.exr) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bNormals = false;
+
+	/** Visible stencil ID, 8-bit grayscale PNG (<base>_instance.png); decode with GetSegmentationIdMap */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bInstanceId = true;
+
+	/** Screen motion in pixels since the previous AOV capture, half-float EXR with RG = XY (<base>_velocity.exr) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bVelocity = false;
+
+	bool IsAnySelected() const { return bDepth || bNormals || bInstanceId || bVelocity; }
+};
+
+namespace VantageCVAOV
+{
+	/** Velocity packing range in NDC units per frame; must match VANTAGECV_AOV_VELOCITY_RANGE in AOVPack.ush */
+	constexpr float VelocityRange = 0.5f;
+}
+
+/**
+ * Splits a packed AOV readback into per-AOV images on the write queue workers.
+ *
+ * The packed layout is written by the AOV material through VantageCVPackAOV
+ * (Shaders/Private/AOVPack.ush):
+ *   R = visible stencil ID, G = SceneDepth (cm),
+ *   B = octahedral normal (2 x 15-bit), A = NDC velocity (2 x 15-bit)
+ *
+ * File bases produce <base>_depth.exr, <base>_normal.exr, <base>_instance.png
+ * and <base>_velocity.exr. A shard:// base appends one sample keyed <key>_aov,
+ * with members <key>_aov.depth.exr, <key>_aov.normal.exr, ..., to the open
+ * shard set; the RGB sample of the same base keeps <key>.
+ */
+class VANTAGECV_API FCaptureAOV
+{
+public:
+	/** Paths (or shard member names) written for a base path and selection */
+	static TArray<FString> GetOutputPaths(const FString& BasePath, const FCaptureAOVSelection& Selection);
+
+	/**
+	 * Decode, encode and write every selected AOV of a packed RGBA32F image
+	 * @param MaxStrips - Upper bound on parallel decode strips (0 = one per task graph worker)
+	 */
+	static bool WriteAll(const FCapturedImage& Packed, const FString& BasePath, const FCaptureAOVSelection& Selection,
+		IImageWrapperModule& ImageWrapperModule, int32 MaxStrips = 0);
+
+	/** Inverse of VantageCVPackUnorm15x2, in [0, 1] */
+	static FVector2f UnpackUnorm15x2(float Packed);
+
+	/** Inverse of VantageCVOctahedronEncode for Oct in [-1, 1] */
+	static FVector3f OctahedronDecode(const FVector2f& Oct);
+};
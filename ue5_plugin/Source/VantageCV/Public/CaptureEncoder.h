@@ -0,0 +1,100 @@
+/******************************************************************************
+ * VantageCV - Capture Encoder Header
+ ******************************************************************************
+ * File: CaptureEncoder.h
+ * Description: Per-output image format selection (PNG, fast PNG, QOI, JPEG,
+ *              EXR, raw BGRA) and the encoders used by the write queue,
+ *              including a strip-parallel QOI encoder for large frames
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CaptureReadback.h"
+#include "CaptureEncoder.generated.h"
+
+class IImageWrapperModule;
+
+/**
+ * On-disk format of a captured image
+ */
+UENUM(BlueprintType)
+enum class ECaptureImageFormat : uint8
+{
+	/** Lossless, PngCompressionLevel (default: the previous maximum setting) */
+	PNG,
+	/** Lossless PNG at the engine's default zlib level: larger files, several times faster */
+	PNGFast,
+	/** Lossless QOI, compressed in parallel strips; roughly PNG-fast size at a fraction of the time */
+	QOI,
+	/** Lossy, JpegQuality; alpha is dropped */
+	JPEG,
+	/** Half-float RGBA OpenEXR, linearized from the 8-bit sRGB capture */
+	EXR,
+	/** Headerless tightly packed BGRA8 (Width * Height * 4 bytes); dimensions come from the request */
+	Raw
+};
+
+/**
+ * Encoding settings for one output
+ */
+USTRUCT(BlueprintType)
+struct VANTAGECV_API FCaptureEncodeSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ECaptureImageFormat Format = ECaptureImageFormat::PNG;
+
+	/** 1-100 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1", ClampMax = "100"))
+	int32 JpegQuality = 90;
+
+	/** Passed to IImageWrapper::GetCompressed for ECaptureImageFormat::PNG */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 PngCompressionLevel = 100;
+
+	/** Upper bound on parallel strips for QOI / EXR conversion (0 = one per task graph worker) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 MaxStrips = 0;
+};
+
+/**
+ * Stateless encoders shared by the write queue workers
+ */
+class VANTAGECV_API FCaptureEncoder
+{
+public:
+	/** File extension (without dot) written for a format */
+	static const TCHAR* GetExtension(ECaptureImageFormat Format);
+
+	/** Path with its extension replaced to match the format */
+	static FString ResolveOutputPath(const FString& FilePath, ECaptureImageFormat Format);
+
+	/**
+	 * Encode a BGRA8 image. Raw is not handled here - its file is the pixel buffer itself.
+	 * @param ImageWrapperModule - Loaded on the game thread by the caller
+	 * @return false if the format is Raw, the image is not BGRA8 or encoding failed
+	 */
+	static bool Encode(const FCapturedImage& Image, const FCaptureEncodeSettings& Settings,
+		IImageWrapperModule& ImageWrapperModule, TArray64<uint8>& OutData);
+
+	/**
+	 * QOI encode in independent row strips. Each strip starts from the true previous
+	 * pixel and only references index entries it wrote itself, so the concatenated
+	 * chunks decode with any standard QOI reader.
+	 */
+	static bool EncodeQOI(const FCapturedImage& Image, int32 MaxStrips, TArray64<uint8>& OutData);
+
+	/** Strip count for an image: about one per 256K pixels, capped by MaxStrips and the worker count */
+	static int32 GetNumStrips(const FCapturedImage& Image, int32 MaxStrips);
+
+private:
+	static bool EncodeWithImageWrapper(const FCapturedImage& Image, const FCaptureEncodeSettings& Settings,
+		IImageWrapperModule& ImageWrapperModule, TArray64<uint8>& OutData);
+
+	static bool EncodeEXR(const FCapturedImage& Image, int32 MaxStrips,
+		IImageWrapperModule& ImageWrapperModule, TArray64<uint8>& OutData);
+};
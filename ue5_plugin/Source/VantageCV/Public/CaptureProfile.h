@@ -0,0 +1,81 @@
+/******************************************************************************
+ * VantageCV - Capture Profile Header
+ ******************************************************************************
+ * File: CaptureProfile.h
+ * Description: Named RGB capture feature sets (final, fast-preview,
+ *              annotation-only) applied to the capture component only when
+ *              the active profile changes
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CaptureProfile.generated.h"
+
+class USceneCaptureComponent2D;
+
+/**
+ * Rendering features of the RGB capture pass.
+ *
+ * Built-ins:
+ *   final           - every feature (Lumen GI and reflections, AO, SSR, fog)
+ *   fast-preview    - direct lighting and shadows only; no GI, AO, SSR or volumetric fog
+ *   annotation-only - unlit, no shadows or effects; for label-only and validation captures
+ *
+ * Mask and AOV passes are unaffected (they always render stripped).
+ */
+USTRUCT(BlueprintType)
+struct VANTAGECV_API FCaptureProfile
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Name;
+
+	/** Off = unlit base color */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bLighting = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bDynamicShadows = true;
+
+	/** Dynamic GI (Lumen); off also sets the GI method to None */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bGlobalIllumination = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAmbientOcclusion = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bScreenSpaceReflections = true;
+
+	/** Reflection captures and Lumen reflections; off also sets the reflection method to None */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bReflections = true;
+
+	/** Sky atmosphere and exponential height fog */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAtmosphere = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bVolumetricFog = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bTranslucency = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAntiAliasing = true;
+
+	/** Built-in profile by name, or nullptr */
+	static const FCaptureProfile* FindBuiltIn(FName ProfileName);
+
+	static const TArray<FCaptureProfile>& GetBuiltIns();
+
+	/** Show flags and GI / reflection method overrides of this profile; exposure is left to the caller */
+	void ApplyTo(USceneCaptureComponent2D* Component) const;
+
+	bool operator==(const FCaptureProfile& Other) const;
+	bool operator!=(const FCaptureProfile& Other) const { return !(*this == Other); }
+};
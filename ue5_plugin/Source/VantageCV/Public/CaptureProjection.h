@@ -0,0 +1,117 @@
+/******************************************************************************
+ * VantageCV - Capture Projection Header
+ ******************************************************************************
+ * File: CaptureProjection.h
+ * Description: World-to-pixel projection built from a scene capture view
+ *              (pose, FOV, resolution) with a batched, frustum-clipped box
+ *              projection kernel for 2D bounding box annotation
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USceneCaptureComponent2D;
+
+/**
+ * World-space box given by its center and three half-axis vectors.
+ * An axis-aligned box has half-axes (Extent.X, 0, 0), (0, Extent.Y, 0), (0, 0, Extent.Z).
+ */
+struct FCaptureWorldBox
+{
+	FVector Center = FVector::ZeroVector;
+	FVector HalfAxisX = FVector::ZeroVector;
+	FVector HalfAxisY = FVector::ZeroVector;
+	FVector HalfAxisZ = FVector::ZeroVector;
+
+	FCaptureWorldBox() = default;
+
+	/** From an AABB origin/extent as returned by AActor::GetActorBounds */
+	FCaptureWorldBox(const FVector& Origin, const FVector& Extent)
+		: Center(Origin)
+		, HalfAxisX(Extent.X, 0.0, 0.0)
+		, HalfAxisY(0.0, Extent.Y, 0.0)
+		, HalfAxisZ(0.0, 0.0, Extent.Z)
+	{
+	}
+};
+
+/**
+ * Screen-space result for one box, in pixels of the capture resolution.
+ */
+struct FCaptureProjectedBox
+{
+	/** Box lies at least partly inside the view frustum */
+	bool bVisible = false;
+
+	/** Box was clipped by an image border or the near plane */
+	bool bTruncated = false;
+
+	/** Clamped to [0, Width] x [0, Height]; only meaningful when bVisible */
+	FVector2D Min = FVector2D::ZeroVector;
+	FVector2D Max = FVector2D::ZeroVector;
+
+	/** Smallest view depth of the visible part (cm) */
+	float NearestDepth = 0.0f;
+
+	/** Share of the unclamped screen box inside the image (1 when not truncated) */
+	float InFrameFraction = 0.0f;
+};
+
+/**
+ * Perspective projection of a scene capture view.
+ *
+ * Uses the same matrix the scene capture renders with (horizontal FOV, Y scaled
+ * by aspect ratio, near plane from the component), so boxes line up with the
+ * captured image regardless of the player viewport. The camera translation is
+ * removed in double precision and the remaining 3x3 view-projection is applied
+ * in float, which keeps large-world coordinates exact enough for pixel output.
+ */
+class VANTAGECV_API FCaptureProjection
+{
+public:
+	FCaptureProjection() = default;
+
+	FCaptureProjection(const FVector& ViewLocation, const FRotator& ViewRotation, float FOVDegrees,
+		int32 InWidth, int32 InHeight, float InNearPlane = 10.0f);
+
+	/** Projection for the component's current world pose and FOV at the given output resolution */
+	static FCaptureProjection FromCaptureComponent(const USceneCaptureComponent2D* Component, int32 InWidth, int32 InHeight);
+
+	/** Whether the projection was built from a valid view */
+	bool IsValid() const { return Width > 0 && Height > 0; }
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+	/**
+	 * Project a single world point.
+	 * @return False if the point is behind the near plane (OutPixel untouched)
+	 */
+	bool ProjectPoint(const FVector& WorldLocation, FVector2D& OutPixel) const;
+
+	/**
+	 * Project every box in one pass. Corners outside the frustum are clipped
+	 * against the near plane and the image borders.
+	 * @param Boxes - World boxes
+	 * @param OutBoxes - Resized to Boxes.Num(), one result per box
+	 */
+	void ProjectBoxes(TConstArrayView<FCaptureWorldBox> Boxes, TArray<FCaptureProjectedBox>& OutBoxes) const;
+
+private:
+	/** Screen bounds of one box from its 8 corners in clip space */
+	FCaptureProjectedBox ResolveBox(const float* ClipX, const float* ClipY, const float* ClipW) const;
+
+	FVector ViewOrigin = FVector::ZeroVector;
+
+	/** Rows of the view-projection without translation: clip = (Row . (P - ViewOrigin)) */
+	FVector3f RowX = FVector3f::ZeroVector;
+	FVector3f RowY = FVector3f::ZeroVector;
+	FVector3f RowW = FVector3f::ZeroVector;
+
+	float NearPlane = 10.0f;
+	int32 Width = 0;
+	int32 Height = 0;
+};
@@ -0,0 +1,156 @@
+/******************************************************************************
+ * VantageCV - Asynchronous Capture Readback Header
+ ******************************************************************************
+ * File: CaptureReadback.h
+ * Description: Ring of in-flight render targets with GPU->CPU staging
+ *              readbacks so frame K+1 can render while frame K is copied down
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include <atomic>
+
+class FRHIGPUTextureReadback;
+
+/**
+ * Pixel layout of a CPU-side capture buffer
+ */
+enum class ECapturePixelLayout : uint8
+{
+	BGRA8,		// 4 bytes per pixel, matches RTF_RGBA8 / PF_B8G8R8A8 targets
+	RGBA32F		// 16 bytes per pixel, matches RTF_RGBA32f targets (packed AOV pass, see CaptureAOV.h)
+};
+
+/**
+ * Tightly packed CPU copy of a captured frame
+ */
+struct VANTAGECV_API FCapturedImage
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	ECapturePixelLayout Layout = ECapturePixelLayout::BGRA8;
+
+	/** Row-major pixel data, Width * Height * GetBytesPerPixel() bytes */
+	TArray64<uint8> Data;
+
+	int32 GetBytesPerPixel() const;
+	bool IsValid() const { return Width > 0 && Height > 0 && Data.Num() == (int64)Width * Height * GetBytesPerPixel(); }
+};
+
+/** Called on the game thread once a submitted capture has been copied to CPU memory */
+DECLARE_DELEGATE_ThreeParams(FOnCaptureReadbackComplete, int32 /*Ticket*/, const FString& /*OutputPath*/, FCapturedImage&& /*Image*/);
+
+/**
+ * Fixed-size ring of capture slots, each owning a render target and a staging readback.
+ *
+ * Usage per frame (game thread):
+ *   1. AcquireSlot() - blocks on the oldest in-flight frame only when the ring is full
+ *   2. Render into GetSlotTarget() (e.g. USceneCaptureComponent2D::CaptureScene)
+ *   3. Submit() - enqueues the GPU copy and returns a ticket immediately
+ *   4. Tick() every frame resolves finished copies and fires OnComplete
+ */
+class VANTAGECV_API FCaptureReadbackRing : public FGCObject
+{
+public:
+	FCaptureReadbackRing();
+	virtual ~FCaptureReadbackRing();
+
+	/** Allocate the ring. Calling again with the same owner only reallocates if more slots are needed. */
+	void Initialize(UObject* InOuter, int32 InRingSize);
+
+	/** Grow the ring to at least InRingSize slots without disturbing in-flight frames */
+	void EnsureCapacity(int32 InRingSize);
+
+	/**
+	 * Reserve a free slot sized to Width x Height.
+	 * @param Layout - Pixel layout of the slot target and of the delivered image
+	 * @return Slot index, or INDEX_NONE if the ring is not initialized
+	 */
+	int32 AcquireSlot(int32 Width, int32 Height, ECapturePixelLayout Layout = ECapturePixelLayout::BGRA8);
+
+	/** Render target backing an acquired slot */
+	UTextureRenderTarget2D* GetSlotTarget(int32 SlotIndex) const;
+
+	/**
+	 * Enqueue the GPU->CPU copy for an acquired slot. Call after the render into the slot target was issued.
+	 * @return Ticket identifying this capture, or INDEX_NONE on failure
+	 */
+	int32 Submit(int32 SlotIndex, const FString& OutputPath);
+
+	/** Return an acquired slot that will not be submitted (e.g. the render could not be issued) */
+	void ReleaseSlot(int32 SlotIndex);
+
+	/** Resolve finished readbacks and deliver them. Call once per game-thread tick. */
+	void Tick();
+
+	/** Block until the given ticket has been delivered. Returns false for unknown tickets. */
+	bool WaitForTicket(int32 Ticket);
+
+	/** Block until every in-flight capture has been delivered. Returns the number delivered. */
+	int32 Flush();
+
+	/** True while the ticket is still waiting on the GPU or on delivery */
+	bool IsTicketPending(int32 Ticket) const;
+
+	/** True once the ticket was issued and has been delivered */
+	bool IsTicketComplete(int32 Ticket) const { return Ticket >= 0 && Ticket < NextTicket && !IsTicketPending(Ticket); }
+
+	int32 GetRingSize() const { return Slots.Num(); }
+	int32 GetNumInFlight() const;
+
+	/** Delivery callback; bound by the owner */
+	FOnCaptureReadbackComplete OnComplete;
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FCaptureReadbackRing"); }
+
+private:
+	enum class ESlotState : uint8
+	{
+		Free,
+		Acquired,	// reserved, render not yet submitted
+		InFlight	// GPU copy enqueued, CPU copy pending until bCopied is set
+	};
+
+	struct FSlot
+	{
+		TObjectPtr<UTextureRenderTarget2D> Target = nullptr;
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+		ESlotState State = ESlotState::Free;
+		ECapturePixelLayout Layout = ECapturePixelLayout::BGRA8;
+		int32 Ticket = INDEX_NONE;
+		FString OutputPath;
+		FCapturedImage Image;
+
+		/** Game-thread time of Submit, for the GPU latency stage */
+		uint64 SubmitCycles = 0;
+
+		/** Set by the render thread when Image has been filled */
+		std::atomic<bool> bCopied{false};
+	};
+
+	/** Make sure the slot render target matches the requested size and layout */
+	void PrepareSlotTarget(FSlot& Slot, int32 Width, int32 Height, ECapturePixelLayout Layout);
+
+	/** Return slot render targets and buffers to the resource pool */
+	void ReleaseSlotResources();
+
+	/** Enqueue a render command copying every ready in-flight slot; bBlock forces the GPU to finish first */
+	void EnqueueResolve(bool bBlock);
+
+	/** Hand resolved slots to OnComplete and free them */
+	int32 DeliverResolved();
+
+	/** Index of the oldest in-flight slot, or INDEX_NONE */
+	int32 FindOldestPendingSlot() const;
+
+	TWeakObjectPtr<UObject> Outer;
+	TArray<TUniquePtr<FSlot>> Slots;
+	int32 NextTicket = 0;
+};
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * VantageCV - Capture Resource Pool Header
+ ******************************************************************************
+ * File: CaptureResourcePool.h
+ * Description: Shared pool of render targets and CPU pixel buffers keyed by
+ *              resolution and format, so multi-resolution recipes reuse GPU
+ *              resources and staging memory instead of reallocating per frame
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Pool usage counters. Bytes cover pooled render targets (GPU) and pixel buffers (CPU).
+ */
+struct VANTAGECV_API FCaptureResourcePoolStats
+{
+	int32 RenderTargetsInUse = 0;
+	int32 RenderTargetsIdle = 0;
+	int32 BuffersInUse = 0;
+	int32 BuffersIdle = 0;
+
+	int64 RenderTargetBytes = 0;
+	int64 BufferBytes = 0;
+	int64 HighWaterRenderTargetBytes = 0;
+	int64 HighWaterBufferBytes = 0;
+
+	int64 RenderTargetAllocations = 0;
+	int64 RenderTargetReuses = 0;
+	int64 BufferAllocations = 0;
+	int64 BufferReuses = 0;
+};
+
+/**
+ * Process-wide render target and pixel buffer pool.
+ *
+ * Render targets are game-thread only. Pixel buffers may be released from any
+ * thread (the write queue workers hand them back after encoding).
+ */
+class VANTAGECV_API FCaptureResourcePool : public FGCObject
+{
+public:
+	/** Access the shared pool. Must first be called from the game thread. */
+	static FCaptureResourcePool& Get();
+
+	/** Release every pooled resource. Called on module shutdown after the write queue drained. */
+	static void Shutdown();
+
+	/** True between first use and Shutdown; lets late destructors skip releasing into a dead pool */
+	static bool IsAvailable() { return Instance != nullptr; }
+
+	/**
+	 * Take a render target of the given size and format, creating one only if none is idle.
+	 * Leaves the contents undefined; capture overwrites them.
+	 */
+	UTextureRenderTarget2D* AcquireRenderTarget(int32 Width, int32 Height, ETextureRenderTargetFormat Format = RTF_RGBA8);
+
+	/** Return a render target obtained from AcquireRenderTarget. Null is ignored. */
+	void ReleaseRenderTarget(UTextureRenderTarget2D* Target);
+
+	/**
+	 * Return Current if it already matches, otherwise release it and acquire a matching target.
+	 * Convenience for owners that hold one target and only change its size.
+	 */
+	UTextureRenderTarget2D* ResizeRenderTarget(UTextureRenderTarget2D* Current, int32 Width, int32 Height, ETextureRenderTargetFormat Format = RTF_RGBA8);
+
+	/** Take a pixel buffer of exactly NumBytes elements. Contents are uninitialized. */
+	TArray64<uint8> AcquireBuffer(int64 NumBytes);
+
+	/** Return a pixel buffer. Safe from any thread. Buffers beyond the idle cap are freed. */
+	void ReleaseBuffer(TArray64<uint8>&& Buffer);
+
+	/** Free every idle render target and buffer */
+	void Trim();
+
+	/** Idle resources kept per (size, format) key before extra releases are freed */
+	void SetMaxIdlePerKey(int32 InMaxIdlePerKey);
+
+	FCaptureResourcePoolStats GetStats() const;
+
+	/** Stats as a JSON object string (bytes and counts, including high-water marks) */
+	FString GetStatsJson() const;
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FCaptureResourcePool"); }
+
+private:
+	FCaptureResourcePool() = default;
+
+	struct FRenderTargetKey
+	{
+		int32 Width = 0;
+		int32 Height = 0;
+		ETextureRenderTargetFormat Format = RTF_RGBA8;
+
+		bool operator==(const FRenderTargetKey& Other) const
+		{
+			return Width == Other.Width && Height == Other.Height && Format == Other.Format;
+		}
+
+		friend uint32 GetTypeHash(const FRenderTargetKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Width), GetTypeHash(Key.Height)), GetTypeHash((uint8)Key.Format));
+		}
+	};
+
+	static FRenderTargetKey MakeKey(const UTextureRenderTarget2D* Target);
+	static int64 GetRenderTargetBytes(const FRenderTargetKey& Key);
+
+	/** Idle targets per key; in-use targets are tracked so GC keeps them alive while pooled */
+	TMap<FRenderTargetKey, TArray<TObjectPtr<UTextureRenderTarget2D>>> IdleTargets;
+	TArray<TObjectPtr<UTextureRenderTarget2D>> InUseTargets;
+
+	/** Idle buffers keyed by byte size */
+	TMap<int64, TArray<TArray64<uint8>>> IdleBuffers;
+
+	/**
+	 * Guards IdleBuffers, MaxIdlePerKey and all of Stats: buffers move on any thread, and the
+	 * game-thread render target counters are read by GetStats from any thread
+	 */
+	mutable FCriticalSection BufferLock;
+
+	int32 MaxIdlePerKey = 4;
+	FCaptureResourcePoolStats Stats;
+
+	static FCaptureResourcePool* Instance;
+};
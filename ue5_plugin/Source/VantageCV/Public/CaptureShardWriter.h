@@ -0,0 +1,160 @@
+/******************************************************************************
+ * VantageCV - Capture Shard Writer Header
+ ******************************************************************************
+ * File: CaptureShardWriter.h
+ * Description: Appends encoded frames and their packed annotation records to
+ *              large WebDataset-style tar shards, each with a fixed-record
+ *              sidecar index for memory-mapped random access
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Sidecar index layout (<shard>.idx, little endian):
+ *
+ *   FCaptureShardIndexHeader
+ *   N x FCaptureShardIndexEntry, one per tar member in tar order
+ *
+ * N = (file size - HeaderBytes) / EntryBytes. Entries are appended as members
+ * are written, so an interrupted run still leaves a valid prefix. A sample that
+ * fails after some of its members reached the tar is closed by a tombstone
+ * entry (Flags = TombstoneFlag, no data) with the same sample index; readers
+ * skip every member of that sample.
+ */
+#pragma pack(push, 1)
+struct FCaptureShardIndexHeader
+{
+	static constexpr uint32 MagicValue = 0x49564356;	// "VCVI"
+	static constexpr uint16 CurrentVersion = 1;
+
+	uint32 Magic = MagicValue;
+	uint16 Version = CurrentVersion;
+	uint16 HeaderBytes = sizeof(FCaptureShardIndexHeader);
+	uint16 EntryBytes = 0;
+	uint16 Reserved = 0;
+	uint32 Reserved2 = 0;
+};
+
+struct FCaptureShardIndexEntry
+{
+	static constexpr int32 MaxNameBytes = 100;	// ustar name field
+
+	/** Byte offset of the member's data (past its tar header) within the shard */
+	uint64 DataOffset = 0;
+	uint64 DataBytes = 0;
+
+	/** Set on the entry marking a partially written sample as invalid */
+	static constexpr uint32 TombstoneFlag = 1;
+
+	/** Members of one sample (e.g. key.qoi + key.ann) share a sample index */
+	uint32 SampleIndex = 0;
+	uint32 Flags = 0;
+
+	/** Member name "<key>.<ext>", UTF-8, zero padded */
+	ANSICHAR Name[104] = {};
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FCaptureShardIndexEntry) == 128, "Shard index entries must stay 128 bytes");
+
+/**
+ * One member of a sample
+ */
+struct FCaptureShardMember
+{
+	/** Extension without dot, e.g. "png", "ann", "json" */
+	FString Extension;
+	const uint8* Data = nullptr;
+	int64 NumBytes = 0;
+};
+
+/**
+ * Process-wide shard sink fed by the write queue workers.
+ *
+ * Output paths starting with shard:// name a sample key instead of a file
+ * ("shard://train/000123.png" writes member "train/000123.png"). Members of a
+ * sample are written contiguously and a sample never spans two shards, so the
+ * tars read as WebDataset. A new shard is started once the next sample would
+ * push the current one past the size limit. Appends are serialized under one
+ * lock; encoding stays parallel on the workers.
+ */
+class VANTAGECV_API FCaptureShardWriter
+{
+public:
+	/** Output paths starting with this prefix are appended to the open shard set */
+	static const TCHAR* PathPrefix;
+
+	static FCaptureShardWriter& Get();
+	static void Shutdown();
+
+	static bool IsShardPath(const FString& OutputPath) { return OutputPath.StartsWith(PathPrefix); }
+
+	/**
+	 * Start a shard set <Directory>/<Prefix>-000000.tar, -000001.tar, ...
+	 * Closes a previously open set first.
+	 * @param MaxShardBytes - Size at which the next sample goes to a new shard
+	 */
+	bool Open(const FString& Directory, const FString& Prefix, int64 MaxShardBytes);
+
+	/**
+	 * Finish the current shard (tar end blocks) and stop accepting samples
+	 * @return Number of shards written by the set
+	 */
+	int32 Close();
+
+	bool IsOpen() const;
+
+	/**
+	 * Append one sample. Member names are "<Key>.<Extension>"; WebDataset treats
+	 * everything before the first dot of the file name as the key, so keys
+	 * should not contain dots.
+	 */
+	bool AppendSample(const FString& Key, const TArray<FCaptureShardMember>& Members);
+
+	/**
+	 * Append an encoded capture addressed by a shard:// path, plus its packed
+	 * annotation record as "<key>.ann" when not empty
+	 */
+	bool AppendCapture(const FString& OutputPath, const TArray64<uint8>& ImageData, const TArray<uint8>& Annotations);
+
+	/** Shards, samples, members, bytes and the current shard path as JSON */
+	FString GetStatsJson() const;
+
+	~FCaptureShardWriter();
+
+private:
+	FCaptureShardWriter() = default;
+
+	bool OpenShard_Locked();
+	void CloseShard_Locked();
+	bool WriteMember_Locked(const FString& Name, const uint8* Data, int64 NumBytes);
+
+	/** Index-only entry invalidating the current sample's members already in the tar */
+	void WriteTombstone_Locked();
+
+	mutable FCriticalSection Lock;
+
+	FString Directory;
+	FString Prefix;
+	int64 MaxShardBytes = 1024ll * 1024 * 1024;
+
+	TUniquePtr<FArchive> ShardArchive;
+	TUniquePtr<FArchive> IndexArchive;
+	FString CurrentShardPath;
+	int64 CurrentShardBytes = 0;
+	uint32 CurrentShardSamples = 0;
+
+	bool bOpen = false;
+	int32 NumShards = 0;
+	int64 NumSamples = 0;
+	int64 NumMembers = 0;
+	int64 TotalBytes = 0;
+	int64 NumFailed = 0;
+
+	static FCaptureShardWriter* Instance;
+};
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * VantageCV - Capture Stream Sink Header
+ ******************************************************************************
+ * File: CaptureStreamSink.h
+ * Description: TCP sink that publishes raw captured frames and packed binary
+ *              annotation records straight to a consumer process (e.g. an
+ *              online training dataloader), bypassing PNG encode and disk I/O
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CaptureReadback.h"
+#include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class FSocket;
+class FRunnableThread;
+
+/**
+ * Wire format (little endian), one message per frame:
+ *
+ *   FCaptureStreamHeader
+ *   Name       : NameBytes UTF-8 bytes (output path without the stream:// prefix)
+ *   Pixels     : ImageBytes, tightly packed rows, layout given by PixelLayout
+ *   Annotations: AnnotationBytes, see FCaptureStreamSink::PackAnnotations
+ */
+#pragma pack(push, 1)
+struct FCaptureStreamHeader
+{
+	static constexpr uint32 MagicValue = 0x46564356;	// "VCVF"
+	static constexpr uint16 CurrentVersion = 1;
+
+	uint32 Magic = MagicValue;
+	uint16 Version = CurrentVersion;
+	uint16 HeaderBytes = sizeof(FCaptureStreamHeader);
+	uint32 Sequence = 0;
+	int32 Ticket = -1;
+	uint32 Width = 0;
+	uint32 Height = 0;
+	uint8 PixelLayout = 0;		// ECapturePixelLayout
+	uint8 Reserved = 0;
+	uint16 NameBytes = 0;
+	uint64 ImageBytes = 0;
+	uint32 AnnotationBytes = 0;
+};
+#pragma pack(pop)
+
+/**
+ * One annotated object in the packed annotation record
+ */
+struct FCaptureStreamObject
+{
+	int32 InstanceId = 0;
+	FVector2f BBoxMin = FVector2f::ZeroVector;
+	FVector2f BBoxMax = FVector2f::ZeroVector;
+	FVector3f Location = FVector3f::ZeroVector;
+	FVector3f Rotation = FVector3f::ZeroVector;	// pitch, yaw, roll
+	FString ClassName;
+};
+
+/**
+ * Single-client TCP frame publisher.
+ *
+ * Publish() moves the frame into a bounded queue and returns; a dedicated
+ * thread accepts the consumer connection and sends messages in order. When
+ * the queue is full Publish waits up to the configured timeout, then drops
+ * the frame. Frames published with no client connected are dropped.
+ */
+class VANTAGECV_API FCaptureStreamSink : public FRunnable
+{
+public:
+	/** Output paths starting with this prefix are routed to the stream instead of disk */
+	static const TCHAR* PathPrefix;
+
+	static FCaptureStreamSink& Get();
+	static void Shutdown();
+
+	static bool IsStreamPath(const FString& OutputPath) { return OutputPath.StartsWith(PathPrefix); }
+
+	/** Start listening on the given port (all interfaces). Restarts if already running on another port. */
+	bool Start(int32 Port, int32 InMaxQueuedFrames = 4);
+
+	/** Disconnect the client and stop the sender thread. Queued frames are discarded. */
+	void StopStreaming();
+
+	bool IsRunning() const { return bRunning.load(); }
+	bool HasClient() const { return bClientConnected.load(); }
+
+	/**
+	 * Queue a frame for sending.
+	 * @param Image - Pixels, moved into the queue
+	 * @param OutputPath - Frame name; the stream:// prefix is stripped
+	 * @param Annotations - Packed annotation record (may be empty)
+	 * @return False if the frame was dropped
+	 */
+	bool Publish(FCapturedImage&& Image, int32 Ticket, const FString& OutputPath, TArray<uint8>&& Annotations);
+
+	/** Block until the queue has drained to the socket (or the client went away) */
+	void Flush();
+
+	/**
+	 * Pack objects into the binary annotation record:
+	 *   uint32 Count, then per object:
+	 *   int32 InstanceId, float BBox[4] (min x, min y, max x, max y),
+	 *   float Location[3], float Rotation[3], uint16 ClassBytes, ClassBytes UTF-8
+	 */
+	static TArray<uint8> PackAnnotations(const TArray<FCaptureStreamObject>& Objects);
+
+	int64 GetFramesSent() const { return FramesSent.load(); }
+	int64 GetFramesDropped() const { return FramesDropped.load(); }
+
+	/** Part of GetFramesDropped: frames published while no client was connected */
+	int64 GetFramesDroppedNoClient() const { return FramesDroppedNoClient.load(); }
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	virtual ~FCaptureStreamSink();
+
+private:
+	FCaptureStreamSink();
+
+	struct FStreamFrame
+	{
+		FCaptureStreamHeader Header;
+		TArray<uint8> Name;
+		FCapturedImage Image;
+		TArray<uint8> Annotations;
+	};
+
+	/** Accept a pending connection if there is no client */
+	void AcceptClient();
+
+	/** Send every byte or fail; drops the client on error */
+	bool SendAll(const uint8* Data, int64 NumBytes);
+	void CloseClient();
+
+	FSocket* ListenSocket = nullptr;
+	FSocket* ClientSocket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	int32 ListenPort = 0;
+
+	FCriticalSection QueueLock;
+	TArray<TUniquePtr<FStreamFrame>> Queue;
+	FEvent* WorkEvent = nullptr;
+	FEvent* SpaceEvent = nullptr;
+
+	int32 MaxQueuedFrames = 4;
+	float MaxPublishWaitSeconds = 1.0f;
+	uint32 NextSequence = 0;
+
+	std::atomic<bool> bRunning{false};
+	std::atomic<bool> bStopRequested{false};
+	std::atomic<bool> bClientConnected{false};
+	std::atomic<bool> bSending{false};
+	std::atomic<int64> FramesSent{0};
+	std::atomic<int64> FramesDropped{0};
+	std::atomic<int64> FramesDroppedNoClient{0};
+
+	static FCaptureStreamSink* Instance;
+};
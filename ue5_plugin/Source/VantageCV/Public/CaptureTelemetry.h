@@ -0,0 +1,127 @@
+/******************************************************************************
+ * VantageCV - Capture Telemetry Header
+ ******************************************************************************
+ * File: CaptureTelemetry.h
+ * Description: Per-stage capture timing (scene apply through annotation),
+ *              exported as Unreal Insights CPU events and "stat VantageCV"
+ *              counters, plus rolling p50/p95/p99 windows for Remote Control
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Pipeline stages of one captured frame
+ */
+enum class ECaptureStage : uint8
+{
+	SceneApply,		// actor states, visibility, lighting
+	Spawn,			// spawning / reusing scene actors
+	Streaming,		// waiting for texture / mesh streaming before render (readiness gate)
+	RenderSubmit,	// CaptureScene + readback enqueue (game thread)
+	GPU,			// submit until the staging copy is ready (render + queue latency)
+	Readback,		// staging copy into the CPU buffer (render thread)
+	Encode,			// image compression (write queue workers)
+	Write,			// file write (write queue workers)
+	Annotation,		// bounding boxes, masks, poses
+	Num
+};
+
+DECLARE_STATS_GROUP(TEXT("VantageCV"), STATGROUP_VantageCV, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scene Apply"), STAT_VantageCV_SceneApply, STATGROUP_VantageCV, VANTAGECV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn"), STAT_VantageCV_Spawn, STATGROUP_VantageCV, VANTAGECV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Streaming Wait"), STAT_VantageCV_Streaming, STATGROUP_VantageCV, VANTAGECV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Render Submit"), STAT_VantageCV_RenderSubmit, STATGROUP_VantageCV, VANTAGECV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Readback"), STAT_VantageCV_Readback, STATGROUP_VantageCV, VANTAGECV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Encode"), STAT_VantageCV_Encode, STATGROUP_VantageCV, VANTAGECV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Write"), STAT_VantageCV_Write, STATGROUP_VantageCV, VANTAGECV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Annotation"), STAT_VantageCV_Annotation, STATGROUP_VantageCV, VANTAGECV_API);
+
+/** GPU latency spans frames, so it is a counter rather than a scoped cycle stat */
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("GPU Latency (ms)"), STAT_VantageCV_GPULatency, STATGROUP_VantageCV, VANTAGECV_API);
+
+/**
+ * Process-wide rolling timing windows, one per stage.
+ *
+ * Record() is thread-safe (stages run on the game, render and write worker
+ * threads). Each stage keeps its last WindowSize samples; percentiles are
+ * computed from a copy of the window when stats are requested.
+ */
+class VANTAGECV_API FCaptureTelemetry
+{
+public:
+	static FCaptureTelemetry& Get();
+
+	static const TCHAR* GetStageName(ECaptureStage Stage);
+
+	void Record(ECaptureStage Stage, double Milliseconds);
+
+	/** Per stage: count, mean, p50, p95, p99 and max over the window, plus lifetime count and total */
+	FString GetStatsJson() const;
+
+	void Reset();
+
+	/** Samples kept per stage; clears the windows */
+	void SetWindowSize(int32 InWindowSize);
+
+private:
+	struct FStageWindow
+	{
+		TArray<float> Samples;
+		int32 NextIndex = 0;
+		int64 TotalCount = 0;
+		double TotalMs = 0.0;
+	};
+
+	mutable FCriticalSection Lock;
+	FStageWindow Windows[(int32)ECaptureStage::Num];
+	int32 WindowSize = 1024;
+};
+
+/**
+ * Times a scope into FCaptureTelemetry, optionally adding the duration to a caller's per-frame total
+ */
+class FCaptureStageScope
+{
+public:
+	explicit FCaptureStageScope(ECaptureStage InStage, float* InAccumulateMs = nullptr)
+		: Stage(InStage)
+		, AccumulateMs(InAccumulateMs)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FCaptureStageScope()
+	{
+		const double Milliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+		FCaptureTelemetry::Get().Record(Stage, Milliseconds);
+		if (AccumulateMs)
+		{
+			*AccumulateMs += (float)Milliseconds;
+		}
+	}
+
+private:
+	ECaptureStage Stage;
+	float* AccumulateMs;
+	uint64 StartCycles;
+};
+
+/** Insights event, stat counter and rolling window for one synchronous stage, e.g. VANTAGECV_CAPTURE_STAGE(Encode) */
+#define VANTAGECV_CAPTURE_STAGE(Stage) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(VantageCV_##Stage); \
+	SCOPE_CYCLE_COUNTER(STAT_VantageCV_##Stage); \
+	FCaptureStageScope PREPROCESSOR_JOIN(CaptureStageScope_, __LINE__)(ECaptureStage::Stage)
+
+/** As VANTAGECV_CAPTURE_STAGE, also adding the duration to a float (ms) owned by the caller */
+#define VANTAGECV_CAPTURE_STAGE_ACCUMULATE(Stage, AccumulateMs) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(VantageCV_##Stage); \
+	SCOPE_CYCLE_COUNTER(STAT_VantageCV_##Stage); \
+	FCaptureStageScope PREPROCESSOR_JOIN(CaptureStageScope_, __LINE__)(ECaptureStage::Stage, &(AccumulateMs))
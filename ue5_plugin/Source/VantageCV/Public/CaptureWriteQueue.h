@@ -0,0 +1,120 @@
+/******************************************************************************
+ * VantageCV - Capture Encode/Write Queue Header
+ ******************************************************************************
+ * File: CaptureWriteQueue.h
+ * Description: Bounded worker pool that takes ownership of captured pixel
+ *              buffers, encodes them (see CaptureEncoder.h) and writes them
+ *              to disk off the game thread
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CaptureReadback.h"
+#include "CaptureEncoder.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Function.h"
+#include <atomic>
+
+class FQueuedThreadPool;
+class IImageWrapperModule;
+struct FCaptureAOVSelection;
+
+/**
+ * Process-wide encode/write queue shared by DataCapture and ResearchController.
+ *
+ * Enqueue() moves the pixel buffer into a job and returns immediately. Once
+ * MaxPendingJobs jobs are queued the caller blocks until a worker frees a slot,
+ * so memory held by pending frames stays bounded. Flush() blocks until every
+ * queued file is on disk.
+ */
+class VANTAGECV_API FCaptureWriteQueue
+{
+public:
+	/** Called once per queued image, on the thread that wrote it, with the write result */
+	using FOnWritten = TUniqueFunction<void(bool bSuccess)>;
+
+	/** Access the shared queue. Workers are started on first use. */
+	static FCaptureWriteQueue& Get();
+
+	/** Stop the workers after draining pending jobs. Called on module shutdown. */
+	static void Shutdown();
+
+	/**
+	 * Queue an image for encoding and writing.
+	 * @param Image - Pixel buffer, moved into the job
+	 * @param FilePath - Destination file, written as given (see FCaptureEncoder::ResolveOutputPath); the directory is created if needed
+	 * @param Settings - Output format; defaults to the lossless PNG used for masks
+	 * @param Annotations - Packed annotation record stored next to the image for shard:// paths (ignored for files)
+	 * @param OnWritten - Optional; also called (with false) when nothing is queued
+	 * @return False if the image is invalid and nothing was queued
+	 */
+	bool Enqueue(FCapturedImage&& Image, const FString& FilePath, const FCaptureEncodeSettings& Settings = FCaptureEncodeSettings(),
+		TArray<uint8>&& Annotations = TArray<uint8>(), FOnWritten&& OnWritten = FOnWritten());
+
+	/**
+	 * Queue a packed RGBA32F AOV readback; the worker splits it into the selected AOVs (see FCaptureAOV)
+	 * @param BasePath - File base or shard:// key the AOV suffixes are appended to
+	 * @return False if the image is invalid and nothing was queued
+	 */
+	bool EnqueueAOVs(FCapturedImage&& Packed, const FString& BasePath, const FCaptureAOVSelection& Selection,
+		FOnWritten&& OnWritten = FOnWritten());
+
+	/**
+	 * Block until every queued job has been written.
+	 * @return Number of files written since the previous flush
+	 */
+	int32 Flush();
+
+	/** Maximum queued jobs before Enqueue blocks. Takes effect immediately. */
+	void SetMaxPendingJobs(int32 InMaxPendingJobs);
+
+	int32 GetNumPending() const { return NumPending.load(); }
+	int32 GetNumWorkers() const { return NumWorkers; }
+	int64 GetTotalWritten() const { return TotalWritten.load(); }
+	int64 GetTotalFailed() const { return TotalFailed.load(); }
+
+	/** Encode and write (or append to the open shard set) synchronously on the calling thread. Used by the workers. */
+	bool EncodeAndWrite(const FCapturedImage& Image, const FString& FilePath, const FCaptureEncodeSettings& Settings,
+		const TArray<uint8>& Annotations = TArray<uint8>()) const;
+
+	~FCaptureWriteQueue();
+
+	/** Work run by a job on its image; returns success */
+	using FWriteFunction = TUniqueFunction<bool(const FCapturedImage&)>;
+
+private:
+	FCaptureWriteQueue();
+
+	/** Shared back-pressure and dispatch; runs Write inline when no thread pool is available */
+	bool EnqueueWork(FCapturedImage&& Image, const FString& FilePath, FWriteFunction&& Write, FOnWritten&& OnWritten);
+
+	/** Create the thread pool and load ImageWrapper on the game thread */
+	void Start();
+
+	/** Called by a worker once its job finished */
+	void OnJobFinished(bool bSuccess);
+
+	friend class FCaptureWriteJob;
+
+	FQueuedThreadPool* ThreadPool = nullptr;
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+	FCriticalSection StartLock;
+
+	/** Set once thread pool creation has failed; the queue then stays inline for the session */
+	std::atomic<bool> bStartFailed{false};
+
+	/** Signalled every time a job finishes; waited on by back-pressure and Flush */
+	FEvent* JobFinishedEvent = nullptr;
+
+	int32 NumWorkers = 0;
+	std::atomic<int32> MaxPendingJobs{8};
+	std::atomic<int32> NumPending{0};
+	std::atomic<int32> WrittenSinceFlush{0};
+	std::atomic<int64> TotalWritten{0};
+	std::atomic<int64> TotalFailed{0};
+
+	static FCaptureWriteQueue* Instance;
+};
@@ -13,6 +13,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "CaptureReadback.h"
+#include "CaptureProjection.h"
+#include "InstanceStatsPass.h"
+#include "CaptureEncoder.h"
+#include "CaptureWriteQueue.h"
+#include "CaptureAOV.h"
+#include "CaptureProfile.h"
+#include "AnchorSpawnSystem.h"
 #include "DataCapture.generated.h"
 
 /**
@@ -42,6 +50,345 @@ struct FObjectAnnotation
 	int32 InstanceID;
 };
 
+/**
+ * One viewpoint in a batched capture
+ */
+USTRUCT(BlueprintType)
+struct FCaptureViewRequest
+{
+	GENERATED_BODY()
+
+	/** Camera world location (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Location = FVector::ZeroVector;
+
+	/** Camera world rotation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Horizontal field of view in degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float FOV = 90.0f;
+
+	/** Full output path of the image for this view; the extension is replaced to match OutputEncoding, {worker} by the worker tag */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString OutputPath;
+
+	/** Optional instance mask output (stencil pass); empty = RGB only */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString MaskOutputPath;
+
+	/** Optional AOV base path (packed AOV pass, ADataCapture::AOVs selects the outputs); empty = no AOVs */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString AOVOutputPath;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Width = 1920;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Height = 1080;
+
+	/**
+	 * Reduce this view's instance mask on the GPU inside the batch, for pixel-accurate boxes
+	 * (FCaptureViewResult::InstanceStats). Reuses the mask of MaskOutputPath, otherwise renders one.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bInstanceStats = false;
+};
+
+/**
+ * Minimum-visible-object criteria checked against a camera pose before rendering
+ */
+USTRUCT(BlueprintType)
+struct FCaptureVisibilityCriteria
+{
+	GENERATED_BODY()
+
+	/** Actors that count as targets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> TargetTags = { TEXT("Vehicle") };
+
+	/** Targets that must pass for the view to be captured; 0 disables the gate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 MinVisibleObjects = 0;
+
+	/** Share of a target's projected box that must lie inside the image */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinInFrameFraction = 0.5f;
+
+	/** Smallest clamped box area in pixels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float MinBoxPixels = 400.0f;
+
+	/** Also require a clear line of sight (visibility-channel traces to a few box points) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bOcclusionTest = false;
+
+	/** On failure, aim at the centroid of the targets and test once more before rejecting */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bRetargetOnFail = true;
+};
+
+/**
+ * Outcome of a pre-capture visibility test
+ */
+USTRUCT(BlueprintType)
+struct FCaptureVisibilityReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bPassed = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumTargets = 0;
+
+	/** Targets at least partly inside the frustum */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumInFrustum = 0;
+
+	/** Targets meeting every criterion (testing stops once MinVisibleObjects is reached) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumVisible = 0;
+
+	/** In-frustum targets failing the in-frame fraction or box size */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumTruncated = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumOccluded = 0;
+
+	/** The pose was re-aimed at the targets; Rotation holds the new pose */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bRetargeted = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator Rotation = FRotator::ZeroRotator;
+};
+
+/**
+ * Streaming readiness gate: prefetch for the upcoming views and wait, bounded, until texture
+ * and mesh streaming settles before rendering
+ */
+USTRUCT(BlueprintType)
+struct FCaptureStreamingGate
+{
+	GENERATED_BODY()
+
+	/** Apply the gate in CaptureFrame, CaptureFrameAsync and CaptureViews */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bEnabled = false;
+
+	/** Visible actors with these tags get their textures prestreamed (the scene plan's vehicles) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> PrestreamTags = { TEXT("Vehicle") };
+
+	/** Longest wait; the capture then proceeds with whatever is resident */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float TimeoutSeconds = 2.0f;
+
+	/** How long the view and actor hints keep raising streaming priority */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float HintDurationSeconds = 1.0f;
+
+	/** Streaming distance boost of the upcoming views (1 = none) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.1"))
+	float BoostFactor = 1.0f;
+
+	/** Upcoming views replace the player and editor viewports as streaming view points */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bOverrideOtherViews = true;
+
+	/** Resources still wanting mips or LODs that count as settled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 MaxPendingResources = 0;
+};
+
+/**
+ * Outcome of one streaming readiness wait
+ */
+USTRUCT(BlueprintType)
+struct FCaptureStreamingReport
+{
+	GENERATED_BODY()
+
+	/** Pending resources dropped to MaxPendingResources before the timeout */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSettled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float WaitMs = 0.0f;
+
+	/** Resources wanting mips or LODs after the hints were applied */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumPendingAtStart = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumPendingAtEnd = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumPrestreamedActors = 0;
+};
+
+/**
+ * Per-view outcome of a batched capture
+ */
+USTRUCT(BlueprintType)
+struct FCaptureViewResult
+{
+	GENERATED_BODY()
+
+	/** Index into the request array */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 ViewIndex = INDEX_NONE;
+
+	/** Image was read back and handed to the write queue */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSuccess = false;
+
+	/** Path actually written (extension matches OutputEncoding) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString ImagePath;
+
+	/** Skipped before rendering by the visibility gate (not a failure) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bRejected = false;
+
+	/** Visibility gate result; only filled when the gate is enabled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FCaptureVisibilityReport Visibility;
+
+	/** Mask was read back and handed to the write queue (false when no mask was requested) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bMaskSuccess = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString MaskPath;
+
+	/** AOVs were read back and handed to the write queue (false when none were requested) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAOVSuccess = false;
+
+	/** Files (or shard members) the AOVs are written to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> AOVPaths;
+
+	/** Bounding boxes for this view (filled by RenderScene when requested) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString BoundingBoxesJson;
+
+	/** Camera pose actually used (re-aimed by the visibility gate if it retargeted), echoed for annotation/extrinsics */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float FOV = 90.0f;
+
+	/** Mask statistics of this view, filled when bInstanceStats was requested and the reduction succeeded */
+	TArray<FInstancePixelStats> InstanceStats;
+	bool bHasInstanceStats = false;
+};
+
+/**
+ * Continuous clip for tracking / video datasets (see ADataCapture::StartSequence)
+ */
+USTRUCT(BlueprintType)
+struct FCaptureSequenceSettings
+{
+	GENERATED_BODY()
+
+	/** Frames 0..NumFrames-1, one per engine tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+	int32 NumFrames = 300;
+
+	/** Engine runs with a fixed timestep of 1 / FrameRate while the sequence is active */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1.0"))
+	float FrameRate = 30.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Width = 1920;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Height = 1080;
+
+	/** Receives images/, masks/ and annotations/; {worker} becomes the worker tag */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString OutputDirectory;
+
+	/** Actors annotated every frame (hidden actors are skipped) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> TargetTags = { TEXT("Vehicle") };
+
+	/**
+	 * Lanes by anchor name (LaneId, StartAnchorName, EndAnchorName, LaneWidth). A target within
+	 * half a lane width of a lane's centre line drives along it; other targets stay in place.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FLaneDefinition> Lanes;
+
+	/** Per-vehicle speed range (cm/s), drawn once per vehicle from Seed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float MinSpeed = 800.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float MaxSpeed = 1400.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Seed = 42;
+
+	/** Re-enter at the lane start after passing its end; otherwise vehicles stop at the end */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWrapLanes = true;
+
+	/** Also capture the instance mask of every frame (needs SegmentationMaterial) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWriteMasks = false;
+};
+
+/** Target driving along a sequence lane; positions are a function of time, not accumulated */
+struct FCaptureSequenceMover
+{
+	TWeakObjectPtr<AActor> Actor;
+	int32 LaneIndex = INDEX_NONE;
+
+	/** Distance along the lane at t = 0 */
+	float StartDistance = 0.0f;
+	float Speed = 0.0f;
+
+	/** Offset from the lane centre line, kept while driving */
+	FVector Offset = FVector::ZeroVector;
+
+	/** Restored when the sequence ends */
+	FTransform OriginalTransform;
+};
+
+/** One annotated object of a sequence frame */
+struct FCaptureSequenceObject
+{
+	FObjectAnnotation Annotation;
+	FVector Velocity = FVector::ZeroVector;
+	bool bTruncated = false;
+	FString LaneId;
+};
+
+struct FCaptureSequenceFrame
+{
+	int32 FrameIndex = 0;
+	int32 Ticket = INDEX_NONE;
+	FString ImagePath;
+	TArray<FCaptureSequenceObject> Objects;
+};
+
+/** Sequence tickets whose image was never written; filled from the write queue workers */
+struct FCaptureSequenceWriteFailures
+{
+	FCriticalSection Lock;
+	TSet<int32> Tickets;
+};
+
 /**
  * Captures rendered images and generates annotations for computer vision tasks
  * Exposed via Remote Control API for Python-driven dataset generation
@@ -54,14 +401,165 @@ class VANTAGECV_API ADataCapture : public AActor
 public:	
 	ADataCapture();
 
-	/** Capture current frame to disk as PNG */
+	/** Capture current frame to disk in OutputEncoding's format (OutputPath's extension is replaced to match) */
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "VantageCV")
 	bool CaptureFrame(const FString& OutputPath, int32 Width, int32 Height);
 
-	/** Generate bounding box annotations in JSON format */
+	/** Queue a capture without waiting for the GPU. The image is written once the readback lands.
+	 *  @return Ticket for IsCaptureComplete/WaitForCapture, or -1 on failure */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "VantageCV")
+	int32 CaptureFrameAsync(const FString& OutputPath, int32 Width, int32 Height);
+
+	/** True once an async capture ticket has been read back and handed off for writing */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool IsCaptureComplete(int32 Ticket) const;
+
+	/**
+	 * Queue RGB and instance mask captures of the same scene state.
+	 * @return Ticket of the RGB frame; the mask uses the next ticket. -1 on failure.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	int32 CaptureFrameWithMaskAsync(const FString& OutputPath, const FString& MaskOutputPath, int32 Width, int32 Height);
+
+	/**
+	 * Queue an RGB capture plus one packed AOV pass of the same scene state; the
+	 * AOVs selected by SetAOVs are split out on the write queue (see FCaptureAOV).
+	 * @param AOVBasePath - Base the AOV suffixes are appended to (<base>_depth.exr, ...)
+	 * @return Ticket of the RGB frame; the AOV pass uses the next ticket. -1 on failure.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	int32 CaptureFrameWithAOVsAsync(const FString& OutputPath, const FString& AOVBasePath, int32 Width, int32 Height);
+
+	/** AOVs written by CaptureFrameWithAOVsAsync and by CaptureViews views with an AOVOutputPath */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void SetAOVs(const FCaptureAOVSelection& Selection) { AOVs = Selection; }
+
+	/** Stencil ID -> actor name/class map for decoding instance masks (JSON) */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetSegmentationIdMap() const;
+
+	/** Block until a single async capture has been read back */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool WaitForCapture(int32 Ticket);
+
+	/** Block until every in-flight async capture has been read back. Returns number of frames flushed. */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "VantageCV")
+	int32 FlushPendingCaptures();
+
+	/**
+	 * Capture several viewpoints of the current scene state in one call.
+	 * All CaptureScene calls are issued back-to-back, then one fence/readback flush covers every view.
+	 * The capture component is restored to its original pose afterwards.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	TArray<FCaptureViewResult> CaptureViews(const TArray<FCaptureViewRequest>& Views);
+
+	/**
+	 * Test a camera pose against visibility criteria without rendering
+	 * (batched frustum projection of the target bounds, optional line-of-sight traces)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FCaptureVisibilityReport EvaluateViewVisibility(const FCaptureViewRequest& View, const FCaptureVisibilityCriteria& Criteria) const;
+
+	/** Criteria CaptureViews applies to every view before rendering it */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void SetVisibilityGate(const FCaptureVisibilityCriteria& Criteria) { VisibilityGate = Criteria; }
+
+	/**
+	 * Prefetch streaming for upcoming views and wait until it settles or StreamingGate.TimeoutSeconds pass.
+	 * Each view is registered with the streaming manager, visible PrestreamTags actors prestream their
+	 * textures, then the wait blocks on in-flight requests rather than sleeping. Recorded as the
+	 * Streaming telemetry stage.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FCaptureStreamingReport WaitForStreaming(const TArray<FCaptureViewRequest>& Views);
+
+	/** Readiness gate the capture paths apply before rendering */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void SetStreamingGate(const FCaptureStreamingGate& Gate) { StreamingGate = Gate; }
+
+	/** Result of the most recent WaitForStreaming, including the automatic ones */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FCaptureStreamingReport GetLastStreamingReport() const { return LastStreamingReport; }
+
+	/** Format of RGB outputs from every capture path; instance masks stay lossless PNG */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void SetOutputEncoding(const FCaptureEncodeSettings& Settings) { OutputEncoding = Settings; }
+
+	/**
+	 * Publish captures whose OutputPath starts with stream:// over TCP instead of writing PNGs.
+	 * Each frame carries raw BGRA8 pixels and a packed annotation record for actors with AnnotationTags.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool StartStreaming(int32 Port, const TArray<FString>& AnnotationTags);
+
+	/** Stop the capture stream and disconnect the consumer */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void StopStreaming();
+
+	/**
+	 * Append captures whose OutputPath starts with shard:// to tar shards <Directory>/<ShardPrefix>-NNNNNN.tar
+	 * (each with a .idx sidecar) instead of writing one file per frame. Frames carry the packed annotation
+	 * record of AnnotationTags as <key>.ann. {worker} in Directory or ShardPrefix becomes the worker tag,
+	 * so every farm worker writes its own shard set.
+	 * @param MaxShardMB - Size at which the next sample starts a new shard
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool StartShardWriter(const FString& Directory, const FString& ShardPrefix, int32 MaxShardMB, const TArray<FString>& AnnotationTags);
+
+	/**
+	 * Flush pending captures into the shards and finish the last one
+	 * @return Number of shards written
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	int32 StopShardWriter();
+
+	/**
+	 * Select the RGB feature set by name: "final", "fast-preview", "annotation-only" or a registered profile.
+	 * The capture component is reconfigured on the next capture only if the feature set differs.
+	 * @return False (profile unchanged) if the name is unknown
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool SetCaptureProfile(const FString& ProfileName);
+
+	/** Add or replace a named profile; a registered name shadows the built-in of the same name */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void RegisterCaptureProfile(const FCaptureProfile& Profile);
+
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetCaptureProfile() const { return CaptureProfileName.ToString(); }
+
+	/** Set the manual exposure bias applied by the next capture (0 = neutral) */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void SetExposureBiasOverride(float Bias) { ExposureBiasOverride = Bias; }
+
+	/**
+	 * Generate bounding box annotations in JSON format for the capture camera's
+	 * current pose at the current render target resolution
+	 */
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "VantageCV")
 	FString GenerateBoundingBoxes(const TArray<FString>& TargetTags);
 
+	/** Generate bounding box annotations for an arbitrary view (e.g. one CaptureViews entry) */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GenerateBoundingBoxesForView(const TArray<FString>& TargetTags, FVector Location, FRotator Rotation,
+		float FOV, int32 Width, int32 Height);
+
+	/**
+	 * Bounding boxes for a view CaptureViews already rendered. Uses the view's InstanceStats when present,
+	 * so no mask is rendered or reduced again; otherwise same as GenerateBoundingBoxesForView.
+	 */
+	FString GenerateBoundingBoxesForViewResult(const TArray<FString>& TargetTags, const FCaptureViewResult& View,
+		int32 Width, int32 Height);
+
+	/**
+	 * Per-instance pixel statistics from a GPU reduction over the instance mask:
+	 * tight box, visible and footprint pixel counts, visible fraction, truncation.
+	 * @return JSON string; empty instance list if SegmentationMaterial is not set
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GenerateInstanceAnnotations(int32 Width, int32 Height);
+
 	/** Generate segmentation mask and save to disk */
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "VantageCV")
 	bool GenerateSegmentationMask(const FString& OutputPath, int32 Width, int32 Height);
@@ -94,17 +592,108 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "VantageCV")
 	FVector GetSceneCenter() const { return SceneCenter; }
 
+	/**
+	 * Start a clip: the engine switches to a fixed timestep of 1 / FrameRate and each following
+	 * tick moves the lane vehicles to their position at t = F / FrameRate, queues frame F through
+	 * the async readback ring and records its boxes, keyed by the actors' stencil instance IDs
+	 * (stable for the whole clip). The camera keeps its current pose. Annotations are written to
+	 * annotations/sequence.json and a MOTChallenge annotations/gt.txt once the last frame is queued.
+	 * @return False if a sequence is already running or nothing can be captured
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool StartSequence(const FCaptureSequenceSettings& Settings);
+
+	/** End the clip early: flush captures, write the annotations, restore vehicles and the timestep */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void StopSequence();
+
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool IsSequenceRunning() const { return SequenceFrameIndex != INDEX_NONE; }
+
+	/** Progress, movers, failures and frame rate of the current or last sequence (JSON) */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetSequenceStatus() const;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	virtual void Tick(float DeltaTime) override;
 
+	/** Tick in editor worlds too so async readbacks are delivered outside PIE */
+	virtual bool ShouldTickIfViewportsOnly() const override { return true; }
+
+	/**
+	 * Post-process material for the instance mask pass. Contract: Post Process domain,
+	 * Blendable Location "Replacing the Tonemapper", Emissive =
+	 *   R = CustomStencil / 255 where CustomDepth <= SceneDepth (visible), else 0
+	 *   G = CustomStencil / 255 (footprint, ignores non-annotated occluders)
+	 * If unset, GenerateSegmentationMask falls back to the legacy SceneColorHDR re-render.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Segmentation")
+	TSoftObjectPtr<class UMaterialInterface> SegmentationMaterial;
+
+	/** Derive 2D boxes from the instance mask (tight, occlusion-aware) when SegmentationMaterial is set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Segmentation")
+	bool bPixelAccurateBoxes = true;
+
+	/**
+	 * Post-process material for the packed AOV pass. Contract: Post Process domain,
+	 * Blendable Location "Replacing the Tonemapper", Output Alpha enabled, and a
+	 * Custom node calling VantageCVPackAOV (include /Plugin/VantageCV/Private/AOVPack.ush) with
+	 *   visible CustomStencil (0 where CustomDepth > SceneDepth), SceneDepth,
+	 *   WorldNormal and the decoded Velocity scene texture
+	 * feeding Emissive (RGB) and Opacity (A). Rendered into an RGBA32F target.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|AOV")
+	TSoftObjectPtr<class UMaterialInterface> AOVMaterial;
+
+	/** AOVs split out of the packed pass */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|AOV")
+	FCaptureAOVSelection AOVs;
+
+	/** Boxes of instances with a smaller visible fraction are dropped from GenerateBoundingBoxes (0 = keep all) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Segmentation", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinVisibleFraction = 0.0f;
+
+	/** Pre-capture gate for CaptureViews; views failing it are skipped before CaptureScene (MinVisibleObjects 0 = off) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Visibility")
+	FCaptureVisibilityCriteria VisibilityGate;
+
+	/** Bounded wait for texture and mesh streaming before every capture (off by default) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Streaming")
+	FCaptureStreamingGate StreamingGate;
+
+	/** Active RGB feature set (FCaptureProfile built-in or CustomCaptureProfiles entry) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Profile")
+	FName CaptureProfileName = TEXT("final");
+
+	/** Project-specific profiles, selectable through CaptureProfileName / SetCaptureProfile */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Profile")
+	TArray<FCaptureProfile> CustomCaptureProfiles;
+
+	/** RGB output format (PNG, fast PNG, QOI, JPEG, EXR or raw BGRA) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV|Output")
+	FCaptureEncodeSettings OutputEncoding;
+
+	/** Number of in-flight render targets used by CaptureFrameAsync (render of K+1 overlaps readback of K) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VantageCV", meta=(ClampMin="1", ClampMax="16"))
+	int32 ReadbackRingSize;
+
 private:
 	/** Scene capture component for rendering */
 	UPROPERTY()
 	class USceneCaptureComponent2D* CaptureComponent;
 
+	/** Stripped capture component for the stencil instance mask pass */
+	UPROPERTY()
+	class USceneCaptureComponent2D* SegmentationCaptureComponent;
+
+	/** Stripped capture component for the packed AOV pass (HDR output, persistent view state for velocity) */
+	UPROPERTY()
+	class USceneCaptureComponent2D* AOVCaptureComponent;
+
 	/** Render target for capturing images */
 	UPROPERTY()
 	UTextureRenderTarget2D* RenderTarget;
@@ -127,18 +716,147 @@ private:
 	UPROPERTY()
 	float InitialFOV;
 
+	/** In-flight render targets and staging readbacks for CaptureFrameAsync */
+	FCaptureReadbackRing ReadbackRing;
+
+	/** Set by WaitForStreaming */
+	FCaptureStreamingReport LastStreamingReport;
+
+	/** WaitForStreaming for the capture component's current pose when StreamingGate is enabled */
+	void ApplyStreamingGate(int32 Width, int32 Height);
+
+	/** Apply the capture profile and manual exposure to the capture component (no-op while both are unchanged) */
+	void ConfigureCaptureComponent();
+
+	/** CaptureProfileName resolved against registered then built-in profiles ("final" if unknown) */
+	const FCaptureProfile& ResolveCaptureProfile() const;
+
+	/** Profile the capture component currently reflects; valid while bCaptureComponentConfigured */
+	FCaptureProfile AppliedCaptureProfile;
+	bool bCaptureComponentConfigured = false;
+
+	/** Called by ReadbackRing once an async capture reaches CPU memory */
+	void HandleReadbackComplete(int32 Ticket, const FString& OutputPath, FCapturedImage&& Image);
+
+	/** Load SegmentationMaterial into the mask component. Returns false if no material is set. */
+	bool ConfigureSegmentationComponent();
+
+	/**
+	 * Render the instance mask into a ring slot and submit it. Returns ticket or -1.
+	 * @param OutTarget - Optional; receives the slot target holding the mask
+	 */
+	int32 SubmitSegmentationCapture(const FString& MaskOutputPath, int32 Width, int32 Height, UTextureRenderTarget2D** OutTarget = nullptr);
+
+	/** Render the instance mask from the current pose into SegmentationTarget. Returns null on failure. */
+	UTextureRenderTarget2D* RenderSegmentationTarget(int32 Width, int32 Height);
+
+	/** Load AOVMaterial into the AOV component and match its show flags to AOVs. Returns false if no material is set. */
+	bool ConfigureAOVComponent();
+
+	/** Render the packed AOV pass into an RGBA32F ring slot and submit it. Returns ticket or -1. */
+	int32 SubmitAOVCapture(const FString& AOVBasePath, int32 Width, int32 Height);
+
+	/** Selection in effect when each pending AOV ticket was submitted */
+	TMap<int32, FCaptureAOVSelection> AOVReadbackTickets;
+
+	/** OutputPath with {worker} resolved and the extension of OutputEncoding; stream:// paths keep theirs */
+	FString ResolveImagePath(const FString& OutputPath) const;
+
+	/** Tickets of instance mask readbacks, written lossless regardless of OutputEncoding */
+	TSet<int32> MaskReadbackTickets;
+
+	/** Submit a ring slot, packing annotations for stream:// and shard:// RGB outputs. Masks are tracked in MaskReadbackTickets. */
+	int32 SubmitCapture(int32 SlotIndex, const FString& OutputPath, bool bMask = false);
+
+	/** Binary annotation record for StreamAnnotationTags at the current scene state and camera pose */
+	TArray<uint8> PackStreamAnnotations(int32 Width, int32 Height) const;
+
+	/** Tags annotated in streamed and sharded frames */
+	TArray<FString> StreamAnnotationTags;
+
+	/** Annotation records for in-flight streamed and sharded tickets */
+	TMap<int32, TArray<uint8>> PendingStreamAnnotations;
+
+	/** Per-ticket delivery status, collected only while CaptureViews is running */
+	TMap<int32, bool>* ActiveBatchStatus = nullptr;
+
+	/** Worker frame each in-flight ticket belongs to; the frame stays non-durable until the write lands */
+	TMap<int32, int64> TicketFrames;
+
+	/** Register a submitted ticket with the worker's current frame, if any */
+	void TrackFrameWrite(int32 Ticket);
+
+	/** Completion callback reporting a write of GlobalFrame back to the worker and, for a sequence ticket, a failed image to the sequence */
+	FCaptureWriteQueue::FOnWritten MakeFrameWriteCallback(int64 GlobalFrame, int32 Ticket = INDEX_NONE) const;
+
 	/** Find all actors matching tags */
 	TArray<AActor*> GetAnnotatableActors(const TArray<FString>& Tags) const;
 
-	/** Calculate 2D bounding box from 3D actor bounds */
-	bool CalculateBoundingBox(AActor* Actor, FVector2D& OutMin, FVector2D& OutMax) const;
+	/** Projection of the capture component at the given resolution (current render target if 0) */
+	FCaptureProjection GetCaptureProjection(int32 Width = 0, int32 Height = 0) const;
 
-	/** Project 3D point to 2D screen space */
-	FVector2D ProjectWorldToScreen(const FVector& WorldLocation) const;
+	/** Count the targets meeting the criteria from one pose */
+	void CountVisibleTargets(const TArray<AActor*>& Targets, TConstArrayView<FCaptureWorldBox> Boxes, const FVector& ViewLocation,
+		const FCaptureProjection& Projection, const FCaptureVisibilityCriteria& Criteria, FCaptureVisibilityReport& OutReport) const;
+
+	/** Any of a few points on the target reachable from the view without hitting another actor */
+	bool HasLineOfSight(const FVector& ViewLocation, const AActor* Target, const FCaptureWorldBox& Box) const;
+
+	/** Project the world bounds of every actor in one batch */
+	void ProjectActorBounds(const TArray<AActor*>& Actors, const FCaptureProjection& Projection, TArray<FCaptureProjectedBox>& OutBoxes) const;
+
+	/** Render the instance mask from the current pose and reduce it on the GPU */
+	bool ComputeInstanceStats(int32 Width, int32 Height, TArray<FInstancePixelStats>& OutStats);
+
+	/**
+	 * Bounding box JSON for the visible actors (mask-derived when available)
+	 * @param InstanceStats - Precomputed mask statistics for this pose; null renders and reduces the mask here
+	 */
+	FString BuildBoundingBoxJson(const TArray<AActor*>& Actors, const FCaptureProjection& Projection,
+		const TArray<FInstancePixelStats>* InstanceStats = nullptr);
 
 	/** Save texture render target to file */
-	bool SaveRenderTargetToFile(UTextureRenderTarget2D* RenderTarget, const FString& FilePath);
+	bool SaveRenderTargetToFile(UTextureRenderTarget2D* RenderTarget, const FString& FilePath, const FCaptureEncodeSettings& Settings = FCaptureEncodeSettings());
 
 	/** Read pixel data from render target */
 	bool ReadRenderTargetPixels(UTextureRenderTarget2D* RenderTarget, TArray<FColor>& OutPixels);
+
+	/** Active sequence (SequenceFrameIndex is INDEX_NONE when none is running) */
+	FCaptureSequenceSettings SequenceSettings;
+	TArray<FLaneDefinition> SequenceLanes;
+	TArray<FCaptureSequenceMover> SequenceMovers;
+	TArray<TWeakObjectPtr<AActor>> SequenceTargets;
+	TArray<FCaptureSequenceFrame> SequenceFrames;
+	TArray<int32> SequenceDroppedFrames;
+
+	/** Index into SequenceFrames by capture ticket */
+	TMap<int32, int32> SequenceFramesByTicket;
+
+	/** Shared with in-flight write callbacks, which may outlive the sequence */
+	TSharedPtr<FCaptureSequenceWriteFailures, ESPMode::ThreadSafe> SequenceWriteFailures;
+	FString SequenceDirectory;
+	int32 SequenceFrameIndex = INDEX_NONE;
+	int32 SequenceFramesQueued = 0;
+	int32 SequenceFramesFailed = 0;
+	double SequenceStartSeconds = 0.0;
+	double SequenceElapsedSeconds = 0.0;
+
+	/** Engine timestep settings replaced while the sequence runs */
+	bool bSequencePreviousFixedTimeStep = false;
+	double SequencePreviousFixedDeltaTime = 0.0;
+
+	/** Move lane vehicles to their position at Time seconds into the clip */
+	void PlaceSequenceMovers(double Time);
+
+	/** Queue the next frame and record its annotations; ends the clip after the last one */
+	void TickSequence();
+
+	/** Flush, write annotations, restore vehicles and the timestep */
+	void FinishSequence();
+
+	/** Move frames whose image failed after submit from SequenceFrames to SequenceDroppedFrames */
+	void DropFailedSequenceFrames();
+
+	/** sequence.json and gt.txt under SequenceDirectory/annotations */
+	bool WriteSequenceAnnotations() const;
 };
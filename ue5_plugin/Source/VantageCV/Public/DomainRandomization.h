@@ -38,6 +38,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/StaticMesh.h"
+#include "ScenePlanner.h"
 #include "DomainRandomization.generated.h"
 
 /**
@@ -241,6 +242,55 @@ struct FDomainRandomizationConfig
 	int32 RandomSeed = -1;
 };
 
+/**
+ * Sampled sky light values for one frame
+ */
+struct FPlannedSky
+{
+	bool bApply = false;
+	bool bHasColor = false;
+	FLinearColor Color = FLinearColor::White;
+	float Intensity = 1.0f;
+};
+
+/**
+ * Sampled sun values for one frame
+ */
+struct FPlannedLighting
+{
+	bool bApply = false;
+	float Intensity = 0.0f;
+	float Elevation = 0.0f;
+	float Azimuth = 0.0f;
+	float Temperature = 6500.0f;
+	bool bHasShadowAmount = false;
+	float ShadowAmount = 1.0f;
+};
+
+/**
+ * One distractor; Offset is relative to the DomainRandomization actor
+ */
+struct FPlannedDistractor
+{
+	FString MeshPath;
+	FVector Offset = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	float Scale = 1.0f;
+	bool bHasColor = false;
+	FLinearColor Color = FLinearColor::White;
+};
+
+/**
+ * Everything ApplyRandomization would change for one frame, sampled up front
+ */
+struct FDomainRandomizationPlan
+{
+	int64 FrameIndex = 0;
+	FPlannedSky Sky;
+	FPlannedLighting Lighting;
+	TArray<FPlannedDistractor> Distractors;
+};
+
 /**
  * Domain Randomization Controller
  * 
@@ -264,6 +314,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "VantageCV|DomainRandomization")
 	void ApplyRandomizationWithSeed(int32 Seed);
 
+	/**
+	 * Start computing plans for frames [FirstFrame, FirstFrame + NumFrames) on worker threads.
+	 * Frame N's plan depends only on (Seed, N) and the current config.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV|DomainRandomization")
+	void PlanFrames(int32 Seed, int32 FirstFrame, int32 NumFrames);
+
+	/**
+	 * Apply a frame's plan (sky, lighting, distractors). Frames that were not planned
+	 * ahead are sampled on the spot with the same result.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV|DomainRandomization")
+	void ApplyPlannedFrame(int32 FrameIndex);
+
+	/** Sample one frame; thread-safe (reads only the arguments) */
+	static FDomainRandomizationPlan PlanFrame(const FDomainRandomizationConfig& InConfig, int32 Seed, int64 FrameIndex);
+
 	/** Randomize ground plane appearance */
 	UFUNCTION(BlueprintCallable, Category = "VantageCV|DomainRandomization")
 	void RandomizeGround();
@@ -372,6 +439,18 @@ private:
 	/** Random stream for reproducible randomization */
 	FRandomStream RandomStream;
 
+	/** Plans computed ahead by PlanFrames */
+	TScenePlanQueue<FDomainRandomizationPlan> PlanQueue;
+
+	/** Seed of the last PlanFrames call (used for frames sampled on demand) */
+	int32 PlanSeed = 0;
+
+	void ApplyPlannedSky(const FPlannedSky& Sky);
+	void ApplyPlannedLighting(const FPlannedLighting& Lighting);
+
+	/** All "Vehicle"-tagged actors in the world (actor index lookup) */
+	TArray<AActor*> GetTaggedVehicles() const;
+
 	/** Initialize vehicle system - discover, lock scales, hide all */
 	void InitializeVehicleSystem();
 
@@ -387,8 +466,8 @@ private:
 	/** Get random vector in range */
 	FVector GetRandomVector(const FVector& Min, const FVector& Max);
 
-	/** Spawn single distractor with random properties */
-	AActor* SpawnSingleDistractor();
+	/** Spawn (or reuse from the pool) one sampled distractor */
+	AActor* SpawnSingleDistractor(const FPlannedDistractor& Distractor);
 
 	/** Find directional light in scene */
 	class ADirectionalLight* FindDirectionalLight() const;
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * VantageCV - Ground Height Subsystem Header
+ ******************************************************************************
+ * File: GroundHeightSubsystem.h
+ * Description: Per-level heightfield cache for spawn placement, built once
+ *              with async line traces, plus a batched ground-height query
+ *              that only traces points the heightfield cannot answer
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "GroundHeightSubsystem.generated.h"
+
+/**
+ * World-level ground height cache.
+ *
+ * BuildHeightfield() queues one async trace per grid sample; results arrive
+ * with the next physics scene query flush (normally the next frame). Until
+ * then, and for points outside the region, queries fall back to synchronous
+ * traces with the same channel and parameters. Static levels never change
+ * between scenes, so the heightfield lives as long as the world.
+ */
+UCLASS()
+class VANTAGECV_API UGroundHeightSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGroundHeightSubsystem* Get(const UWorld* World);
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Start building a heightfield over the region. No-op if the same region and
+	 * cell size are already built or building.
+	 * @param Region - XY extent to sample; traces run from Max.Z + 500 to Min.Z - 1000
+	 * @param CellSize - Sample spacing in cm (grown if the region would exceed the sample cap)
+	 */
+	void BuildHeightfield(const FBox& Region, float CellSize = 25.0f);
+
+	/** All heightfield traces have completed */
+	bool IsHeightfieldReady() const { return bHeightfieldReady; }
+
+	/** Drop the heightfield (e.g. after moving level geometry) */
+	void Invalidate();
+
+	/**
+	 * Ground Z under every point, in input order. Points without ground keep their own Z.
+	 */
+	void GetGroundHeights(TConstArrayView<FVector> Points, TArray<float>& OutHeights);
+
+	/** Single-point convenience wrapper around GetGroundHeights */
+	float GetGroundHeight(const FVector& Point);
+
+	/** Heightfield and fallback counters as JSON */
+	FString GetStatsJson() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Heightfield answer for the point, false if a trace is needed */
+	bool SampleHeightfield(const FVector& Point, float& OutZ) const;
+
+	/** Blocking trace with the same settings the heightfield uses */
+	bool TraceGround(const FVector& Start, const FVector& End, float& OutZ) const;
+
+	void HandleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 TraceGeneration);
+
+	FCollisionQueryParams MakeQueryParams() const;
+
+	/** Arguments of the last BuildHeightfield call, for the no-op check */
+	FBox RequestedRegion = FBox(ForceInit);
+	float RequestedCellSize = 0.0f;
+
+	FBox2D Region = FBox2D(ForceInit);
+	float TraceTopZ = 0.0f;
+	float TraceBottomZ = 0.0f;
+	float CellSize = 0.0f;
+	int32 NumX = 0;
+	int32 NumY = 0;
+
+	TArray<float> Heights;
+	TBitArray<> HasHeight;
+
+	int32 PendingTraces = 0;
+	uint32 Generation = 0;
+	bool bHeightfieldReady = false;
+
+	int64 NumHeightfieldHits = 0;
+	int64 NumTraceFallbacks = 0;
+};
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * VantageCV - Lighting Preset Subsystem Header
+ ******************************************************************************
+ * File: LightingPresetSubsystem.h
+ * Description: Registry of named lighting / time-of-day presets with cached
+ *              sun, sky light and scene light handles, so switching presets
+ *              is a parameter swap instead of an actor scan, and the sky is
+ *              only recaptured when its captured input actually changes
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LightingPresetSubsystem.generated.h"
+
+class ALight;
+class ADirectionalLight;
+class ASkyLight;
+class UTextureCube;
+
+/**
+ * Full parameter set of one lighting preset. Negative values keep the level's current value.
+ */
+USTRUCT(BlueprintType)
+struct FVantageCVLightingPreset
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSetSunRotation = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator SunRotation = FRotator(-45.0f, 0.0f, 0.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SunIntensity = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSetSunColor = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FLinearColor SunColor = FLinearColor::White;
+
+	/** Kelvin; <= 0 keeps current */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SunTemperature = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SkyIntensity = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSetSkyColor = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FLinearColor SkyColor = FLinearColor::White;
+
+	/**
+	 * Pre-captured sky cubemap (UTextureCube asset path). When set the sky light
+	 * uses it as a specified cubemap instead of capturing the scene.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString SkyCubemapPath;
+
+	/** Exposure bias for DataCapture actors; applied by callers that own a capture */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ExposureBias = 0.0f;
+};
+
+/**
+ * World-level lighting preset registry.
+ *
+ * The sun and sky light are found once (or spawned as VantageCV_Sun /
+ * VantageCV_SkyLight on request) and kept as handles; scene lights are listed
+ * once and kept current through the world's actor spawned handler. Intensity
+ * and color are applied at shading time, so only a change of sun direction or
+ * sky source triggers a sky recapture. Presets with a pre-captured cubemap swap
+ * textures instead. Built-in presets mirror the Python time-of-day states;
+ * more can be registered at runtime or listed in Game.ini
+ * ([/Script/VantageCV.LightingPresetSubsystem] +ConfiguredPresets=(...)).
+ */
+UCLASS(config = Game)
+class VANTAGECV_API ULightingPresetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static ULightingPresetSubsystem* Get(const UWorld* World);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Add or replace a preset (keyed by Preset.Name) */
+	void RegisterPreset(const FVantageCVLightingPreset& Preset);
+
+	const FVantageCVLightingPreset* FindPreset(FName PresetName) const;
+
+	/**
+	 * Apply a registered preset
+	 * @param bSpawnMissingLights - Spawn the sun / sky light if the level has none
+	 * @return false if the preset is unknown or the level has no sun or sky light
+	 */
+	bool ApplyPreset(FName PresetName, bool bSpawnMissingLights = false);
+
+	/**
+	 * Apply a registered preset and push its ExposureBias to every DataCapture of the world.
+	 * Used by all named-preset entry points so they produce the same exposure.
+	 */
+	bool ApplyPresetWithExposure(FName PresetName, bool bSpawnMissingLights = false);
+
+	/** Apply an unregistered parameter set with the same change tracking */
+	bool ApplyPreset(const FVantageCVLightingPreset& Preset, bool bSpawnMissingLights = false);
+
+	/** Cached main directional light; nullptr if none and bSpawnIfMissing is false */
+	ADirectionalLight* GetSun(bool bSpawnIfMissing = false);
+
+	/** Cached sky light; nullptr if none and bSpawnIfMissing is false */
+	ASkyLight* GetSkyLight(bool bSpawnIfMissing = false);
+
+	/** Cached point, spot and directional lights of the level */
+	void GetSceneLights(TArray<ALight*>& OutLights);
+
+	/**
+	 * Recapture the sky if its capture inputs changed since the last capture
+	 * (sun direction or sky source), or unconditionally with bForce
+	 * @return true if a capture was issued
+	 */
+	bool UpdateSkyCapture(bool bForce = false);
+
+	/** Name of the preset applied last (None after direct light edits through other paths) */
+	FName GetActivePreset() const { return ActivePreset; }
+
+	/**
+	 * Preset name last requested through RenderScene lighting, registered or SceneController
+	 * (those are not readable back from the level). Empty for a new world.
+	 */
+	const FString& GetRequestedPreset() const { return RequestedPreset; }
+	void SetRequestedPreset(const FString& PresetName) { RequestedPreset = PresetName; }
+
+	/** Preset count, applies, skipped parameter writes, recaptures and cubemap swaps as JSON */
+	FString GetStatsJson() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void RegisterBuiltInPresets();
+
+	/** Build the scene light list on first use */
+	void RefreshSceneLights();
+	void HandleActorSpawned(AActor* Actor);
+
+	UTextureCube* LoadCubemap(const FString& CubemapPath);
+
+	/** Extra presets loaded from config, registered after the built-ins */
+	UPROPERTY(Config)
+	TArray<FVantageCVLightingPreset> ConfiguredPresets;
+
+	TMap<FName, FVantageCVLightingPreset> Presets;
+
+	/** Loaded pre-captured cubemaps, held for the lifetime of the world */
+	UPROPERTY(Transient)
+	TMap<FString, TObjectPtr<UTextureCube>> Cubemaps;
+
+	TWeakObjectPtr<ADirectionalLight> Sun;
+	TWeakObjectPtr<ASkyLight> SkyLight;
+	TArray<TWeakObjectPtr<ALight>> SceneLights;
+	bool bSceneLightsBuilt = false;
+	FDelegateHandle ActorSpawnedHandle;
+
+	/** Inputs of the last sky capture */
+	bool bHasSkyCapture = false;
+	FRotator CapturedSunRotation = FRotator::ZeroRotator;
+
+	FName ActivePreset;
+	FString RequestedPreset;
+
+	int64 NumApplies = 0;
+	int64 NumParametersWritten = 0;
+	int64 NumParametersSkipped = 0;
+	int64 NumRecaptures = 0;
+	int64 NumRecapturesSkipped = 0;
+	int64 NumCubemapSwaps = 0;
+};
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * VantageCV - Material Instance Cache Header
+ ******************************************************************************
+ * File: MaterialInstanceCache.h
+ * Description: One dynamic material instance per mesh component slot, reused
+ *              across randomization passes, with batched by-index parameter
+ *              writes so repeated randomization allocates nothing
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MaterialInstanceCache.generated.h"
+
+class UMeshComponent;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Parameter values to write to one material slot in a single pass
+ */
+struct VANTAGECV_API FMaterialParameterBatch
+{
+	TArray<TPair<FName, float>, TInlineAllocator<4>> Scalars;
+	TArray<TPair<FName, FLinearColor>, TInlineAllocator<2>> Vectors;
+
+	void SetScalar(FName Name, float Value) { Scalars.Emplace(Name, Value); }
+	void SetVector(FName Name, const FLinearColor& Value) { Vectors.Emplace(Name, Value); }
+	void Reset() { Scalars.Reset(); Vectors.Reset(); }
+};
+
+/**
+ * World-level MID cache.
+ *
+ * The first randomization of a component slot creates a MID parented to the
+ * slot's material and resolves parameter indices; later passes write values by
+ * index into the same MID. Pooled actors keep their components, so their MIDs
+ * are reused across scenes as well. Entries die with their component.
+ */
+UCLASS()
+class VANTAGECV_API UMaterialInstanceCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UMaterialInstanceCacheSubsystem* Get(const UWorld* World);
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Cached MID for the slot, created and assigned on first use
+	 * @return nullptr if the slot has no material
+	 */
+	UMaterialInstanceDynamic* GetOrCreate(UMeshComponent* Component, int32 SlotIndex);
+
+	/**
+	 * Write the batch to the slot's MID (created on first use)
+	 * @return false if the slot has no material
+	 */
+	bool ApplyParameters(UMeshComponent* Component, int32 SlotIndex, const FMaterialParameterBatch& Batch);
+
+	/** Put the slot's original material back (the MID stays cached for the next randomization) */
+	void RestoreBaseMaterial(UMeshComponent* Component, int32 SlotIndex);
+
+	/** Entry, creation and reuse counters as JSON */
+	FString GetStatsJson() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCachedSlot
+	{
+		TWeakObjectPtr<UMaterialInstanceDynamic> Instance;
+		TWeakObjectPtr<UMaterialInterface> BaseMaterial;
+		TMap<FName, int32> ScalarIndices;
+		TMap<FName, int32> VectorIndices;
+	};
+
+	FCachedSlot* FindOrCreateSlot(UMeshComponent* Component, int32 SlotIndex);
+
+	/** Drop entries whose component was destroyed */
+	void PruneStaleEntries();
+
+	TMap<TWeakObjectPtr<UMeshComponent>, TArray<FCachedSlot>> Entries;
+
+	int32 InsertsSincePrune = 0;
+	int64 NumCreated = 0;
+	int64 NumReused = 0;
+};
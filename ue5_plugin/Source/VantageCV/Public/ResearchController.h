@@ -7,6 +7,8 @@
 #include "Engine/SceneCapture2D.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "CaptureEncoder.h"
+#include "VantageCVEventLog.h"
 #include "ResearchController.generated.h"
 
 /**
@@ -61,6 +63,10 @@ struct FResearchCameraConfig
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 Height = 1080;
+
+    /** Output format of CaptureFrame; the output path's extension is replaced to match */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FCaptureEncodeSettings Encoding;
 };
 
 /**
@@ -117,7 +123,7 @@ public:
     /**
      * Initialize the research scene
      * @param SceneId Unique identifier for this scene
-     * @param Seed Random seed for determinism
+     * @param Seed Random seed for determinism (offset by the worker index on a render farm)
      * @return True if initialization successful
      */
     UFUNCTION(BlueprintCallable, Category = "Research|Scene")
@@ -125,13 +131,13 @@ public:
 
     /**
      * Reset scene to initial state
-     * @param NewSeed New random seed (uses increment if -1)
+     * @param NewSeed New random seed (uses increment by the worker count if -1)
      */
     UFUNCTION(BlueprintCallable, Category = "Research|Scene")
     void ResetScene(int32 NewSeed = -1);
 
     /**
-     * Set time of day (lighting)
+     * Set time of day (applies the noon / night lighting preset)
      * @param bIsDay True for daytime, false for night
      */
     UFUNCTION(BlueprintCallable, Category = "Research|Scene")
@@ -214,6 +220,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Research|Capture")
     void SetOutputDirectory(const FString& Path);
 
+    /**
+     * Block until every queued image has been encoded and written
+     * @return Number of files written since the previous flush
+     */
+    UFUNCTION(BlueprintCallable, Category = "Research|Capture")
+    int32 FlushPendingWrites();
+
     // ========================================
     // MODULE 5: Annotation Support
     // ========================================
@@ -240,10 +253,10 @@ public:
     // ========================================
 
     /**
-     * Log structured message
+     * Log structured message through FVantageCVEventLog (Module and Message must be literals)
      */
-    void LogInfo(const FString& Module, const FString& Message, const TMap<FString, FString>& Data = {});
-    void LogError(const FString& Module, const FString& Message, const FString& Reason, const FString& SuggestedFix = TEXT(""));
+    void LogInfo(const TCHAR* Module, const TCHAR* Message, std::initializer_list<FVantageCVEventField> Fields = {});
+    void LogError(const TCHAR* Module, const TCHAR* Message, const FString& Reason, const FString& SuggestedFix = FString());
 
 protected:
     // Scene state
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * VantageCV - Scene Planner Header
+ ******************************************************************************
+ * File: ScenePlanner.h
+ * Description: Counter-based random numbers keyed by (seed, frame, stream) and
+ *              a queue of scene plans computed ahead of time on worker threads,
+ *              so any frame is reproducible without replaying earlier frames
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * Independent random streams within one frame. Each category draws from its own
+ * stream, so e.g. a different distractor count never shifts the lighting values.
+ */
+enum class EScenePlanStream : uint32
+{
+	Sky = 1,
+	Lighting,
+	Distractors,
+	Parking,
+	Lanes,
+	Props,
+	Vehicles,
+	Camera
+};
+
+/**
+ * Stateless-by-construction random source: draw N of (seed, frame, stream) is a
+ * hash of those values and N. Same interface as FRandomStream / FDeterministicRandom
+ * so sampling code can be templated on either.
+ */
+class VANTAGECV_API FCounterRandom
+{
+public:
+	FCounterRandom(int32 Seed, int64 FrameIndex, EScenePlanStream Stream);
+
+	/** Random float in [0, 1) */
+	float FRand();
+
+	/** Random float in [Min, Max) */
+	float FRandRange(float Min, float Max);
+
+	/** Random int in [Min, Max] */
+	int32 RandRange(int32 Min, int32 Max);
+
+	bool RandBool(float TrueProbability = 0.5f);
+
+	uint32 GetCallCount() const { return Counter; }
+
+private:
+	uint64 NextBits();
+
+	uint64 Key = 0;
+	uint32 Counter = 0;
+};
+
+/**
+ * Plans for upcoming frames, computed in batches on the thread pool.
+ *
+ * Launch() copies everything the plan function needs into the task; the game
+ * thread only calls Take() when applying a frame, which blocks solely if that
+ * frame's batch is still running. The plan function must not touch the world.
+ */
+template <typename PlanType>
+class TScenePlanQueue
+{
+public:
+	using FPlanFunction = TFunction<PlanType(int64 FrameIndex)>;
+
+	void Launch(int64 FirstFrame, int32 NumFrames, FPlanFunction PlanFrame)
+	{
+		if (NumFrames <= 0)
+		{
+			return;
+		}
+
+		FPendingBatch& Batch = Pending.AddDefaulted_GetRef();
+		Batch.FirstFrame = FirstFrame;
+		Batch.NumFrames = NumFrames;
+		Batch.Result = Async(EAsyncExecution::ThreadPool, [FirstFrame, NumFrames, PlanFrame = MoveTemp(PlanFrame)]()
+		{
+			TArray<PlanType> Plans;
+			Plans.SetNum(NumFrames);
+			ParallelFor(NumFrames, [&Plans, &PlanFrame, FirstFrame](int32 Index)
+			{
+				Plans[Index] = PlanFrame(FirstFrame + Index);
+			});
+			return Plans;
+		});
+	}
+
+	/** Remove and return the plan for the frame; false if it was never launched */
+	bool Take(int64 FrameIndex, PlanType& OutPlan)
+	{
+		CollectBatches(FrameIndex);
+
+		PlanType* Plan = Ready.Find(FrameIndex);
+		if (!Plan)
+		{
+			return false;
+		}
+		OutPlan = MoveTemp(*Plan);
+		Ready.Remove(FrameIndex);
+		return true;
+	}
+
+	/** Drop every plan; running batches finish in the background and are discarded */
+	void Reset()
+	{
+		Pending.Reset();
+		Ready.Reset();
+	}
+
+	int32 NumReady() const { return Ready.Num(); }
+
+	int32 NumPendingFrames() const
+	{
+		int32 NumFrames = 0;
+		for (const FPendingBatch& Batch : Pending)
+		{
+			NumFrames += Batch.NumFrames;
+		}
+		return NumFrames;
+	}
+
+private:
+	/** Move finished batches into Ready, waiting only for the one holding WaitForFrame */
+	void CollectBatches(int64 WaitForFrame)
+	{
+		for (int32 Index = Pending.Num() - 1; Index >= 0; --Index)
+		{
+			FPendingBatch& Batch = Pending[Index];
+			const bool bHoldsFrame = WaitForFrame >= Batch.FirstFrame && WaitForFrame < Batch.FirstFrame + Batch.NumFrames;
+			if (!bHoldsFrame && !Batch.Result.IsReady())
+			{
+				continue;
+			}
+
+			TArray<PlanType> Plans = Batch.Result.Consume();
+			for (int32 PlanIndex = 0; PlanIndex < Plans.Num(); ++PlanIndex)
+			{
+				Ready.Add(Batch.FirstFrame + PlanIndex, MoveTemp(Plans[PlanIndex]));
+			}
+			Pending.RemoveAtSwap(Index);
+		}
+	}
+
+	struct FPendingBatch
+	{
+		int64 FirstFrame = 0;
+		int32 NumFrames = 0;
+		TFuture<TArray<PlanType>> Result;
+	};
+
+	TArray<FPendingBatch> Pending;
+	TMap<int64, PlanType> Ready;
+};
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * VantageCV - Scene State Delta Header
+ ******************************************************************************
+ * File: SceneStateDelta.h
+ * Description: Apply-if-changed helpers for actor visibility, collision and
+ *              transform so consecutive scenes only dirty render state and
+ *              physics for actors whose state actually differs
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Counters for one scene update
+ */
+struct VANTAGECV_API FSceneDeltaStats
+{
+	/** Actors that needed at least one change */
+	int32 NumUpdated = 0;
+
+	/** Actors already in the requested state */
+	int32 NumSkipped = 0;
+
+	void Record(bool bChanged) { bChanged ? NumUpdated++ : NumSkipped++; }
+};
+
+/**
+ * The level itself is the previous frame's state: every helper compares the
+ * requested state with the actor's current one and only calls the setters that
+ * would change something. Tolerances absorb float round-trips through JSON.
+ */
+struct VANTAGECV_API FSceneStateDelta
+{
+	/** Z that hidden vehicles are parked at (1 km below ground) */
+	static constexpr float HiddenZ = -100000.0f;
+
+	/** Hidden + collision off (e.g. actor states with bVisible = false); true if anything changed */
+	static bool ApplyVisibility(AActor* Actor, bool bVisible);
+
+	/** Teleport only if location or rotation differ; true if moved */
+	static bool ApplyTransform(AActor* Actor, const FVector& Location, const FRotator& Rotation);
+
+	static bool ApplyScale(AActor* Actor, const FVector& Scale);
+
+	/** Hidden, no collision and parked at HiddenZ; true if anything changed */
+	static bool ApplyHiddenParked(AActor* Actor);
+
+	/** Actor is hidden, has no collision and sits at HiddenZ */
+	static bool IsHiddenParked(const AActor* Actor);
+};
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * VantageCV - Segmentation Stencil Header
+ ******************************************************************************
+ * File: SegmentationStencil.h
+ * Description: Custom depth/stencil instance ID allocation for spawned actors,
+ *              used by the GPU instance segmentation pass
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Assigns every annotated actor a unique Custom Stencil value (1-255, 0 = background).
+ *
+ * The segmentation pass samples CustomStencil through a post-process material, so
+ * the mask red channel is the instance ID. IDs are reclaimed when actors are
+ * released or destroyed; with more than 255 live instances IDs are reused.
+ */
+class VANTAGECV_API FSegmentationStencil
+{
+public:
+	static constexpr int32 MaxInstanceId = 255;
+
+	/**
+	 * Enable custom depth on every primitive of the actor and write its stencil ID.
+	 * @return Assigned ID, or the existing ID if the actor already has one
+	 */
+	static int32 AssignInstanceId(AActor* Actor);
+
+	/** Return the actor's ID to the free list and disable custom depth on it */
+	static void ReleaseInstanceId(AActor* Actor);
+
+	/** Assigned ID, or 0 if the actor has none */
+	static int32 GetInstanceId(const AActor* Actor);
+
+	/** Actor for an ID, or nullptr */
+	static AActor* FindActor(int32 InstanceId);
+
+	/** Drop every assignment (e.g. on scene reset) */
+	static void Reset();
+
+	/** JSON map of stencil ID -> actor name/class for decoding masks */
+	static FString GetIdMapJson();
+
+	/** Make sure r.CustomDepth writes stencil (mode 3) */
+	static void EnsureStencilEnabled();
+
+private:
+	/** Remove entries whose actor has been destroyed */
+	static void PurgeStale();
+};
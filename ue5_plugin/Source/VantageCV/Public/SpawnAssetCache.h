@@ -0,0 +1,97 @@
+/******************************************************************************
+ * VantageCV - Spawn Asset Cache Header
+ ******************************************************************************
+ * File: SpawnAssetCache.h
+ * Description: Path -> actor class / static mesh cache for spawn asset paths,
+ *              filled by async preloading so scene spawns never block on disk
+ *              loads or retry paths that already failed
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Engine/StreamableManager.h"
+
+class UStaticMesh;
+
+/**
+ * Resolved spawn asset: exactly one of Class / Mesh is set for a valid entry
+ */
+struct VANTAGECV_API FSpawnAsset
+{
+	UClass* Class = nullptr;
+	UStaticMesh* Mesh = nullptr;
+
+	bool IsValid() const { return Class != nullptr || Mesh != nullptr; }
+};
+
+/**
+ * Process-wide spawn asset cache (game thread only).
+ *
+ * Holds hard references to every resolved class and mesh for the life of the
+ * module, and remembers paths that failed to resolve so they are not retried.
+ * Preload() requests loads through FStreamableManager; Resolve() on a path that
+ * is still loading waits for that request instead of issuing a second load.
+ */
+class VANTAGECV_API FSpawnAssetCache : public FGCObject
+{
+public:
+	static FSpawnAssetCache& Get();
+
+	/** Drop every cached reference. Called on module shutdown. */
+	static void Shutdown();
+
+	/**
+	 * Start async loads for paths that are neither cached nor already loading.
+	 * @return Number of paths requested
+	 */
+	int32 Preload(const TArray<FString>& AssetPaths);
+
+	/** Block until every preload request has completed */
+	void WaitForPreloads();
+
+	/**
+	 * Actor class or static mesh for the path. Cached and failed paths return
+	 * immediately; unknown paths are loaded synchronously once and cached.
+	 */
+	FSpawnAsset Resolve(const FString& AssetPath);
+
+	/** Forget failed paths so they are tried again (e.g. after mounting new content) */
+	void ClearFailedPaths();
+
+	/** Counters as a JSON object string */
+	FString GetStatsJson() const;
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FSpawnAssetCache"); }
+
+private:
+	FSpawnAssetCache() = default;
+
+	/** Classify a loaded object and record the result for the path */
+	FSpawnAsset Store(const FString& AssetPath, UObject* LoadedObject);
+
+	void HandlePreloadComplete(TArray<FString> AssetPaths);
+
+	struct FCachedAsset
+	{
+		TObjectPtr<UClass> Class;
+		TObjectPtr<UStaticMesh> Mesh;
+	};
+
+	TMap<FString, FCachedAsset> Cache;
+	TSet<FString> FailedPaths;
+
+	FStreamableManager StreamableManager;
+	TMap<FString, TSharedPtr<FStreamableHandle>> PendingLoads;
+
+	int64 NumHits = 0;
+	int64 NumBlockingLoads = 0;
+	int64 NumPreloaded = 0;
+
+	static FSpawnAssetCache* Instance;
+};
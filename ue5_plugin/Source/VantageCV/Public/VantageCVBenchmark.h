@@ -0,0 +1,52 @@
+/******************************************************************************
+ * VantageCV - Benchmark Header
+ ******************************************************************************
+ * File: VantageCVBenchmark.h
+ * Description: In-engine throughput benchmarks (capture, anchor spawning,
+ *              anchor resolution, annotation) with machine-readable JSON
+ *              results for regression tracking and farm sizing
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * Benchmark runner for the loaded level.
+ *
+ * Suites (comma separated, empty or "all" = every suite):
+ *   Capture    - CaptureFrame fps at 640x480, 1920x1080 and 3840x2160
+ *   Spawn      - SpawnParkingVehicles + SpawnLaneVehicles for 50 / 200 / 500 vehicles
+ *   Anchors    - ResolveAnchors time for 50 / 200 / 1000 / 5000 anchor actors
+ *   Annotation - bounding box and pose generation for 10 / 100 / 500 targets
+ *
+ * Capture uses the level's first DataCapture actor as placed (load the reference
+ * map first). Spawn and Anchors build a synthetic anchor layout at
+ * BenchmarkOrigin, Annotation a pooled target grid in front of the camera;
+ * both are removed afterwards. Each case runs one warm-up pass
+ * (pool fill, asset load, shader compile) and then Iterations timed passes.
+ *
+ * Console: VantageCV.Benchmark [Suites] [Iterations] [OutputPath]
+ * Unattended: -ExecCmds="VantageCV.Benchmark all 10, Quit"
+ */
+class VANTAGECV_API FVantageCVBenchmark
+{
+public:
+	/** Location of the synthetic layout, away from typical level content */
+	static const FVector BenchmarkOrigin;
+
+	/**
+	 * Run the selected suites on the game thread
+	 * @param Iterations - Timed passes per case (after one warm-up pass)
+	 * @param OutputPath - JSON file to write (empty = GetDefaultOutputPath())
+	 * @return Results JSON (machine info, then one array of cases per suite)
+	 */
+	static FString Run(UWorld* World, const FString& Suites, int32 Iterations, const FString& OutputPath);
+
+	/** Saved/VantageCV/Benchmarks/benchmark_<tag>_<timestamp>.json */
+	static FString GetDefaultOutputPath();
+};
@@ -0,0 +1,212 @@
+/******************************************************************************
+ * VantageCV - Event Log Header
+ ******************************************************************************
+ * File: VantageCVEventLog.h
+ * Description: Structured event logging with typed fields: callers copy into
+ *              a preallocated ring without heap allocation, a background
+ *              thread formats JSON lines, and hot-path events are gated by
+ *              runtime and compile-time verbosity
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+class FArchive;
+
+/** Severity, most severe first */
+enum class EVantageCVEventLevel : uint8
+{
+	Error,
+	Warning,
+	Info,
+	/** Per-frame and per-actor events (spawn results, capture stages) */
+	Verbose,
+	VeryVerbose
+};
+
+/**
+ * Most verbose level compiled in; VANTAGECV_EVENT calls above it compile to nothing.
+ * Override from the Build.cs (PublicDefinitions.Add("VANTAGECV_EVENT_COMPILED_LEVEL=2")).
+ */
+#ifndef VANTAGECV_EVENT_COMPILED_LEVEL
+	#if UE_BUILD_SHIPPING
+		#define VANTAGECV_EVENT_COMPILED_LEVEL 2
+	#else
+		#define VANTAGECV_EVENT_COMPILED_LEVEL 4
+	#endif
+#endif
+
+/**
+ * One key/value of an event. Keys must be string literals; string values are
+ * copied into the event when it is written, so views of temporaries are fine.
+ */
+struct VANTAGECV_API FVantageCVEventField
+{
+	enum class EType : uint8
+	{
+		Int,
+		Float,
+		Bool,
+		String,
+		Vector
+	};
+
+	const TCHAR* Key = nullptr;
+	EType Type = EType::Int;
+	int64 Int = 0;
+	double Float[3] = { 0.0, 0.0, 0.0 };
+	FStringView String;
+
+	FVantageCVEventField(const TCHAR* InKey, int32 Value) : Key(InKey), Type(EType::Int), Int(Value) {}
+	FVantageCVEventField(const TCHAR* InKey, int64 Value) : Key(InKey), Type(EType::Int), Int(Value) {}
+	FVantageCVEventField(const TCHAR* InKey, uint32 Value) : Key(InKey), Type(EType::Int), Int(Value) {}
+	FVantageCVEventField(const TCHAR* InKey, float Value) : Key(InKey), Type(EType::Float), Float{ Value, 0.0, 0.0 } {}
+	FVantageCVEventField(const TCHAR* InKey, double Value) : Key(InKey), Type(EType::Float), Float{ Value, 0.0, 0.0 } {}
+	FVantageCVEventField(const TCHAR* InKey, bool Value) : Key(InKey), Type(EType::Bool), Int(Value ? 1 : 0) {}
+	FVantageCVEventField(const TCHAR* InKey, const TCHAR* Value) : Key(InKey), Type(EType::String), String(Value) {}
+	FVantageCVEventField(const TCHAR* InKey, const FString& Value) : Key(InKey), Type(EType::String), String(Value) {}
+	FVantageCVEventField(const TCHAR* InKey, FStringView Value) : Key(InKey), Type(EType::String), String(Value) {}
+	FVantageCVEventField(const TCHAR* InKey, const FVector& Value) : Key(InKey), Type(EType::Vector), Float{ Value.X, Value.Y, Value.Z } {}
+	FVantageCVEventField(const TCHAR* InKey, const FRotator& Value) : Key(InKey), Type(EType::Vector), Float{ Value.Pitch, Value.Yaw, Value.Roll } {}
+};
+
+/**
+ * Process-wide structured event log.
+ *
+ * Write() copies the event (literal module and message, up to MaxFields typed
+ * fields, string values into an inline buffer) into a lock-free bounded ring
+ * and returns; nothing is allocated or formatted on the calling thread. A
+ * writer thread drains the ring every 100 ms (immediately for warnings and
+ * errors) into Saved/VantageCV/Logs/events_<worker>.jsonl, one JSON object per
+ * line with the same keys as the Python ResearchLogger (timestamp, module,
+ * level, message, fields), and echoes "[Module] Message | {fields}" to the
+ * output log. When the ring is full events are dropped and counted.
+ *
+ * Command line: -VantageCVEventLevel=Verbose, -VantageCVEventDir=F:/logs,
+ * -VantageCVEventEcho=0 (file only), -VantageCVEventFile=0 (output log only)
+ * Console: VantageCV.EventLevel <Error|Warning|Info|Verbose|VeryVerbose>
+ */
+class VANTAGECV_API FVantageCVEventLog : public FRunnable
+{
+public:
+	static constexpr int32 MaxFields = 8;
+	static constexpr int32 TextCapacity = 256;
+	static constexpr int32 Capacity = 4096;
+
+	static FVantageCVEventLog& Get();
+	static void Shutdown();
+
+	/** Cheap runtime check callers use to skip building fields (VANTAGECV_EVENT does this) */
+	static bool IsEnabled(EVantageCVEventLevel Level) { return (uint8)Level <= RuntimeLevel.load(std::memory_order_relaxed); }
+
+	static void SetLevel(EVantageCVEventLevel Level);
+	static EVantageCVEventLevel GetLevel() { return (EVantageCVEventLevel)RuntimeLevel.load(std::memory_order_relaxed); }
+
+	/** "Error", "Warning", "Info", "Verbose", "VeryVerbose" (case-insensitive); false if unknown */
+	static bool ParseLevel(const FString& Name, EVantageCVEventLevel& OutLevel);
+	static const TCHAR* GetLevelName(EVantageCVEventLevel Level);
+
+	/**
+	 * Queue an event (any thread)
+	 * @param Module - String literal (e.g. TEXT("AnchorResolver"))
+	 * @param Message - String literal
+	 */
+	void Write(EVantageCVEventLevel Level, const TCHAR* Module, const TCHAR* Message, std::initializer_list<FVantageCVEventField> Fields);
+
+	/** Block until every event queued so far is written */
+	void Flush();
+
+	/** Level, file, written / dropped counts and ring occupancy */
+	FString GetStatsJson() const;
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	virtual ~FVantageCVEventLog();
+
+private:
+	FVantageCVEventLog();
+
+	struct FStoredField
+	{
+		const TCHAR* Key = nullptr;
+		FVantageCVEventField::EType Type = FVantageCVEventField::EType::Int;
+		int64 Int = 0;
+		double Float[3] = { 0.0, 0.0, 0.0 };
+		uint16 TextOffset = 0;
+		uint16 TextLength = 0;
+	};
+
+	struct FEventRecord
+	{
+		/** Ring slot state (bounded MPMC queue sequence) */
+		std::atomic<uint64> Sequence{0};
+		double Seconds = 0.0;
+		uint64 Frame = 0;
+		const TCHAR* Module = nullptr;
+		const TCHAR* Message = nullptr;
+		EVantageCVEventLevel Level = EVantageCVEventLevel::Info;
+		uint8 NumFields = 0;
+		uint16 TextLength = 0;
+		FStoredField Fields[MaxFields];
+		TCHAR Text[TextCapacity];
+	};
+
+	/** Read -VantageCVEvent* arguments */
+	void ParseCommandLine();
+
+	/** Format and write every published record; returns the number written */
+	int32 Drain();
+
+	void FormatRecord(const FEventRecord& Record, FString& OutJson, FString& OutEcho) const;
+
+	TUniquePtr<FEventRecord[]> Records;
+	std::atomic<uint64> EnqueuePosition{0};
+	uint64 DequeuePosition = 0;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WorkEvent = nullptr;
+	FEvent* DrainedEvent = nullptr;
+	std::atomic<bool> bStopRequested{false};
+
+	/** Serializes Drain between the writer thread and Flush on shutdown */
+	mutable FCriticalSection DrainLock;
+
+	FArchive* FileWriter = nullptr;
+	FString FilePath;
+	bool bEcho = true;
+
+	/** Wall clock at construction, so records only store FPlatformTime::Seconds() */
+	FDateTime BaseTime;
+	double BaseSeconds = 0.0;
+
+	std::atomic<int64> NumWritten{0};
+	std::atomic<int64> NumDropped{0};
+
+	static std::atomic<uint8> RuntimeLevel;
+	static FVantageCVEventLog* Instance;
+};
+
+/**
+ * Structured event with compile-time and runtime gating; fields are evaluated
+ * only when the level is enabled:
+ *   VANTAGECV_EVENT(Verbose, TEXT("SpawnResult"), TEXT("Vehicle spawned"), {TEXT("anchor"), Name}, {TEXT("location"), Loc});
+ */
+#define VANTAGECV_EVENT(Level, Module, Message, ...) \
+	do \
+	{ \
+		if constexpr ((int32)EVantageCVEventLevel::Level <= VANTAGECV_EVENT_COMPILED_LEVEL) \
+		{ \
+			if (FVantageCVEventLog::IsEnabled(EVantageCVEventLevel::Level)) \
+			{ \
+				FVantageCVEventLog::Get().Write(EVantageCVEventLevel::Level, Module, Message, { __VA_ARGS__ }); \
+			} \
+		} \
+	} while (0)
@@ -25,9 +25,14 @@ public:
 	virtual void ShutdownModule() override;
 
 private:
+	/** Worker, event log and Remote Control setup, deferred until the engine is initialized */
+	void OnPostEngineInit();
+
 	/** Register Remote Control API endpoints for Python communication */
 	void RegisterRemoteControlEndpoints();
 	
 	/** Unregister Remote Control API endpoints */
 	void UnregisterRemoteControlEndpoints();
+
+	FDelegateHandle PostEngineInitHandle;
 };
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * VantageCV - Recipe Runner Header
+ ******************************************************************************
+ * File: VantageCVRecipe.h
+ * Description: Headless generation recipes: research_v2.yaml, the level
+ *              anchors YAML and vehicles.yaml loaded natively and rendered
+ *              in-process for N frames, without Python or Remote Control
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnchorSpawnSystem.h"
+#include "Containers/Ticker.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UWorld;
+class FJsonObject;
+class ADomainRandomization;
+
+/** Vehicle count bucket from vehicles.count_distribution ("1", "2-4") */
+struct FRecipeCountBucket
+{
+	int32 Min = 1;
+	int32 Max = 1;
+	float Weight = 0.0f;
+};
+
+/** Vehicle class from vehicles.class_weights with its pre-placed level actors */
+struct FRecipeVehicleClass
+{
+	FString Name;
+	float Weight = 0.0f;
+	TArray<FString> ActorNames;
+};
+
+/**
+ * One generation run, as the Python research_v2 pipeline reads it.
+ *
+ * research_v2.yaml - seed, frame count, time of day, vehicle count/class
+ *                    distributions and actors, camera, output directories
+ * anchors YAML     - parking slots, lanes, sidewalk and locked actors (FAnchorSpawnConfig)
+ * vehicles.yaml    - default rotation offset and actor pool prewarm counts
+ */
+struct VANTAGECV_API FVantageCVRecipe
+{
+	FString ExperimentName;
+	int32 Seed = 42;
+	int32 NumImages = 100;
+
+	/** Lighting preset applied once before the first frame ("day" maps to "noon") */
+	FString LightingPreset;
+
+	TArray<FRecipeCountBucket> CountBuckets;
+	TArray<FRecipeVehicleClass> VehicleClasses;
+
+	/** vehicles.default.rotation_offset, added to every slot yaw */
+	float RotationOffset = 0.0f;
+
+	FVector CameraLocation = FVector(0.0f, 0.0f, 150.0f);
+	FRotator CameraRotation = FRotator::ZeroRotator;
+	float CameraFOV = 90.0f;
+	float CameraFOVJitter = 0.0f;
+	int32 Width = 1920;
+	int32 Height = 1080;
+	FString ImageFormat = TEXT("png");
+
+	/** Absolute output directories (relative YAML paths resolve against the research YAML's repository root) */
+	FString ImagesDir;
+	FString AnnotationsDir;
+	FString MetadataDir;
+
+	FAnchorSpawnConfig AnchorConfig;
+
+	/** pool.prewarm (asset path -> count) */
+	TMap<FString, int32> PoolPrewarm;
+
+	/** Largest vehicle count any bucket can produce */
+	int32 GetMaxVehicles() const;
+
+	/**
+	 * Load all three files
+	 * @param OutError - First problem found (file, line and reason for YAML errors)
+	 */
+	static bool Load(const FString& ResearchPath, const FString& AnchorsPath, const FString& VehiclesPath,
+		FVantageCVRecipe& OutRecipe, FString& OutError);
+
+	/**
+	 * Read a YAML file into JSON values. Supports the subset the repo's configs use:
+	 * block maps and sequences, inline [a, b] / {k: v}, quoted and plain scalars,
+	 * comments. Anchors, tags and multi-line scalars are rejected with a line number.
+	 */
+	static TSharedPtr<FJsonObject> LoadYaml(const FString& Path, FString& OutError);
+};
+
+/**
+ * Renders a recipe one frame per engine tick through UVantageCVSubsystem::RenderScene.
+ *
+ * Per frame (global frame F of this worker, see FVantageCVWorker):
+ *   1. vehicle count and classes drawn from (Seed, F); one level actor per vehicle
+ *   2. anchor slots from UAnchorSpawnSystem::PlanFrame(Seed, F), grounded; other vehicles hidden
+ *   3. ADomainRandomization::ApplyPlannedFrame(F) when the level has one
+ *   4. fixed camera with FOV jitter rendered to <images>/frame_<F>.<format>
+ *   5. <annotations>/frame_<F>.json in the research_v2 FrameAnnotation.to_dict() schema,
+ *      plus camera, vehicle list and poses
+ *
+ * Frames already completed by a previous run are skipped (-VantageCVResume), so a
+ * farm of N workers renders the recipe's num_images frames exactly once overall.
+ *
+ * Console: VantageCV.RunRecipe <research.yaml> <anchors.yaml> <vehicles.yaml> [NumFrames] [-quit]
+ * Unattended: -game -ExecCmds="VantageCV.RunRecipe F:/VantageCV/configs/research_v2.yaml ... -quit"
+ */
+class VANTAGECV_API FVantageCVRecipeRunner
+{
+public:
+	static FVantageCVRecipeRunner& Get();
+	static void Shutdown();
+
+	/**
+	 * Start rendering (replaces a running recipe)
+	 * @param NumFrames - Global frame count (<= 0 = the recipe's num_images)
+	 * @param bQuitWhenDone - Request engine exit afterwards (exit code 1 if any frame failed)
+	 */
+	bool Start(UWorld* World, const FVantageCVRecipe& Recipe, int32 NumFrames, bool bQuitWhenDone, FString& OutError);
+
+	/** Stop after the current frame and flush pending writes */
+	void Stop();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+	/** Experiment, progress, failures and throughput as JSON */
+	FString GetStatusJson() const;
+
+	~FVantageCVRecipeRunner();
+
+private:
+	FVantageCVRecipeRunner() = default;
+
+	bool Tick(float DeltaTime);
+
+	/** Sample anchor and randomization plans for the PlanBatchSize frames from Frames[FirstIndex] on worker threads */
+	void PlanBatch(int32 FirstIndex);
+
+	enum class EFrameResult : uint8
+	{
+		Succeeded,
+		Rejected,	// Visibility gate: no image or annotation
+		Failed
+	};
+
+	/** Render one global frame and write its annotation. The caller reports it to the worker; only Succeeded completes it. */
+	EFrameResult RenderFrame(int64 GlobalFrame);
+
+	/** Flush writes, write the run summary and optionally quit */
+	void Finish();
+
+	FVantageCVRecipe Recipe;
+	TWeakObjectPtr<UWorld> World;
+	TStrongObjectPtr<UAnchorSpawnSystem> SpawnSystem;
+	TWeakObjectPtr<ADomainRandomization> DomainRandomization;
+
+	TArray<int64> Frames;
+	int32 NextFrame = 0;
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+	int32 NumRejected = 0;
+	double StartSeconds = 0.0;
+	bool bQuitWhenDone = false;
+	bool bFinished = false;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	static FVantageCVRecipeRunner* Instance;
+};
@@ -12,14 +12,212 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "DataCapture.h"
+#include "SceneStateDelta.h"
+#include "LightingPresetSubsystem.h"
 #include "VantageCVSubsystem.generated.h"
 
+/**
+ * Transform/visibility update for an actor already in the level
+ */
+USTRUCT(BlueprintType)
+struct FVantageCVActorState
+{
+	GENERATED_BODY()
+
+	/** Actor object name (or editor label) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString ActorName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bVisible = true;
+};
+
+/**
+ * Actor to spawn for this scene (blueprint class or static mesh asset path)
+ */
+USTRUCT(BlueprintType)
+struct FVantageCVSpawnRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString AssetPath;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Scale = 1.0f;
+
+	/** Actor tag added on spawn (used by annotation TargetTags) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Tag = TEXT("Vehicle");
+};
+
+/**
+ * Lighting and exposure state for this scene
+ */
+USTRUCT(BlueprintType)
+struct FVantageCVLightingState
+{
+	GENERATED_BODY()
+
+	/** Lighting preset applied first (registered preset, else SceneController preset); empty = keep active preset */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Preset;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSetSun = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator SunRotation = FRotator(-45.0f, 0.0f, 0.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SunIntensity = 10.0f;
+
+	/** Sky light intensity; negative = keep current */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SkyIntensity = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ExposureBias = 0.0f;
+};
+
+/**
+ * Complete description of one scene render
+ */
+USTRUCT(BlueprintType)
+struct FVantageCVSceneRequest
+{
+	GENERATED_BODY()
+
+	/**
+	 * Replace the actors spawned by the previous RenderScene call. Previous actors with the
+	 * same asset and tag are moved into place instead of being released and re-acquired.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bClearPreviousSpawns = true;
+
+	/** Hide every "Vehicle"-tagged actor not listed as visible in ActorStates or spawned for this scene */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bHideAllVehicles = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FVantageCVActorState> ActorStates;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FVantageCVSpawnRequest> Spawns;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVantageCVLightingState Lighting;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FCaptureViewRequest> Cameras;
+
+	/** DataCapture profile for these views ("final", "fast-preview", "annotation-only", ...); empty = keep current */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString CaptureProfile;
+
+	/** Actor tags to annotate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> TargetTags;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bBoundingBoxes = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bPoses = true;
+
+	/** Block until every image is on disk before returning */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWaitForWrites = false;
+
+	/** Global frame rendered by this request (GetWorkerFrames); >= 0 reports it to the worker heartbeat */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 FrameIndex = -1;
+};
+
+/**
+ * Everything produced by one RenderScene call
+ */
+USTRUCT(BlueprintType)
+struct FVantageCVSceneResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSuccess = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString ErrorMessage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FCaptureViewResult> Views;
+
+	/** Names of actors spawned for this scene, in request order (empty entry = spawn failed) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> SpawnedActors;
+
+	/** ActorStates entries whose actor was not found */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> MissingActors;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString BoundingBoxesJson;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString PosesJson;
+
+	/** Actors whose visibility, collision or transform had to change for this scene */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumActorsUpdated = 0;
+
+	/** Actors already in the requested state (no render-state or physics update) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumActorsSkipped = 0;
+
+	/** Views skipped before rendering by the DataCapture visibility gate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumViewsRejected = 0;
+
+	/** Per-stage breakdown of this call (ms); GPU, encode and write are in GetCaptureTelemetry */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SpawnMs = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SceneApplyMs = 0.0f;
+
+	/** Render submit through readback of every view */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float CaptureMs = 0.0f;
+
+	/** Streaming readiness wait before the first view (part of CaptureMs; 0 unless the DataCapture StreamingGate is enabled) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float StreamingMs = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float AnnotationMs = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ElapsedMs = 0.0f;
+};
+
 /**
  * VantageCV Engine Subsystem
  * Provides globally accessible functions that can be called via Remote Control API
  * This is the research-grade approach for Python-UE5 communication
  */
-UCLASS()
+UCLASS(config = Game)
 class VANTAGECV_API UVantageCVSubsystem : public UEngineSubsystem
 {
 	GENERATED_BODY()
@@ -43,4 +241,240 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "VantageCV")
 	bool RandomizeScene();
+
+	/**
+	 * Block until every queued capture image has been encoded and written to disk
+	 * Call at the end of a scene before reading the files back
+	 * @return Number of files written since the previous flush
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	int32 FlushCaptureWrites();
+
+	/**
+	 * Set the number of queued images allowed before capture calls block
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void SetMaxPendingWrites(int32 MaxPendingWrites);
+
+	/**
+	 * Render target / pixel buffer pool usage, including high-water memory
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetResourcePoolStats();
+
+	/**
+	 * Free idle pooled render targets and pixel buffers (e.g. after a resolution sweep)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void TrimResourcePool();
+
+	/**
+	 * Spawn parked actors ahead of the first scene so it does not pay load/spawn cost
+	 * @param AssetCounts - Blueprint class or static mesh path -> minimum idle count
+	 * @return Number of actors spawned
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	int32 PrewarmActorPool(const TMap<FString, int32>& AssetCounts);
+
+	/**
+	 * Per-asset idle / in-use / spawned / reused counts of the spawned-actor pool
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetActorPoolStats();
+
+	/**
+	 * Destroy parked actors beyond MaxIdlePerAsset (e.g. after switching asset sets)
+	 * @return Number of actors destroyed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	int32 TrimActorPool(int32 MaxIdlePerAsset);
+
+	/**
+	 * Cached material instance counts (components, slots, MIDs created vs reused)
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetMaterialCacheStats();
+
+	/**
+	 * Start async loads of spawn asset paths (vehicle/prop configs) into the spawn asset cache
+	 * @param bWaitForCompletion - Block until every requested asset has loaded
+	 * @return Number of paths newly requested
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	int32 PreloadSpawnAssets(const TArray<FString>& AssetPaths, bool bWaitForCompletion);
+
+	/**
+	 * Cached class/mesh counts, failed paths, hits and blocking loads of the spawn asset cache
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetSpawnAssetCacheStats();
+
+	/**
+	 * Ground Z under every point in one call (cached heightfield where built, traces elsewhere)
+	 * @return Heights in input order; points without ground keep their own Z
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	TArray<float> GetGroundHeights(const TArray<FVector>& Points);
+
+	/**
+	 * Start caching ground heights over a region (e.g. a prop zone); built once per level
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void BuildGroundHeightfield(const FVector& RegionMin, const FVector& RegionMax, float CellSize);
+
+	/**
+	 * Heightfield readiness, sample counts, heightfield hits and trace fallbacks
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetGroundHeightStats();
+
+	/**
+	 * Shard writer state (open flag, current shard, shard/sample/byte counts)
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetShardWriterStats();
+
+	/**
+	 * Rolling per-stage capture timings (scene apply, spawn, render submit, GPU, readback,
+	 * encode, write, annotation) with p50/p95/p99 over the last WindowSize samples
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetCaptureTelemetry();
+
+	/**
+	 * Clear the timing windows; WindowSize > 0 also changes the samples kept per stage
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void ResetCaptureTelemetry(int32 WindowSize);
+
+	/**
+	 * Set this instance's place in a worker set: it owns global frames WorkerIndex + k * NumWorkers
+	 * @param TotalFrames - Frames of the whole set (0 = open ended)
+	 * @param ResumeFrame - First global frame still to render (e.g. durable_resume_frame of the last heartbeat)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void ConfigureWorker(int32 WorkerIndex, int32 NumWorkers, int32 TotalFrames, int32 ResumeFrame);
+
+	/**
+	 * Worker identity, progress, throughput and failed frames (same record as the heartbeat file)
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetWorkerStatus();
+
+	/**
+	 * Next owned global frames not yet completed, starting at the resume watermark
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	TArray<int32> GetWorkerFrames(int32 MaxFrames);
+
+	/**
+	 * Report a frame rendered outside RenderScene (RenderScene reports Request.FrameIndex itself)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void ReportFrameComplete(int32 FrameIndex, bool bSuccess);
+
+	/**
+	 * Run the capture / spawn / anchor / annotation benchmarks in the current level (see FVantageCVBenchmark)
+	 * @param Suites - Comma separated suite names, empty or "all" = every suite
+	 * @param Iterations - Timed passes per case
+	 * @param OutputPath - Results file (empty = Saved/VantageCV/Benchmarks/)
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString RunBenchmarks(const FString& Suites, int32 Iterations, const FString& OutputPath);
+
+	/**
+	 * Load a generation recipe (research_v2.yaml, level anchors YAML, vehicles.yaml) and render it
+	 * in-process, one frame per engine tick (see FVantageCVRecipeRunner)
+	 * @param NumFrames - Global frame count (<= 0 = the recipe's num_images)
+	 * @return False if a file fails to load or no anchors resolve; the error is logged
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool RunRecipe(const FString& ResearchPath, const FString& AnchorsPath, const FString& VehiclesPath, int32 NumFrames);
+
+	/**
+	 * Running recipe's progress, failures and throughput
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetRecipeStatus();
+
+	/**
+	 * Stop the running recipe after the current frame
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void StopRecipe();
+
+	/**
+	 * Set the structured event level at runtime (see FVantageCVEventLog)
+	 * @param Level - Error, Warning, Info, Verbose or VeryVerbose
+	 * @return False for an unknown level name
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool SetEventLogLevel(const FString& Level);
+
+	/**
+	 * Event log level, file and written / dropped counts; flushes pending events first
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetEventLogStats();
+
+	/**
+	 * Apply a registered lighting preset (time of day, Perfect or configured) and its exposure bias
+	 * @param bSpawnMissingLights - Spawn VantageCV_Sun / VantageCV_SkyLight if the level has none
+	 * @return False if the preset is unknown or the level has no sun or sky light
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	bool ApplyLightingPreset(const FString& PresetName, bool bSpawnMissingLights);
+
+	/**
+	 * Add or replace a lighting preset, e.g. with a pre-captured sky cubemap
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	void RegisterLightingPreset(const FVantageCVLightingPreset& Preset);
+
+	/**
+	 * Preset count, active preset, skipped parameter writes and sky recaptures
+	 * @return JSON object string
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FString GetLightingPresetStats();
+
+	/**
+	 * Apply a full scene description and capture it in one game-thread call:
+	 * actor states, spawns, lighting, all camera views and annotations
+	 * @return Artifacts and annotations for every camera
+	 */
+	UFUNCTION(BlueprintCallable, Category = "VantageCV")
+	FVantageCVSceneResponse RenderScene(const FVantageCVSceneRequest& Request);
+
+private:
+	/** Current play world, falling back to the editor world */
+	UWorld* FindTargetWorld() const;
+
+	AActor* FindActorByName(UWorld* World, const FString& ActorName) const;
+	AActor* SpawnSceneActor(UWorld* World, const FVantageCVSpawnRequest& SpawnRequest);
+
+	/**
+	 * Match the request's spawns against the previous scene's actors (same asset and tag),
+	 * move matches in place, acquire the rest and release leftovers to the pool
+	 */
+	void UpdateSceneSpawns(UWorld* World, const TArray<FVantageCVSpawnRequest>& Spawns,
+		FVantageCVSceneResponse& Response, FSceneDeltaStats& Stats);
+
+	/** Layers explicit sun / sky values over the requested or active preset; only differing values are written */
+	void ApplyLighting(UWorld* World, const FVantageCVLightingState& Lighting);
+
+	/** Spawn assets preloaded at Initialize in addition to the distractor shapes ([/Script/VantageCV.VantageCVSubsystem] in Game.ini) */
+	UPROPERTY(Config)
+	TArray<FString> PreloadAssetPaths;
 };
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * VantageCV - Render Worker Header
+ ******************************************************************************
+ * File: VantageCVWorker.h
+ * Description: Worker identity for multi-instance render farms: deterministic
+ *              frame and seed partitioning, per-worker output namespaces and
+ *              a heartbeat/progress record for an external coordinator
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Process-wide identity of this UE instance within a worker set.
+ *
+ * Worker W of N owns the global frames W, W + N, W + 2N, ... Frame plans are
+ * keyed by global frame (FCounterRandom), and sequential FDeterministicRandom
+ * users take GetFrameSeed(BaseSeed, GlobalFrame), so a frame renders the same
+ * on any worker and the union over all workers equals a single-worker run.
+ *
+ * Command line (all optional; ConfigureWorker overrides at runtime):
+ *   -VantageCVWorker=3 -VantageCVNumWorkers=8 -VantageCVTotalFrames=100000
+ *   -VantageCVHeartbeatDir=F:/farm/status -VantageCVHeartbeatSeconds=5
+ *   -VantageCVResumeFrame=4096, or -VantageCVResume to continue from this
+ *   worker's last heartbeat (durable_resume_frame and failed_frames)
+ *
+ * Progress: frames reported through CompleteFrame advance a watermark. Every
+ * capture submitted while a frame is current is registered with AddPendingWrite
+ * and reports CompleteWrite once its file is written (or fails), so the
+ * heartbeat's durable_resume_frame, the first owned frame not yet on disk, tracks
+ * real write completion. A restarted straggler resumes without duplicating or
+ * skipping frames.
+ */
+class VANTAGECV_API FVantageCVWorker
+{
+public:
+	/** Token in output paths replaced by GetWorkerTag() (e.g. "F:/out/{worker}/frame.png") */
+	static const TCHAR* WorkerToken;
+
+	static FVantageCVWorker& Get();
+	static void Shutdown();
+
+	/**
+	 * Set identity and frame budget, resetting progress
+	 * @param TotalFrames - Global frame count of the whole set (0 = open ended)
+	 * @param ResumeFrame - First global frame still to render (rounded up to an owned frame)
+	 */
+	void Configure(int32 WorkerIndex, int32 NumWorkers, int64 TotalFrames, int64 ResumeFrame = 0);
+
+	int32 GetWorkerIndex() const { return WorkerIndex; }
+	int32 GetNumWorkers() const { return NumWorkers; }
+
+	/** "w03" - used for output namespaces and the heartbeat file */
+	FString GetWorkerTag() const;
+
+	/** Global index of this worker's LocalIndex-th frame */
+	int64 GetGlobalFrame(int64 LocalIndex) const { return WorkerIndex + LocalIndex * NumWorkers; }
+
+	bool OwnsFrame(int64 GlobalFrame) const { return GlobalFrame >= 0 && GlobalFrame % NumWorkers == WorkerIndex; }
+
+	/** Seed for sequential random users (scene resets): BaseSeed + GlobalFrame, so seeds never collide across workers */
+	static int32 GetFrameSeed(int32 BaseSeed, int64 GlobalFrame) { return (int32)((uint32)BaseSeed + (uint32)GlobalFrame); }
+
+	/** Frame being rendered, else the first frame GetPendingFrames hands out (honours the resume watermark) */
+	int64 GetSeedFrame() const;
+
+	/** Path with the {worker} token replaced; paths without it are returned unchanged */
+	FString ResolvePath(const FString& Path) const;
+
+	/**
+	 * Up to MaxFrames owned global frames that are not yet completed: frames that failed in the
+	 * resumed run first, then frames from the resume watermark on.
+	 */
+	TArray<int64> GetPendingFrames(int32 MaxFrames) const;
+
+	/** Mark a global frame as started (reported as CurrentFrame) */
+	void BeginFrame(int64 GlobalFrame);
+
+	/** Mark a global frame as finished; failed frames are listed in the heartbeat for reassignment */
+	void CompleteFrame(int64 GlobalFrame, bool bSuccess);
+
+	/** Frame passed to BeginFrame and not yet completed, or INDEX_NONE */
+	int64 GetCurrentFrame() const;
+
+	/**
+	 * An output of GlobalFrame entered the readback / write pipeline. DurableResumeFrame does not
+	 * pass the frame until every such output has reported CompleteWrite.
+	 */
+	void AddPendingWrite(int64 GlobalFrame);
+
+	/** Any thread. A failed write lists the frame in FailedFrames so it is rendered again. */
+	void CompleteWrite(int64 GlobalFrame, bool bSuccess);
+
+	/** Identity, progress, throughput and queue depth as JSON (same record as the heartbeat file) */
+	FString GetStatusJson() const;
+
+	/** Write the heartbeat file now */
+	void WriteHeartbeat();
+
+	~FVantageCVWorker();
+
+private:
+	FVantageCVWorker();
+
+	/** Read the worker arguments from FCommandLine */
+	void ParseCommandLine();
+
+	/** Restore ResumeFrame and failed frames from this worker's previous heartbeat (-VantageCVResume) */
+	void LoadPreviousHeartbeat();
+
+	bool TickHeartbeat(float DeltaTime);
+
+	/** Advance ResumeLocalIndex past contiguously processed frames */
+	void AdvanceWatermark_Locked();
+
+	/** Advance DurableResumeLocalIndex up to ResumeLocalIndex past frames with no outstanding writes */
+	void AdvanceDurableWatermark_Locked();
+
+	FString GetHeartbeatPath() const;
+
+	FString BuildStatusJson_Locked() const;
+
+	mutable FCriticalSection Lock;
+
+	int32 WorkerIndex = 0;
+	int32 NumWorkers = 1;
+	int64 TotalFrames = 0;
+
+	/** Local index of the first owned frame not yet completed or failed */
+	int64 ResumeLocalIndex = 0;
+
+	/** Same watermark, but only advanced past frames whose every output has been written */
+	int64 DurableResumeLocalIndex = 0;
+
+	/** Outstanding readbacks and writes per frame (local index) */
+	TMap<int64, int32> PendingWrites;
+
+	/** Processed frames above the watermark (local indices) */
+	TSet<int64> ProcessedAhead;
+
+	/** Failed global frames not yet re-rendered; every one is persisted in the heartbeat */
+	TSet<int64> FailedFrames;
+
+	/** Failures carried over by -VantageCVResume that GetPendingFrames hands out again */
+	TSet<int64> RetryFrames;
+
+	int64 CurrentFrame = INDEX_NONE;
+	int64 NumCompleted = 0;
+	int64 NumFailed = 0;
+	int64 NumWriteFailures = 0;
+
+	/** Completion times of the last frames, for throughput */
+	TArray<double> RecentCompletions;
+	double StartSeconds = 0.0;
+	double LastCompletionSeconds = 0.0;
+
+	FString HeartbeatDirectory;
+	float HeartbeatSeconds = 5.0f;
+	uint64 HeartbeatSequence = 0;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	static FVantageCVWorker* Instance;
+};
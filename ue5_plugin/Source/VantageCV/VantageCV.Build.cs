@@ -44,7 +44,8 @@ public class VantageCV : ModuleRules
 				"RemoteControlProtocol",
 				"ImageWriteQueue",
 				"JsonUtilities",
-				"Json"
+				"Json",
+				"VantageCVShaders"
 			}
 			);
 			
@@ -55,7 +56,9 @@ public class VantageCV : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"Slate",
-				"SlateCore"
+				"SlateCore",
+				"Sockets",
+				"Networking"
 			}
 			);
 		
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * VantageCV - Instance Statistics Pass Implementation
+ ******************************************************************************
+ * File: InstanceStatsPass.cpp
+ * Description: Global compute shader binding, RDG setup and readback for the
+ *              instance mask reduction
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "InstanceStatsPass.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "TextureResource.h"
+#include "GlobalShader.h"
+#include "ShaderParameterStruct.h"
+#include "DataDrivenShaderPlatformInfo.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderTargetPool.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "Algo/AllOf.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogInstanceStats, Log, All);
+
+namespace
+{
+	/** Must match NUM_IDS / STATS_STRIDE in InstanceStats.usf */
+	constexpr int32 NumIds = FInstanceStatsPass::MaxInstanceId + 1;
+	constexpr int32 StatsStride = 6;
+	constexpr int32 NumWords = NumIds * StatsStride;
+}
+
+class FInstanceStatsCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FInstanceStatsCS);
+	SHADER_USE_PARAMETER_STRUCT(FInstanceStatsCS, FGlobalShader);
+
+	static constexpr int32 ThreadGroupSize = 16;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, MaskTexture)
+		SHADER_PARAMETER(FIntPoint, MaskSize)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, OutStats)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+	}
+};
+
+IMPLEMENT_GLOBAL_SHADER(FInstanceStatsCS, "/Plugin/VantageCV/Private/InstanceStats.usf", "MainCS", SF_Compute);
+
+FInstanceStatsReadback::FInstanceStatsReadback() = default;
+FInstanceStatsReadback::~FInstanceStatsReadback() = default;
+
+bool FInstanceStatsPass::Compute(UTextureRenderTarget2D* MaskTarget, TArray<FInstancePixelStats>& OutStats)
+{
+	const FInstanceStatsRequest Request = Enqueue(MaskTarget);
+	Resolve(MakeArrayView(&Request, 1));
+	return GetStats(Request, OutStats);
+}
+
+FInstanceStatsRequest FInstanceStatsPass::Enqueue(UTextureRenderTarget2D* MaskTarget)
+{
+	check(IsInGameThread());
+
+	FTextureRenderTargetResource* Resource = MaskTarget ? MaskTarget->GameThread_GetRenderTargetResource() : nullptr;
+	if (!Resource)
+	{
+		UE_LOG(LogInstanceStats, Error, TEXT("Instance stats: mask target has no render resource"));
+		return nullptr;
+	}
+
+	FInstanceStatsRequest Request = MakeShared<FInstanceStatsReadback, ESPMode::ThreadSafe>();
+	Request->MaskSize = FIntPoint(MaskTarget->SizeX, MaskTarget->SizeY);
+	Request->Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("VantageCV.InstanceStatsReadback"));
+
+	// Enqueued after the mask capture, so it reads the freshly rendered stencil IDs
+	ENQUEUE_RENDER_COMMAND(VantageCVInstanceStats)(
+		[Resource, Request](FRHICommandListImmediate& RHICmdList)
+		{
+			FRDGBuilder GraphBuilder(RHICmdList);
+
+			FRDGTextureRef MaskTexture = GraphBuilder.RegisterExternalTexture(
+				CreateRenderTarget(Resource->GetRenderTargetTexture(), TEXT("VantageCV.InstanceMask")));
+
+			FRDGBufferRef StatsBuffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), NumWords), TEXT("VantageCV.InstanceStats"));
+			FRDGBufferUAVRef StatsUAV = GraphBuilder.CreateUAV(StatsBuffer);
+			AddClearUAVPass(GraphBuilder, StatsUAV, 0u);
+
+			FInstanceStatsCS::FParameters* Parameters = GraphBuilder.AllocParameters<FInstanceStatsCS::FParameters>();
+			Parameters->MaskTexture = MaskTexture;
+			Parameters->MaskSize = Request->MaskSize;
+			Parameters->OutStats = StatsUAV;
+
+			TShaderMapRef<FInstanceStatsCS> Shader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+			FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("VantageCV.InstanceStats %dx%d", Request->MaskSize.X, Request->MaskSize.Y),
+				Shader, Parameters, FComputeShaderUtils::GetGroupCount(Request->MaskSize, FInstanceStatsCS::ThreadGroupSize));
+
+			AddEnqueueCopyPass(GraphBuilder, Request->Readback.Get(), StatsBuffer, NumWords * sizeof(uint32));
+			GraphBuilder.Execute();
+		});
+	return Request;
+}
+
+void FInstanceStatsPass::Resolve(TConstArrayView<FInstanceStatsRequest> Requests)
+{
+	check(IsInGameThread());
+
+	TArray<FInstanceStatsRequest> Pending;
+	for (const FInstanceStatsRequest& Request : Requests)
+	{
+		if (Request.IsValid() && !Request->bReadBack)
+		{
+			Pending.Add(Request);
+		}
+	}
+	if (Pending.Num() == 0)
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(VantageCVResolveInstanceStats)(
+		[Pending](FRHICommandListImmediate& RHICmdList)
+		{
+			// Callers resolve after their own readback flush, so the copies are normally done already
+			const bool bAllReady = Algo::AllOf(Pending, [](const FInstanceStatsRequest& Request) { return Request->Readback->IsReady(); });
+			if (!bAllReady)
+			{
+				RHICmdList.BlockUntilGPUIdle();
+			}
+
+			for (const FInstanceStatsRequest& Request : Pending)
+			{
+				if (const void* Data = Request->Readback->Lock(NumWords * sizeof(uint32)))
+				{
+					Request->Words.SetNumUninitialized(NumWords);
+					FMemory::Memcpy(Request->Words.GetData(), Data, NumWords * sizeof(uint32));
+					Request->Readback->Unlock();
+					Request->bReadBack = true;
+				}
+			}
+		});
+	FlushRenderingCommands();
+}
+
+bool FInstanceStatsPass::GetStats(const FInstanceStatsRequest& Request, TArray<FInstancePixelStats>& OutStats)
+{
+	OutStats.Reset();
+	if (!Request.IsValid() || !Request->bReadBack)
+	{
+		UE_LOG(LogInstanceStats, Error, TEXT("Instance stats: GPU readback failed"));
+		return false;
+	}
+
+	const TArray<uint32>& Words = Request->Words;
+	const FIntPoint MaskSize = Request->MaskSize;
+	for (int32 Id = 1; Id < NumIds; ++Id)
+	{
+		const uint32* Stats = &Words[Id * StatsStride];
+		if (Stats[4] == 0 && Stats[5] == 0)
+		{
+			continue;
+		}
+
+		FInstancePixelStats& Instance = OutStats.AddDefaulted_GetRef();
+		Instance.InstanceId = Id;
+		Instance.VisiblePixels = (int32)Stats[4];
+		Instance.FootprintPixels = (int32)Stats[5];
+
+		if (Instance.VisiblePixels > 0)
+		{
+			Instance.Min = FIntPoint((int32)~Stats[0], (int32)~Stats[1]);
+			Instance.Max = FIntPoint((int32)Stats[2] - 1, (int32)Stats[3] - 1);
+			Instance.bTruncated = Instance.Min.X == 0 || Instance.Min.Y == 0
+				|| Instance.Max.X == MaskSize.X - 1 || Instance.Max.Y == MaskSize.Y - 1;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,26 @@
+/******************************************************************************
+ * VantageCV - Shaders Module Implementation
+ ******************************************************************************
+ * File: VantageCVShadersModule.cpp
+ * Description: Shader source directory mapping for /Plugin/VantageCV
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#include "VantageCVShadersModule.h"
+#include "Interfaces/IPluginManager.h"
+#include "ShaderCore.h"
+#include "Misc/Paths.h"
+
+void FVantageCVShadersModule::StartupModule()
+{
+	// Global shaders (instance stats pass) live in the plugin's Shaders directory
+	const FString ShaderDir = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("VantageCV"))->GetBaseDir(), TEXT("Shaders"));
+	AddShaderSourceDirectoryMapping(TEXT("/Plugin/VantageCV"), ShaderDir);
+}
+
+void FVantageCVShadersModule::ShutdownModule()
+{
+}
+
+IMPLEMENT_MODULE(FVantageCVShadersModule, VantageCVShaders)
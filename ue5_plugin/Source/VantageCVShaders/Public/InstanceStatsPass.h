@@ -0,0 +1,101 @@
+/******************************************************************************
+ * VantageCV - Instance Statistics Pass Header
+ ******************************************************************************
+ * File: InstanceStatsPass.h
+ * Description: GPU reduction over the stencil instance mask producing tight
+ *              per-instance pixel boxes, visible pixel counts and truncation
+ *              flags with a single small readback
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTextureRenderTarget2D;
+class FRHIGPUBufferReadback;
+
+/**
+ * Pixel statistics for one stencil instance in a mask.
+ */
+struct FInstancePixelStats
+{
+	/** Stencil ID (1-255), see FSegmentationStencil in the VantageCV module */
+	int32 InstanceId = 0;
+
+	/** Inclusive pixel extents of the visible pixels; only meaningful when VisiblePixels > 0 */
+	FIntPoint Min = FIntPoint::ZeroValue;
+	FIntPoint Max = FIntPoint::ZeroValue;
+
+	/** Pixels where the instance is the front-most surface */
+	int32 VisiblePixels = 0;
+
+	/** Pixels the instance covers ignoring non-annotated occluders (walls, trees, terrain) */
+	int32 FootprintPixels = 0;
+
+	/** Visible pixels touch an image border */
+	bool bTruncated = false;
+
+	/** Visible / footprint, 0-1. Occlusion by other annotated instances is not counted. */
+	float GetVisibleFraction() const
+	{
+		return FootprintPixels > 0 ? FMath::Min(1.0f, (float)VisiblePixels / (float)FootprintPixels) : 0.0f;
+	}
+};
+
+/**
+ * One reduction enqueued behind a mask render, read back later by FInstanceStatsPass::Resolve
+ */
+struct VANTAGECVSHADERS_API FInstanceStatsReadback
+{
+	FIntPoint MaskSize = FIntPoint::ZeroValue;
+	TUniquePtr<FRHIGPUBufferReadback> Readback;
+
+	/** Raw counters; valid once bReadBack is set by Resolve */
+	TArray<uint32> Words;
+	bool bReadBack = false;
+
+	FInstanceStatsReadback();
+	~FInstanceStatsReadback();
+};
+
+using FInstanceStatsRequest = TSharedPtr<FInstanceStatsReadback, ESPMode::ThreadSafe>;
+
+/**
+ * Runs the InstanceStats compute shader over a mask render target.
+ *
+ * Expects the mask contract of ADataCapture::SegmentationMaterial: R = visible
+ * stencil ID / 255, G = footprint stencil ID / 255. The whole reduction happens
+ * in group shared memory on the GPU; only 256 x 6 counters are read back.
+ */
+class VANTAGECVSHADERS_API FInstanceStatsPass
+{
+public:
+	/** Largest stencil ID the shader counts (NUM_IDS - 1 in InstanceStats.usf) */
+	static constexpr int32 MaxInstanceId = 255;
+
+	/**
+	 * Reduce the mask and block until the counters are back on the CPU. Game thread only.
+	 * @param MaskTarget - Rendered instance mask
+	 * @param OutStats - One entry per instance with any visible or footprint pixels, sorted by ID
+	 * @return False if the target has no resource or the readback failed
+	 */
+	static bool Compute(UTextureRenderTarget2D* MaskTarget, TArray<FInstancePixelStats>& OutStats);
+
+	/**
+	 * Enqueue the reduction behind whatever was last rendered into the mask, without waiting. Game thread only.
+	 * The target may be rendered again afterwards; render commands run in order.
+	 * @return Null if the target has no resource
+	 */
+	static FInstanceStatsRequest Enqueue(UTextureRenderTarget2D* MaskTarget);
+
+	/** Copy every enqueued reduction to the CPU with one render flush and at most one GPU wait. Game thread only. */
+	static void Resolve(TConstArrayView<FInstanceStatsRequest> Requests);
+
+	/**
+	 * Decode a resolved request
+	 * @return False if the request is null or its readback failed
+	 */
+	static bool GetStats(const FInstanceStatsRequest& Request, TArray<FInstancePixelStats>& OutStats);
+};
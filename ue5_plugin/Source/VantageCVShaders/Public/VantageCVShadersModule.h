@@ -0,0 +1,26 @@
+/******************************************************************************
+ * VantageCV - Shaders Module Header
+ ******************************************************************************
+ * File: VantageCVShadersModule.h
+ * Description: Module interface for the VantageCV global shaders; maps the
+ *              plugin's Shaders directory before the shader types register
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * VantageCV shaders module (LoadingPhase PostConfigInit)
+ * Holds only global shaders and their passes, so the gameplay module can load at Default
+ */
+class FVantageCVShadersModule : public IModuleInterface
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
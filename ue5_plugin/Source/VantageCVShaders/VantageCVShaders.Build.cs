@@ -0,0 +1,37 @@
+/******************************************************************************
+ * VantageCV - Shaders Module Build Configuration
+ ******************************************************************************
+ * File: VantageCVShaders.Build.cs
+ * Description: Build configuration for the VantageCV global shader module,
+ *              loaded at PostConfigInit so its shaders register in time
+ * Author: Evan Petersen
+ * Date: October 2026
+ *****************************************************************************/
+
+using UnrealBuildTool;
+
+public class VantageCVShaders : ModuleRules
+{
+	public VantageCVShaders(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"RenderCore",
+				"RHI"
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Projects"
+			}
+			);
+	}
+}
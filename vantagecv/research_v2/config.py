@@ -153,6 +153,10 @@ class VehicleSpawnerConfig:
         "StaticMeshActor_8": 0.687,
         "StaticMeshActor_9": 1.225,
     })
+    
+    # vehicles.yaml whose pool.prewarm block (asset path -> count) is sent to
+    # UE5 before the first frame so early scenes reuse parked actors
+    pool_config_path: str = "configs/vehicles.yaml"
 
 
 @dataclass 
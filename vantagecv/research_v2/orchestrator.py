@@ -25,6 +25,8 @@ from typing import Optional, Any
 import json
 import time
 
+import yaml
+
 from .logging_utils import ResearchLogger, PipelineLogger
 from .config import ResearchConfig
 from .scene_controller import SceneController
@@ -587,6 +589,10 @@ class DatasetOrchestrator:
             )
             return self._stats
         
+        # Park pooled actors before the first scene needs them
+        if self.ue5:
+            self._prewarm_actor_pool()
+        
         # Initialize scene
         self._scene.initialize(seed=self.config.random_seed)
         self._spawner.set_seed(self.config.random_seed)
@@ -626,6 +632,27 @@ class DatasetOrchestrator:
         
         return self._stats
     
+    def _prewarm_actor_pool(self) -> None:
+        """Send the pool.prewarm block of vehicles.yaml to the UE5 actor pool."""
+        pool_path = Path(self.config.vehicles.pool_config_path)
+        if not pool_path.exists():
+            self.logger.warning("Actor pool config not found", path=str(pool_path))
+            return
+        
+        with open(pool_path, "r") as f:
+            data = yaml.safe_load(f) or {}
+        prewarm = (data.get("pool") or {}).get("prewarm") or {}
+        if not prewarm:
+            return
+        
+        spawned = self.ue5.prewarm_actor_pool(prewarm)
+        self.logger.info(
+            "Actor pool prewarmed",
+            path=str(pool_path),
+            assets=len(prewarm),
+            spawned=spawned,
+        )
+    
     def _log_progress(
         self,
         frames_attempted: int,
@@ -0,0 +1,194 @@
+#==============================================================================
+# VantageCV - Capture Shard Reader
+#==============================================================================
+# File: shard_reader.py
+# Description: Random-access reader for the tar shards written by the UE5
+#              plugin (DataCapture.StartShardWriter). The sidecar .idx is
+#              memory-mapped, so opening a shard is O(1) and members are
+#              sliced straight out of the mapped tar.
+# Author: Evan Petersen
+# Date: October 2026
+#==============================================================================
+
+import bisect
+import glob
+import mmap
+import os
+import struct
+import logging
+from typing import Dict, Iterator, List, Optional, Tuple
+
+import numpy as np
+
+from .stream_client import StreamObject, unpack_annotations
+
+logger = logging.getLogger(__name__)
+
+
+def _split_member_name(name: str) -> Tuple[str, str]:
+    """WebDataset split: the key ends at the first dot of the file name ("a/0001.depth.exr" -> "a/0001", "depth.exr")."""
+    directory, _, file_name = name.rpartition("/")
+    stem, _, extension = file_name.partition(".")
+    return (f"{directory}/{stem}" if directory else stem), extension
+
+# Must match FCaptureShardIndexHeader / FCaptureShardIndexEntry in CaptureShardWriter.h
+_INDEX_HEADER = struct.Struct("<IHHHHI")
+_INDEX_MAGIC = 0x49564356
+_INDEX_VERSION = 1
+_TOMBSTONE_FLAG = 1
+
+INDEX_DTYPE = np.dtype([
+    ("offset", "<u8"),
+    ("size", "<u8"),
+    ("sample", "<u4"),
+    ("flags", "<u4"),
+    ("name", "S104"),
+])
+
+
+class ShardReader:
+    """
+    One tar shard plus its sidecar index.
+
+    Tars are plain WebDataset shards and can also be read by `webdataset` or
+    `tarfile`; this reader only adds O(1) random access.
+
+    Usage:
+        with ShardReader("F:/dataset/train-000000.tar") as shard:
+            sample = shard.sample(10)          # {"qoi": memoryview, "ann": memoryview}
+            objects = shard.annotations(10)
+    """
+
+    def __init__(self, tar_path: str, index_path: Optional[str] = None):
+        self.tar_path = tar_path
+        self.index_path = index_path or os.path.splitext(tar_path)[0] + ".idx"
+
+        with open(self.index_path, "rb") as index_file:
+            magic, version, header_bytes, entry_bytes, _, _ = _INDEX_HEADER.unpack(
+                index_file.read(_INDEX_HEADER.size))
+        if magic != _INDEX_MAGIC:
+            raise ValueError(f"Bad shard index magic 0x{magic:08x}: {self.index_path}")
+        if version != _INDEX_VERSION or entry_bytes != INDEX_DTYPE.itemsize:
+            raise ValueError(f"Unsupported shard index version {version} ({entry_bytes} byte entries)")
+
+        # A shard still being written may end in a partial entry; only whole entries count
+        num_entries = (os.path.getsize(self.index_path) - header_bytes) // entry_bytes
+        self.entries = (np.memmap(self.index_path, dtype=INDEX_DTYPE, mode="r",
+                                  offset=header_bytes, shape=(num_entries,))
+                        if num_entries > 0 else np.zeros(0, dtype=INDEX_DTYPE))
+
+        # Samples closed by a tombstone entry were only partly written and are skipped
+        samples = self.entries["sample"]
+        dead = np.unique(samples[(self.entries["flags"] & _TOMBSTONE_FLAG) != 0])
+        self._samples = np.setdiff1d(np.unique(samples), dead)
+
+        # mmap cannot map an empty file (a shard that was just opened); it reads as no samples
+        self._file = open(tar_path, "rb")
+        self._map = None
+        if os.fstat(self._file.fileno()).st_size > 0:
+            self._map = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        else:
+            self.entries = np.zeros(0, dtype=INDEX_DTYPE)
+            self._samples = np.zeros(0, dtype=np.uint32)
+
+    def close(self) -> None:
+        if self._map is not None:
+            self._map.close()
+            self._map = None
+        if self._file is not None:
+            self._file.close()
+            self._file = None
+
+    def __enter__(self) -> "ShardReader":
+        return self
+
+    def __exit__(self, *args) -> None:
+        self.close()
+
+    def __len__(self) -> int:
+        """Number of complete samples."""
+        return len(self._samples)
+
+    @property
+    def num_members(self) -> int:
+        return len(self.entries)
+
+    def member(self, index: int) -> Tuple[str, memoryview]:
+        """Name and data of one tar member, in tar order."""
+        entry = self.entries[index]
+        offset, size = int(entry["offset"]), int(entry["size"])
+        return entry["name"].decode("utf-8"), memoryview(self._map)[offset:offset + size]
+
+    def _member_range(self, index: int) -> Tuple[int, int]:
+        """Index entries [first, last) of the index-th complete sample."""
+        if index < 0 or index >= len(self._samples):
+            raise IndexError(f"Sample {index} not in {self.tar_path}")
+        sample_index = self._samples[index]
+        samples = self.entries["sample"]
+        return (int(np.searchsorted(samples, sample_index, side="left")),
+                int(np.searchsorted(samples, sample_index, side="right")))
+
+    def sample(self, index: int) -> Dict[str, memoryview]:
+        """Members of one sample keyed by extension (e.g. "qoi", "ann", "depth.exr")."""
+        first, last = self._member_range(index)
+
+        members = {}
+        for member_index in range(first, last):
+            name, data = self.member(member_index)
+            members[_split_member_name(name)[1]] = data
+        return members
+
+    def key(self, index: int) -> str:
+        """Sample key (member name without extension)."""
+        first, _ = self._member_range(index)
+        return _split_member_name(self.entries[first]["name"].decode("utf-8"))[0]
+
+    def annotations(self, index: int) -> List[StreamObject]:
+        """Decoded packed annotation record of a sample (empty if none was written)."""
+        record = self.sample(index).get("ann")
+        return unpack_annotations(bytes(record)) if record is not None else []
+
+    def samples(self) -> Iterator[Dict[str, memoryview]]:
+        for index in range(len(self)):
+            yield self.sample(index)
+
+
+class ShardDataset:
+    """
+    Every shard of one set (<prefix>-NNNNNN.tar) as a single indexable dataset.
+    """
+
+    def __init__(self, directory: str, prefix: str = "shard"):
+        paths = sorted(glob.glob(os.path.join(directory, f"{prefix}-[0-9]*.tar")))
+        self.shards = [ShardReader(path) for path in paths]
+        self._starts: List[int] = []
+        total = 0
+        for shard in self.shards:
+            self._starts.append(total)
+            total += len(shard)
+        self._total = total
+        logger.info(f"Opened {len(self.shards)} shards with {total} samples from {directory}")
+
+    def close(self) -> None:
+        for shard in self.shards:
+            shard.close()
+
+    def __enter__(self) -> "ShardDataset":
+        return self
+
+    def __exit__(self, *args) -> None:
+        self.close()
+
+    def __len__(self) -> int:
+        return self._total
+
+    def locate(self, index: int) -> Tuple[ShardReader, int]:
+        """Shard and local sample index of a global sample index."""
+        if index < 0 or index >= self._total:
+            raise IndexError(index)
+        shard_index = bisect.bisect_right(self._starts, index) - 1
+        return self.shards[shard_index], index - self._starts[shard_index]
+
+    def __getitem__(self, index: int) -> Dict[str, memoryview]:
+        shard, local_index = self.locate(index)
+        return shard.sample(local_index)
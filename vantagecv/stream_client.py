@@ -0,0 +1,157 @@
+#==============================================================================
+# VantageCV - Capture Stream Client
+#==============================================================================
+# File: stream_client.py
+# Description: Reader for the binary capture stream published by the UE5
+#              plugin (DataCapture.StartStreaming). Yields raw frames and
+#              annotations without touching disk.
+# Author: Evan Petersen
+# Date: October 2026
+#==============================================================================
+
+import socket
+import struct
+import logging
+from dataclasses import dataclass, field
+from typing import Iterator, List, Optional
+
+import numpy as np
+
+logger = logging.getLogger(__name__)
+
+# Must match FCaptureStreamHeader in CaptureStreamSink.h (packed, little endian)
+_HEADER = struct.Struct("<IHHIiIIBBHQI")
+_MAGIC = 0x46564356
+_VERSION = 1
+
+_OBJECT = struct.Struct("<i4f3f3fH")
+
+
+@dataclass
+class StreamObject:
+    """One annotated object from the packed annotation record."""
+    instance_id: int
+    bbox: tuple          # (x_min, y_min, x_max, y_max) in pixels
+    location: tuple      # (x, y, z) world cm
+    rotation: tuple      # (pitch, yaw, roll) degrees
+    class_name: str
+
+
+@dataclass
+class StreamFrame:
+    """A single streamed frame."""
+    sequence: int
+    ticket: int
+    name: str
+    image: np.ndarray    # H x W x 4, BGRA uint8
+    objects: List[StreamObject] = field(default_factory=list)
+
+
+def unpack_annotations(data: bytes) -> List[StreamObject]:
+    """Decode the annotation record written by FCaptureStreamSink::PackAnnotations."""
+    if len(data) < 4:
+        return []
+    (count,) = struct.unpack_from("<I", data, 0)
+    offset = 4
+    objects = []
+    for _ in range(count):
+        values = _OBJECT.unpack_from(data, offset)
+        offset += _OBJECT.size
+        class_bytes = values[-1]
+        class_name = data[offset:offset + class_bytes].decode("utf-8")
+        offset += class_bytes
+        objects.append(StreamObject(
+            instance_id=values[0],
+            bbox=tuple(values[1:5]),
+            location=tuple(values[5:8]),
+            rotation=tuple(values[8:11]),
+            class_name=class_name,
+        ))
+    return objects
+
+
+class CaptureStreamClient:
+    """
+    TCP consumer for the plugin's capture stream.
+
+    Usage:
+        bridge.call_function(bridge.data_capture_path, "StartStreaming",
+                             {"Port": 30020, "AnnotationTags": ["Vehicle"]})
+        client = CaptureStreamClient(port=30020)
+        client.connect()
+        bridge.capture_frame_async("stream://frame_0001", 1280, 720)
+        for frame in client.frames():
+            ...
+    """
+
+    def __init__(self, host: str = "localhost", port: int = 30020, timeout: Optional[float] = None):
+        self.host = host
+        self.port = port
+        self.timeout = timeout
+        self._sock: Optional[socket.socket] = None
+
+    def connect(self) -> None:
+        """Connect to the plugin's stream socket."""
+        self._sock = socket.create_connection((self.host, self.port), timeout=self.timeout)
+        self._sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 8 * 1024 * 1024)
+        logger.info(f"Connected to capture stream at {self.host}:{self.port}")
+
+    def close(self) -> None:
+        if self._sock:
+            self._sock.close()
+            self._sock = None
+
+    def __enter__(self) -> "CaptureStreamClient":
+        self.connect()
+        return self
+
+    def __exit__(self, *args) -> None:
+        self.close()
+
+    def _recv_exact(self, num_bytes: int) -> bytearray:
+        buffer = bytearray(num_bytes)
+        view = memoryview(buffer)
+        received = 0
+        while received < num_bytes:
+            count = self._sock.recv_into(view[received:], num_bytes - received)
+            if count == 0:
+                raise ConnectionError("Capture stream closed by UE5")
+            received += count
+        return buffer
+
+    def read_frame(self) -> StreamFrame:
+        """Block until the next frame arrives."""
+        if not self._sock:
+            raise RuntimeError("CaptureStreamClient is not connected")
+
+        (magic, version, header_bytes, sequence, ticket, width, height,
+         layout, _reserved, name_bytes, image_bytes, annotation_bytes) = _HEADER.unpack(
+            self._recv_exact(_HEADER.size))
+
+        if magic != _MAGIC:
+            raise ValueError(f"Bad stream magic 0x{magic:08x}")
+        if version != _VERSION:
+            raise ValueError(f"Unsupported stream version {version}")
+        if header_bytes > _HEADER.size:
+            self._recv_exact(header_bytes - _HEADER.size)
+
+        name = bytes(self._recv_exact(name_bytes)).decode("utf-8") if name_bytes else ""
+        pixels = self._recv_exact(image_bytes)
+        annotations = bytes(self._recv_exact(annotation_bytes)) if annotation_bytes else b""
+
+        image = np.frombuffer(pixels, dtype=np.uint8).reshape(height, width, 4)
+        return StreamFrame(
+            sequence=sequence,
+            ticket=ticket,
+            name=name,
+            image=image,
+            objects=unpack_annotations(annotations),
+        )
+
+    def frames(self) -> Iterator[StreamFrame]:
+        """Yield frames until the connection closes."""
+        while True:
+            try:
+                yield self.read_frame()
+            except ConnectionError:
+                return
@@ -223,6 +223,964 @@ class UE5Bridge:
             logger.error(f"Frame capture failed: {e}")
             return False
     
+    def capture_frame_async(self, output_path: str, width: int = 1920, height: int = 1080) -> int:
+        """
+        Queue a frame capture without waiting for the GPU readback.
+        
+        Args:
+            output_path: Full path where image should be saved
+            width: Image width in pixels
+            height: Image height in pixels
+            
+        Returns:
+            Capture ticket, or -1 if the capture could not be queued
+        """
+        try:
+            result = self.call_function(
+                self.data_capture_path,
+                "CaptureFrameAsync",
+                {
+                    "OutputPath": output_path,
+                    "Width": width,
+                    "Height": height
+                }
+            )
+            return int(result.get("ReturnValue", -1))
+            
+        except Exception as e:
+            logger.error(f"Async frame capture failed: {e}")
+            return -1
+    
+    def capture_views(self, views: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+        """
+        Capture several viewpoints of the current scene in one call.
+        
+        Args:
+            views: One dict per view with keys "location" (x, y, z), "rotation"
+                   (pitch, yaw, roll), "fov", "output_path", "width", "height"
+                   and optionally "aov_output_path" (AOV base, see set_aovs)
+            
+        Returns:
+            Per-view results (ViewIndex, bSuccess, bRejected, Visibility, ImagePath, bAOVSuccess,
+            AOVPaths, Location, Rotation, FOV). With a visibility gate set, rejected views were never rendered.
+        """
+        payload = []
+        for view in views:
+            x, y, z = view["location"]
+            pitch, yaw, roll = view.get("rotation", (0.0, 0.0, 0.0))
+            payload.append({
+                "Location": {"X": x, "Y": y, "Z": z},
+                "Rotation": {"Pitch": pitch, "Yaw": yaw, "Roll": roll},
+                "FOV": view.get("fov", 90.0),
+                "OutputPath": view["output_path"],
+                "AOVOutputPath": view.get("aov_output_path", ""),
+                "Width": view.get("width", 1920),
+                "Height": view.get("height", 1080),
+            })
+        
+        try:
+            result = self.call_function(self.data_capture_path, "CaptureViews", {"Views": payload})
+            return result.get("ReturnValue", [])
+        except Exception as e:
+            logger.error(f"Batched view capture failed: {e}")
+            return []
+    
+    def set_visibility_gate(self, min_visible_objects: int, target_tags: List[str] = None,
+                            min_in_frame_fraction: float = 0.5, min_box_pixels: float = 400.0,
+                            occlusion_test: bool = False, retarget_on_fail: bool = True) -> None:
+        """
+        Reject views before rendering unless enough targets are visible from the pose.
+        Applied by capture_views and render_scene; min_visible_objects=0 disables the gate.
+        
+        Args:
+            min_visible_objects: Targets that must pass
+            target_tags: Actor tags that count as targets (default ["Vehicle"])
+            min_in_frame_fraction: Share of a target's projected box inside the image
+            min_box_pixels: Smallest on-screen box area
+            occlusion_test: Also require line of sight (a few traces per target)
+            retarget_on_fail: Re-aim at the target centroid once before rejecting
+        """
+        try:
+            self.call_function(self.data_capture_path, "SetVisibilityGate", {
+                "Criteria": {
+                    "TargetTags": target_tags or ["Vehicle"],
+                    "MinVisibleObjects": min_visible_objects,
+                    "MinInFrameFraction": min_in_frame_fraction,
+                    "MinBoxPixels": min_box_pixels,
+                    "bOcclusionTest": occlusion_test,
+                    "bRetargetOnFail": retarget_on_fail
+                }
+            })
+        except Exception as e:
+            logger.error(f"Set visibility gate failed: {e}")
+    
+    def set_streaming_gate(self, enabled: bool = True, timeout_seconds: float = 2.0,
+                           prestream_tags: List[str] = None, hint_duration_seconds: float = 1.0,
+                           boost_factor: float = 1.0, override_other_views: bool = True,
+                           max_pending_resources: int = 0) -> None:
+        """
+        Wait for texture and mesh streaming before every capture, bounded by a timeout,
+        instead of sleeping or re-rendering. Applied by capture_frame, capture_views and
+        render_scene; the wait is reported as the Streaming telemetry stage.
+        
+        Args:
+            enabled: Turn the gate on or off
+            timeout_seconds: Longest wait before capturing with partial residency
+            prestream_tags: Visible actors whose textures are prestreamed (default ["Vehicle"])
+            hint_duration_seconds: How long view and actor hints keep raising priority
+            boost_factor: Streaming distance boost of the upcoming views
+            override_other_views: Upcoming views replace the viewports as streaming view points
+            max_pending_resources: Resources still streaming that count as settled
+        """
+        try:
+            self.call_function(self.data_capture_path, "SetStreamingGate", {
+                "Gate": {
+                    "bEnabled": enabled,
+                    "PrestreamTags": prestream_tags or ["Vehicle"],
+                    "TimeoutSeconds": timeout_seconds,
+                    "HintDurationSeconds": hint_duration_seconds,
+                    "BoostFactor": boost_factor,
+                    "bOverrideOtherViews": override_other_views,
+                    "MaxPendingResources": max_pending_resources
+                }
+            })
+        except Exception as e:
+            logger.error(f"Set streaming gate failed: {e}")
+    
+    def wait_for_streaming(self, views: List[Dict[str, Any]]) -> Dict[str, Any]:
+        """
+        Prefetch streaming for upcoming views and wait until it settles (set_streaming_gate
+        supplies the timeout and prestream tags).
+        
+        Args:
+            views: FCaptureViewRequest dicts (Location, Rotation, FOV, Width, Height)
+            
+        Returns:
+            Report with bSettled, WaitMs, NumPendingAtStart, NumPendingAtEnd, NumPrestreamedActors
+        """
+        try:
+            result = self.call_function(self.data_capture_path, "WaitForStreaming", {"Views": views})
+            return result.get("ReturnValue", {})
+        except Exception as e:
+            logger.error(f"Wait for streaming failed: {e}")
+            return {}
+    
+    def start_sequence(self, output_directory: str, num_frames: int, lanes: List[Dict[str, Any]],
+                       frame_rate: float = 30.0, width: int = 1920, height: int = 1080,
+                       target_tags: List[str] = None, min_speed: float = 800.0,
+                       max_speed: float = 1400.0, seed: int = 42, wrap_lanes: bool = True,
+                       write_masks: bool = False) -> bool:
+        """
+        Capture a continuous clip in-engine: lane vehicles move with a fixed
+        timestep and every frame is queued through the async readback ring.
+        Poll get_sequence_status() until running is False.
+        
+        Args:
+            output_directory: Receives images/, masks/ and annotations/ (sequence.json, gt.txt)
+            num_frames: Frames in the clip
+            lanes: Dicts with "lane_id", "start", "end" (anchor actor names) and
+                   optionally "width" (cm, default 350)
+            frame_rate: Fixed timestep is 1 / frame_rate
+            width: Image width in pixels
+            height: Image height in pixels
+            target_tags: Annotated actor tags (default ["Vehicle"])
+            min_speed: Slowest vehicle speed (cm/s)
+            max_speed: Fastest vehicle speed (cm/s)
+            seed: Seed for the per-vehicle speeds
+            wrap_lanes: Re-enter at the lane start instead of stopping at its end
+            write_masks: Also capture instance masks (needs SegmentationMaterial)
+            
+        Returns:
+            True if the sequence started
+        """
+        try:
+            result = self.call_function(self.data_capture_path, "StartSequence", {
+                "Settings": {
+                    "NumFrames": num_frames,
+                    "FrameRate": frame_rate,
+                    "Width": width,
+                    "Height": height,
+                    "OutputDirectory": output_directory,
+                    "TargetTags": target_tags or ["Vehicle"],
+                    "Lanes": [{
+                        "LaneId": lane["lane_id"],
+                        "StartAnchorName": lane["start"],
+                        "EndAnchorName": lane["end"],
+                        "LaneWidth": lane.get("width", 350.0)
+                    } for lane in lanes],
+                    "MinSpeed": min_speed,
+                    "MaxSpeed": max_speed,
+                    "Seed": seed,
+                    "bWrapLanes": wrap_lanes,
+                    "bWriteMasks": write_masks
+                }
+            })
+            return bool(result.get("ReturnValue", False))
+        except Exception as e:
+            logger.error(f"Sequence start failed: {e}")
+            return False
+    
+    def get_sequence_status(self) -> Dict[str, Any]:
+        """
+        Progress of the current or last sequence.
+        
+        Returns:
+            Status dictionary (running, frame, num_frames, frames_queued, frames_failed,
+            targets, movers, frames_per_second, output_directory)
+        """
+        try:
+            result = self.call_function(self.data_capture_path, "GetSequenceStatus")
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Sequence status query failed: {e}")
+            return {}
+    
+    def stop_sequence(self) -> None:
+        """End the running sequence early; captured frames and annotations are kept."""
+        try:
+            self.call_function(self.data_capture_path, "StopSequence")
+        except Exception as e:
+            logger.error(f"Sequence stop failed: {e}")
+    
+    def evaluate_view_visibility(self, view: Dict[str, Any], criteria: Dict[str, Any]) -> Dict[str, Any]:
+        """
+        Test a camera pose without rendering it.
+        
+        Args:
+            view: Same keys as a capture_views entry (output_path not needed)
+            criteria: FCaptureVisibilityCriteria fields, e.g. {"MinVisibleObjects": 1}
+            
+        Returns:
+            FCaptureVisibilityReport (bPassed, NumTargets, NumInFrustum, NumVisible,
+            NumTruncated, NumOccluded, bRetargeted, Rotation)
+        """
+        x, y, z = view["location"]
+        pitch, yaw, roll = view.get("rotation", (0.0, 0.0, 0.0))
+        try:
+            result = self.call_function(self.data_capture_path, "EvaluateViewVisibility", {
+                "View": {
+                    "Location": {"X": x, "Y": y, "Z": z},
+                    "Rotation": {"Pitch": pitch, "Yaw": yaw, "Roll": roll},
+                    "FOV": view.get("fov", 90.0),
+                    "Width": view.get("width", 1920),
+                    "Height": view.get("height", 1080),
+                },
+                "Criteria": criteria
+            })
+            return result.get("ReturnValue", {})
+        except Exception as e:
+            logger.error(f"View visibility evaluation failed: {e}")
+            return {"bPassed": False}
+    
+    def set_output_encoding(self, image_format: str = "PNG", jpeg_quality: int = 90,
+                            png_compression_level: int = 100, max_strips: int = 0) -> bool:
+        """
+        Select the file format of RGB captures.
+        
+        Args:
+            image_format: "PNG", "PNGFast", "QOI", "JPEG", "EXR" or "Raw"
+            jpeg_quality: JPEG quality 1-100
+            png_compression_level: Compression level for "PNG"
+            max_strips: Parallel strip cap for QOI / EXR (0 = one per worker)
+            
+        Returns:
+            True if successful. Output paths get the extension of the format.
+        """
+        try:
+            self.call_function(self.data_capture_path, "SetOutputEncoding", {
+                "Settings": {
+                    "Format": image_format,
+                    "JpegQuality": jpeg_quality,
+                    "PngCompressionLevel": png_compression_level,
+                    "MaxStrips": max_strips
+                }
+            })
+            return True
+        except Exception as e:
+            logger.error(f"Set output encoding failed: {e}")
+            return False
+    
+    def set_capture_profile(self, profile: str) -> bool:
+        """
+        Select the RGB capture feature set.
+        
+        Args:
+            profile: "final" (full GI, reflections, AO), "fast-preview" (direct
+                lighting and shadows only), "annotation-only" (unlit, no effects)
+                or a profile registered on the DataCapture actor
+            
+        Returns:
+            True if the profile exists
+        """
+        try:
+            result = self.call_function(self.data_capture_path, "SetCaptureProfile", {
+                "ProfileName": profile
+            })
+            return bool(result.get("ReturnValue", False))
+        except Exception as e:
+            logger.error(f"Set capture profile failed: {e}")
+            return False
+    
+    def set_aovs(self, depth: bool = True, normals: bool = False, instance_id: bool = True,
+                 velocity: bool = False) -> bool:
+        """
+        Select the AOVs split out of the packed AOV pass (needs DataCapture.AOVMaterial).
+        
+        Args:
+            depth: <base>_depth.exr, float SceneDepth in cm
+            normals: <base>_normal.exr, world-space normal in RGB
+            instance_id: <base>_instance.png, 8-bit visible stencil ID
+            velocity: <base>_velocity.exr, pixel motion since the previous AOV capture in RG
+            
+        Returns:
+            True if successful
+        """
+        try:
+            self.call_function(self.data_capture_path, "SetAOVs", {
+                "Selection": {
+                    "bDepth": depth,
+                    "bNormals": normals,
+                    "bInstanceId": instance_id,
+                    "bVelocity": velocity
+                }
+            })
+            return True
+        except Exception as e:
+            logger.error(f"Set AOVs failed: {e}")
+            return False
+    
+    def capture_frame_with_aovs_async(self, output_path: str, aov_base_path: str,
+                                      width: int = 1920, height: int = 1080) -> int:
+        """
+        Queue an RGB capture plus the AOVs selected by set_aovs from one extra packed pass.
+        
+        Args:
+            output_path: RGB image path
+            aov_base_path: Base the AOV suffixes are appended to ("shard://<key>" for shards)
+            width: Image width in pixels
+            height: Image height in pixels
+            
+        Returns:
+            Ticket of the RGB frame (the AOV pass uses the next ticket), or -1
+        """
+        try:
+            result = self.call_function(self.data_capture_path, "CaptureFrameWithAOVsAsync", {
+                "OutputPath": output_path,
+                "AOVBasePath": aov_base_path,
+                "Width": width,
+                "Height": height
+            })
+            return int(result.get("ReturnValue", -1))
+        except Exception as e:
+            logger.error(f"AOV frame capture failed: {e}")
+            return -1
+    
+    def start_shard_writer(self, directory: str, shard_prefix: str = "shard", max_shard_mb: int = 1024,
+                           annotation_tags: List[str] = None) -> bool:
+        """
+        Route captures with "shard://<key>.<ext>" output paths into tar shards.
+        
+        Args:
+            directory: Output directory for <shard_prefix>-NNNNNN.tar / .idx
+            shard_prefix: Shard file name prefix
+            max_shard_mb: Shard size at which the next sample starts a new shard
+            annotation_tags: Actor tags packed into each sample as <key>.ann
+            
+        Returns:
+            True if the first shard was opened. Read back with vantagecv.shard_reader.
+        """
+        try:
+            result = self.call_function(self.data_capture_path, "StartShardWriter", {
+                "Directory": directory,
+                "ShardPrefix": shard_prefix,
+                "MaxShardMB": max_shard_mb,
+                "AnnotationTags": annotation_tags or []
+            })
+            return bool(result.get("ReturnValue", False))
+        except Exception as e:
+            logger.error(f"Start shard writer failed: {e}")
+            return False
+    
+    def stop_shard_writer(self) -> int:
+        """Flush pending captures into the shards and close the set. Returns the shard count."""
+        try:
+            result = self.call_function(self.data_capture_path, "StopShardWriter")
+            return int(result.get("ReturnValue", 0))
+        except Exception as e:
+            logger.error(f"Stop shard writer failed: {e}")
+            return 0
+    
+    def get_shard_writer_stats(self) -> Dict[str, Any]:
+        """Query shard writer state (current shard, shard / sample / byte counts)."""
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetShardWriterStats"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Shard writer stats query failed: {e}")
+            return {}
+    
+    def wait_for_capture(self, ticket: int) -> bool:
+        """Block until an async capture ticket has been read back."""
+        try:
+            result = self.call_function(self.data_capture_path, "WaitForCapture", {"Ticket": ticket})
+            return result.get("ReturnValue", False)
+        except Exception as e:
+            logger.error(f"Wait for capture {ticket} failed: {e}")
+            return False
+    
+    def flush_captures(self) -> int:
+        """Block until every in-flight async capture has been read back and written to disk."""
+        try:
+            result = self.call_function(self.data_capture_path, "FlushPendingCaptures")
+            return int(result.get("ReturnValue", 0))
+        except Exception as e:
+            logger.error(f"Flush captures failed: {e}")
+            return 0
+    
+    def flush_capture_writes(self) -> int:
+        """
+        Block until every queued capture image has been encoded and written.
+        Call at the end of a scene before reading images back from disk.
+        
+        Returns:
+            Number of files written since the previous flush
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "FlushCaptureWrites"
+            )
+            return int(result.get("ReturnValue", 0))
+        except Exception as e:
+            logger.error(f"Flush capture writes failed: {e}")
+            return 0
+    
+    def get_resource_pool_stats(self) -> Dict[str, Any]:
+        """
+        Query render target / pixel buffer pool usage.
+        
+        Returns:
+            Dictionary with in-use/idle counts, current bytes and high-water bytes
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetResourcePoolStats"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Resource pool stats query failed: {e}")
+            return {}
+    
+    def prewarm_actor_pool(self, asset_counts: Dict[str, int]) -> int:
+        """
+        Spawn parked actors so the first scenes reuse instead of spawning.
+        
+        Args:
+            asset_counts: Asset path -> minimum idle count, e.g. the
+                          pool.prewarm section of configs/vehicles.yaml
+            
+        Returns:
+            Number of actors spawned
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "PrewarmActorPool",
+                {"AssetCounts": {path: int(count) for path, count in asset_counts.items()}}
+            )
+            return int(result.get("ReturnValue", 0))
+        except Exception as e:
+            logger.error(f"Actor pool prewarm failed: {e}")
+            return 0
+    
+    def get_actor_pool_stats(self) -> Dict[str, Any]:
+        """
+        Query the spawned-actor pool.
+        
+        Returns:
+            Dictionary with total idle/in-use counts and per-asset spawned/reused counters
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetActorPoolStats"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Actor pool stats query failed: {e}")
+            return {}
+    
+    def trim_actor_pool(self, max_idle_per_asset: int = 0) -> int:
+        """
+        Destroy parked pool actors above a per-asset idle count.
+        
+        Args:
+            max_idle_per_asset: Idle actors kept per asset (0 = destroy all idle)
+            
+        Returns:
+            Number of actors destroyed
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "TrimActorPool",
+                {"MaxIdlePerAsset": int(max_idle_per_asset)}
+            )
+            return int(result.get("ReturnValue", 0))
+        except Exception as e:
+            logger.error(f"Actor pool trim failed: {e}")
+            return 0
+    
+    def get_material_cache_stats(self) -> Dict[str, Any]:
+        """
+        Query the material instance cache used by material and distractor randomization.
+        
+        Returns:
+            Dictionary with cached component/slot counts and MIDs created vs reused
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetMaterialCacheStats"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Material cache stats query failed: {e}")
+            return {}
+    
+    def preload_spawn_assets(self, asset_paths: List[str], wait: bool = False) -> int:
+        """
+        Start async loads of vehicle/prop asset paths so the first scene does
+        not block on disk loads. Paths that fail are cached and not retried.
+        
+        Args:
+            asset_paths: Blueprint class or static mesh object paths
+            wait: Block until every requested asset has loaded
+            
+        Returns:
+            Number of paths newly requested
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "PreloadSpawnAssets",
+                {"AssetPaths": list(asset_paths), "bWaitForCompletion": wait}
+            )
+            return int(result.get("ReturnValue", 0))
+        except Exception as e:
+            logger.error(f"Spawn asset preload failed: {e}")
+            return 0
+    
+    def get_spawn_asset_cache_stats(self) -> Dict[str, Any]:
+        """
+        Query the spawn asset cache.
+        
+        Returns:
+            Dictionary with cached class/mesh counts, failed paths, hits and blocking loads
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetSpawnAssetCacheStats"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Spawn asset cache stats query failed: {e}")
+            return {}
+    
+    def get_ground_heights(self, points: List[tuple]) -> List[float]:
+        """
+        Ground Z under many points in one call instead of one trace request per point.
+        
+        Args:
+            points: (x, y, z) candidates in cm; z is the trace reference height
+            
+        Returns:
+            Ground Z per point, in input order (the point's own z where no ground was hit)
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetGroundHeights",
+                {"Points": [{"X": x, "Y": y, "Z": z} for x, y, z in points]}
+            )
+            return [float(h) for h in result.get("ReturnValue", [])]
+        except Exception as e:
+            logger.error(f"Ground height query failed: {e}")
+            return [float(z) for _, _, z in points]
+    
+    def build_ground_heightfield(self, region_min: tuple, region_max: tuple, cell_size: float = 25.0) -> None:
+        """
+        Start caching ground heights over a region (e.g. a prop zone).
+        Built with async traces once per level; later queries inside it skip tracing.
+        """
+        try:
+            self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "BuildGroundHeightfield",
+                {
+                    "RegionMin": {"X": region_min[0], "Y": region_min[1], "Z": region_min[2]},
+                    "RegionMax": {"X": region_max[0], "Y": region_max[1], "Z": region_max[2]},
+                    "CellSize": cell_size
+                }
+            )
+        except Exception as e:
+            logger.error(f"Ground heightfield build failed: {e}")
+    
+    def apply_lighting_preset(self, preset_name: str, spawn_missing_lights: bool = False) -> bool:
+        """
+        Apply a registered lighting preset (dawn, morning, noon, afternoon, sunset,
+        night, Perfect or one registered at runtime) and its exposure bias.
+        Light handles are cached; the sky is recaptured only when the sun moved.
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "ApplyLightingPreset",
+                {"PresetName": preset_name, "bSpawnMissingLights": spawn_missing_lights}
+            )
+            return bool(result.get("ReturnValue", False))
+        except Exception as e:
+            logger.error(f"Apply lighting preset failed: {e}")
+            return False
+    
+    def register_lighting_preset(self, preset: Dict[str, Any]) -> None:
+        """
+        Add or replace a lighting preset.
+        
+        Args:
+            preset: FVantageCVLightingPreset fields, e.g.
+                {"Name": "overcast", "SunRotation": {"Pitch": -30, "Yaw": 175, "Roll": -55.49},
+                 "SkyIntensity": 0.6, "SkyCubemapPath": "/Game/Sky/Overcast.Overcast", "ExposureBias": 2.0}
+                Negative intensities keep the level's current value.
+        """
+        try:
+            self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "RegisterLightingPreset",
+                {"Preset": preset}
+            )
+        except Exception as e:
+            logger.error(f"Register lighting preset failed: {e}")
+    
+    def get_lighting_preset_stats(self) -> Dict[str, Any]:
+        """
+        Query the lighting preset registry.
+        
+        Returns:
+            Dictionary with preset count, active preset, skipped writes and sky recaptures
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetLightingPresetStats"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Lighting preset stats query failed: {e}")
+            return {}
+    
+    def get_capture_telemetry(self) -> Dict[str, Any]:
+        """
+        Query rolling per-stage capture timings.
+        
+        Returns:
+            Dictionary with window_size and, under stages, per stage (SceneApply, Spawn,
+            RenderSubmit, GPU, Readback, Encode, Write, Annotation)
+            count/total_count/total_ms/mean_ms/p50_ms/p95_ms/p99_ms/max_ms
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetCaptureTelemetry"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Capture telemetry query failed: {e}")
+            return {}
+    
+    def reset_capture_telemetry(self, window_size: int = 0) -> bool:
+        """
+        Clear the capture timing windows.
+        
+        Args:
+            window_size: Samples kept per stage (0 keeps the current size)
+            
+        Returns:
+            True if successful
+        """
+        try:
+            self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "ResetCaptureTelemetry",
+                {"WindowSize": window_size}
+            )
+            return True
+        except Exception as e:
+            logger.error(f"Capture telemetry reset failed: {e}")
+            return False
+    
+    def run_benchmarks(self, suites: str = "all", iterations: int = 10,
+                       output_path: str = "") -> Dict[str, Any]:
+        """
+        Run the in-engine benchmark suites in the current level.
+        
+        Args:
+            suites: Comma separated subset of Capture, Spawn, Anchors, Annotation
+                ("all" = every suite)
+            iterations: Timed passes per case (after one warm-up pass)
+            output_path: Results file inside UE (empty = Saved/VantageCV/Benchmarks/)
+            
+        Returns:
+            Results dictionary: machine info plus one list of cases per suite
+            (fps and count/mean_ms/min_ms/p50_ms/p95_ms/max_ms timings)
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "RunBenchmarks",
+                {"Suites": suites, "Iterations": iterations, "OutputPath": output_path}
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Benchmark run failed: {e}")
+            return {}
+    
+    def run_recipe(self, research_path: str, anchors_path: str,
+                   vehicles_path: str, num_frames: int = 0) -> bool:
+        """
+        Start rendering a generation recipe inside UE, without per-frame calls.
+        
+        UE reads the three YAML files itself and renders one frame per engine
+        tick; images and per-frame annotation JSON go to the research config's
+        output directories. Poll get_recipe_status() for progress.
+        
+        Args:
+            research_path: research_v2.yaml (absolute, or relative to the UE project)
+            anchors_path: Level anchors YAML
+            vehicles_path: vehicles.yaml
+            num_frames: Global frame count (0 = the config's num_images)
+            
+        Returns:
+            True if the recipe loaded and started
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "RunRecipe",
+                {
+                    "ResearchPath": research_path,
+                    "AnchorsPath": anchors_path,
+                    "VehiclesPath": vehicles_path,
+                    "NumFrames": num_frames,
+                }
+            )
+            return bool(result.get("ReturnValue", False))
+        except Exception as e:
+            logger.error(f"Recipe start failed: {e}")
+            return False
+    
+    def get_recipe_status(self) -> Dict[str, Any]:
+        """
+        Progress of the running recipe.
+        
+        Returns:
+            Status dictionary (running, finished, frames, frames_done, succeeded,
+            rejected, failed, current_frame, frames_per_second, output directories)
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetRecipeStatus",
+                {}
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Recipe status query failed: {e}")
+            return {}
+    
+    def stop_recipe(self) -> None:
+        """Stop the running recipe after its current frame."""
+        try:
+            self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "StopRecipe",
+                {}
+            )
+        except Exception as e:
+            logger.error(f"Recipe stop failed: {e}")
+    
+    def set_event_log_level(self, level: str) -> bool:
+        """
+        Set the plugin's structured event level at runtime.
+        
+        Args:
+            level: Error, Warning, Info, Verbose or VeryVerbose
+            
+        Returns:
+            False if the level name is unknown
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "SetEventLogLevel",
+                {"Level": level}
+            )
+            return bool(result.get("ReturnValue", False))
+        except Exception as e:
+            logger.error(f"Event log level change failed: {e}")
+            return False
+    
+    def get_event_log_stats(self) -> Dict[str, Any]:
+        """
+        Plugin event log state, after flushing pending events.
+        
+        Returns:
+            Stats dictionary (Level, CompiledLevel, File, Echo, Written,
+            Dropped, Queued, Capacity)
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetEventLogStats",
+                {}
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Event log stats query failed: {e}")
+            return {}
+    
+    def configure_worker(self, worker_index: int, num_workers: int,
+                         total_frames: int = 0, resume_frame: int = 0) -> bool:
+        """
+        Set this UE instance's place in a render farm worker set.
+        
+        Worker W of N owns global frames W, W + N, W + 2N, ...; "{worker}" in
+        output paths and shard names becomes the worker tag (e.g. "w03").
+        
+        Args:
+            worker_index: Index of this instance (0-based)
+            num_workers: Instances in the set
+            total_frames: Frames of the whole set (0 = open ended)
+            resume_frame: First global frame still to render, e.g. the
+                durable_resume_frame of this worker's last heartbeat
+            
+        Returns:
+            True if successful
+        """
+        try:
+            self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "ConfigureWorker",
+                {
+                    "WorkerIndex": worker_index,
+                    "NumWorkers": num_workers,
+                    "TotalFrames": total_frames,
+                    "ResumeFrame": resume_frame
+                }
+            )
+            return True
+        except Exception as e:
+            logger.error(f"Worker configuration failed: {e}")
+            return False
+    
+    def get_worker_status(self) -> Dict[str, Any]:
+        """
+        Query the worker heartbeat record.
+        
+        Returns:
+            Dictionary with worker_index/num_workers/worker_tag, host/gpu, resume_frame,
+            durable_resume_frame, num_completed, num_failed, num_remaining,
+            frames_per_second, pending_writes, frames_awaiting_writes and failed_frames
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetWorkerStatus"
+            )
+            return json.loads(result.get("ReturnValue", "{}") or "{}")
+        except Exception as e:
+            logger.error(f"Worker status query failed: {e}")
+            return {}
+    
+    def get_worker_frames(self, max_frames: int = 64) -> List[int]:
+        """
+        Next global frames owned by this worker and not yet completed.
+        
+        Args:
+            max_frames: Maximum frames returned
+            
+        Returns:
+            Global frame indices in render order (pass each as FrameIndex to render_scene)
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "GetWorkerFrames",
+                {"MaxFrames": max_frames}
+            )
+            return list(result.get("ReturnValue", []) or [])
+        except Exception as e:
+            logger.error(f"Worker frame query failed: {e}")
+            return []
+    
+    def report_frame_complete(self, frame_index: int, success: bool = True) -> bool:
+        """
+        Report a frame rendered outside render_scene to the worker heartbeat.
+        
+        Args:
+            frame_index: Global frame index
+            success: False lists the frame in failed_frames for reassignment
+            
+        Returns:
+            True if successful
+        """
+        try:
+            self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "ReportFrameComplete",
+                {"FrameIndex": frame_index, "bSuccess": success}
+            )
+            return True
+        except Exception as e:
+            logger.error(f"Frame report failed: {e}")
+            return False
+    
+    def render_scene(self, request: Dict[str, Any]) -> Dict[str, Any]:
+        """
+        Apply a complete scene description and capture it in a single call.
+        
+        Args:
+            request: FVantageCVSceneRequest fields, e.g.
+                {
+                    "ActorStates": [{"ActorName": ..., "Location": {...}, "Rotation": {...}, "bVisible": True}],
+                    "Spawns": [{"AssetPath": ..., "Location": {...}, "Rotation": {...}, "Tag": "Vehicle"}],
+                    "Lighting": {"Preset": "OutdoorSun", "ExposureBias": 0.0},
+                    "Cameras": [{"Location": {...}, "Rotation": {...}, "FOV": 90, "OutputPath": ..., "Width": 1920, "Height": 1080}],
+                    "TargetTags": ["Vehicle"],
+                    "FrameIndex": 42
+                }
+                FrameIndex (from get_worker_frames) reports the frame to the
+                worker heartbeat; omit it outside a worker set.
+            
+        Returns:
+            FVantageCVSceneResponse as a dictionary (Views, BoundingBoxesJson, PosesJson, ...)
+        """
+        try:
+            result = self.call_function(
+                "/Script/VantageCV.Default__VantageCVSubsystem",
+                "RenderScene",
+                {"Request": request}
+            )
+            return result.get("ReturnValue", {})
+        except Exception as e:
+            logger.error(f"Render scene failed: {e}")
+            return {"bSuccess": False, "ErrorMessage": str(e)}
+    
     def set_property(self, object_path: str, property_name: str, 
                      value: Any) -> None:
         """
@@ -449,6 +1407,60 @@ class UE5Bridge:
             # Fall back to Python-side cleanup
             return 0, -1
 
+    def plan_randomization_frames(self, seed: int, first_frame: int, num_frames: int,
+                                  domain_randomization_path: str = None) -> bool:
+        """
+        Precompute domain randomization (sky, lighting, distractors) for a range
+        of frames on UE5 worker threads. Frame N depends only on (seed, N).
+        
+        Args:
+            seed: Plan seed
+            first_frame: First frame index to plan
+            num_frames: Number of consecutive frames
+            domain_randomization_path: Optional path to DomainRandomization actor
+            
+        Returns:
+            True if the planning request was sent
+        """
+        if domain_randomization_path is None:
+            domain_randomization_path = "/Game/automobile.automobile:PersistentLevel.DomainRandomization_1"
+        
+        try:
+            self.call_function(
+                domain_randomization_path,
+                "PlanFrames",
+                {"Seed": seed, "FirstFrame": first_frame, "NumFrames": num_frames}
+            )
+            return True
+        except Exception as e:
+            logger.error(f"Plan randomization frames failed: {e}")
+            return False
+    
+    def apply_planned_frame(self, frame_index: int, domain_randomization_path: str = None) -> bool:
+        """
+        Apply a frame's randomization plan (sampled on demand if it was not planned ahead).
+        
+        Args:
+            frame_index: Frame index to apply
+            domain_randomization_path: Optional path to DomainRandomization actor
+            
+        Returns:
+            True if the call succeeded
+        """
+        if domain_randomization_path is None:
+            domain_randomization_path = "/Game/automobile.automobile:PersistentLevel.DomainRandomization_1"
+        
+        try:
+            self.call_function(
+                domain_randomization_path,
+                "ApplyPlannedFrame",
+                {"FrameIndex": frame_index}
+            )
+            return True
+        except Exception as e:
+            logger.error(f"Apply planned frame {frame_index} failed: {e}")
+            return False
+
     def get_actor_bounds(self, actor_name: str) -> Optional[Dict[str, float]]:
         """
         Get actor bounding box dimensions in centimeters.